@@ -36,6 +36,10 @@ struct Stat
   int64_t not_exist_count      = 0;
   int64_t delete_other_count   = 0;
 
+  int64_t lookup_success_count = 0;
+  int64_t lookup_missing_count = 0;
+  int64_t lookup_other_count   = 0;
+
   int64_t scan_success_count     = 0;
   int64_t scan_open_failed_count = 0;
   int64_t mismatch_count         = 0;
@@ -70,8 +74,8 @@ public:
 
     const char *filename = btree_filename.c_str();
 
-    RC rc = handler_.create(
-        log_handler_, bpm_, filename, AttrType::INTS, sizeof(int32_t) /*attr_len*/, internal_max_size, leaf_max_size);
+    RC rc = handler_.create(log_handler_, bpm_, filename, vector<AttrType>{AttrType::INTS},
+        vector<int>{sizeof(int32_t)} /*attr_len*/, false /*is_unique*/, internal_max_size, leaf_max_size);
     if (rc != RC::SUCCESS) {
       throw runtime_error("failed to create btree handler");
     }
@@ -92,13 +96,20 @@ public:
         state.thread_index());
   }
 
+  static vector<IndexUserKey> MakeKeys(uint32_t value)
+  {
+    char key[KEY_NULL_BYTE + sizeof(value)];
+    memset(key, 0, KEY_NULL_BYTE);
+    memcpy(key + KEY_NULL_BYTE, &value, sizeof(value));
+    return vector<IndexUserKey>{IndexUserKey(key, sizeof(key))};
+  }
+
   void FillUp(uint32_t min, uint32_t max)
   {
     for (uint32_t value = min; value < max; ++value) {
-      const char *key = reinterpret_cast<const char *>(&value);
-      RID         rid(value, value);
+      RID rid(value, value);
 
-      [[maybe_unused]] RC rc = handler_.insert_entry(key, &rid);
+      [[maybe_unused]] RC rc = handler_.insert_entry(MakeKeys(value), &rid);
       ASSERT(rc == RC::SUCCESS, "failed to insert entry into btree. key=%" PRIu32, value);
     }
   }
@@ -114,10 +125,9 @@ public:
 
   void Insert(uint32_t value, Stat &stat)
   {
-    const char *key = reinterpret_cast<const char *>(&value);
-    RID         rid(value, value);
+    RID rid(value, value);
 
-    RC rc = handler_.insert_entry(key, &rid);
+    RC rc = handler_.insert_entry(MakeKeys(value), &rid);
     switch (rc) {
       case RC::SUCCESS: {
         stat.insert_success_count++;
@@ -133,10 +143,9 @@ public:
 
   void Delete(uint32_t value, Stat &stat)
   {
-    const char *key = reinterpret_cast<const char *>(&value);
-    RID         rid(value, value);
+    RID rid(value, value);
 
-    RC rc = handler_.delete_entry(key, &rid);
+    RC rc = handler_.delete_entry(MakeKeys(value), &rid);
     switch (rc) {
       case RC::SUCCESS: {
         stat.delete_success_count++;
@@ -150,21 +159,31 @@ public:
     }
   }
 
-  void Scan(uint32_t begin, uint32_t end, Stat &stat)
+  void Lookup(uint32_t value, Stat &stat)
   {
-    const char *begin_key = reinterpret_cast<const char *>(&begin);
-    const char *end_key   = reinterpret_cast<const char *>(&end);
+    list<RID> rids;
 
+    RC rc = handler_.get_entry(MakeKeys(value), rids);
+    if (OB_FAIL(rc)) {
+      stat.lookup_other_count++;
+    } else if (rids.size() != 1) {
+      stat.lookup_missing_count++;
+    } else {
+      stat.lookup_success_count++;
+    }
+  }
+
+  void Scan(uint32_t begin, uint32_t end, Stat &stat)
+  {
     BplusTreeScanner scanner(handler_);
 
-    RC rc =
-        scanner.open(begin_key, sizeof(begin_key), true /*inclusive*/, end_key, sizeof(end_key), true /*inclusive*/);
+    RC rc = scanner.open(MakeKeys(begin), true /*inclusive*/, MakeKeys(end), true /*inclusive*/);
     if (rc != RC::SUCCESS) {
       stat.scan_open_failed_count++;
     } else {
       RID      rid;
       uint32_t count = 0;
-      while (RC::RECORD_EOF != (rc = scanner.next_entry(rid))) {
+      while (RC::SUCCESS == (rc = scanner.next_entry(rid))) {
         count++;
       }
 
@@ -203,9 +222,9 @@ BENCHMARK_DEFINE_F(InsertionBenchmark, Insertion)(State &state)
     Insert(value, stat);
   }
 
-  state.counters["success"]   = Counter(stat.insert_success_count, Counter::kIsRate);
-  state.counters["duplicate"] = Counter(stat.duplicate_count, Counter::kIsRate);
-  state.counters["other"]     = Counter(stat.insert_other_count, Counter::kIsRate);
+  state.counters["success"]   = benchmark::Counter(stat.insert_success_count, benchmark::Counter::kIsRate);
+  state.counters["duplicate"] = benchmark::Counter(stat.duplicate_count, benchmark::Counter::kIsRate);
+  state.counters["other"]     = benchmark::Counter(stat.insert_other_count, benchmark::Counter::kIsRate);
 }
 
 BENCHMARK_REGISTER_F(InsertionBenchmark, Insertion)->Threads(10);
@@ -242,9 +261,9 @@ BENCHMARK_DEFINE_F(DeletionBenchmark, Deletion)(State &state)
     Delete(value, stat);
   }
 
-  state.counters["success"]   = Counter(stat.delete_success_count, Counter::kIsRate);
-  state.counters["not_exist"] = Counter(stat.not_exist_count, Counter::kIsRate);
-  state.counters["other"]     = Counter(stat.delete_other_count, Counter::kIsRate);
+  state.counters["success"]   = benchmark::Counter(stat.delete_success_count, benchmark::Counter::kIsRate);
+  state.counters["not_exist"] = benchmark::Counter(stat.not_exist_count, benchmark::Counter::kIsRate);
+  state.counters["other"]     = benchmark::Counter(stat.delete_other_count, benchmark::Counter::kIsRate);
 }
 
 BENCHMARK_REGISTER_F(DeletionBenchmark, Deletion)->Threads(10)->Arg(4 * 10000);
@@ -284,16 +303,57 @@ BENCHMARK_DEFINE_F(ScanBenchmark, Scan)(State &state)
     Scan(begin, end, stat);
   }
 
-  state.counters["success"]               = Counter(stat.scan_success_count, Counter::kIsRate);
-  state.counters["open_failed_count"]     = Counter(stat.scan_open_failed_count, Counter::kIsRate);
-  state.counters["mismatch_number_count"] = Counter(stat.mismatch_count, Counter::kIsRate);
-  state.counters["other"]                 = Counter(stat.scan_other_count, Counter::kIsRate);
+  state.counters["success"]               = benchmark::Counter(stat.scan_success_count, benchmark::Counter::kIsRate);
+  state.counters["open_failed_count"]     = benchmark::Counter(stat.scan_open_failed_count, benchmark::Counter::kIsRate);
+  state.counters["mismatch_number_count"] = benchmark::Counter(stat.mismatch_count, benchmark::Counter::kIsRate);
+  state.counters["other"]                 = benchmark::Counter(stat.scan_other_count, benchmark::Counter::kIsRate);
 }
 
 BENCHMARK_REGISTER_F(ScanBenchmark, Scan)->Threads(10)->Arg(4 * 10000);
 
 ////////////////////////////////////////////////////////////////////////////////
 
+/**
+ * 只读的点查询，用来观察查询吞吐量随线程数的变化
+ */
+class LookupBenchmark : public BenchmarkBase
+{
+public:
+  string Name() const override { return "lookup"; }
+
+  void SetUp(const State &state) override
+  {
+    if (0 != state.thread_index()) {
+      return;
+    }
+
+    BenchmarkBase::SetUp(state);
+
+    uint32_t max = GetRangeMax(state);
+    ASSERT(max > 0, "invalid argument count. %ld", state.range(0));
+    FillUp(0, max);
+  }
+};
+
+BENCHMARK_DEFINE_F(LookupBenchmark, Lookup)(State &state)
+{
+  IntegerGenerator generator(0, GetRangeMax(state) - 1);
+  Stat             stat;
+
+  for (auto _ : state) {
+    uint32_t value = static_cast<uint32_t>(generator.next());
+    Lookup(value, stat);
+  }
+
+  state.counters["success"] = benchmark::Counter(stat.lookup_success_count, benchmark::Counter::kIsRate);
+  state.counters["missing"] = benchmark::Counter(stat.lookup_missing_count, benchmark::Counter::kIsRate);
+  state.counters["other"]   = benchmark::Counter(stat.lookup_other_count, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(LookupBenchmark, Lookup)->ThreadRange(1, 8)->Arg(4 * 10000);
+
+////////////////////////////////////////////////////////////////////////////////
+
 struct MixtureBenchmark : public BenchmarkBase
 {
   string Name() const override { return "mixture"; }
@@ -332,16 +392,16 @@ BENCHMARK_DEFINE_F(MixtureBenchmark, Mixture)(State &state)
     }
   }
 
-  state.counters.insert({{"insert_success", Counter(stat.insert_success_count, Counter::kIsRate)},
-      {"insert_other", Counter(stat.insert_other_count, Counter::kIsRate)},
-      {"insert_duplicate", Counter(stat.duplicate_count, Counter::kIsRate)},
-      {"delete_success", Counter(stat.delete_success_count, Counter::kIsRate)},
-      {"delete_other", Counter(stat.delete_other_count, Counter::kIsRate)},
-      {"delete_not_exist", Counter(stat.not_exist_count, Counter::kIsRate)},
-      {"scan_success", Counter(stat.scan_success_count, Counter::kIsRate)},
-      {"scan_other", Counter(stat.scan_other_count, Counter::kIsRate)},
-      {"scan_mismatch", Counter(stat.mismatch_count, Counter::kIsRate)},
-      {"scan_open_failed", Counter(stat.scan_open_failed_count, Counter::kIsRate)}});
+  state.counters.insert({{"insert_success", benchmark::Counter(stat.insert_success_count, benchmark::Counter::kIsRate)},
+      {"insert_other", benchmark::Counter(stat.insert_other_count, benchmark::Counter::kIsRate)},
+      {"insert_duplicate", benchmark::Counter(stat.duplicate_count, benchmark::Counter::kIsRate)},
+      {"delete_success", benchmark::Counter(stat.delete_success_count, benchmark::Counter::kIsRate)},
+      {"delete_other", benchmark::Counter(stat.delete_other_count, benchmark::Counter::kIsRate)},
+      {"delete_not_exist", benchmark::Counter(stat.not_exist_count, benchmark::Counter::kIsRate)},
+      {"scan_success", benchmark::Counter(stat.scan_success_count, benchmark::Counter::kIsRate)},
+      {"scan_other", benchmark::Counter(stat.scan_other_count, benchmark::Counter::kIsRate)},
+      {"scan_mismatch", benchmark::Counter(stat.mismatch_count, benchmark::Counter::kIsRate)},
+      {"scan_open_failed", benchmark::Counter(stat.scan_open_failed_count, benchmark::Counter::kIsRate)}});
 }
 
 BENCHMARK_REGISTER_F(MixtureBenchmark, Mixture)->Threads(10)->Arg(4 * 10000);
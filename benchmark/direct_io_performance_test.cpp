@@ -0,0 +1,128 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <benchmark/benchmark.h>
+#include <random>
+
+#include "common/lang/stdexcept.h"
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/double_write_buffer.h"
+#include "storage/clog/vacuous_log_handler.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/**
+ * 对比普通读写和直接IO(O_DIRECT)。
+ * 参数 0 表示普通读写，1 表示直接IO。
+ * 缓冲池只有 128 个页帧，文件有 PAGE_NUM 个页面，扫描和随机写都会频繁地读写磁盘。
+ * 注意普通读写时，数据文件通常都在操作系统的页缓存中，读页面只是一次内存复制；
+ * 直接IO的收益主要在于不占用双份内存，以及写回时不需要操作系统再刷一遍脏页。
+ */
+class DirectIoBenchmark : public Fixture
+{
+public:
+  static constexpr int PAGE_NUM = 4096;
+
+  void SetUp(const State &state) override
+  {
+    LoggerFactory::init_default("direct_io_performance_test.log", LOG_LEVEL_WARN);
+
+    const bool direct_io = state.range(0) != 0;
+    filename_            = direct_io ? "direct_io_performance_test.direct.bp" : "direct_io_performance_test.buffered.bp";
+    ::remove(filename_.c_str());
+
+    // 最少的内存，只有128个页帧
+    bpm_ = make_unique<BufferPoolManager>(BP_PAGE_SIZE);
+    bpm_->set_direct_io(direct_io);
+    RC rc = bpm_->init(make_unique<VacuousDoubleWriteBuffer>());
+    if (OB_SUCC(rc)) {
+      rc = bpm_->create_file(filename_.c_str());
+    }
+    if (OB_SUCC(rc)) {
+      rc = bpm_->open_file(log_handler_, filename_.c_str(), buffer_pool_);
+    }
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to open buffer pool file. filename=%s, rc=%s", filename_.c_str(), strrc(rc));
+      throw runtime_error("failed to open buffer pool file");
+    }
+
+    for (int i = 1; i < PAGE_NUM; i++) {
+      Frame *frame = nullptr;
+      rc           = buffer_pool_->allocate_page(&frame);
+      if (OB_FAIL(rc)) {
+        throw runtime_error("failed to allocate page");
+      }
+      memset(frame->data(), i & 0xFF, BP_PAGE_DATA_SIZE);
+      frame->mark_dirty();
+      buffer_pool_->unpin_page(frame);
+    }
+    buffer_pool_->flush_all_pages();
+  }
+
+  void TearDown(const State &state) override
+  {
+    bpm_->close_file(filename_.c_str());
+    bpm_.reset();
+    buffer_pool_ = nullptr;
+    ::remove(filename_.c_str());
+  }
+
+protected:
+  string                        filename_;
+  VacuousLogHandler             log_handler_;
+  unique_ptr<BufferPoolManager> bpm_;
+  DiskBufferPool               *buffer_pool_ = nullptr;
+};
+
+BENCHMARK_DEFINE_F(DirectIoBenchmark, SequentialScan)(State &state)
+{
+  int64_t page_count = 0;
+  for (auto _ : state) {
+    BufferPoolIterator iterator;
+    iterator.init(*buffer_pool_, 1);
+    while (iterator.has_next()) {
+      Frame *frame = nullptr;
+      if (OB_SUCC(buffer_pool_->get_this_page(iterator.next(), &frame))) {
+        DoNotOptimize(frame->data()[0]);
+        buffer_pool_->unpin_page(frame);
+        page_count++;
+      }
+    }
+  }
+  state.SetItemsProcessed(page_count);
+  state.SetBytesProcessed(page_count * BP_PAGE_SIZE);
+}
+
+BENCHMARK_REGISTER_F(DirectIoBenchmark, SequentialScan)->Arg(0)->Arg(1)->Unit(kMillisecond);
+
+BENCHMARK_DEFINE_F(DirectIoBenchmark, RandomWrite)(State &state)
+{
+  mt19937                       random_generator(0);
+  uniform_int_distribution<int> distribution(1, PAGE_NUM - 1);
+
+  int64_t page_count = 0;
+  for (auto _ : state) {
+    Frame *frame = nullptr;
+    if (OB_SUCC(buffer_pool_->get_this_page(distribution(random_generator), &frame))) {
+      frame->data()[page_count % BP_PAGE_DATA_SIZE]++;
+      frame->mark_dirty();
+      buffer_pool_->unpin_page(frame);
+      page_count++;
+    }
+  }
+  state.SetItemsProcessed(page_count);
+}
+
+BENCHMARK_REGISTER_F(DirectIoBenchmark, RandomWrite)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
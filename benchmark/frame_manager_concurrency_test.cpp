@@ -0,0 +1,230 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <benchmark/benchmark.h>
+#include <random>
+
+#include "common/lang/stdexcept.h"
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/**
+ * @brief 测试 BPFrameManager 在多线程下的吞吐量
+ * @details 第一个参数是分区个数，分区个数为1时等价于只有一把全局锁。
+ * 对比不同分区个数、不同线程数下的结果，可以看到页帧表分区对并发访问的影响。
+ */
+class FrameManagerBenchmark : public Fixture
+{
+public:
+  virtual string Name() const = 0;
+
+  virtual int PartitionNum(const State &state) const { return static_cast<int>(state.range(0)); }
+
+  virtual const char *EvictionPolicy(const State &state) const { return nullptr; }
+
+  void SetUp(const State &state) override
+  {
+    if (0 != state.thread_index()) {
+      return;
+    }
+
+    string log_name = this->Name() + ".log";
+    LoggerFactory::init_default(log_name.c_str(), LOG_LEVEL_WARN);
+
+    frame_manager_ = make_unique<BPFrameManager>(this->Name().c_str());
+    RC rc          = frame_manager_->init(POOL_NUM, PartitionNum(state), EvictionPolicy(state));
+    if (OB_FAIL(rc)) {
+      throw runtime_error("failed to init frame manager");
+    }
+  }
+
+  void TearDown(const State &state) override
+  {
+    if (0 != state.thread_index()) {
+      return;
+    }
+
+    list<Frame *> frames = frame_manager_->find_list(BUFFER_POOL_ID);
+    for (Frame *frame : frames) {
+      frame_manager_->free(BUFFER_POOL_ID, frame->page_num(), frame);
+    }
+    frame_manager_->cleanup();
+    frame_manager_.reset();
+  }
+
+  void FillUp(int page_count)
+  {
+    for (PageNum page_num = 0; page_num < page_count; page_num++) {
+      Frame *frame = frame_manager_->alloc(BUFFER_POOL_ID, page_num);
+      ASSERT(frame != nullptr, "failed to alloc frame. page_num=%d", page_num);
+      frame->unpin();
+    }
+  }
+
+  int FrameCount() const { return POOL_NUM * DEFAULT_ITEM_NUM_PER_POOL; }
+
+  /**
+   * @brief 访问一个页面，如果不在内存中就分配一个页帧，没有空闲页帧时淘汰一些
+   * @return 是否命中
+   */
+  bool Access(PageNum page_num)
+  {
+    Frame *frame = frame_manager_->get(BUFFER_POOL_ID, page_num);
+    if (frame != nullptr) {
+      frame->unpin();
+      return true;
+    }
+
+    while ((frame = frame_manager_->alloc(BUFFER_POOL_ID, page_num)) == nullptr) {
+      frame_manager_->purge_frames(1, [](Frame *) { return RC::SUCCESS; });
+    }
+    frame->unpin();
+    return false;
+  }
+
+protected:
+  static constexpr int BUFFER_POOL_ID = 1;
+  static constexpr int POOL_NUM       = 64;
+
+  unique_ptr<BPFrameManager> frame_manager_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief 所有页面都在内存中，只测试 get 的并发
+ */
+class FrameHitBenchmark : public FrameManagerBenchmark
+{
+public:
+  string Name() const override { return "frame_hit"; }
+
+  void SetUp(const State &state) override
+  {
+    if (0 != state.thread_index()) {
+      return;
+    }
+
+    FrameManagerBenchmark::SetUp(state);
+    FillUp(FrameCount());
+  }
+};
+
+BENCHMARK_DEFINE_F(FrameHitBenchmark, Get)(State &state)
+{
+  mt19937                    random_generator(state.thread_index());
+  uniform_int_distribution<> page_distribution(0, FrameCount() - 1);
+
+  int64_t hit_count = 0;
+  for (auto _ : state) {
+    if (Access(page_distribution(random_generator))) {
+      hit_count++;
+    }
+  }
+
+  state.counters["hit"] = benchmark::Counter(hit_count, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(FrameHitBenchmark, Get)
+    ->Arg(1)
+    ->Arg(BPFrameManager::DEFAULT_PARTITION_NUM)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief 访问的页面是内存的两倍，一半的访问需要淘汰页帧
+ */
+class FrameMixtureBenchmark : public FrameManagerBenchmark
+{
+public:
+  string Name() const override { return "frame_mixture"; }
+};
+
+BENCHMARK_DEFINE_F(FrameMixtureBenchmark, Mixture)(State &state)
+{
+  mt19937                    random_generator(state.thread_index());
+  uniform_int_distribution<> page_distribution(0, FrameCount() * 2 - 1);
+
+  int64_t hit_count  = 0;
+  int64_t miss_count = 0;
+  for (auto _ : state) {
+    if (Access(page_distribution(random_generator))) {
+      hit_count++;
+    } else {
+      miss_count++;
+    }
+  }
+
+  state.counters["hit"]  = benchmark::Counter(hit_count, benchmark::Counter::kIsRate);
+  state.counters["miss"] = benchmark::Counter(miss_count, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(FrameMixtureBenchmark, Mixture)
+    ->Arg(1)
+    ->Arg(BPFrameManager::DEFAULT_PARTITION_NUM)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief 对比不同淘汰策略在 OLTP + 全表扫描混合负载下的命中率
+ * @details 参数是淘汰策略的下标。一半的访问落在占内存 1/2 的热点页面上，另一半是顺序扫描
+ * 内存4倍大小的页面。
+ */
+class FrameScanMixtureBenchmark : public FrameManagerBenchmark
+{
+public:
+  string Name() const override { return "frame_scan_mixture"; }
+
+  int PartitionNum(const State &state) const override { return BPFrameManager::DEFAULT_PARTITION_NUM; }
+
+  const char *EvictionPolicy(const State &state) const override { return POLICIES[state.range(0)]; }
+
+  static constexpr const char *POLICIES[] = {"lru", "2q"};
+};
+
+BENCHMARK_DEFINE_F(FrameScanMixtureBenchmark, ScanMixture)(State &state)
+{
+  mt19937                    random_generator(state.thread_index());
+  uniform_int_distribution<> hot_distribution(0, FrameCount() / 2 - 1);
+  const int                  scan_page_count = FrameCount() * 4;
+
+  PageNum scan_page = 0;
+  bool    scan      = false;
+  for (auto _ : state) {
+    if (scan) {
+      Access(FrameCount() + scan_page);  // 扫描的页面和热点页面不重叠
+      scan_page = (scan_page + 1) % scan_page_count;
+    } else {
+      Access(hot_distribution(random_generator));
+    }
+    scan = !scan;
+  }
+
+  if (0 == state.thread_index()) {
+    BPFrameManager::Stat stat = frame_manager_->stat();
+    state.SetLabel(EvictionPolicy(state));
+    state.counters["hit_ratio"] = stat.hit_ratio();
+    state.counters["evict"]     = benchmark::Counter(stat.evict_count, benchmark::Counter::kIsRate);
+  }
+}
+
+BENCHMARK_REGISTER_F(FrameScanMixtureBenchmark, ScanMixture)->Arg(0)->Arg(1)->Threads(1)->Threads(8)->UseRealTime();
+
+////////////////////////////////////////////////////////////////////////////////
+
+BENCHMARK_MAIN();
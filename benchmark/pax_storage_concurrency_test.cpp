@@ -247,7 +247,7 @@ public:
     ChunkFileScanner scanner;
     Table            table;
     table.table_meta_.storage_format_ = StorageFormat::PAX_FORMAT;
-    RC rc = scanner.open_scan_chunk(&table, *buffer_pool_, log_handler_, ReadWriteMode::READ_ONLY);
+    RC rc = scanner.open_scan_chunk(&table, *buffer_pool_, nullptr /*trx*/, log_handler_, ReadWriteMode::READ_ONLY);
     if (rc != RC::SUCCESS) {
       stat.scan_open_failed_count++;
     } else {
@@ -296,8 +296,8 @@ BENCHMARK_DEFINE_F(DISABLED_InsertionBenchmark, Insertion)(State &state)
     Insert(generator.next(), stat, rid);
   }
 
-  state.counters["success"] = Counter(stat.insert_success_count, Counter::kIsRate);
-  state.counters["other"]   = Counter(stat.insert_other_count, Counter::kIsRate);
+  state.counters["success"] = benchmark::Counter(stat.insert_success_count, benchmark::Counter::kIsRate);
+  state.counters["other"]   = benchmark::Counter(stat.insert_other_count, benchmark::Counter::kIsRate);
 }
 
 BENCHMARK_REGISTER_F(DISABLED_InsertionBenchmark, Insertion)->Threads(10);
@@ -346,9 +346,9 @@ BENCHMARK_DEFINE_F(DISABLED_DeletionBenchmark, Deletion)(State &state)
     Delete(rid, stat);
   }
 
-  state.counters["success"]   = Counter(stat.delete_success_count, Counter::kIsRate);
-  state.counters["not_exist"] = Counter(stat.not_exist_count, Counter::kIsRate);
-  state.counters["other"]     = Counter(stat.delete_other_count, Counter::kIsRate);
+  state.counters["success"]   = benchmark::Counter(stat.delete_success_count, benchmark::Counter::kIsRate);
+  state.counters["not_exist"] = benchmark::Counter(stat.not_exist_count, benchmark::Counter::kIsRate);
+  state.counters["other"]     = benchmark::Counter(stat.delete_other_count, benchmark::Counter::kIsRate);
 }
 
 BENCHMARK_REGISTER_F(DISABLED_DeletionBenchmark, Deletion)->Threads(10)->Arg(4 * 10000);
@@ -389,10 +389,10 @@ BENCHMARK_DEFINE_F(DISABLED_ScanBenchmark, Scan)(State &state)
     Scan(begin, end, stat);
   }
 
-  state.counters["success"]               = Counter(stat.scan_success_count, Counter::kIsRate);
-  state.counters["open_failed_count"]     = Counter(stat.scan_open_failed_count, Counter::kIsRate);
-  state.counters["mismatch_number_count"] = Counter(stat.mismatch_count, Counter::kIsRate);
-  state.counters["other"]                 = Counter(stat.scan_other_count, Counter::kIsRate);
+  state.counters["success"]               = benchmark::Counter(stat.scan_success_count, benchmark::Counter::kIsRate);
+  state.counters["open_failed_count"]     = benchmark::Counter(stat.scan_open_failed_count, benchmark::Counter::kIsRate);
+  state.counters["mismatch_number_count"] = benchmark::Counter(stat.mismatch_count, benchmark::Counter::kIsRate);
+  state.counters["other"]                 = benchmark::Counter(stat.scan_other_count, benchmark::Counter::kIsRate);
 }
 
 BENCHMARK_REGISTER_F(DISABLED_ScanBenchmark, Scan)->Threads(10)->Arg(4 * 10000);
@@ -426,10 +426,10 @@ BENCHMARK_DEFINE_F(DISABLED_ScanChunkBenchmark, ScanChunk)(State &state)
     ScanChunk(stat);
   }
 
-  state.counters["success"]               = Counter(stat.scan_success_count, Counter::kIsRate);
-  state.counters["open_failed_count"]     = Counter(stat.scan_open_failed_count, Counter::kIsRate);
-  state.counters["mismatch_number_count"] = Counter(stat.mismatch_count, Counter::kIsRate);
-  state.counters["other"]                 = Counter(stat.scan_other_count, Counter::kIsRate);
+  state.counters["success"]               = benchmark::Counter(stat.scan_success_count, benchmark::Counter::kIsRate);
+  state.counters["open_failed_count"]     = benchmark::Counter(stat.scan_open_failed_count, benchmark::Counter::kIsRate);
+  state.counters["mismatch_number_count"] = benchmark::Counter(stat.mismatch_count, benchmark::Counter::kIsRate);
+  state.counters["other"]                 = benchmark::Counter(stat.scan_other_count, benchmark::Counter::kIsRate);
 }
 
 BENCHMARK_REGISTER_F(DISABLED_ScanChunkBenchmark, ScanChunk)->Threads(10)->Arg(4 * 10000);
@@ -487,15 +487,15 @@ BENCHMARK_DEFINE_F(DISABLED_MixtureBenchmark, Mixture)(State &state)
     }
   }
 
-  state.counters.insert({{"insert_success", Counter(stat.insert_success_count, Counter::kIsRate)},
-      {"insert_other", Counter(stat.insert_other_count, Counter::kIsRate)},
-      {"delete_success", Counter(stat.delete_success_count, Counter::kIsRate)},
-      {"delete_other", Counter(stat.delete_other_count, Counter::kIsRate)},
-      {"delete_not_exist", Counter(stat.not_exist_count, Counter::kIsRate)},
-      {"scan_success", Counter(stat.scan_success_count, Counter::kIsRate)},
-      {"scan_other", Counter(stat.scan_other_count, Counter::kIsRate)},
-      {"scan_mismatch", Counter(stat.mismatch_count, Counter::kIsRate)},
-      {"scan_open_failed", Counter(stat.scan_open_failed_count, Counter::kIsRate)}});
+  state.counters.insert({{"insert_success", benchmark::Counter(stat.insert_success_count, benchmark::Counter::kIsRate)},
+      {"insert_other", benchmark::Counter(stat.insert_other_count, benchmark::Counter::kIsRate)},
+      {"delete_success", benchmark::Counter(stat.delete_success_count, benchmark::Counter::kIsRate)},
+      {"delete_other", benchmark::Counter(stat.delete_other_count, benchmark::Counter::kIsRate)},
+      {"delete_not_exist", benchmark::Counter(stat.not_exist_count, benchmark::Counter::kIsRate)},
+      {"scan_success", benchmark::Counter(stat.scan_success_count, benchmark::Counter::kIsRate)},
+      {"scan_other", benchmark::Counter(stat.scan_other_count, benchmark::Counter::kIsRate)},
+      {"scan_mismatch", benchmark::Counter(stat.mismatch_count, benchmark::Counter::kIsRate)},
+      {"scan_open_failed", benchmark::Counter(stat.scan_open_failed_count, benchmark::Counter::kIsRate)}});
 }
 
 BENCHMARK_REGISTER_F(DISABLED_MixtureBenchmark, Mixture)->Threads(10)->Arg(4 * 10000);
@@ -252,11 +252,11 @@ BENCHMARK_DEFINE_F(InsertionBenchmark, Insertion)(State &state)
     Insert(generator.next(), stat, rid);
   }
 
-  state.counters["success"] = Counter(stat.insert_success_count, Counter::kIsRate);
-  state.counters["other"]   = Counter(stat.insert_other_count, Counter::kIsRate);
+  state.counters["success"] = benchmark::Counter(stat.insert_success_count, benchmark::Counter::kIsRate);
+  state.counters["other"]   = benchmark::Counter(stat.insert_other_count, benchmark::Counter::kIsRate);
 }
 
-BENCHMARK_REGISTER_F(InsertionBenchmark, Insertion)->Threads(10);
+BENCHMARK_REGISTER_F(InsertionBenchmark, Insertion)->Threads(10)->Threads(16);
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -302,9 +302,9 @@ BENCHMARK_DEFINE_F(DeletionBenchmark, Deletion)(State &state)
     Delete(rid, stat);
   }
 
-  state.counters["success"]   = Counter(stat.delete_success_count, Counter::kIsRate);
-  state.counters["not_exist"] = Counter(stat.not_exist_count, Counter::kIsRate);
-  state.counters["other"]     = Counter(stat.delete_other_count, Counter::kIsRate);
+  state.counters["success"]   = benchmark::Counter(stat.delete_success_count, benchmark::Counter::kIsRate);
+  state.counters["not_exist"] = benchmark::Counter(stat.not_exist_count, benchmark::Counter::kIsRate);
+  state.counters["other"]     = benchmark::Counter(stat.delete_other_count, benchmark::Counter::kIsRate);
 }
 
 BENCHMARK_REGISTER_F(DeletionBenchmark, Deletion)->Threads(10)->Arg(4 * 10000);
@@ -345,10 +345,10 @@ BENCHMARK_DEFINE_F(ScanBenchmark, Scan)(State &state)
     Scan(begin, end, stat);
   }
 
-  state.counters["success"]               = Counter(stat.scan_success_count, Counter::kIsRate);
-  state.counters["open_failed_count"]     = Counter(stat.scan_open_failed_count, Counter::kIsRate);
-  state.counters["mismatch_number_count"] = Counter(stat.mismatch_count, Counter::kIsRate);
-  state.counters["other"]                 = Counter(stat.scan_other_count, Counter::kIsRate);
+  state.counters["success"]               = benchmark::Counter(stat.scan_success_count, benchmark::Counter::kIsRate);
+  state.counters["open_failed_count"]     = benchmark::Counter(stat.scan_open_failed_count, benchmark::Counter::kIsRate);
+  state.counters["mismatch_number_count"] = benchmark::Counter(stat.mismatch_count, benchmark::Counter::kIsRate);
+  state.counters["other"]                 = benchmark::Counter(stat.scan_other_count, benchmark::Counter::kIsRate);
 }
 
 BENCHMARK_REGISTER_F(ScanBenchmark, Scan)->Threads(10)->Arg(4 * 10000);
@@ -403,15 +403,15 @@ BENCHMARK_DEFINE_F(MixtureBenchmark, Mixture)(State &state)
     }
   }
 
-  state.counters.insert({{"insert_success", Counter(stat.insert_success_count, Counter::kIsRate)},
-      {"insert_other", Counter(stat.insert_other_count, Counter::kIsRate)},
-      {"delete_success", Counter(stat.delete_success_count, Counter::kIsRate)},
-      {"delete_other", Counter(stat.delete_other_count, Counter::kIsRate)},
-      {"delete_not_exist", Counter(stat.not_exist_count, Counter::kIsRate)},
-      {"scan_success", Counter(stat.scan_success_count, Counter::kIsRate)},
-      {"scan_other", Counter(stat.scan_other_count, Counter::kIsRate)},
-      {"scan_mismatch", Counter(stat.mismatch_count, Counter::kIsRate)},
-      {"scan_open_failed", Counter(stat.scan_open_failed_count, Counter::kIsRate)}});
+  state.counters.insert({{"insert_success", benchmark::Counter(stat.insert_success_count, benchmark::Counter::kIsRate)},
+      {"insert_other", benchmark::Counter(stat.insert_other_count, benchmark::Counter::kIsRate)},
+      {"delete_success", benchmark::Counter(stat.delete_success_count, benchmark::Counter::kIsRate)},
+      {"delete_other", benchmark::Counter(stat.delete_other_count, benchmark::Counter::kIsRate)},
+      {"delete_not_exist", benchmark::Counter(stat.not_exist_count, benchmark::Counter::kIsRate)},
+      {"scan_success", benchmark::Counter(stat.scan_success_count, benchmark::Counter::kIsRate)},
+      {"scan_other", benchmark::Counter(stat.scan_other_count, benchmark::Counter::kIsRate)},
+      {"scan_mismatch", benchmark::Counter(stat.mismatch_count, benchmark::Counter::kIsRate)},
+      {"scan_open_failed", benchmark::Counter(stat.scan_open_failed_count, benchmark::Counter::kIsRate)}});
 }
 
 BENCHMARK_REGISTER_F(MixtureBenchmark, Mixture)->Threads(10)->Arg(4 * 10000);
@@ -0,0 +1,238 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "common/compress/lz_codec.h"
+
+namespace common {
+
+namespace {
+
+constexpr int MIN_MATCH     = 4;
+constexpr int MAX_OFFSET    = 65535;
+constexpr int HASH_BITS     = 12;
+constexpr int LAST_LITERALS = 5;   ///< 最后几个字节总是当做字面量，匹配不会延伸到这里
+constexpr int MF_LIMIT      = 12;  ///< 距离结尾不到这么多字节时不再查找匹配
+constexpr int RUN_MASK      = 15;  ///< token中每个长度占4位
+
+inline uint32_t read32(const uint8_t *p)
+{
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint32_t hash32(uint32_t v) { return (v * 2654435761U) >> (32 - HASH_BITS); }
+
+/// 写入超过 RUN_MASK 的那部分长度
+inline uint8_t *write_length(uint8_t *op, int length)
+{
+  for (; length >= 255; length -= 255) {
+    *op++ = 255;
+  }
+  *op++ = static_cast<uint8_t>(length);
+  return op;
+}
+
+/// 读取额外的长度字节，累加到 length 上。数据不完整或者长度超过 limit 时返回false
+inline bool read_length(const uint8_t *&ip, const uint8_t *iend, int limit, int &length)
+{
+  uint8_t b = 0;
+  do {
+    if (ip >= iend) {
+      return false;
+    }
+    b = *ip++;
+    length += b;
+    if (length > limit) {
+      return false;
+    }
+  } while (b == 255);
+  return true;
+}
+
+/**
+ * @brief 输出一个序列
+ * @param match_length 匹配长度，为0表示最后一个只有字面量的序列
+ */
+inline uint8_t *write_sequence(uint8_t *op, uint8_t *oend, const uint8_t *literals, int literal_length, int offset,
+    int match_length)
+{
+  // token + 字面量长度 + 字面量 + 偏移 + 匹配长度
+  const int64_t need = 1 + (literal_length / 255 + 1) + literal_length + 2 + (match_length / 255 + 1);
+  if (oend - op < need) {
+    return nullptr;
+  }
+
+  uint8_t *token       = op++;
+  const int match_code = match_length > 0 ? match_length - MIN_MATCH : 0;
+  *token = static_cast<uint8_t>((literal_length >= RUN_MASK ? RUN_MASK : literal_length) << 4);
+  if (literal_length >= RUN_MASK) {
+    op = write_length(op, literal_length - RUN_MASK);
+  }
+  memcpy(op, literals, literal_length);
+  op += literal_length;
+
+  if (match_length == 0) {
+    return op;
+  }
+
+  *op++ = static_cast<uint8_t>(offset & 0xFF);
+  *op++ = static_cast<uint8_t>(offset >> 8);
+  *token |= static_cast<uint8_t>(match_code >= RUN_MASK ? RUN_MASK : match_code);
+  if (match_code >= RUN_MASK) {
+    op = write_length(op, match_code - RUN_MASK);
+  }
+  return op;
+}
+
+}  // namespace
+
+int LzCodec::compress_bound(int src_size) { return src_size + src_size / 255 + 16; }
+
+int LzCodec::compress(const char *src, int src_size, char *dst, int dst_capacity)
+{
+  if (src == nullptr || dst == nullptr || src_size < 0 || dst_capacity <= 0) {
+    return -1;
+  }
+
+  const uint8_t *base   = reinterpret_cast<const uint8_t *>(src);
+  const uint8_t *ip     = base;
+  const uint8_t *anchor = base;
+  const uint8_t *iend   = base + src_size;
+  uint8_t       *op     = reinterpret_cast<uint8_t *>(dst);
+  uint8_t       *oend   = op + dst_capacity;
+
+  if (src_size >= MF_LIMIT) {
+    const uint8_t *mflimit     = iend - MF_LIMIT;
+    const uint8_t *match_limit = iend - LAST_LITERALS;
+
+    // 记录每个4字节串最后一次出现的位置
+    int32_t hash_table[1 << HASH_BITS];
+    memset(hash_table, 0xFF, sizeof(hash_table));
+
+    while (ip < mflimit) {
+      const uint32_t sequence = read32(ip);
+      const uint32_t h        = hash32(sequence);
+      const int32_t  ref      = hash_table[h];
+      hash_table[h]           = static_cast<int32_t>(ip - base);
+
+      if (ref < 0 || (ip - base) - ref > MAX_OFFSET || read32(base + ref) != sequence) {
+        ip++;
+        continue;
+      }
+
+      // 向前向后尽量延长匹配
+      const uint8_t *match = base + ref;
+      while (ip > anchor && match > base && ip[-1] == match[-1]) {
+        ip--;
+        match--;
+      }
+
+      const uint8_t *match_end = ip + MIN_MATCH;
+      const uint8_t *ref_end   = match + MIN_MATCH;
+      while (match_end < match_limit && *match_end == *ref_end) {
+        match_end++;
+        ref_end++;
+      }
+
+      op = write_sequence(op, oend, anchor, static_cast<int>(ip - anchor), static_cast<int>(ip - match),
+          static_cast<int>(match_end - ip));
+      if (op == nullptr) {
+        return -1;
+      }
+
+      ip     = match_end;
+      anchor = ip;
+
+      // 把匹配结尾附近的位置也放到哈希表中，提高后面找到匹配的机会
+      if (ip - 2 >= base && ip < mflimit) {
+        hash_table[hash32(read32(ip - 2))] = static_cast<int32_t>(ip - 2 - base);
+      }
+    }
+  }
+
+  op = write_sequence(op, oend, anchor, static_cast<int>(iend - anchor), 0, 0);
+  if (op == nullptr) {
+    return -1;
+  }
+  return static_cast<int>(op - reinterpret_cast<uint8_t *>(dst));
+}
+
+int LzCodec::decompress(const char *src, int src_size, char *dst, int dst_capacity)
+{
+  if (src == nullptr || dst == nullptr || src_size <= 0 || dst_capacity < 0) {
+    return -1;
+  }
+
+  const uint8_t *ip    = reinterpret_cast<const uint8_t *>(src);
+  const uint8_t *iend  = ip + src_size;
+  uint8_t       *obase = reinterpret_cast<uint8_t *>(dst);
+  uint8_t       *op    = obase;
+  uint8_t       *oend  = obase + dst_capacity;
+
+  while (true) {
+    if (ip >= iend) {
+      return -1;
+    }
+
+    const uint8_t token          = *ip++;
+    int           literal_length = token >> 4;
+    if (literal_length == RUN_MASK && !read_length(ip, iend, dst_capacity, literal_length)) {
+      return -1;
+    }
+    if (literal_length > iend - ip || literal_length > oend - op) {
+      return -1;
+    }
+    memcpy(op, ip, literal_length);
+    op += literal_length;
+    ip += literal_length;
+
+    // 最后一个序列只有字面量
+    if (ip == iend) {
+      break;
+    }
+
+    if (iend - ip < 2) {
+      return -1;
+    }
+    const int offset = ip[0] | (ip[1] << 8);
+    ip += 2;
+    if (offset == 0 || offset > op - obase) {
+      return -1;
+    }
+
+    int match_length = token & RUN_MASK;
+    if (match_length == RUN_MASK && !read_length(ip, iend, dst_capacity, match_length)) {
+      return -1;
+    }
+    match_length += MIN_MATCH;
+    if (match_length > oend - op) {
+      return -1;
+    }
+
+    // 匹配串可能和正在输出的数据重叠，重叠时只能逐个字节复制
+    const uint8_t *match = op - offset;
+    if (offset >= match_length) {
+      memcpy(op, match, match_length);
+      op += match_length;
+    } else {
+      for (int i = 0; i < match_length; i++) {
+        *op++ = *match++;
+      }
+    }
+  }
+
+  return static_cast<int>(op - obase);
+}
+
+}  // namespace common
@@ -0,0 +1,50 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+namespace common {
+
+/**
+ * @brief 一个简单的LZ77压缩算法，格式与LZ4的块格式类似
+ * @details 压缩后的数据由若干个序列组成，每个序列是：
+ * 1. 一个字节的token，高4位是字面量长度，低4位是匹配长度减去4；
+ *    等于15时表示后面还有额外的长度字节，每个字节累加，直到遇到不是255的字节；
+ * 2. 字面量；
+ * 3. 两个字节的匹配偏移(小端)，以及额外的匹配长度字节。
+ * 最后一个序列只有字面量，没有匹配部分。
+ *
+ * 只使用一个哈希表查找4字节的重复串，速度很快，适合压缩页面这样的小块数据。
+ * 匹配偏移最大是65535，更大的数据也可以压缩，只是找不到更远的重复串。
+ */
+class LzCodec
+{
+public:
+  /**
+   * @brief 最坏情况下压缩后的大小
+   */
+  static int compress_bound(int src_size);
+
+  /**
+   * @brief 压缩数据
+   * @param dst_capacity 压缩结果的最大长度，可以比 compress_bound 小，用来提前放弃压缩效果不好的数据
+   * @return 压缩后的长度。dst 放不下压缩结果或者参数错误时返回 -1
+   */
+  static int compress(const char *src, int src_size, char *dst, int dst_capacity);
+
+  /**
+   * @brief 解压数据
+   * @details 会检查输入数据的合法性，损坏的数据不会导致越界读写
+   * @return 解压后的长度。数据损坏或者 dst 放不下时返回 -1
+   */
+  static int decompress(const char *src, int src_size, char *dst, int dst_capacity);
+};
+
+}  // namespace common
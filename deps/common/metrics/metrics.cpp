@@ -12,6 +12,9 @@ See the Mulan PSL v2 for more details. */
 // Created by Longda on 2021/4/19.
 //
 
+#include <algorithm>
+#include <sstream>
+
 #include "common/metrics/metrics.h"
 #include "common/lang/mutex.h"
 
@@ -99,6 +102,104 @@ void SimpleTimer::snapshot()
   ((SimplerTimerSnapshot *)snapshot_value_)->setValue(mean, tps);
 }
 
+Counter::~Counter()
+{
+  if (snapshot_value_ != NULL) {
+    delete snapshot_value_;
+    snapshot_value_ = NULL;
+  }
+}
+
+void Counter::snapshot()
+{
+  if (snapshot_value_ == NULL) {
+    snapshot_value_ = new SnapshotBasic<long>();
+  }
+  long value = this->value();
+  ((SnapshotBasic<long> *)snapshot_value_)->setValue(value);
+}
+
+LatencyHistogram::LatencyHistogram()
+{
+  for (std::atomic<long> &bucket : buckets_) {
+    bucket.store(0);
+  }
+}
+
+LatencyHistogram::~LatencyHistogram()
+{
+  if (snapshot_value_ != NULL) {
+    delete snapshot_value_;
+    snapshot_value_ = NULL;
+  }
+}
+
+void LatencyHistogram::update(long value)
+{
+  if (value < 0) {
+    value = 0;
+  }
+
+  int index = 0;
+  for (unsigned long v = value; v != 0 && index < BUCKET_NUM - 1; v >>= 1) {
+    index++;
+  }
+
+  buckets_[index].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value, std::memory_order_relaxed);
+
+  long max_value = max_.load(std::memory_order_relaxed);
+  while (max_value < value && !max_.compare_exchange_weak(max_value, value, std::memory_order_relaxed)) {
+  }
+}
+
+double LatencyHistogram::mean() const
+{
+  long count = this->count();
+  return count == 0 ? 0.0 : static_cast<double>(sum()) / count;
+}
+
+long LatencyHistogram::percentile(double quantile) const
+{
+  long total = 0;
+  long counts[BUCKET_NUM];
+  for (int i = 0; i < BUCKET_NUM; i++) {
+    counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+  if (total == 0) {
+    return 0;
+  }
+
+  // 至少要有 rank 个值不大于返回的结果
+  long rank = static_cast<long>(quantile * total + 0.5);
+  rank      = std::min(std::max(rank, 1L), total);
+
+  long accumulated = 0;
+  for (int i = 0; i < BUCKET_NUM; i++) {
+    accumulated += counts[i];
+    if (accumulated >= rank) {
+      long upper = i == 0 ? 0 : (1L << i) - 1;
+      return std::min(upper, max());
+    }
+  }
+  return max();
+}
+
+void LatencyHistogram::snapshot()
+{
+  if (snapshot_value_ == NULL) {
+    snapshot_value_ = new SnapshotBasic<std::string>();
+  }
+
+  std::stringstream oss;
+  oss << "count:" << count() << ",mean:" << mean() << ",p50:" << percentile(0.5) << ",p99:" << percentile(0.99)
+      << ",max:" << max();
+  std::string value = oss.str();
+  ((SnapshotBasic<std::string> *)snapshot_value_)->setValue(value);
+}
+
 Histogram::Histogram(RandomGenerator &random) : UniformReservoir(random) {}
 
 Histogram::Histogram(RandomGenerator &random, size_t size) : UniformReservoir(random, size) {}
@@ -31,9 +31,21 @@ public:
   void set_snapshot(Snapshot *value) { snapshot_value_ = value; }
 };
 
+/**
+ * @brief 累计计数，snapshot 不会清零
+ */
 class Counter : public Metric
 {
-  void set_snapshot(SnapshotBasic<long> *value) { snapshot_value_ = value; }
+public:
+  virtual ~Counter();
+
+  void inc(long increase = 1) { value_.fetch_add(increase, std::memory_order_relaxed); }
+  long value() const { return value_.load(std::memory_order_relaxed); }
+
+  void snapshot();
+
+protected:
+  std::atomic<long> value_{0};
 };
 
 class Meter : public Metric
@@ -100,6 +112,43 @@ protected:
   long              snapshot_tick_;
 };
 // update ms
+/**
+ * @brief 按照2的幂划分桶的直方图，适合统计IO耗时这种分布范围很大的数据
+ * @details 第0个桶统计0，第i个桶统计 [2^(i-1), 2^i) 中的值。每个桶都是原子变量，记录时不加锁，
+ * 可以在很热的路径上使用。分位数只能精确到桶的上界。
+ */
+class LatencyHistogram : public Metric
+{
+public:
+  static constexpr int BUCKET_NUM = 48;
+
+public:
+  LatencyHistogram();
+  virtual ~LatencyHistogram();
+
+  void update(long value);
+
+  long   count() const { return count_.load(std::memory_order_relaxed); }
+  long   sum() const { return sum_.load(std::memory_order_relaxed); }
+  long   max() const { return max_.load(std::memory_order_relaxed); }
+  double mean() const;
+
+  /**
+   * @brief 估算分位数
+   * @param quantile 取值范围 [0, 1]
+   * @return 分位数所在的桶的上界，不会超过记录过的最大值
+   */
+  long percentile(double quantile) const;
+
+  void snapshot();
+
+protected:
+  std::atomic<long> buckets_[BUCKET_NUM];
+  std::atomic<long> count_{0};
+  std::atomic<long> sum_{0};
+  std::atomic<long> max_{0};
+};
+
 class TimerStat
 {
 public:
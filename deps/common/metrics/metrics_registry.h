@@ -17,6 +17,7 @@ See the Mulan PSL v2 for more details. */
 
 #include <list>
 #include <map>
+#include <mutex>
 #include <string>
 
 #include "common/metrics/metric.h"
@@ -24,6 +25,11 @@ See the Mulan PSL v2 for more details. */
 
 namespace common {
 
+/**
+ * @brief 指标的注册表
+ * @details 注册和注销可以在任意线程中进行，比如打开和关闭文件时，所以所有的接口都加了锁。
+ * 注册的指标在注销之前必须一直有效。
+ */
 class MetricsRegistry
 {
 public:
@@ -40,6 +46,7 @@ public:
   void add_reporter(Reporter *reporter) { reporters.push_back(reporter); }
 
 protected:
+  std::mutex                      lock_;
   std::map<std::string, Metric *> metrics;
   std::list<Reporter *>           reporters;
 };
@@ -24,4 +24,26 @@ See the Mulan PSL v2 for more details. */
 
 #define SOCKET_BUFFER_SIZE 8192
 
+#define BUFFER_POOL "BUFFER_POOL"
+#define BUFFER_POOL_MEMORY_SIZE "MEMORY_SIZE"
+#define BUFFER_POOL_HUGE_PAGE "HUGE_PAGE"
+#define BUFFER_POOL_NUMA_INTERLEAVE "NUMA_INTERLEAVE"
+#define BUFFER_POOL_EVICTION_POLICY "EVICTION_POLICY"
+#define BUFFER_POOL_PAGE_CLEANER "PAGE_CLEANER"
+#define BUFFER_POOL_DIRTY_PAGE_RATIO "DIRTY_PAGE_RATIO"
+#define BUFFER_POOL_CLEAN_FRAME_RESERVE "CLEAN_FRAME_RESERVE"
+#define BUFFER_POOL_PAGE_CLEANER_INTERVAL_MS "PAGE_CLEANER_INTERVAL_MS"
+#define BUFFER_POOL_READ_AHEAD_PAGES "READ_AHEAD_PAGES"
+#define BUFFER_POOL_IO_BACKEND "IO_BACKEND"
+#define BUFFER_POOL_DIRECT_IO "DIRECT_IO"
+#define BUFFER_POOL_WARM_UP "WARM_UP"
+#define BUFFER_POOL_WARM_UP_DUMP_INTERVAL_SEC "WARM_UP_DUMP_INTERVAL_SEC"
+#define BUFFER_POOL_VECTOR_CACHE_SIZE "VECTOR_CACHE_SIZE"
+
+#define TRX "TRX"
+#define TRX_VACUUM "VACUUM"
+#define TRX_VACUUM_INTERVAL_MS "VACUUM_INTERVAL_MS"
+#define TRX_VACUUM_PAGES_PER_BATCH "VACUUM_PAGES_PER_BATCH"
+#define TRX_VACUUM_BATCH_SLEEP_MS "VACUUM_BATCH_SLEEP_MS"
+
 #define SESSION_STAGE_NAME "SessionStage"
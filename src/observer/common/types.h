@@ -42,13 +42,15 @@ enum class ReadWriteMode
 
 /**
  * @brief 存储格式
- * @details 当前仅支持行存格式（ROW_FORMAT）以及 PAX 存储格式(PAX_FORMAT)。
+ * @details 当前支持行存格式（ROW_FORMAT）、PAX 存储格式(PAX_FORMAT)，以及使用槽页面存放变长行的
+ * 行存格式(SLOTTED_FORMAT)。
  */
 enum class StorageFormat
 {
   UNKNOWN_FORMAT = 0,
   ROW_FORMAT,
-  PAX_FORMAT
+  PAX_FORMAT,
+  SLOTTED_FORMAT
 };
 
 /**
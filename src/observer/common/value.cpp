@@ -313,6 +313,18 @@ void Value::set_vector(const VectorData &vector, bool give_ownership)
   length_   = vector.dim * sizeof(float);
 }
 
+void Value::set_vector_reference(const VectorData &vector)
+{
+  reset();
+  attr_type_           = AttrType::VECTORS;
+  value_.vector_value_ = {
+      .dim    = vector.dim,
+      .vector = vector.vector,
+  };
+  own_data_ = false;
+  length_   = vector.dim * sizeof(float);
+}
+
 void Value::set_value(const Value &value)
 {
   reset();
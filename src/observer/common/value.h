@@ -289,6 +289,8 @@ public:
   void set_date(int val);        // 从 YYYYMMDD 格式的整数创建 Value
   void set_vector(const char *s);
   void set_vector(const VectorData &vector, bool give_ownership = false);
+  /// 引用外部的向量数据，比如映射到内存的向量数据文件，既不复制也不释放
+  void set_vector_reference(const VectorData &vector);
   void set_string_from_other(const Value &other);
   void set_text_from_other(const Value &other);
   void set_text(const char *s, int len, bool give_ownership = false);
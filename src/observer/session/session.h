@@ -85,6 +85,12 @@ public:
 
   bool used_chunk_mode() { return used_chunk_mode_; }
 
+  /**
+   * @brief 并行度，向量化执行时使用多少个线程扫描一张表
+   */
+  void set_parallel_degree(int parallel_degree) { parallel_degree_ = parallel_degree; }
+  int  parallel_degree() const { return parallel_degree_; }
+
   void set_used_chunk_mode(bool used_chunk_mode) { used_chunk_mode_ = used_chunk_mode; }
 
   /**
@@ -113,4 +119,6 @@ private:
   bool used_chunk_mode_ = false;
 
   ExecutionMode execution_mode_ = ExecutionMode::TUPLE_ITERATOR;
+
+  int parallel_degree_ = 1;  ///< 不大于1时不并行执行
 };
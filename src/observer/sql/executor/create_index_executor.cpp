@@ -18,6 +18,7 @@ See the Mulan PSL v2 for more details. */
 #include "event/sql_event.h"
 #include "session/session.h"
 #include "sql/stmt/create_index_stmt.h"
+#include "storage/db/db.h"
 #include "storage/table/table.h"
 
 RC CreateIndexExecutor::execute(SQLStageEvent *sql_event)
@@ -32,6 +33,8 @@ RC CreateIndexExecutor::execute(SQLStageEvent *sql_event)
 
   Trx   *trx   = session->current_trx();
   Table *table = create_index_stmt->table();
+  // 建索引时会扫描所有记录，不能同时回收记录
+  auto vacuum_guard = session->get_current_db()->pause_vacuum();
   return table->create_index(
       trx, create_index_stmt->field_metas(), create_index_stmt->index_name().c_str(), create_index_stmt->is_unique());
 }
@@ -40,7 +40,8 @@ RC CreateTableExecutor::execute(SQLStageEvent *sql_event)
     // create-table-select
     if (!create_table_stmt->attr_infos().empty()) {
       // 指定了字段信息
-      rc = session->get_current_db()->create_table(table_name, create_table_stmt->attr_infos(), create_table_stmt->storage_format());
+      rc = session->get_current_db()->create_table(table_name, create_table_stmt->attr_infos(), create_table_stmt->storage_format(),
+          create_table_stmt->page_compression());
       size_ = create_table_stmt->attr_infos().size();
     } else {
       std::vector<AttrInfoSqlNode> attr_infos;
@@ -59,7 +60,8 @@ RC CreateTableExecutor::execute(SQLStageEvent *sql_event)
         attr_infos.push_back(attr_info);
       }
       size_ = attr_infos.size();
-      rc = session->get_current_db()->create_table(table_name, attr_infos, create_table_stmt->storage_format());
+      rc = session->get_current_db()->create_table(table_name, attr_infos, create_table_stmt->storage_format(),
+          create_table_stmt->page_compression());
     }
 
     // 开始插入数据
@@ -85,10 +87,18 @@ RC CreateTableExecutor::execute(SQLStageEvent *sql_event)
         LOG_WARN("failed to insert record by transaction. rc=%s", strrc(rc));
       }
     }
+    // 插入的文本和向量攒在缓冲区中，最后一起写入文件
+    if (table_ != nullptr) {
+      RC flush_rc = table_->flush_texts_and_vectors();
+      if (OB_SUCC(rc)) {
+        rc = flush_rc;
+      }
+    }
     
   } else {
     // normally create table
-    rc = session->get_current_db()->create_table(table_name, create_table_stmt->attr_infos(), create_table_stmt->storage_format());
+    rc = session->get_current_db()->create_table(table_name, create_table_stmt->attr_infos(), create_table_stmt->storage_format(),
+        create_table_stmt->page_compression());
   }
 
   return rc;
@@ -4,6 +4,7 @@
 #include "event/sql_event.h"
 #include "session/session.h"
 #include "sql/stmt/create_index_stmt.h"
+#include "storage/db/db.h"
 #include "storage/table/table.h"
 
 #include <sql/stmt/create_vector_index_stmt.h>
@@ -20,6 +21,8 @@ RC CreateVectorIndexExecutor::execute(SQLStageEvent *sql_event)
 
   Trx   *trx   = session->current_trx();
   Table *table = create_index_stmt->table();
+  // 建索引时会扫描所有记录，不能同时回收记录
+  auto vacuum_guard = session->get_current_db()->pause_vacuum();
   return table->create_vector_index(trx,
       create_index_stmt->field_meta(),
       create_index_stmt->index_name().c_str(),
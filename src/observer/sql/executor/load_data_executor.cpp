@@ -32,16 +32,20 @@ RC LoadDataExecutor::execute(SQLStageEvent *sql_event)
   return rc;
 }
 
+/// 每攒够这么多行插入一次。批量插入时每个记录页面只记录一条日志，索引也按照键值排序以后插入
+static constexpr int LOAD_DATA_BATCH_SIZE = 1000;
+
 /**
- * 从文件中导入数据时使用。尝试向表中插入解析后的一行数据。
+ * 从文件中导入数据时使用。把解析后的一行数据转换成一条记录。
  * @param table  要导入的表
  * @param file_values 从文件中读取到的一行数据，使用分隔符拆分后的几个字段值
- * @param record_values Table::insert_record使用的参数，为了防止频繁的申请内存
+ * @param record_values Table::make_record使用的参数，为了防止频繁的申请内存
+ * @param record 生成的记录
  * @param errmsg 如果出现错误，通过这个参数返回错误信息
  * @return 成功返回RC::SUCCESS
  */
-RC insert_record_from_file(
-    Table *table, std::vector<std::string> &file_values, std::vector<Value> &record_values, std::stringstream &errmsg)
+RC make_record_from_file(Table *table, std::vector<std::string> &file_values, std::vector<Value> &record_values,
+    Record &record, std::stringstream &errmsg)
 {
 
   const int field_num     = record_values.size();
@@ -65,12 +69,9 @@ RC insert_record_from_file(
   }
 
   if (RC::SUCCESS == rc) {
-    Record record;
     rc = table->make_record(field_num, record_values.data(), record);
     if (rc != RC::SUCCESS) {
       errmsg << "insert failed.";
-    } else if (RC::SUCCESS != (rc = table->insert_record(record))) {
-      errmsg << "insert failed.";
     }
   }
   return rc;
@@ -101,6 +102,37 @@ void LoadDataExecutor::load_data(Table *table, const char *file_name, SqlResult
   int                      line_num        = 0;
   int                      insertion_count = 0;
   RC                       rc              = RC::SUCCESS;
+
+  std::vector<Record> records;
+  std::vector<int>    record_lines;  // 每条记录所在的行号
+  records.reserve(LOAD_DATA_BATCH_SIZE);
+  record_lines.reserve(LOAD_DATA_BATCH_SIZE);
+
+  // 批量插入失败时整批都没有插入，再逐行插入这一批记录，保留出错行之前的记录，并报告出错的行号
+  auto flush = [&]() {
+    RC ret = table->insert_records(records);
+    if (OB_SUCC(ret)) {
+      insertion_count += static_cast<int>(records.size());
+    } else {
+      for (size_t i = 0; i < records.size(); i++) {
+        if (OB_SUCC(ret)) {
+          ret = table->insert_record(records[i]);
+          if (OB_SUCC(ret)) {
+            insertion_count++;
+            continue;
+          }
+          result_string << "Line:" << record_lines[i] << " insert record failed:insert failed.. error:" << strrc(ret)
+                        << std::endl;
+        }
+        // 没有插入的记录引用的文本和向量不会再被使用
+        table->free_texts_and_vectors_of_record(records[i].data());
+      }
+    }
+    records.clear();
+    record_lines.clear();
+    return ret;
+  };
+
   while (!fs.eof() && RC::SUCCESS == rc) {
     std::getline(fs, line);
     line_num++;
@@ -111,13 +143,30 @@ void LoadDataExecutor::load_data(Table *table, const char *file_name, SqlResult
     file_values.clear();
     common::split_string(line, delim, file_values);
     std::stringstream errmsg;
-    rc = insert_record_from_file(table, file_values, record_values, errmsg);
+    Record            record;
+    rc = make_record_from_file(table, file_values, record_values, record, errmsg);
     if (rc != RC::SUCCESS) {
       result_string << "Line:" << line_num << " insert record failed:" << errmsg.str() << ". error:" << strrc(rc)
                     << std::endl;
-    } else {
-      insertion_count++;
+      break;
     }
+
+    records.push_back(std::move(record));
+    record_lines.push_back(line_num);
+    if (static_cast<int>(records.size()) >= LOAD_DATA_BATCH_SIZE) {
+      rc = flush();
+    }
+  }
+
+  // 出错行之前攒下的记录仍然插入，与逐行插入时的结果一致
+  RC flush_rc = flush();
+  if (RC::SUCCESS == rc) {
+    rc = flush_rc;
+  }
+  // 导入的文本和向量攒在缓冲区中，最后一起写入文件
+  flush_rc = table->flush_texts_and_vectors();
+  if (RC::SUCCESS == rc) {
+    rc = flush_rc;
   }
   fs.close();
 
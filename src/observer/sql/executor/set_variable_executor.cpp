@@ -34,6 +34,20 @@ RC SetVariableExecutor::execute(SQLStageEvent *sql_event)
       } else {
         rc = RC::INVALID_ARGUMENT;
       }
+    } else if (strcasecmp(var_name, "parallel_degree") == 0) {
+#ifdef CONCURRENCY
+      const int max_parallel_degree = MAX_PARALLEL_DEGREE;
+#else
+      // 没有 CONCURRENCY 时缓冲池和页帧的锁都是空操作，多个线程同时扫描会破坏缓冲池，只能串行扫描
+      const int max_parallel_degree = 1;
+#endif
+      if (var_value.attr_type() == AttrType::INTS && var_value.get_int() >= 1 &&
+          var_value.get_int() <= max_parallel_degree) {
+        session->set_parallel_degree(var_value.get_int());
+        LOG_TRACE("set parallel_degree to %d", var_value.get_int());
+      } else {
+        rc = RC::VARIABLE_NOT_VALID;
+      }
     } else if (strcasecmp(var_name, "NAMES") == 0) {
       // nop
     } else {
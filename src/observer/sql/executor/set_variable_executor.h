@@ -32,6 +32,9 @@ public:
 
   RC execute(SQLStageEvent *sql_event);
 
+  /// 并行度的上限，每个并行度对应一个线程
+  static constexpr int MAX_PARALLEL_DEGREE = 64;
+
 private:
   RC var_value_to_boolean(const Value &var_value, bool &bool_value) const;
 
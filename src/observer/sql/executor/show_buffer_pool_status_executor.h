@@ -0,0 +1,61 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/rc.h"
+#include "event/session_event.h"
+#include "event/sql_event.h"
+#include "session/session.h"
+#include "sql/executor/sql_result.h"
+#include "sql/operator/string_list_physical_operator.h"
+#include "storage/db/db.h"
+#include "storage/table/buffer_pool_status_view.h"
+
+/**
+ * @brief 显示缓冲池统计信息的执行器
+ * @ingroup Executor
+ * @details 每个打开的文件一行，与查询 __buffer_pool_status__ 虚拟表的结果相同
+ */
+class ShowBufferPoolStatusExecutor
+{
+public:
+  ShowBufferPoolStatusExecutor()          = default;
+  virtual ~ShowBufferPoolStatusExecutor() = default;
+
+  RC execute(SQLStageEvent *sql_event)
+  {
+    SqlResult    *sql_result    = sql_event->session_event()->sql_result();
+    SessionEvent *session_event = sql_event->session_event();
+
+    Db *db = session_event->session()->get_current_db();
+
+    TupleSchema tuple_schema;
+    for (const AttrInfoSqlNode &attr_info : BufferPoolStatusView::attr_infos()) {
+      tuple_schema.append_cell(TupleCellSpec("", attr_info.name.c_str(), attr_info.name.c_str()));
+    }
+    sql_result->set_tuple_schema(tuple_schema);
+
+    vector<vector<Value>> rows;
+    BufferPoolStatusView::make_rows(db->buffer_pool_manager(), rows);
+
+    auto oper = new StringListPhysicalOperator;
+    for (const vector<Value> &row : rows) {
+      vector<string> strings;
+      for (const Value &value : row) {
+        strings.push_back(value.to_string());
+      }
+      oper->append(strings.begin(), strings.end());
+    }
+
+    sql_result->set_operator(unique_ptr<PhysicalOperator>(oper));
+    return RC::SUCCESS;
+  }
+};
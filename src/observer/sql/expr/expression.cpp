@@ -556,6 +556,39 @@ RC ConjunctionExpr::get_value(const Tuple &tuple, Value &value, Trx *trx) const
   return rc;
 }
 
+RC ConjunctionExpr::eval(Chunk &chunk, std::vector<uint8_t> &select)
+{
+  // 子表达式的 eval 只会把不满足条件的记录清零，AND 时依次计算即可
+  if (conjunction_type_ == Type::AND) {
+    for (unique_ptr<Expression> &expr : children_) {
+      RC rc = expr->eval(chunk, select);
+      if (rc != RC::SUCCESS) {
+        LOG_WARN("failed to eval child expression. rc=%s", strrc(rc));
+        return rc;
+      }
+    }
+    return RC::SUCCESS;
+  }
+
+  vector<uint8_t> any_select(chunk.rows(), children_.empty() ? 1 : 0);
+  vector<uint8_t> child_select;
+  for (unique_ptr<Expression> &expr : children_) {
+    child_select.assign(chunk.rows(), 1);
+    RC rc = expr->eval(chunk, child_select);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to eval child expression. rc=%s", strrc(rc));
+      return rc;
+    }
+    for (int i = 0; i < chunk.rows(); i++) {
+      any_select[i] |= child_select[i];
+    }
+  }
+  for (int i = 0; i < chunk.rows(); i++) {
+    select[i] &= any_select[i];
+  }
+  return RC::SUCCESS;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 ArithmeticExpr::ArithmeticExpr(ArithmeticExpr::Type type, Expression *left, Expression *right)
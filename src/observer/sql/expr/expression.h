@@ -370,6 +370,11 @@ public:
   AttrType value_type() const override { return AttrType::BOOLEANS; }
   RC       get_value(const Tuple &tuple, Value &value, Trx *trx = nullptr) const override;
 
+  /**
+   * @brief 把不满足条件的记录在 select 中清零。OR 时分别计算每个子表达式再取并集
+   */
+  RC eval(Chunk &chunk, std::vector<uint8_t> &select) override;
+
   Type conjunction_type() const { return conjunction_type_; }
 
   std::vector<std::unique_ptr<Expression>> &children() { return children_; }
@@ -229,9 +229,14 @@ public:
     } else if (field_meta->type() == AttrType::VECTORS) {
       VectorData vector_data;
       memcpy(&vector_data, this->record().data() + field_meta->offset(), field_meta->len());
-      table_->load_vector(&vector_data);
+      bool mapped = false;
+      table_->load_vector(&vector_data, mapped);
       cell.set_type(AttrType::VECTORS);
-      cell.set_vector(vector_data, true);
+      if (mapped) {
+        cell.set_vector_reference(vector_data);  // 不复制，直接引用映射到内存的向量数据
+      } else {
+        cell.set_vector(vector_data, true);
+      }
     } else {
       cell.set_type(field_meta->type());
       cell.set_data(this->record_->data() + field_meta->offset(), field_meta->len());
@@ -277,6 +282,9 @@ public:
         };
         table_->dump_vector(&vector_data);
         memcpy(this->record_->data() + field_meta->offset(), &vector_data, length);
+      } else if (field_meta->type() == AttrType::TEXTS || field_meta->type() == AttrType::VECTORS) {
+        // 不能留下旧的 TextData 或 VectorData，否则删除记录时会再释放一次
+        memset(this->record_->data() + field_meta->offset(), 0, length);
       } else {
         memcpy(this->record_->data() + field_meta->offset(), cell.data(), length);
       }
@@ -300,6 +308,9 @@ public:
         };
         table_->dump_vector(&vector_data);
         memcpy(data + field_meta->offset(), &vector_data, length);
+      } else if (field_meta->type() == AttrType::TEXTS || field_meta->type() == AttrType::VECTORS) {
+        // 不能留下旧的 TextData 或 VectorData，否则删除记录时会再释放一次
+        memset(data + field_meta->offset(), 0, length);
       } else {
         memcpy(data + field_meta->offset(), cell.data(), length);
       }
@@ -43,6 +43,13 @@ RC DeletePhysicalOperator::open(Trx *trx)
     RowTuple *row_tuple = static_cast<RowTuple *>(tuple);
     Record   &record    = row_tuple->record();
     records_.emplace_back(std::move(record));
+
+    // 扫描出来的记录可能直接指向页面，关闭子算子以后页面就不再加锁了，需要复制一份
+    rc = records_.back().materialize();
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to copy record: %s", strrc(rc));
+      return rc;
+    }
   }
 
   child->close();
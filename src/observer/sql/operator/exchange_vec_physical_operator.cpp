@@ -0,0 +1,188 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/operator/exchange_vec_physical_operator.h"
+#include "common/log/log.h"
+#include "common/thread/thread_util.h"
+
+using namespace std;
+using namespace common;
+
+ExchangeVecPhysicalOperator::~ExchangeVecPhysicalOperator() { close(); }
+
+string ExchangeVecPhysicalOperator::param() const { return "dop=" + to_string(children_.size()); }
+
+RC ExchangeVecPhysicalOperator::open(Trx *trx)
+{
+  if (children_.empty()) {
+    LOG_WARN("exchange operator has no child");
+    return RC::INVALID_ARGUMENT;
+  }
+
+  // 工作线程还没有启动，可以直接重置
+  if (morsels_ != nullptr) {
+    morsels_->reset();
+  }
+
+  chunks_.clear();
+  ready_chunks_.clear();
+  free_chunks_.clear();
+  for (size_t i = 0; i < children_.size() * CHUNKS_PER_WORKER; i++) {
+    chunks_.push_back(make_unique<Chunk>());
+    free_chunks_.push_back(chunks_.back().get());
+  }
+  current_chunk_   = nullptr;
+  stopped_         = false;
+  error_rc_        = RC::SUCCESS;
+  running_workers_ = static_cast<int>(children_.size());
+
+  for (unique_ptr<PhysicalOperator> &child : children_) {
+    workers_.push_back(make_unique<thread>(&ExchangeVecPhysicalOperator::worker_func, this, child.get(), trx));
+  }
+  LOG_TRACE("exchange operator started %d workers", workers_.size());
+  return RC::SUCCESS;
+}
+
+RC ExchangeVecPhysicalOperator::next(Chunk &chunk)
+{
+  unique_lock<mutex> guard(lock_);
+  if (current_chunk_ != nullptr) {
+    free_chunks_.push_back(current_chunk_);
+    current_chunk_ = nullptr;
+    free_cv_.notify_one();
+  }
+
+  ready_cv_.wait(guard, [this]() { return !ready_chunks_.empty() || running_workers_ == 0 || OB_FAIL(error_rc_); });
+  if (OB_FAIL(error_rc_)) {
+    return error_rc_;
+  }
+  if (ready_chunks_.empty()) {
+    return RC::RECORD_EOF;
+  }
+
+  current_chunk_ = ready_chunks_.front();
+  ready_chunks_.pop_front();
+  guard.unlock();
+
+  return chunk.reference(*current_chunk_);
+}
+
+RC ExchangeVecPhysicalOperator::close()
+{
+  {
+    lock_guard<mutex> guard(lock_);
+    stopped_ = true;
+  }
+  free_cv_.notify_all();
+
+  for (unique_ptr<thread> &worker : workers_) {
+    worker->join();
+  }
+  workers_.clear();
+  current_chunk_ = nullptr;
+  return RC::SUCCESS;
+}
+
+void ExchangeVecPhysicalOperator::worker_func(PhysicalOperator *child, Trx *trx)
+{
+  thread_set_name("Exchange");
+
+  // 子算子的打开、执行和关闭都在同一个工作线程中。扫描时会一直持有当前页面的读锁，
+  // 加锁和解锁必须在同一个线程中，打开失败时通过 error_rc_ 返回给调用方
+  RC rc = child->open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open child operator. rc=%s", strrc(rc));
+    finish_worker(rc);
+    return;
+  }
+
+  Chunk result;
+  while (OB_SUCC(rc = child->next(result))) {
+    if (result.rows() == 0) {
+      continue;
+    }
+
+    Chunk *chunk = acquire_free_chunk();
+    if (chunk == nullptr) {
+      break;  // 调用方已经不需要更多的结果了
+    }
+
+    rc = copy_chunk(result, *chunk);
+    lock_guard<mutex> guard(lock_);
+    if (OB_FAIL(rc)) {
+      free_chunks_.push_back(chunk);
+      break;
+    }
+    ready_chunks_.push_back(chunk);
+    ready_cv_.notify_one();
+  }
+
+  RC close_rc = child->close();
+  if (OB_FAIL(close_rc)) {
+    LOG_WARN("failed to close child operator. rc=%s", strrc(close_rc));
+  }
+  finish_worker(rc);
+}
+
+Chunk *ExchangeVecPhysicalOperator::acquire_free_chunk()
+{
+  unique_lock<mutex> guard(lock_);
+  free_cv_.wait(guard, [this]() { return !free_chunks_.empty() || stopped_ || OB_FAIL(error_rc_); });
+  if (stopped_ || OB_FAIL(error_rc_)) {
+    return nullptr;
+  }
+
+  Chunk *chunk = free_chunks_.front();
+  free_chunks_.pop_front();
+  return chunk;
+}
+
+RC ExchangeVecPhysicalOperator::copy_chunk(Chunk &source, Chunk &target)
+{
+  // 缓冲区第一次使用或者结构不一样时，按照子算子返回的结果创建列
+  bool same_layout = target.column_num() == source.column_num();
+  for (int i = 0; same_layout && i < source.column_num(); i++) {
+    const Column &column = source.column(i);
+    same_layout = target.column_ids(i) == source.column_ids(i) && target.column(i).attr_len() == column.attr_len() &&
+                  target.column(i).capacity() >= column.count();
+  }
+  if (!same_layout) {
+    target.reset();
+    for (int i = 0; i < source.column_num(); i++) {
+      const Column &column   = source.column(i);
+      const int     capacity = max(column.capacity(), column.count());
+      target.add_column(make_unique<Column>(column.attr_type(), column.attr_len(), capacity), source.column_ids(i));
+    }
+  }
+
+  target.reset_data();
+  for (int i = 0; i < source.column_num(); i++) {
+    Column &column = source.column(i);
+    target.column(i).set_column_type(column.column_type());
+    RC rc = target.column(i).append(column.data(), column.count());
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to copy column. index=%d, rc=%s", i, strrc(rc));
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+void ExchangeVecPhysicalOperator::finish_worker(RC rc)
+{
+  lock_guard<mutex> guard(lock_);
+  running_workers_--;
+  if (rc != RC::SUCCESS && rc != RC::RECORD_EOF && error_rc_ == RC::SUCCESS) {
+    LOG_WARN("exchange worker failed. rc=%s", strrc(rc));
+    error_rc_ = rc;
+    free_cv_.notify_all();  // 其它工作线程不需要再继续了
+  }
+  ready_cv_.notify_all();
+}
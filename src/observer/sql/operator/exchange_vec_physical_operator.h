@@ -0,0 +1,82 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/deque.h"
+#include "common/lang/memory.h"
+#include "common/lang/mutex.h"
+#include "common/lang/thread.h"
+#include "sql/operator/physical_operator.h"
+
+class PageMorselQueue;
+
+/**
+ * @brief 汇总多个线程执行结果的物理算子(Vectorized)
+ * @ingroup PhysicalOperator
+ * @details 每个子算子是一个独立的执行管道，open 时为每个子算子启动一个线程，子算子在这个线程中打开、执行和关闭。
+ * 子算子返回的 chunk 复制到缓冲区中，由调用 next 的线程依次取出。返回结果的顺序是不确定的。
+ * 缓冲区的个数是固定的，调用方来不及处理时工作线程会等待，不会无限制地占用内存。
+ *
+ * 并行扫描时，每个子算子是共用一个 PageMorselQueue 的 TableScanVecPhysicalOperator，
+ * 扫描和过滤都在工作线程中完成。
+ */
+class ExchangeVecPhysicalOperator : public PhysicalOperator
+{
+public:
+  ExchangeVecPhysicalOperator() = default;
+  virtual ~ExchangeVecPhysicalOperator();
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::EXCHANGE_VEC; }
+
+  std::string param() const override;
+
+  RC open(Trx *trx) override;
+  RC next(Chunk &chunk) override;
+  RC close() override;
+
+  /**
+   * @brief 子算子共用的 PageMorselQueue，每次 open 时重置，重新执行时会再扫描一遍所有的页面
+   */
+  void set_morsel_queue(std::shared_ptr<PageMorselQueue> morsels) { morsels_ = std::move(morsels); }
+
+private:
+  /// 执行一个子算子，把结果放到缓冲区中
+  void worker_func(PhysicalOperator *child, Trx *trx);
+
+  /// 取一个空闲的缓冲区，停止时返回 nullptr
+  Chunk *acquire_free_chunk();
+
+  /// 把子算子返回的结果复制到缓冲区中
+  static RC copy_chunk(Chunk &source, Chunk &target);
+
+  /// 工作线程结束时调用，rc 不是 SUCCESS/RECORD_EOF 时记录下来返回给调用方
+  void finish_worker(RC rc);
+
+private:
+  /// 每个工作线程平均可以使用的缓冲区个数
+  static constexpr int CHUNKS_PER_WORKER = 2;
+
+  vector<unique_ptr<thread>> workers_;
+  vector<unique_ptr<Chunk>>  chunks_;  ///< 所有的缓冲区
+
+  mutex              lock_;
+  condition_variable ready_cv_;  ///< 有新的结果或者工作线程结束
+  condition_variable free_cv_;   ///< 有空闲的缓冲区或者需要停止
+  deque<Chunk *>     ready_chunks_;
+  deque<Chunk *>     free_chunks_;
+  int                running_workers_ = 0;
+  bool               stopped_         = false;
+  RC                 error_rc_        = RC::SUCCESS;  ///< 工作线程遇到的第一个错误
+
+  Chunk *current_chunk_ = nullptr;  ///< 最近一次返回给调用方的结果，下次调用 next 时归还
+
+  std::shared_ptr<PageMorselQueue> morsels_;
+};
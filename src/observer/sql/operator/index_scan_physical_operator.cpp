@@ -71,6 +71,11 @@ RC IndexScanPhysicalOperator::next()
   bool filter_result = false;
   while (RC::SUCCESS == (rc = index_scanner_->next_entry(&rid))) {
     rc = record_handler_->get_record(rid, current_record_);
+    if (rc == RC::RECORD_NOT_EXIST) {
+      // 读到索引项以后，记录可能刚好被 MvccVacuum 回收了，这样的记录对当前事务本来就不可见
+      LOG_TRACE("record has been vacuumed. rid=%s", rid.to_string().c_str());
+      continue;
+    }
     if (OB_FAIL(rc)) {
       LOG_TRACE("failed to get record. rid=%s, rc=%s", rid.to_string().c_str(), strrc(rc));
       return rc;
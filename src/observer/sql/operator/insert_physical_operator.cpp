@@ -114,9 +114,28 @@ RC InsertPhysicalOperator::open(Trx *trx)
     }
   }
 
+  // 插入的文本和向量可能还在缓冲区中
+  if (OB_SUCC(rc)) {
+    rc = flush_texts_and_vectors();
+  }
   return rc;
 }
 
+RC InsertPhysicalOperator::flush_texts_and_vectors()
+{
+  if (!table_->is_view()) {
+    return table_->flush_texts_and_vectors();
+  }
+
+  for (Table *base_table : static_cast<View *>(table_)->base_tables()) {
+    RC rc = base_table->flush_texts_and_vectors();
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
 RC InsertPhysicalOperator::next() { return RC::RECORD_EOF; }
 
 RC InsertPhysicalOperator::close() { return RC::SUCCESS; }
@@ -41,6 +41,10 @@ public:
 
   void set_attrs_name(const std::vector<std::string> &attrs_name) { attrs_name_ = attrs_name; }
 
+private:
+  /// 把插入时写入的文本和向量刷到文件中，插入视图时处理所有的基表
+  RC flush_texts_and_vectors();
+
 private:
   Table             *table_ = nullptr;
   std::vector<Value> values_;
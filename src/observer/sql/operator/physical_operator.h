@@ -48,6 +48,7 @@ enum class PhysicalOperatorType
   PROJECT_VEC,
   CALC,
   STRING_LIST,
+  VALUE_LIST,
   DELETE,
   INSERT,
   SCALAR_GROUP_BY,
@@ -55,6 +56,7 @@ enum class PhysicalOperatorType
   GROUP_BY_VEC,
   AGGREGATE_VEC,
   EXPR_VEC,
+  EXCHANGE_VEC,
   UPDATE,
   ORDER_BY,
   VECTOR_INDEX_SCAN,
@@ -104,6 +104,8 @@ RC TableScanPhysicalOperator::next()
 }
 
 RC TableScanPhysicalOperator::close() { 
+  // current_record_ 可能还指向页帧，关闭时释放
+  current_record_ = Record();
   return record_scanner_.close_scan(); 
 }
 
@@ -14,6 +14,52 @@ See the Mulan PSL v2 for more details. */
 
 using namespace std;
 
+/**
+ * @brief 从过滤条件中找出 字段 op 常量 形式的比较，用来根据 zone map 跳过页面
+ * @details 只处理最外层的条件以及 AND 连接的条件，其它条件不影响结果
+ */
+static void collect_zone_map_predicates(Expression &expr, vector<ZoneMapPredicate> &predicates)
+{
+  if (expr.type() == ExprType::CONJUNCTION) {
+    auto &conjunction_expr = static_cast<ConjunctionExpr &>(expr);
+    if (conjunction_expr.conjunction_type() == ConjunctionExpr::Type::AND) {
+      for (unique_ptr<Expression> &child : conjunction_expr.children()) {
+        collect_zone_map_predicates(*child, predicates);
+      }
+    }
+    return;
+  }
+
+  if (expr.type() != ExprType::COMPARISON) {
+    return;
+  }
+
+  auto  &comparison_expr = static_cast<ComparisonExpr &>(expr);
+  CompOp comp            = comparison_expr.comp();
+  Expression *left       = comparison_expr.left().get();
+  Expression *right      = comparison_expr.right().get();
+  if (left->type() == ExprType::VALUE && right->type() == ExprType::FIELD) {
+    // 常量在左边时交换一下，比较运算符也要反过来
+    swap(left, right);
+    switch (comp) {
+      case CompOp::LESS_THAN: comp = CompOp::GREAT_THAN; break;
+      case CompOp::LESS_EQUAL: comp = CompOp::GREAT_EQUAL; break;
+      case CompOp::GREAT_THAN: comp = CompOp::LESS_THAN; break;
+      case CompOp::GREAT_EQUAL: comp = CompOp::LESS_EQUAL; break;
+      default: break;
+    }
+  }
+  if (left->type() != ExprType::FIELD || right->type() != ExprType::VALUE) {
+    return;
+  }
+
+  ZoneMapPredicate predicate;
+  predicate.col_id = static_cast<FieldExpr *>(left)->field().meta()->field_id();
+  predicate.op     = comp;
+  predicate.value  = static_cast<ValueExpr *>(right)->get_value();
+  predicates.push_back(std::move(predicate));
+}
+
 RC TableScanVecPhysicalOperator::open(Trx *trx)
 {
   RC rc = table_->get_chunk_scanner(chunk_scanner_, trx, mode_);
@@ -21,12 +67,31 @@ RC TableScanVecPhysicalOperator::open(Trx *trx)
     LOG_WARN("failed to get chunk scanner", strrc(rc));
     return rc;
   }
+
+  if (morsels_ != nullptr) {
+    chunk_scanner_.set_morsel_queue(morsels_.get());
+  }
+
+  vector<unique_ptr<Expression>> &all_predicates =
+      predicate_owner_ != nullptr ? predicate_owner_->predicates_ : predicates_;
+
+  vector<ZoneMapPredicate> zone_map_predicates;
+  for (unique_ptr<Expression> &expr : all_predicates) {
+    collect_zone_map_predicates(*expr, zone_map_predicates);
+  }
+  chunk_scanner_.set_zone_map_predicates(std::move(zone_map_predicates));
+
+  // 可见性判断和过滤都在 chunk scanner 中完成
+  vector<Expression *> predicates;
+  for (unique_ptr<Expression> &expr : all_predicates) {
+    predicates.push_back(expr.get());
+  }
+  chunk_scanner_.set_predicates(std::move(predicates));
+
   // TODO: don't need to fetch all columns from record manager
+  // 事务字段的 field_id 不是它在表中的位置，所以按照位置编号
   for (int i = 0; i < table_->table_meta().field_num(); ++i) {
-    all_columns_.add_column(
-        make_unique<Column>(*table_->table_meta().field(i)), table_->table_meta().field(i)->field_id());
-    filterd_columns_.add_column(
-        make_unique<Column>(*table_->table_meta().field(i)), table_->table_meta().field(i)->field_id());
+    all_columns_.add_column(make_unique<Column>(*table_->table_meta().field(i)), i);
   }
   return rc;
 }
@@ -36,29 +101,8 @@ RC TableScanVecPhysicalOperator::next(Chunk &chunk)
   RC rc = RC::SUCCESS;
 
   all_columns_.reset_data();
-  filterd_columns_.reset_data();
   if (OB_SUCC(rc = chunk_scanner_.next_chunk(all_columns_))) {
-    select_.assign(all_columns_.rows(), 1);
-    if (predicates_.empty()) {
-      chunk.reference(all_columns_);
-    } else {
-      rc = filter(all_columns_);
-      if (rc != RC::SUCCESS) {
-        LOG_TRACE("filtered failed=%s", strrc(rc));
-        return rc;
-      }
-      // TODO: if all setted, it doesn't need to set one by one
-      for (int i = 0; i < all_columns_.rows(); i++) {
-        if (select_[i] == 0) {
-          continue;
-        }
-        for (int j = 0; j < all_columns_.column_num(); j++) {
-          filterd_columns_.column(j).append_one(
-              (char *)all_columns_.column(filterd_columns_.column_ids(j)).get_value(i).data());
-        }
-      }
-      chunk.reference(filterd_columns_);
-    }
+    chunk.reference(all_columns_);
   }
   return rc;
 }
@@ -71,15 +115,3 @@ void TableScanVecPhysicalOperator::set_predicates(vector<unique_ptr<Expression>>
 {
   predicates_ = std::move(exprs);
 }
-
-RC TableScanVecPhysicalOperator::filter(Chunk &chunk)
-{
-  RC rc = RC::SUCCESS;
-  for (unique_ptr<Expression> &expr : predicates_) {
-    rc = expr->eval(chunk, select_);
-    if (rc != RC::SUCCESS) {
-      return rc;
-    }
-  }
-  return rc;
-}
@@ -38,15 +38,24 @@ public:
 
   void set_predicates(std::vector<std::unique_ptr<Expression>> &&exprs);
 
-private:
-  RC filter(Chunk &chunk);
+  /**
+   * @brief 使用另一个算子的过滤条件
+   * @details 并行扫描时多个算子共用一份条件。条件在扫描时只会读取，可以在多个线程中同时使用。
+   * owner 需要比当前算子存在的时间长
+   */
+  void share_predicates(TableScanVecPhysicalOperator &owner) { predicate_owner_ = &owner; }
+
+  /**
+   * @brief 只扫描从 morsels 中取到的页面，多个算子共用一个 PageMorselQueue 时可以并行扫描
+   */
+  void set_morsel_queue(std::shared_ptr<PageMorselQueue> morsels) { morsels_ = std::move(morsels); }
 
 private:
   Table                                   *table_ = nullptr;
   ReadWriteMode                            mode_  = ReadWriteMode::READ_WRITE;
   ChunkFileScanner                         chunk_scanner_;
   Chunk                                    all_columns_;
-  Chunk                                    filterd_columns_;
-  std::vector<uint8_t>                     select_;
   std::vector<std::unique_ptr<Expression>> predicates_;
+  TableScanVecPhysicalOperator            *predicate_owner_ = nullptr;  ///< 不为空时使用它的过滤条件
+  std::shared_ptr<PageMorselQueue>         morsels_;
 };
@@ -59,8 +59,11 @@ RC UpdatePhysicalOperator::open(Trx *trx)
           return RC::INTERNAL;
         }
         update_table = base_table_map[tuple_table_name];
+        // 原地更新以后旧的文本和向量不再被引用了，记录写回页面以后再释放
+        std::vector<TextData>   old_texts;
+        std::vector<VectorData> old_vectors;
         // 正式开始更新
-        rc = update_table->visit_record(update_rid, [this, tuple](Record &record) {
+        rc = update_table->visit_record(update_rid, [this, tuple, &old_texts, &old_vectors](Record &record) {
           Record             old_record(record);
           std::vector<Value> cells_to_update;  // 先存，防止有一个 field 更新异常导致部分写入。
           // for (size_t i = 0; i < exprs_.size(); i++) {
@@ -110,6 +113,19 @@ RC UpdatePhysicalOperator::open(Trx *trx)
             cells_to_update.push_back(cell);
           }
 
+          for (size_t field_metas_idx : update_field_idx) {
+            const FieldMeta *base_field = update_table->table_meta().field(field_metas_[field_metas_idx].name());
+            if (base_field != nullptr && base_field->type() == AttrType::TEXTS) {
+              TextData text_data{};
+              memcpy(&text_data, record.data() + base_field->offset(), base_field->len());
+              old_texts.push_back(text_data);
+            } else if (base_field != nullptr && base_field->type() == AttrType::VECTORS) {
+              VectorData vector_data{};
+              memcpy(&vector_data, record.data() + base_field->offset(), base_field->len());
+              old_vectors.push_back(vector_data);
+            }
+          }
+
           for (size_t i = 0; i < cells_to_update.size(); ++i) {
             size_t field_metas_idx = update_field_idx[i];
             tuple->set_cell_at(field_metas_[field_metas_idx].field_id(), cells_to_update[i], record.data());
@@ -123,11 +139,22 @@ RC UpdatePhysicalOperator::open(Trx *trx)
           }
           return RC::SUCCESS;
         });
+        if (OB_SUCC(rc)) {
+          for (const TextData &text_data : old_texts) {
+            update_table->free_text(text_data);
+          }
+          for (const VectorData &vector_data : old_vectors) {
+            update_table->free_vector(vector_data);
+          }
+        }
       }
 
     } else {
       // 非视图更新情况
-      rc = table_->visit_record(tuple->record().rid(), [this, tuple](Record &record) {
+      // 原地更新以后旧的文本和向量不再被引用了，记录写回页面以后再释放
+      std::vector<TextData>   old_texts;
+      std::vector<VectorData> old_vectors;
+      rc = table_->visit_record(tuple->record().rid(), [this, tuple, &old_texts, &old_vectors](Record &record) {
         Record             old_record(record);
         std::vector<Value> cells_to_update;  // 先存，防止有一个 field 更新异常导致部分写入。
         for (size_t i = 0; i < exprs_.size(); i++) {
@@ -175,6 +202,18 @@ RC UpdatePhysicalOperator::open(Trx *trx)
           cells_to_update.push_back(cell);
         }
 
+        for (size_t i = 0; i < cells_to_update.size(); ++i) {
+          if (field_metas_[i].type() == AttrType::TEXTS) {
+            TextData text_data{};
+            memcpy(&text_data, record.data() + field_metas_[i].offset(), field_metas_[i].len());
+            old_texts.push_back(text_data);
+          } else if (field_metas_[i].type() == AttrType::VECTORS) {
+            VectorData vector_data{};
+            memcpy(&vector_data, record.data() + field_metas_[i].offset(), field_metas_[i].len());
+            old_vectors.push_back(vector_data);
+          }
+        }
+
         for (size_t i = 0; i < cells_to_update.size(); ++i) {
           tuple->set_cell_at(field_metas_[i].field_id(), cells_to_update[i], record.data());
         }
@@ -187,6 +226,14 @@ RC UpdatePhysicalOperator::open(Trx *trx)
         }
         return RC::SUCCESS;
       });
+      if (OB_SUCC(rc)) {
+        for (const TextData &text_data : old_texts) {
+          table_->free_text(text_data);
+        }
+        for (const VectorData &vector_data : old_vectors) {
+          table_->free_vector(vector_data);
+        }
+      }
     }
 
     if (rc != RC::SUCCESS) {
@@ -198,6 +245,17 @@ RC UpdatePhysicalOperator::open(Trx *trx)
     rc = RC::SUCCESS;
   }
 
+  // 更新时写入的文本和向量可能还在缓冲区中
+  for (auto &[base_table_name, base_table] : base_table_map) {
+    RC flush_rc = base_table->flush_texts_and_vectors();
+    if (OB_SUCC(rc)) {
+      rc = flush_rc;
+    }
+  }
+  if (OB_SUCC(rc)) {
+    rc = table_->flush_texts_and_vectors();
+  }
+
   child->close();
   if (OB_FAIL(rc)) {
     LOG_WARN("update index failed: %s", strrc(rc));
@@ -0,0 +1,67 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "sql/operator/physical_operator.h"
+#include <vector>
+
+/**
+ * @brief 值列表物理算子
+ * @ingroup PhysicalOperator
+ * @details 与 StringListPhysicalOperator 类似，但是每个值保留自己的类型，给虚拟表这种不存储数据的表使用
+ */
+class ValueListPhysicalOperator : public PhysicalOperator
+{
+public:
+  ValueListPhysicalOperator() {}
+
+  virtual ~ValueListPhysicalOperator() = default;
+
+  void append(std::vector<Value> values) { rows_.emplace_back(std::move(values)); }
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::VALUE_LIST; }
+
+  RC open(Trx *) override { return RC::SUCCESS; }
+
+  RC next() override
+  {
+    if (!started_) {
+      started_  = true;
+      iterator_ = rows_.begin();
+    } else if (iterator_ != rows_.end()) {
+      ++iterator_;
+    }
+    return iterator_ == rows_.end() ? RC::RECORD_EOF : RC::SUCCESS;
+  }
+
+  virtual RC close() override
+  {
+    iterator_ = rows_.end();
+    return RC::SUCCESS;
+  }
+
+  virtual Tuple *current_tuple() override
+  {
+    if (iterator_ == rows_.end()) {
+      return nullptr;
+    }
+
+    tuple_.set_cells(*iterator_);
+    return &tuple_;
+  }
+
+private:
+  using ValueList = std::vector<Value>;
+  std::vector<ValueList>           rows_;
+  std::vector<ValueList>::iterator iterator_;
+  bool                             started_ = false;
+  ValueListTuple                   tuple_;
+};
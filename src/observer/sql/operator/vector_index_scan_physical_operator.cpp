@@ -29,16 +29,20 @@ RC VectorIndexScanPhysicalOperator::open(Trx *trx)
 
 RC VectorIndexScanPhysicalOperator::next()
 {
-  if (result_iterator_ == result.end()) {
-    return RC::RECORD_EOF;
-  }
   if (record_handler_ == nullptr) {
     LOG_WARN("internal error");
     return RC::INTERNAL;
   }
-  record_handler_->get_record(*result_iterator_, current_record_);
-  ++result_iterator_;
-  return RC::SUCCESS;
+  while (result_iterator_ != result.end()) {
+    RC rc = record_handler_->get_record(*result_iterator_, current_record_);
+    ++result_iterator_;
+    // 向量索引不会删除索引项，记录可能已经被 MvccVacuum 回收了
+    if (rc == RC::RECORD_NOT_EXIST) {
+      continue;
+    }
+    return rc;
+  }
+  return RC::RECORD_EOF;
 }
 
 RC VectorIndexScanPhysicalOperator::close()
@@ -15,6 +15,7 @@ See the Mulan PSL v2 for more details. */
 #include <utility>
 
 #include "common/log/log.h"
+#include "session/session.h"
 #include "sql/expr/expression.h"
 #include "sql/operator/aggregate_vec_physical_operator.h"
 #include "sql/operator/calc_logical_operator.h"
@@ -22,6 +23,7 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/delete_logical_operator.h"
 #include "sql/operator/delete_physical_operator.h"
 #include "sql/operator/explain_logical_operator.h"
+#include "sql/operator/exchange_vec_physical_operator.h"
 #include "sql/operator/explain_physical_operator.h"
 #include "sql/operator/expr_vec_physical_operator.h"
 #include "sql/operator/group_by_vec_physical_operator.h"
@@ -524,7 +526,33 @@ RC PhysicalPlanGenerator::create_vec_plan(TableGetLogicalOperator &table_get_ope
   TableScanVecPhysicalOperator *table_scan_oper = new TableScanVecPhysicalOperator(table, table_get_oper.read_write_mode());
   table_scan_oper->set_predicates(std::move(predicates));
   oper = unique_ptr<PhysicalOperator>(table_scan_oper);
-  LOG_TRACE("use vectorized table scan");
+
+  // 只读的扫描可以按照页面划分给多个线程，由 exchange 算子汇总结果。
+  // 没有 CONCURRENCY 时缓冲池的锁都是空操作，不能并行扫描
+#ifdef CONCURRENCY
+  Session  *session         = Session::current_session();
+  const int parallel_degree = session == nullptr ? 1 : session->parallel_degree();
+#else
+  const int parallel_degree = 1;
+#endif
+  if (parallel_degree <= 1 || table->is_view() || table_get_oper.read_write_mode() != ReadWriteMode::READ_ONLY) {
+    LOG_TRACE("use vectorized table scan");
+    return RC::SUCCESS;
+  }
+
+  auto morsels       = make_shared<PageMorselQueue>();
+  auto exchange_oper = make_unique<ExchangeVecPhysicalOperator>();
+  table_scan_oper->set_morsel_queue(morsels);
+  exchange_oper->set_morsel_queue(morsels);
+  exchange_oper->add_child(std::move(oper));
+  for (int i = 1; i < parallel_degree; i++) {
+    auto worker_oper = make_unique<TableScanVecPhysicalOperator>(table, ReadWriteMode::READ_ONLY);
+    worker_oper->share_predicates(*table_scan_oper);
+    worker_oper->set_morsel_queue(morsels);
+    exchange_oper->add_child(std::move(worker_oper));
+  }
+  oper = std::move(exchange_oper);
+  LOG_TRACE("use parallel vectorized table scan. parallel degree=%d", parallel_degree);
 
   return RC::SUCCESS;
 }
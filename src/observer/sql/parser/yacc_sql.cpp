@@ -0,0 +1,3675 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 2
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 2 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+#include "common/log/log.h"
+#include "common/lang/string.h"
+#include "sql/parser/parse_defs.h"
+#include "sql/parser/yacc_sql.hpp"
+#include "sql/parser/lex_sql.h"
+#include "sql/expr/expression.h"
+
+using namespace std;
+
+string token_name(const char *sql_string, YYLTYPE *llocp)
+{
+  return string(sql_string + llocp->first_column, llocp->last_column - llocp->first_column + 1);
+}
+
+int yyerror(YYLTYPE *llocp, const char *sql_string, ParsedSqlResult *sql_result, yyscan_t scanner, const char *msg)
+{
+  std::unique_ptr<ParsedSqlNode> error_sql_node = std::make_unique<ParsedSqlNode>(SCF_ERROR);
+  error_sql_node->error.error_msg = msg;
+  error_sql_node->error.line = llocp->first_line;
+  error_sql_node->error.column = llocp->first_column;
+  sql_result->add_sql_node(std::move(error_sql_node));
+  return 0;
+}
+
+ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
+                                             Expression *left,
+                                             Expression *right,
+                                             const char *sql_string,
+                                             YYLTYPE *llocp)
+{
+  ArithmeticExpr *expr = new ArithmeticExpr(type, left, right);
+  expr->set_name(token_name(sql_string, llocp));
+  return expr;
+}
+
+UnboundAggregateExpr *create_aggregate_expression(AggregateType type,
+                                           Expression *child,
+                                           const char *sql_string,
+                                           YYLTYPE *llocp)
+{
+  UnboundAggregateExpr *expr = new UnboundAggregateExpr(type, child);
+  expr->set_name(token_name(sql_string, llocp));
+  return expr;
+}
+
+
+#line 125 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "yacc_sql.hpp"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_SEMICOLON = 3,                  /* SEMICOLON  */
+  YYSYMBOL_BY = 4,                         /* BY  */
+  YYSYMBOL_CREATE = 5,                     /* CREATE  */
+  YYSYMBOL_DROP = 6,                       /* DROP  */
+  YYSYMBOL_GROUP = 7,                      /* GROUP  */
+  YYSYMBOL_TABLE = 8,                      /* TABLE  */
+  YYSYMBOL_TABLES = 9,                     /* TABLES  */
+  YYSYMBOL_VIEW = 10,                      /* VIEW  */
+  YYSYMBOL_INDEX = 11,                     /* INDEX  */
+  YYSYMBOL_UNIQUE = 12,                    /* UNIQUE  */
+  YYSYMBOL_CALC = 13,                      /* CALC  */
+  YYSYMBOL_SELECT = 14,                    /* SELECT  */
+  YYSYMBOL_DESC = 15,                      /* DESC  */
+  YYSYMBOL_SHOW = 16,                      /* SHOW  */
+  YYSYMBOL_SYNC = 17,                      /* SYNC  */
+  YYSYMBOL_INSERT = 18,                    /* INSERT  */
+  YYSYMBOL_DELETE = 19,                    /* DELETE  */
+  YYSYMBOL_UPDATE = 20,                    /* UPDATE  */
+  YYSYMBOL_LBRACE = 21,                    /* LBRACE  */
+  YYSYMBOL_RBRACE = 22,                    /* RBRACE  */
+  YYSYMBOL_COMMA = 23,                     /* COMMA  */
+  YYSYMBOL_TRX_BEGIN = 24,                 /* TRX_BEGIN  */
+  YYSYMBOL_TRX_COMMIT = 25,                /* TRX_COMMIT  */
+  YYSYMBOL_TRX_ROLLBACK = 26,              /* TRX_ROLLBACK  */
+  YYSYMBOL_INT_T = 27,                     /* INT_T  */
+  YYSYMBOL_STRING_T = 28,                  /* STRING_T  */
+  YYSYMBOL_FLOAT_T = 29,                   /* FLOAT_T  */
+  YYSYMBOL_DATE_T = 30,                    /* DATE_T  */
+  YYSYMBOL_VECTOR_T = 31,                  /* VECTOR_T  */
+  YYSYMBOL_HELP = 32,                      /* HELP  */
+  YYSYMBOL_EXIT = 33,                      /* EXIT  */
+  YYSYMBOL_DOT = 34,                       /* DOT  */
+  YYSYMBOL_INTO = 35,                      /* INTO  */
+  YYSYMBOL_VALUES = 36,                    /* VALUES  */
+  YYSYMBOL_FROM = 37,                      /* FROM  */
+  YYSYMBOL_INNER_JOIN = 38,                /* INNER_JOIN  */
+  YYSYMBOL_WHERE = 39,                     /* WHERE  */
+  YYSYMBOL_HAVING = 40,                    /* HAVING  */
+  YYSYMBOL_AND = 41,                       /* AND  */
+  YYSYMBOL_OR = 42,                        /* OR  */
+  YYSYMBOL_SET = 43,                       /* SET  */
+  YYSYMBOL_ON = 44,                        /* ON  */
+  YYSYMBOL_IN = 45,                        /* IN  */
+  YYSYMBOL_NOT_IN = 46,                    /* NOT_IN  */
+  YYSYMBOL_EXISTS = 47,                    /* EXISTS  */
+  YYSYMBOL_NOT_EXISTS = 48,                /* NOT_EXISTS  */
+  YYSYMBOL_LOAD = 49,                      /* LOAD  */
+  YYSYMBOL_ORDER = 50,                     /* ORDER  */
+  YYSYMBOL_ASC = 51,                       /* ASC  */
+  YYSYMBOL_INFILE = 52,                    /* INFILE  */
+  YYSYMBOL_EXPLAIN = 53,                   /* EXPLAIN  */
+  YYSYMBOL_STORAGE = 54,                   /* STORAGE  */
+  YYSYMBOL_FORMAT = 55,                    /* FORMAT  */
+  YYSYMBOL_COMPRESSION = 56,               /* COMPRESSION  */
+  YYSYMBOL_AS = 57,                        /* AS  */
+  YYSYMBOL_EQ = 58,                        /* EQ  */
+  YYSYMBOL_LT = 59,                        /* LT  */
+  YYSYMBOL_GT = 60,                        /* GT  */
+  YYSYMBOL_LE = 61,                        /* LE  */
+  YYSYMBOL_GE = 62,                        /* GE  */
+  YYSYMBOL_NE = 63,                        /* NE  */
+  YYSYMBOL_NOT = 64,                       /* NOT  */
+  YYSYMBOL_NULL_T = 65,                    /* NULL_T  */
+  YYSYMBOL_LIKE = 66,                      /* LIKE  */
+  YYSYMBOL_L2_DISTANCE = 67,               /* L2_DISTANCE  */
+  YYSYMBOL_COSINE_DISTANCE = 68,           /* COSINE_DISTANCE  */
+  YYSYMBOL_INNER_PRODUCT = 69,             /* INNER_PRODUCT  */
+  YYSYMBOL_IS = 70,                        /* IS  */
+  YYSYMBOL_COUNT = 71,                     /* COUNT  */
+  YYSYMBOL_MAX = 72,                       /* MAX  */
+  YYSYMBOL_MIN = 73,                       /* MIN  */
+  YYSYMBOL_AVG = 74,                       /* AVG  */
+  YYSYMBOL_SUM = 75,                       /* SUM  */
+  YYSYMBOL_TEXT_T = 76,                    /* TEXT_T  */
+  YYSYMBOL_LIMIT = 77,                     /* LIMIT  */
+  YYSYMBOL_WITH = 78,                      /* WITH  */
+  YYSYMBOL_NUMBER = 79,                    /* NUMBER  */
+  YYSYMBOL_FLOAT = 80,                     /* FLOAT  */
+  YYSYMBOL_ID = 81,                        /* ID  */
+  YYSYMBOL_SSS = 82,                       /* SSS  */
+  YYSYMBOL_DATE = 83,                      /* DATE  */
+  YYSYMBOL_VECTOR = 84,                    /* VECTOR  */
+  YYSYMBOL_85_ = 85,                       /* '+'  */
+  YYSYMBOL_86_ = 86,                       /* '-'  */
+  YYSYMBOL_87_ = 87,                       /* '*'  */
+  YYSYMBOL_88_ = 88,                       /* '/'  */
+  YYSYMBOL_UMINUS = 89,                    /* UMINUS  */
+  YYSYMBOL_YYACCEPT = 90,                  /* $accept  */
+  YYSYMBOL_commands = 91,                  /* commands  */
+  YYSYMBOL_command_wrapper = 92,           /* command_wrapper  */
+  YYSYMBOL_exit_stmt = 93,                 /* exit_stmt  */
+  YYSYMBOL_help_stmt = 94,                 /* help_stmt  */
+  YYSYMBOL_sync_stmt = 95,                 /* sync_stmt  */
+  YYSYMBOL_begin_stmt = 96,                /* begin_stmt  */
+  YYSYMBOL_commit_stmt = 97,               /* commit_stmt  */
+  YYSYMBOL_rollback_stmt = 98,             /* rollback_stmt  */
+  YYSYMBOL_drop_table_stmt = 99,           /* drop_table_stmt  */
+  YYSYMBOL_show_tables_stmt = 100,         /* show_tables_stmt  */
+  YYSYMBOL_show_buffer_pool_status_stmt = 101, /* show_buffer_pool_status_stmt  */
+  YYSYMBOL_desc_table_stmt = 102,          /* desc_table_stmt  */
+  YYSYMBOL_create_index_stmt = 103,        /* create_index_stmt  */
+  YYSYMBOL_id_or_number = 104,             /* id_or_number  */
+  YYSYMBOL_create_vector_index_stmt = 105, /* create_vector_index_stmt  */
+  YYSYMBOL_drop_index_stmt = 106,          /* drop_index_stmt  */
+  YYSYMBOL_create_table_stmt = 107,        /* create_table_stmt  */
+  YYSYMBOL_create_view_stmt = 108,         /* create_view_stmt  */
+  YYSYMBOL_attr_def_list = 109,            /* attr_def_list  */
+  YYSYMBOL_attr_def = 110,                 /* attr_def  */
+  YYSYMBOL_id_list = 111,                  /* id_list  */
+  YYSYMBOL_number = 112,                   /* number  */
+  YYSYMBOL_type = 113,                     /* type  */
+  YYSYMBOL_insert_stmt = 114,              /* insert_stmt  */
+  YYSYMBOL_value_list = 115,               /* value_list  */
+  YYSYMBOL_value = 116,                    /* value  */
+  YYSYMBOL_storage_format = 117,           /* storage_format  */
+  YYSYMBOL_compression = 118,              /* compression  */
+  YYSYMBOL_delete_stmt = 119,              /* delete_stmt  */
+  YYSYMBOL_update_list = 120,              /* update_list  */
+  YYSYMBOL_update_stmt = 121,              /* update_stmt  */
+  YYSYMBOL_select_stmt = 122,              /* select_stmt  */
+  YYSYMBOL_calc_stmt = 123,                /* calc_stmt  */
+  YYSYMBOL_expression_list = 124,          /* expression_list  */
+  YYSYMBOL_expression = 125,               /* expression  */
+  YYSYMBOL_rel_attr = 126,                 /* rel_attr  */
+  YYSYMBOL_relation = 127,                 /* relation  */
+  YYSYMBOL_rel_list = 128,                 /* rel_list  */
+  YYSYMBOL_join_list = 129,                /* join_list  */
+  YYSYMBOL_where = 130,                    /* where  */
+  YYSYMBOL_condition_list = 131,           /* condition_list  */
+  YYSYMBOL_condition = 132,                /* condition  */
+  YYSYMBOL_comp_op = 133,                  /* comp_op  */
+  YYSYMBOL_group_by = 134,                 /* group_by  */
+  YYSYMBOL_having = 135,                   /* having  */
+  YYSYMBOL_order_by = 136,                 /* order_by  */
+  YYSYMBOL_order_by_list = 137,            /* order_by_list  */
+  YYSYMBOL_order_by_item = 138,            /* order_by_item  */
+  YYSYMBOL_limit = 139,                    /* limit  */
+  YYSYMBOL_explain_stmt = 140,             /* explain_stmt  */
+  YYSYMBOL_set_variable_stmt = 141,        /* set_variable_stmt  */
+  YYSYMBOL_opt_semicolon = 142             /* opt_semicolon  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if 1
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* 1 */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL \
+             && defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+  YYLTYPE yyls_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
+      + 2 * YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  80
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   423
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  90
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  53
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  164
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  341
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   340
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,    87,    85,     2,    86,     2,    88,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
+      55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
+      65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
+      75,    76,    77,    78,    79,    80,    81,    82,    83,    84,
+      89
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,   242,   242,   250,   251,   252,   253,   254,   255,   256,
+     257,   258,   259,   260,   261,   262,   263,   264,   265,   266,
+     267,   269,   270,   271,   272,   276,   282,   287,   293,   299,
+     305,   311,   318,   325,   341,   349,   365,   383,   389,   394,
+     401,   408,   419,   445,   455,   481,   490,   508,   530,   540,
+     562,   565,   578,   587,   596,   605,   614,   623,   635,   641,
+     654,   657,   658,   659,   660,   661,   662,   665,   678,   703,
+     706,   717,   722,   727,   732,   737,   744,   754,   766,   774,
+     777,   784,   787,   794,   806,   812,   820,   834,   897,   906,
+     911,   917,   923,   934,   945,   956,   960,   964,   968,   972,
+     976,   979,   982,   985,   988,   992,   996,   999,  1004,  1010,
+    1016,  1019,  1023,  1027,  1034,  1039,  1046,  1055,  1060,  1067,
+    1077,  1086,  1100,  1103,  1124,  1127,  1133,  1136,  1142,  1148,
+    1156,  1164,  1172,  1182,  1183,  1184,  1185,  1186,  1187,  1188,
+    1189,  1190,  1191,  1192,  1193,  1194,  1195,  1200,  1203,  1213,
+    1216,  1223,  1226,  1235,  1241,  1250,  1256,  1262,  1272,  1275,
+    1297,  1305,  1313,  1323,  1324
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "SEMICOLON", "BY",
+  "CREATE", "DROP", "GROUP", "TABLE", "TABLES", "VIEW", "INDEX", "UNIQUE",
+  "CALC", "SELECT", "DESC", "SHOW", "SYNC", "INSERT", "DELETE", "UPDATE",
+  "LBRACE", "RBRACE", "COMMA", "TRX_BEGIN", "TRX_COMMIT", "TRX_ROLLBACK",
+  "INT_T", "STRING_T", "FLOAT_T", "DATE_T", "VECTOR_T", "HELP", "EXIT",
+  "DOT", "INTO", "VALUES", "FROM", "INNER_JOIN", "WHERE", "HAVING", "AND",
+  "OR", "SET", "ON", "IN", "NOT_IN", "EXISTS", "NOT_EXISTS", "LOAD",
+  "ORDER", "ASC", "INFILE", "EXPLAIN", "STORAGE", "FORMAT", "COMPRESSION",
+  "AS", "EQ", "LT", "GT", "LE", "GE", "NE", "NOT", "NULL_T", "LIKE",
+  "L2_DISTANCE", "COSINE_DISTANCE", "INNER_PRODUCT", "IS", "COUNT", "MAX",
+  "MIN", "AVG", "SUM", "TEXT_T", "LIMIT", "WITH", "NUMBER", "FLOAT", "ID",
+  "SSS", "DATE", "VECTOR", "'+'", "'-'", "'*'", "'/'", "UMINUS", "$accept",
+  "commands", "command_wrapper", "exit_stmt", "help_stmt", "sync_stmt",
+  "begin_stmt", "commit_stmt", "rollback_stmt", "drop_table_stmt",
+  "show_tables_stmt", "show_buffer_pool_status_stmt", "desc_table_stmt",
+  "create_index_stmt", "id_or_number", "create_vector_index_stmt",
+  "drop_index_stmt", "create_table_stmt", "create_view_stmt",
+  "attr_def_list", "attr_def", "id_list", "number", "type", "insert_stmt",
+  "value_list", "value", "storage_format", "compression", "delete_stmt",
+  "update_list", "update_stmt", "select_stmt", "calc_stmt",
+  "expression_list", "expression", "rel_attr", "relation", "rel_list",
+  "join_list", "where", "condition_list", "condition", "comp_op",
+  "group_by", "having", "order_by", "order_by_list", "order_by_item",
+  "limit", "explain_stmt", "set_variable_stmt", "opt_semicolon", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-225)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-70)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+     308,    13,    28,   177,   177,   -61,    -3,  -225,     3,    30,
+     -41,  -225,  -225,  -225,  -225,  -225,   -27,   308,    65,    71,
+    -225,  -225,  -225,  -225,  -225,  -225,  -225,  -225,  -225,  -225,
+    -225,  -225,  -225,  -225,  -225,  -225,  -225,  -225,  -225,  -225,
+    -225,  -225,    -5,     9,    16,    89,   102,    34,    63,    12,
+    -225,   108,   126,   130,   143,   151,   154,   165,   166,  -225,
+    -225,   129,  -225,  -225,  -225,   205,  -225,  -225,  -225,   212,
+    -225,   163,  -225,  -225,   107,   121,   144,   188,   -23,  -225,
+    -225,  -225,  -225,   -16,   -14,   189,   153,   155,  -225,   194,
+       7,   218,    31,   177,   177,   177,   177,   177,   177,   177,
+     177,   -59,  -225,  -225,  -225,   177,   160,   230,   177,   177,
+     177,   177,   173,   181,    -2,   226,   185,   264,  -225,   186,
+     254,   200,   254,   201,   239,   246,   213,   264,   273,  -225,
+    -225,   142,   216,   220,    35,    92,   109,   118,   123,  -225,
+    -225,  -225,   292,   177,     1,     1,  -225,  -225,   -39,   293,
+     258,  -225,   200,   296,    87,  -225,   260,   226,    48,  -225,
+     -17,   297,  -225,   312,   309,  -225,   298,   249,   255,  -225,
+     314,  -225,   177,   177,   177,  -225,  -225,  -225,  -225,  -225,
+     177,  -225,   257,  -225,   173,   173,   226,   317,   264,   177,
+     177,   307,  -225,    91,   177,  -225,  -225,  -225,  -225,  -225,
+    -225,  -225,  -225,  -225,     6,   186,   320,   200,   288,   200,
+     328,   335,  -225,   127,   131,   135,  -225,  -225,  -225,   313,
+     351,   323,   314,    96,    96,  -225,  -225,  -225,  -225,  -225,
+    -225,  -225,  -225,  -225,  -225,   294,  -225,   299,   177,    87,
+      87,   224,   283,   310,  -225,   297,    55,  -225,   254,   342,
+     200,   291,  -225,  -225,  -225,    87,   370,   336,   357,   358,
+    -225,  -225,    96,  -225,  -225,   185,  -225,   359,  -225,  -225,
+     324,   254,   326,  -225,  -225,  -225,   361,   362,   258,   177,
+      87,   337,   264,  -225,  -225,    46,   327,  -225,   330,  -225,
+    -225,   311,  -225,  -225,  -225,   382,   319,   314,   325,  -225,
+     316,   318,   377,   177,   321,  -225,   369,  -225,  -225,  -225,
+     322,    17,  -225,   378,  -225,  -225,   344,  -225,  -225,   177,
+      69,  -225,  -225,  -225,  -225,  -225,  -225,   381,   329,   347,
+      69,   383,   331,   349,    69,   385,   332,   353,    69,   387,
+    -225
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_uint8 yydefact[] =
+{
+       0,     0,     0,     0,     0,     0,     0,    27,     0,     0,
+       0,    28,    29,    30,    26,    25,     0,     0,     0,   163,
+      24,    23,    17,    18,    19,    20,     9,    10,    11,    12,
+      14,    15,    16,     8,    13,     5,     7,     6,     4,     3,
+      21,    22,     0,     0,     0,     0,     0,     0,     0,     0,
+      78,     0,     0,     0,     0,     0,     0,     0,     0,    71,
+      73,   114,    75,    76,    77,     0,   110,   107,    88,    89,
+     109,     0,    34,    32,     0,     0,     0,     0,     0,   160,
+       1,   164,     2,     0,     0,     0,     0,     0,    31,     0,
+     107,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,    71,    73,   106,     0,     0,    90,     0,     0,
+       0,     0,     0,     0,     0,   124,     0,     0,   162,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,   104,
+     105,     0,     0,     0,     0,     0,     0,     0,     0,   115,
+     116,    94,    91,     0,   100,   101,   102,   103,   117,   120,
+     122,    33,     0,     0,   126,    83,     0,   124,     0,   161,
+       0,    50,    45,    58,     0,    48,     0,     0,     0,    43,
+      69,   108,     0,     0,     0,    95,    96,    97,    98,    99,
+       0,    92,     0,   119,     0,     0,   124,     0,     0,     0,
+       0,     0,   125,   127,     0,    86,    72,    74,    61,    62,
+      63,    64,    65,    66,    57,     0,     0,     0,     0,     0,
+       0,     0,    70,     0,     0,     0,    93,   118,   121,     0,
+     147,     0,    69,   131,   132,   143,   144,   145,   146,   133,
+     134,   135,   136,   137,   138,     0,   139,   141,     0,   126,
+     126,    85,     0,     0,    56,    50,    79,    59,     0,     0,
+       0,     0,   111,   112,   113,   126,     0,   149,     0,     0,
+     140,   142,   130,   128,   129,     0,    60,     0,    55,    51,
+       0,     0,    81,    47,    49,    35,     0,     0,   122,     0,
+     126,   151,     0,    67,    84,    54,     0,    46,     0,    44,
+      36,     0,   123,   148,   150,     0,   158,    69,     0,    53,
+       0,     0,     0,     0,     0,    87,     0,    52,    80,    82,
+       0,   155,   152,   153,   159,    68,     0,   157,   156,     0,
+       0,   154,    39,    41,    40,    38,    37,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+      42
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+    -225,  -225,   397,  -225,  -225,  -225,  -225,  -225,  -225,  -225,
+    -225,  -225,  -225,  -225,  -145,  -225,  -225,  -225,  -225,   170,
+     211,  -143,  -225,  -225,  -225,  -167,   -45,  -225,  -225,  -225,
+     152,  -225,   -47,  -225,    -4,   -48,  -225,   233,   235,   145,
+    -149,  -224,  -225,  -225,  -225,  -225,  -225,   101,  -225,  -225,
+    -225,  -225,  -225
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int16 yydefgoto[] =
+{
+       0,    18,    19,    20,    21,    22,    23,    24,    25,    26,
+      27,    28,    29,    30,   327,    31,    32,    33,    34,   206,
+     161,   164,   267,   204,    35,   128,    67,   272,   289,    36,
+     157,    37,    38,    39,    68,    69,    70,   149,   150,   186,
+     155,   192,   193,   238,   257,   281,   296,   312,   313,   305,
+      40,    41,    82
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
+{
+      71,    92,    91,   212,    90,   119,    73,   121,   195,   187,
+     198,   199,   200,   201,   202,   263,   264,   104,   182,   152,
+      72,    42,   139,    43,    44,    45,     4,   242,   140,   -69,
+     127,   278,   317,    49,   153,   117,    47,   220,    75,    48,
+      77,   120,   183,   122,    46,   131,   132,   133,   134,   135,
+     136,   137,   138,   130,    78,   259,   294,   175,   118,   203,
+     144,   145,   146,   147,   247,    80,   249,    76,   318,     4,
+     243,   244,   159,   162,    81,   165,    83,    50,    74,    51,
+      52,    53,   170,    54,    55,    56,    57,    58,   110,   111,
+      84,    59,    60,    61,    62,    63,    64,    85,    65,    66,
+      86,   141,   108,   109,   110,   111,   191,   276,    49,   270,
+     298,   299,   271,    87,   176,    88,   108,   109,   110,   111,
+     108,   109,   110,   111,   213,   214,   215,   196,   197,    93,
+     306,   177,   239,   240,   189,   190,   322,   323,   324,   181,
+     178,   223,   224,   222,    89,   179,   241,    94,   325,   252,
+     326,    95,    50,   253,    51,    52,    53,   254,    54,    55,
+      56,    57,    58,   101,    96,   172,    59,    60,    61,    62,
+      63,    64,    97,    65,    66,    98,   216,   108,   109,   110,
+     111,   108,   109,   110,   111,   331,    99,   100,   113,   335,
+     262,   191,   191,   339,   108,   109,   110,   111,    49,   273,
+     112,   274,   114,   108,   109,   110,   111,   191,   108,   109,
+     110,   111,   108,   109,   110,   111,   108,   109,   110,   111,
+     108,   109,   110,   111,   287,   115,    49,   108,   109,   110,
+     111,   116,   191,   123,   124,   105,   125,   297,   126,   173,
+     129,   142,    50,   174,    51,    52,    53,   265,    54,    55,
+      56,    57,    58,   143,   148,   311,    59,    60,    61,    62,
+      63,    64,   151,    65,    66,   154,   156,   160,     4,   106,
+      50,   311,    51,    52,    53,   293,    54,    55,    56,    57,
+      58,   163,   166,   167,   102,   103,    61,    62,    63,    64,
+     168,    65,    66,   107,   169,   171,   185,   108,   109,   110,
+     111,   108,   109,   110,   111,   108,   109,   110,   111,   108,
+     109,   110,   111,     1,     2,   180,   184,   188,   194,   209,
+     205,     3,     4,     5,     6,     7,     8,     9,    10,    50,
+     210,   208,    11,    12,    13,   207,   211,   127,   217,   221,
+      14,    15,   246,    59,    60,   248,    62,    63,    64,   250,
+     158,    16,   225,   226,   227,   228,   251,   255,   256,   258,
+     260,    17,   266,   261,   275,   229,   230,   231,   232,   233,
+     234,   235,   277,   236,   279,   268,   280,   237,   282,   286,
+     283,   285,   288,   290,   291,   300,   303,   295,   301,   302,
+     307,   315,   108,   109,   110,   111,   304,   308,   310,   309,
+     314,   319,   320,   316,   328,   330,   332,   334,   336,   340,
+     329,   338,   333,   337,    79,   269,   245,   284,   219,   218,
+     321,     0,     0,   292
+};
+
+static const yytype_int16 yycheck[] =
+{
+       4,    49,    49,   170,    49,    21,     9,    21,   157,   152,
+      27,    28,    29,    30,    31,   239,   240,    65,    57,    21,
+      81,     8,    81,    10,    11,    12,    14,    21,    87,    22,
+      23,   255,    15,    21,    36,    58,     8,   186,    35,    11,
+      81,    57,    81,    57,    31,    93,    94,    95,    96,    97,
+      98,    99,   100,    22,    81,   222,   280,    22,    81,    76,
+     108,   109,   110,   111,   207,     0,   209,    37,    51,    14,
+      64,    65,   117,   120,     3,   122,    81,    65,    81,    67,
+      68,    69,   127,    71,    72,    73,    74,    75,    87,    88,
+      81,    79,    80,    81,    82,    83,    84,    81,    86,    87,
+      11,   105,    85,    86,    87,    88,   154,   250,    21,    54,
+      64,    65,    57,    11,    22,    81,    85,    86,    87,    88,
+      85,    86,    87,    88,   172,   173,   174,    79,    80,    21,
+     297,    22,    41,    42,    47,    48,    67,    68,    69,   143,
+      22,   189,   190,   188,    81,    22,   194,    21,    79,    22,
+      81,    21,    65,    22,    67,    68,    69,    22,    71,    72,
+      73,    74,    75,    34,    21,    23,    79,    80,    81,    82,
+      83,    84,    21,    86,    87,    21,   180,    85,    86,    87,
+      88,    85,    86,    87,    88,   330,    21,    21,    81,   334,
+     238,   239,   240,   338,    85,    86,    87,    88,    21,   246,
+      37,   248,    81,    85,    86,    87,    88,   255,    85,    86,
+      87,    88,    85,    86,    87,    88,    85,    86,    87,    88,
+      85,    86,    87,    88,   271,    81,    21,    85,    86,    87,
+      88,    43,   280,    44,    81,    23,    81,   282,    44,    23,
+      22,    81,    65,    23,    67,    68,    69,    23,    71,    72,
+      73,    74,    75,    23,    81,   303,    79,    80,    81,    82,
+      83,    84,    81,    86,    87,    39,    81,    81,    14,    57,
+      65,   319,    67,    68,    69,   279,    71,    72,    73,    74,
+      75,    81,    81,    44,    79,    80,    81,    82,    83,    84,
+      44,    86,    87,    81,    81,    22,    38,    85,    86,    87,
+      88,    85,    86,    87,    88,    85,    86,    87,    88,    85,
+      86,    87,    88,     5,     6,    23,    23,    21,    58,    21,
+      23,    13,    14,    15,    16,    17,    18,    19,    20,    65,
+      81,    22,    24,    25,    26,    23,    81,    23,    81,    22,
+      32,    33,    22,    79,    80,    57,    82,    83,    84,    21,
+      86,    43,    45,    46,    47,    48,    21,    44,     7,    36,
+      66,    53,    79,    64,    22,    58,    59,    60,    61,    62,
+      63,    64,    81,    66,     4,    65,    40,    70,    21,    55,
+      22,    22,    56,    22,    22,    58,     4,    50,    58,    78,
+      65,    22,    85,    86,    87,    88,    77,    81,    21,    81,
+      79,    23,    58,    81,    23,    58,    23,    58,    23,    22,
+      81,    58,    81,    81,    17,   245,   205,   265,   185,   184,
+     319,    -1,    -1,   278
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_uint8 yystos[] =
+{
+       0,     5,     6,    13,    14,    15,    16,    17,    18,    19,
+      20,    24,    25,    26,    32,    33,    43,    53,    91,    92,
+      93,    94,    95,    96,    97,    98,    99,   100,   101,   102,
+     103,   105,   106,   107,   108,   114,   119,   121,   122,   123,
+     140,   141,     8,    10,    11,    12,    31,     8,    11,    21,
+      65,    67,    68,    69,    71,    72,    73,    74,    75,    79,
+      80,    81,    82,    83,    84,    86,    87,   116,   124,   125,
+     126,   124,    81,     9,    81,    35,    37,    81,    81,    92,
+       0,     3,   142,    81,    81,    81,    11,    11,    81,    81,
+     116,   122,   125,    21,    21,    21,    21,    21,    21,    21,
+      21,    34,    79,    80,   125,    23,    57,    81,    85,    86,
+      87,    88,    37,    81,    81,    81,    43,    58,    81,    21,
+      57,    21,    57,    44,    81,    81,    44,    23,   115,    22,
+      22,   125,   125,   125,   125,   125,   125,   125,   125,    81,
+      87,   124,    81,    23,   125,   125,   125,   125,    81,   127,
+     128,    81,    21,    36,    39,   130,    81,   120,    86,   116,
+      81,   110,   122,    81,   111,   122,    81,    44,    44,    81,
+     116,    22,    23,    23,    23,    22,    22,    22,    22,    22,
+      23,   124,    57,    81,    23,    38,   129,   111,    21,    47,
+      48,   125,   131,   132,    58,   130,    79,    80,    27,    28,
+      29,    30,    31,    76,   113,    23,   109,    23,    22,    21,
+      81,    81,   115,   125,   125,   125,   124,    81,   128,   127,
+     130,    22,   116,   125,   125,    45,    46,    47,    48,    58,
+      59,    60,    61,    62,    63,    64,    66,    70,   133,    41,
+      42,   125,    21,    64,    65,   110,    22,   111,    57,   111,
+      21,    21,    22,    22,    22,    44,     7,   134,    36,   115,
+      66,    64,   125,   131,   131,    23,    79,   112,    65,   109,
+      54,    57,   117,   122,   122,    22,   111,    81,   131,     4,
+      40,   135,    21,    22,   120,    22,    55,   122,    56,   118,
+      22,    22,   129,   124,   131,    50,   136,   116,    64,    65,
+      58,    58,    78,     4,    77,   139,   115,    65,    81,    81,
+      21,   125,   137,   138,    79,    22,    81,    15,    51,    23,
+      58,   137,    67,    68,    69,    79,    81,   104,    23,    81,
+      58,   104,    23,    81,    58,   104,    23,    81,    58,   104,
+      22
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_uint8 yyr1[] =
+{
+       0,    90,    91,    92,    92,    92,    92,    92,    92,    92,
+      92,    92,    92,    92,    92,    92,    92,    92,    92,    92,
+      92,    92,    92,    92,    92,    93,    94,    95,    96,    97,
+      98,    99,   100,   101,   102,   103,   103,   104,   104,   104,
+     104,   104,   105,   106,   107,   107,   107,   107,   108,   108,
+     109,   109,   110,   110,   110,   110,   110,   110,   111,   111,
+     112,   113,   113,   113,   113,   113,   113,   114,   114,   115,
+     115,   116,   116,   116,   116,   116,   116,   116,   116,   117,
+     117,   118,   118,   119,   120,   120,   121,   122,   123,   124,
+     124,   124,   124,   124,   124,   125,   125,   125,   125,   125,
+     125,   125,   125,   125,   125,   125,   125,   125,   125,   125,
+     125,   125,   125,   125,   126,   126,   126,   127,   127,   127,
+     128,   128,   129,   129,   130,   130,   131,   131,   131,   131,
+     132,   132,   132,   133,   133,   133,   133,   133,   133,   133,
+     133,   133,   133,   133,   133,   133,   133,   134,   134,   135,
+     135,   136,   136,   137,   137,   138,   138,   138,   139,   139,
+     140,   141,   141,   142,   142
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     3,     2,     4,     2,     8,     9,     1,     1,     1,
+       1,     1,    27,     5,     9,     5,     9,     8,     5,     8,
+       0,     3,     7,     6,     5,     4,     3,     2,     1,     3,
+       1,     1,     1,     1,     1,     1,     1,     8,    11,     0,
+       3,     1,     2,     1,     2,     1,     1,     1,     1,     0,
+       4,     0,     3,     4,     5,     3,     5,    10,     2,     1,
+       2,     3,     4,     5,     3,     4,     4,     4,     4,     4,
+       3,     3,     3,     3,     3,     3,     2,     1,     4,     1,
+       1,     6,     6,     6,     1,     3,     3,     1,     3,     2,
+       1,     3,     0,     5,     0,     2,     0,     1,     3,     3,
+       3,     2,     2,     1,     1,     1,     1,     1,     1,     1,
+       2,     1,     2,     1,     1,     1,     1,     0,     3,     0,
+       2,     0,     3,     1,     3,     1,     2,     2,     0,     2,
+       2,     4,     3,     0,     1
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (&yylloc, sql_string, sql_result, scanner, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
+   If N is 0, then set CURRENT to the empty location which ends
+   the previous symbol: RHS[0] (always defined).  */
+
+#ifndef YYLLOC_DEFAULT
+# define YYLLOC_DEFAULT(Current, Rhs, N)                                \
+    do                                                                  \
+      if (N)                                                            \
+        {                                                               \
+          (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;        \
+          (Current).first_column = YYRHSLOC (Rhs, 1).first_column;      \
+          (Current).last_line    = YYRHSLOC (Rhs, N).last_line;         \
+          (Current).last_column  = YYRHSLOC (Rhs, N).last_column;       \
+        }                                                               \
+      else                                                              \
+        {                                                               \
+          (Current).first_line   = (Current).last_line   =              \
+            YYRHSLOC (Rhs, 0).last_line;                                \
+          (Current).first_column = (Current).last_column =              \
+            YYRHSLOC (Rhs, 0).last_column;                              \
+        }                                                               \
+    while (0)
+#endif
+
+#define YYRHSLOC(Rhs, K) ((Rhs)[K])
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+/* YYLOCATION_PRINT -- Print the location on the stream.
+   This macro was not mandated originally: define only if we know
+   we won't break user code: when these are the locations we know.  */
+
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+
+/* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
+
+YY_ATTRIBUTE_UNUSED
+static int
+yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
+{
+  int res = 0;
+  int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
+  if (0 <= yylocp->first_line)
+    {
+      res += YYFPRINTF (yyo, "%d", yylocp->first_line);
+      if (0 <= yylocp->first_column)
+        res += YYFPRINTF (yyo, ".%d", yylocp->first_column);
+    }
+  if (0 <= yylocp->last_line)
+    {
+      if (yylocp->first_line < yylocp->last_line)
+        {
+          res += YYFPRINTF (yyo, "-%d", yylocp->last_line);
+          if (0 <= end_col)
+            res += YYFPRINTF (yyo, ".%d", end_col);
+        }
+      else if (0 <= end_col && yylocp->first_column < end_col)
+        res += YYFPRINTF (yyo, "-%d", end_col);
+    }
+  return res;
+}
+
+#   define YYLOCATION_PRINT  yy_location_print_
+
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
+
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, Location, sql_string, sql_result, scanner); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  YY_USE (sql_string);
+  YY_USE (sql_result);
+  YY_USE (scanner);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp, sql_string, sql_result, scanner);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule, const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]), sql_string, sql_result, scanner);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, yylsp, Rule, sql_string, sql_result, scanner); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+  YYLTYPE *yylloc;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
+
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
+/* Return the length of YYSTR.  */
+static YYPTRDIFF_T
+yystrlen (const char *yystr)
+{
+  YYPTRDIFF_T yylen;
+  for (yylen = 0; yystr[yylen]; yylen++)
+    continue;
+  return yylen;
+}
+# endif
+#endif
+
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
+/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
+   YYDEST.  */
+static char *
+yystpcpy (char *yydest, const char *yysrc)
+{
+  char *yyd = yydest;
+  const char *yys = yysrc;
+
+  while ((*yyd++ = *yys++) != '\0')
+    continue;
+
+  return yyd - 1;
+}
+# endif
+#endif
+
+#ifndef yytnamerr
+/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
+   quotes and backslashes, so that it's suitable for yyerror.  The
+   heuristic is that double-quoting is unnecessary unless the string
+   contains an apostrophe, a comma, or backslash (other than
+   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
+   null, do not copy; instead, return the length of what the result
+   would have been.  */
+static YYPTRDIFF_T
+yytnamerr (char *yyres, const char *yystr)
+{
+  if (*yystr == '"')
+    {
+      YYPTRDIFF_T yyn = 0;
+      char const *yyp = yystr;
+      for (;;)
+        switch (*++yyp)
+          {
+          case '\'':
+          case ',':
+            goto do_not_strip_quotes;
+
+          case '\\':
+            if (*++yyp != '\\')
+              goto do_not_strip_quotes;
+            else
+              goto append;
+
+          append:
+          default:
+            if (yyres)
+              yyres[yyn] = *yyp;
+            yyn++;
+            break;
+
+          case '"':
+            if (yyres)
+              yyres[yyn] = '\0';
+            return yyn;
+          }
+    do_not_strip_quotes: ;
+    }
+
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
+    return yystrlen (yystr);
+}
+#endif
+
+
+static int
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  /* There are many possibilities here to consider:
+     - If this state is a consistent state with a default action, then
+       the only way this function was invoked is if the default action
+       is an error action.  In that case, don't check for expected
+       tokens because there are none.
+     - The only way there can be no lookahead present (in yychar) is if
+       this state is a consistent state with a default action.  Thus,
+       detecting the absence of a lookahead is sufficient to determine
+       that there is no unexpected or expected token to report.  In that
+       case, just report a simple "syntax error".
+     - Don't assume there isn't a lookahead just because this state is a
+       consistent state with a default action.  There might have been a
+       previous inconsistent state, consistent state with a non-default
+       action, or user semantic action that manipulated yychar.
+     - Of course, the expected token list depends on states to have
+       correct lookahead information, and it depends on the parser not
+       to perform extra reductions after fetching a lookahead from the
+       scanner and before detecting a syntax error.  Thus, state merging
+       (from LALR or IELR) and default reductions corrupt the expected
+       token list.  However, the list is correct for canonical LR with
+       one exception: it will still contain any token that will not be
+       accepted due to an error action in a later state.
+  */
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
+    {
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
+    }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
+
+  switch (yycount)
+    {
+#define YYCASE_(N, S)                       \
+      case N:                               \
+        yyformat = S;                       \
+        break
+    default: /* Avoid compiler warnings. */
+      YYCASE_(0, YY_("syntax error"));
+      YYCASE_(1, YY_("syntax error, unexpected %s"));
+      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
+      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
+      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
+      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
+#undef YYCASE_
+    }
+
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
+  {
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
+  }
+
+  if (*yymsg_alloc < yysize)
+    {
+      *yymsg_alloc = 2 * yysize;
+      if (! (yysize <= *yymsg_alloc
+             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
+        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
+      return -1;
+    }
+
+  /* Avoid sprintf, as that infringes on the user's name space.
+     Don't have undefined behavior even if the translation
+     produced a string with the wrong number of "%s"s.  */
+  {
+    char *yyp = *yymsg;
+    int yyi = 0;
+    while ((*yyp = *yyformat) != '\0')
+      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
+        {
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
+          yyformat += 2;
+        }
+      else
+        {
+          ++yyp;
+          ++yyformat;
+        }
+  }
+  return 0;
+}
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
+{
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  YY_USE (sql_string);
+  YY_USE (sql_result);
+  YY_USE (scanner);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
+{
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+/* Location data for the lookahead symbol.  */
+static YYLTYPE yyloc_default
+# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+  = { 1, 1, 1, 1 }
+# endif
+;
+YYLTYPE yylloc = yyloc_default;
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+    /* The location stack: array, bottom, top.  */
+    YYLTYPE yylsa[YYINITDEPTH];
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+  YYLTYPE yyloc;
+
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
+  /* Buffer for error messages, and its allocated size.  */
+  char yymsgbuf[128];
+  char *yymsg = yymsgbuf;
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  yylsp[0] = yylloc;
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+        YYLTYPE *yyls1 = yyls;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+        yyls = yyls1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        YYSTACK_RELOCATE (yyls_alloc, yyls);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+      yylsp = yyls + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, &yylloc, scanner);
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+  *++yylsp = yylloc;
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+  /* Default location. */
+  YYLLOC_DEFAULT (yyloc, (yylsp - yylen), yylen);
+  yyerror_range[1] = yyloc;
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 2: /* commands: command_wrapper opt_semicolon  */
+#line 243 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+  {
+    std::unique_ptr<ParsedSqlNode> sql_node = std::unique_ptr<ParsedSqlNode>((yyvsp[-1].sql_node));
+    sql_result->add_sql_node(std::move(sql_node));
+  }
+#line 1919 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 25: /* exit_stmt: EXIT  */
+#line 276 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+         {
+      (void)yynerrs;  // 这么写为了消除yynerrs未使用的告警。如果你有更好的方法欢迎提PR
+      (yyval.sql_node) = new ParsedSqlNode(SCF_EXIT);
+    }
+#line 1928 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 26: /* help_stmt: HELP  */
+#line 282 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+         {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_HELP);
+    }
+#line 1936 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 27: /* sync_stmt: SYNC  */
+#line 287 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+         {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_SYNC);
+    }
+#line 1944 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 28: /* begin_stmt: TRX_BEGIN  */
+#line 293 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+               {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_BEGIN);
+    }
+#line 1952 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 29: /* commit_stmt: TRX_COMMIT  */
+#line 299 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+               {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_COMMIT);
+    }
+#line 1960 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 30: /* rollback_stmt: TRX_ROLLBACK  */
+#line 305 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                  {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_ROLLBACK);
+    }
+#line 1968 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 31: /* drop_table_stmt: DROP TABLE ID  */
+#line 311 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                  {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_TABLE);
+      (yyval.sql_node)->drop_table.relation_name = (yyvsp[0].string);
+      free((yyvsp[0].string));
+    }
+#line 1978 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 32: /* show_tables_stmt: SHOW TABLES  */
+#line 318 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_SHOW_TABLES);
+    }
+#line 1986 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 33: /* show_buffer_pool_status_stmt: SHOW ID ID ID  */
+#line 325 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                  {
+      if (0 == strcasecmp((yyvsp[-2].string), "BUFFER") && 0 == strcasecmp((yyvsp[-1].string), "POOL") && 0 == strcasecmp((yyvsp[0].string), "STATUS")) {
+        (yyval.sql_node) = new ParsedSqlNode(SCF_SHOW_BUFFER_POOL_STATUS);
+      } else {
+        (yyval.sql_node) = new ParsedSqlNode(SCF_ERROR);
+        (yyval.sql_node)->error.error_msg = "unknown show statement";
+        (yyval.sql_node)->error.line      = (yylsp[-3]).first_line;
+        (yyval.sql_node)->error.column    = (yylsp[-3]).first_column;
+      }
+      free((yyvsp[-2].string));
+      free((yyvsp[-1].string));
+      free((yyvsp[0].string));
+    }
+#line 2004 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 34: /* desc_table_stmt: DESC ID  */
+#line 341 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+             {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_DESC_TABLE);
+      (yyval.sql_node)->desc_table.relation_name = (yyvsp[0].string);
+      free((yyvsp[0].string));
+    }
+#line 2014 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 35: /* create_index_stmt: CREATE INDEX ID ON ID LBRACE id_list RBRACE  */
+#line 350 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_INDEX);
+      CreateIndexSqlNode &create_index = (yyval.sql_node)->create_index;
+      create_index.index_name = (yyvsp[-5].string);
+      create_index.relation_name = (yyvsp[-3].string);
+      create_index.attribute_names = *(yyvsp[-1].string_list);
+      create_index.is_unique = false;
+      free((yyvsp[-5].string));
+      free((yyvsp[-3].string));
+      if ((yyvsp[-1].string_list) != nullptr) {
+        // 因为是从右往左解析的，所以需要反转
+        std::reverse((yyval.sql_node)->create_index.attribute_names.begin(), (yyval.sql_node)->create_index.attribute_names.end());
+        delete (yyvsp[-1].string_list);
+      }
+    }
+#line 2034 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 36: /* create_index_stmt: CREATE UNIQUE INDEX ID ON ID LBRACE id_list RBRACE  */
+#line 366 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_INDEX);
+      CreateIndexSqlNode &create_index = (yyval.sql_node)->create_index;
+      create_index.index_name = (yyvsp[-5].string);
+      create_index.relation_name = (yyvsp[-3].string);
+      create_index.attribute_names = *(yyvsp[-1].string_list);
+      create_index.is_unique = true;
+      free((yyvsp[-5].string));
+      free((yyvsp[-3].string));
+      if ((yyvsp[-1].string_list) != nullptr) {
+        // 因为是从右往左解析的，所以需要反转
+        std::reverse((yyval.sql_node)->create_index.attribute_names.begin(), (yyval.sql_node)->create_index.attribute_names.end());
+        delete (yyvsp[-1].string_list);
+      }
+    }
+#line 2054 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 37: /* id_or_number: ID  */
+#line 384 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+        (yyval.string) = new char[strlen((yyvsp[0].string)) + 1];
+        strcpy((yyval.string), (yyvsp[0].string));
+        (yyval.string)[strlen((yyvsp[0].string))] = '\0';
+    }
+#line 2064 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 38: /* id_or_number: NUMBER  */
+#line 390 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+        (yyval.string) = new char[20];
+        sprintf((yyval.string), "%d", (yyvsp[0].number));
+    }
+#line 2073 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 39: /* id_or_number: L2_DISTANCE  */
+#line 395 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+        const char* s = "l2_distance";
+        (yyval.string) = new char[strlen(s) + 1];
+        strcpy((yyval.string), s);
+        (yyval.string)[strlen(s)] = '\0';
+    }
+#line 2084 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 40: /* id_or_number: INNER_PRODUCT  */
+#line 402 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+        const char* s = "inner_product";
+        (yyval.string) = new char[strlen(s) + 1];
+        strcpy((yyval.string), s);
+        (yyval.string)[strlen(s)] = '\0';
+    }
+#line 2095 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 41: /* id_or_number: COSINE_DISTANCE  */
+#line 409 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+        const char* s = "cossine_distance";
+        (yyval.string) = new char[strlen(s) + 1];
+        strcpy((yyval.string), s);
+        (yyval.string)[strlen(s)] = '\0';
+    }
+#line 2106 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 42: /* create_vector_index_stmt: CREATE VECTOR_T INDEX ID ON ID LBRACE ID RBRACE WITH LBRACE ID EQ id_or_number COMMA ID EQ id_or_number COMMA ID EQ id_or_number COMMA ID EQ id_or_number RBRACE  */
+#line 420 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+        (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_VECTOR_INDEX);
+        CreateVectorIndexSqlNode &create_vector_index = (yyval.sql_node)->create_vector_index;
+        create_vector_index.index_name = (yyvsp[-23].string);
+        create_vector_index.relation_name = (yyvsp[-21].string);
+        create_vector_index.attribute_names = (yyvsp[-19].string);
+        create_vector_index.params[0] = {(yyvsp[-15].string), (yyvsp[-13].string)};
+        create_vector_index.params[1] = {(yyvsp[-11].string), (yyvsp[-9].string)};
+        create_vector_index.params[2] = {(yyvsp[-7].string), (yyvsp[-5].string)};
+        create_vector_index.params[3] = {(yyvsp[-3].string), (yyvsp[-1].string)};
+        free((yyvsp[-23].string));
+        free((yyvsp[-21].string));
+        free((yyvsp[-19].string));
+        free((yyvsp[-15].string));
+        delete[] (yyvsp[-13].string);
+        free((yyvsp[-11].string));
+        delete[] (yyvsp[-9].string);
+        free((yyvsp[-7].string));
+        delete[] (yyvsp[-5].string);
+        free((yyvsp[-3].string));
+        delete[] (yyvsp[-1].string);
+    }
+#line 2133 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 43: /* drop_index_stmt: DROP INDEX ID ON ID  */
+#line 446 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_INDEX);
+      (yyval.sql_node)->drop_index.index_name = (yyvsp[-2].string);
+      (yyval.sql_node)->drop_index.relation_name = (yyvsp[0].string);
+      free((yyvsp[-2].string));
+      free((yyvsp[0].string));
+    }
+#line 2145 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 44: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE storage_format compression  */
+#line 456 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_TABLE);
+      CreateTableSqlNode &create_table = (yyval.sql_node)->create_table;
+      create_table.relation_name = (yyvsp[-6].string);
+      free((yyvsp[-6].string));
+
+      std::vector<AttrInfoSqlNode> *src_attrs = (yyvsp[-3].attr_infos);
+
+      if (src_attrs != nullptr) {
+        create_table.attr_infos.swap(*src_attrs);
+        delete src_attrs;
+      }
+      create_table.attr_infos.emplace_back(*(yyvsp[-4].attr_info));
+      std::reverse(create_table.attr_infos.begin(), create_table.attr_infos.end());
+      delete (yyvsp[-4].attr_info);
+      if ((yyvsp[-1].string) != nullptr) {
+        create_table.storage_format = (yyvsp[-1].string);
+        free((yyvsp[-1].string));
+      }
+      if ((yyvsp[0].string) != nullptr) {
+        create_table.compression = (yyvsp[0].string);
+        free((yyvsp[0].string));
+      }
+    }
+#line 2174 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 45: /* create_table_stmt: CREATE TABLE ID AS select_stmt  */
+#line 482 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_TABLE);
+      CreateTableSqlNode &create_table = (yyval.sql_node)->create_table;
+      create_table.relation_name = (yyvsp[-2].string);
+      free((yyvsp[-2].string));
+      create_table.sub_select = (yyvsp[0].sql_node);
+    }
+#line 2186 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 46: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE AS select_stmt  */
+#line 491 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_TABLE);
+      CreateTableSqlNode &create_table = (yyval.sql_node)->create_table;
+      create_table.relation_name = (yyvsp[-6].string);
+      free((yyvsp[-6].string));
+
+      std::vector<AttrInfoSqlNode> *src_attrs = (yyvsp[-3].attr_infos);
+
+      if (src_attrs != nullptr) {
+        create_table.attr_infos.swap(*src_attrs);
+        delete src_attrs;
+      }
+      create_table.attr_infos.emplace_back(*(yyvsp[-4].attr_info));
+      std::reverse(create_table.attr_infos.begin(), create_table.attr_infos.end());
+      delete (yyvsp[-4].attr_info);
+      create_table.sub_select = (yyvsp[0].sql_node);
+    }
+#line 2208 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 47: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE select_stmt  */
+#line 509 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_TABLE);
+      CreateTableSqlNode &create_table = (yyval.sql_node)->create_table;
+      create_table.relation_name = (yyvsp[-5].string);
+      free((yyvsp[-5].string));
+
+      std::vector<AttrInfoSqlNode> *src_attrs = (yyvsp[-2].attr_infos);
+
+      if (src_attrs != nullptr) {
+        create_table.attr_infos.swap(*src_attrs);
+        delete src_attrs;
+      }
+      create_table.attr_infos.emplace_back(*(yyvsp[-3].attr_info));
+      std::reverse(create_table.attr_infos.begin(), create_table.attr_infos.end());
+      delete (yyvsp[-3].attr_info);
+      create_table.sub_select = (yyvsp[0].sql_node);
+    }
+#line 2230 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 48: /* create_view_stmt: CREATE VIEW ID AS select_stmt  */
+#line 531 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_VIEW);
+      CreateViewSqlNode &create_view = (yyval.sql_node)->create_view;
+      create_view.view_name = (yyvsp[-2].string);
+      free((yyvsp[-2].string));
+      create_view.sub_select = (yyvsp[0].sql_node);
+      // 得到 AS 之后的字符串
+      create_view.description = std::string(sql_string + (yylsp[0]).first_column, (yylsp[0]).last_column - (yylsp[0]).first_column + 1);
+    }
+#line 2244 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 49: /* create_view_stmt: CREATE VIEW ID LBRACE id_list RBRACE AS select_stmt  */
+#line 541 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_VIEW);
+      CreateViewSqlNode &create_view = (yyval.sql_node)->create_view;
+      create_view.view_name = (yyvsp[-5].string);
+      free((yyvsp[-5].string));
+
+      std::vector<std::string> *src_attrs = (yyvsp[-3].string_list);
+      if (src_attrs != nullptr) {
+        create_view.attrs_name.swap(*src_attrs);
+        delete src_attrs;
+      }
+      std::reverse(create_view.attrs_name.begin(), create_view.attrs_name.end());
+      
+      create_view.sub_select = (yyvsp[0].sql_node);
+      // 得到 AS 之后的字符串
+      create_view.description = std::string(sql_string + (yylsp[0]).first_column, (yylsp[0]).last_column - (yylsp[0]).first_column + 1);
+    }
+#line 2266 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 50: /* attr_def_list: %empty  */
+#line 562 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.attr_infos) = nullptr;
+    }
+#line 2274 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 51: /* attr_def_list: COMMA attr_def attr_def_list  */
+#line 566 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      if ((yyvsp[0].attr_infos) != nullptr) {
+        (yyval.attr_infos) = (yyvsp[0].attr_infos);
+      } else {
+        (yyval.attr_infos) = new std::vector<AttrInfoSqlNode>;
+      }
+      (yyval.attr_infos)->emplace_back(*(yyvsp[-1].attr_info));
+      delete (yyvsp[-1].attr_info);
+    }
+#line 2288 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 52: /* attr_def: ID type LBRACE number RBRACE NOT NULL_T  */
+#line 579 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.attr_info) = new AttrInfoSqlNode;
+      (yyval.attr_info)->type = (AttrType)(yyvsp[-5].number);
+      (yyval.attr_info)->name = (yyvsp[-6].string);
+      (yyval.attr_info)->arr_len = (yyvsp[-3].number);
+      (yyval.attr_info)->nullable = false;
+      free((yyvsp[-6].string));
+    }
+#line 2301 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 53: /* attr_def: ID type LBRACE number RBRACE NULL_T  */
+#line 588 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+          (yyval.attr_info) = new AttrInfoSqlNode;
+          (yyval.attr_info)->type = (AttrType)(yyvsp[-4].number);
+          (yyval.attr_info)->name = (yyvsp[-5].string);
+          (yyval.attr_info)->arr_len = (yyvsp[-2].number);
+          (yyval.attr_info)->nullable = true;
+          free((yyvsp[-5].string));
+    }
+#line 2314 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 54: /* attr_def: ID type LBRACE number RBRACE  */
+#line 597 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.attr_info) = new AttrInfoSqlNode;
+      (yyval.attr_info)->type = (AttrType)(yyvsp[-3].number);
+      (yyval.attr_info)->name = (yyvsp[-4].string);
+      (yyval.attr_info)->arr_len = (yyvsp[-1].number);
+      (yyval.attr_info)->nullable = true;
+      free((yyvsp[-4].string));
+    }
+#line 2327 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 55: /* attr_def: ID type NOT NULL_T  */
+#line 606 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.attr_info) = new AttrInfoSqlNode;
+      (yyval.attr_info)->type = (AttrType)(yyvsp[-2].number);
+      (yyval.attr_info)->name = (yyvsp[-3].string);
+      (yyval.attr_info)->arr_len = 1;
+      (yyval.attr_info)->nullable = false;
+      free((yyvsp[-3].string));
+    }
+#line 2340 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 56: /* attr_def: ID type NULL_T  */
+#line 615 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.attr_info) = new AttrInfoSqlNode;
+      (yyval.attr_info)->type = (AttrType)(yyvsp[-1].number);
+      (yyval.attr_info)->name = (yyvsp[-2].string);
+      (yyval.attr_info)->arr_len = 1;
+      (yyval.attr_info)->nullable = true;
+      free((yyvsp[-2].string));
+    }
+#line 2353 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 57: /* attr_def: ID type  */
+#line 624 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.attr_info) = new AttrInfoSqlNode;
+      (yyval.attr_info)->type = (AttrType)(yyvsp[0].number);
+      (yyval.attr_info)->name = (yyvsp[-1].string);
+      (yyval.attr_info)->arr_len = 1;
+      (yyval.attr_info)->nullable = true;
+      free((yyvsp[-1].string));
+    }
+#line 2366 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 58: /* id_list: ID  */
+#line 636 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.string_list) = new std::vector<std::string>;
+      (yyval.string_list)->emplace_back((yyvsp[0].string));
+      free((yyvsp[0].string));
+    }
+#line 2376 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 59: /* id_list: ID COMMA id_list  */
+#line 642 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      if ((yyvsp[0].string_list) != nullptr) {
+        (yyval.string_list) = (yyvsp[0].string_list);
+      } else {
+        (yyval.string_list) = new std::vector<std::string>;
+      }
+      (yyval.string_list)->emplace_back((yyvsp[-2].string));
+      free((yyvsp[-2].string));
+    }
+#line 2390 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 60: /* number: NUMBER  */
+#line 654 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+           {(yyval.number) = (yyvsp[0].number);}
+#line 2396 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 61: /* type: INT_T  */
+#line 657 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+               { (yyval.number) = static_cast<int>(AttrType::INTS); }
+#line 2402 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 62: /* type: STRING_T  */
+#line 658 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+               { (yyval.number) = static_cast<int>(AttrType::CHARS); }
+#line 2408 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 63: /* type: FLOAT_T  */
+#line 659 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+               { (yyval.number) = static_cast<int>(AttrType::FLOATS); }
+#line 2414 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 64: /* type: DATE_T  */
+#line 660 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+               { (yyval.number) = static_cast<int>(AttrType::DATES); }
+#line 2420 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 65: /* type: VECTOR_T  */
+#line 661 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                 { (yyval.number) = static_cast<int>(AttrType::VECTORS); }
+#line 2426 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 66: /* type: TEXT_T  */
+#line 662 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                 { (yyval.number) = static_cast<int>(AttrType::TEXTS); }
+#line 2432 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 67: /* insert_stmt: INSERT INTO ID VALUES LBRACE value value_list RBRACE  */
+#line 666 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_INSERT);
+      (yyval.sql_node)->insertion.relation_name = (yyvsp[-5].string);
+      if ((yyvsp[-1].value_list) != nullptr) {
+        (yyval.sql_node)->insertion.values.swap(*(yyvsp[-1].value_list));
+        delete (yyvsp[-1].value_list);
+      }
+      (yyval.sql_node)->insertion.values.emplace_back(*(yyvsp[-2].value));
+      std::reverse((yyval.sql_node)->insertion.values.begin(), (yyval.sql_node)->insertion.values.end());
+      delete (yyvsp[-2].value);
+      free((yyvsp[-5].string));
+    }
+#line 2449 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 68: /* insert_stmt: INSERT INTO ID LBRACE id_list RBRACE VALUES LBRACE value value_list RBRACE  */
+#line 679 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+     {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_INSERT);
+      (yyval.sql_node)->insertion.relation_name = (yyvsp[-8].string);
+      
+      // fields list
+      if ((yyvsp[-6].string_list) != nullptr) {
+        (yyval.sql_node)->insertion.attrs_name.swap(*(yyvsp[-6].string_list));
+        delete (yyvsp[-6].string_list);
+      }
+      std::reverse((yyval.sql_node)->insertion.attrs_name.begin(), (yyval.sql_node)->insertion.attrs_name.end());
+
+      if ((yyvsp[-1].value_list) != nullptr) {
+        (yyval.sql_node)->insertion.values.swap(*(yyvsp[-1].value_list));
+        delete (yyvsp[-1].value_list);
+      }
+      (yyval.sql_node)->insertion.values.emplace_back(*(yyvsp[-2].value));
+      std::reverse((yyval.sql_node)->insertion.values.begin(), (yyval.sql_node)->insertion.values.end());
+      delete (yyvsp[-2].value);
+      free((yyvsp[-8].string));
+    }
+#line 2474 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 69: /* value_list: %empty  */
+#line 703 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.value_list) = nullptr;
+    }
+#line 2482 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 70: /* value_list: COMMA value value_list  */
+#line 706 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                              { 
+      if ((yyvsp[0].value_list) != nullptr) {
+        (yyval.value_list) = (yyvsp[0].value_list);
+      } else {
+        (yyval.value_list) = new std::vector<Value>;
+      }
+      (yyval.value_list)->emplace_back(*(yyvsp[-1].value));
+      delete (yyvsp[-1].value);
+    }
+#line 2496 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 71: /* value: NUMBER  */
+#line 717 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+           {
+      (yyval.value) = new Value((int)(yyvsp[0].number));
+      (yyloc) = (yylsp[0]);
+    }
+#line 2505 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 72: /* value: '-' NUMBER  */
+#line 722 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+               {
+      (yyval.value) = new Value(-(int)(yyvsp[0].number));
+      (yyloc) = (yylsp[0]);
+    }
+#line 2514 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 73: /* value: FLOAT  */
+#line 727 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+          {
+      (yyval.value) = new Value((float)(yyvsp[0].floats));
+      (yyloc) = (yylsp[0]);
+    }
+#line 2523 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 74: /* value: '-' FLOAT  */
+#line 732 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+              {
+      (yyval.value) = new Value(-(float)(yyvsp[0].floats));
+      (yyloc) = (yylsp[0]);
+    }
+#line 2532 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 75: /* value: SSS  */
+#line 737 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+        {
+      char *tmp = common::substr((yyvsp[0].string),1,strlen((yyvsp[0].string))-2);
+      (yyval.value) = new Value(tmp);
+      free(tmp);
+      free((yyvsp[0].string));
+    }
+#line 2543 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 76: /* value: DATE  */
+#line 744 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+         {
+      char *tmp = common::substr((yyvsp[0].string),1,strlen((yyvsp[0].string))-2);
+      (yyval.value) = Value::from_date(tmp);
+      if (!(yyval.value)->is_date_valid()) {
+        (yyval.value)->reset();
+      }
+      free(tmp);
+      free((yyvsp[0].string));
+    }
+#line 2557 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 77: /* value: VECTOR  */
+#line 754 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+           {
+      // 如果以双引号或单引号开头，去掉头尾的引号
+      if ((yyvsp[0].string)[0] == '\"' || (yyvsp[0].string)[0] == '\'') {
+        char *tmp = common::substr((yyvsp[0].string),1,strlen((yyvsp[0].string))-2);
+        (yyval.value) = Value::from_vector(tmp);
+        free(tmp);
+      } else {
+        (yyval.value) = Value::from_vector((yyvsp[0].string));
+      }
+      free((yyvsp[0].string));
+    }
+#line 2573 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 78: /* value: NULL_T  */
+#line 766 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+           {
+      (yyval.value) = new Value();
+      (yyval.value)->set_null();
+      (yyloc) = (yylsp[0]);
+    }
+#line 2583 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 79: /* storage_format: %empty  */
+#line 774 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.string) = nullptr;
+    }
+#line 2591 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 80: /* storage_format: STORAGE FORMAT EQ ID  */
+#line 778 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.string) = (yyvsp[0].string);
+    }
+#line 2599 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 81: /* compression: %empty  */
+#line 784 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.string) = nullptr;
+    }
+#line 2607 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 82: /* compression: COMPRESSION EQ ID  */
+#line 788 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.string) = (yyvsp[0].string);
+    }
+#line 2615 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 83: /* delete_stmt: DELETE FROM ID where  */
+#line 795 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_DELETE);
+      (yyval.sql_node)->deletion.relation_name = (yyvsp[-1].string);
+      if ((yyvsp[0].condition_list) != nullptr) {
+        (yyval.sql_node)->deletion.conditions.swap(*(yyvsp[0].condition_list));
+        delete (yyvsp[0].condition_list);
+      }
+      free((yyvsp[-1].string));
+    }
+#line 2629 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 84: /* update_list: ID EQ expression COMMA update_list  */
+#line 807 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+        (yyval.update_info_list) = (yyvsp[0].update_info_list);
+        (yyval.update_info_list)->emplace_back(std::string((yyvsp[-4].string)), (yyvsp[-2].expression));
+        free((yyvsp[-4].string));
+    }
+#line 2639 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 85: /* update_list: ID EQ expression  */
+#line 813 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+        (yyval.update_info_list) = new std::vector<UpdateInfoNode>();
+        (yyval.update_info_list)->emplace_back(std::string((yyvsp[-2].string)), (yyvsp[0].expression));
+        free((yyvsp[-2].string));
+    }
+#line 2649 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 86: /* update_stmt: UPDATE ID SET update_list where  */
+#line 821 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_UPDATE);
+      (yyval.sql_node)->update.relation_name = (yyvsp[-3].string);
+      (yyval.sql_node)->update.update_infos = *(yyvsp[-1].update_info_list);
+      if ((yyvsp[0].condition_list) != nullptr) {
+        (yyval.sql_node)->update.conditions.swap(*(yyvsp[0].condition_list));
+        delete (yyvsp[0].condition_list);
+      }
+      free((yyvsp[-3].string));
+      delete (yyvsp[-1].update_info_list);
+    }
+#line 2665 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 87: /* select_stmt: SELECT expression_list FROM rel_list join_list where group_by having order_by limit  */
+#line 835 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_SELECT);
+      if ((yyvsp[-8].expression_list) != nullptr) {
+        (yyval.sql_node)->selection.expressions.swap(*(yyvsp[-8].expression_list));
+        delete (yyvsp[-8].expression_list);
+      }
+
+      // from
+      if ((yyvsp[-6].relation_list) != nullptr) {
+        (yyval.sql_node)->selection.relations.swap(*(yyvsp[-6].relation_list));
+        std::reverse((yyval.sql_node)->selection.relations.begin(), (yyval.sql_node)->selection.relations.end());
+        delete (yyvsp[-6].relation_list);
+      }
+
+      // join
+      if ((yyvsp[-5].join_list) != nullptr) {
+        /* 由于是递归顺序解析的join，需要 reverse */
+        std::reverse((yyvsp[-5].join_list)->begin(), (yyvsp[-5].join_list)->end());
+        for (auto &join : *(yyvsp[-5].join_list)) {
+          (yyval.sql_node)->selection.relations.push_back(join.relation);
+          for (auto &condition : join.conditions) {
+            (yyval.sql_node)->selection.conditions.emplace_back(std::move(condition));
+          }
+        }
+        // delete $5; // TODO(Soulter): free test
+      }
+
+      // where
+      if ((yyvsp[-4].condition_list) != nullptr) {
+        // $$->selection.conditions.swap(*$6);
+        for (auto &condition : *(yyvsp[-4].condition_list)) {
+          (yyval.sql_node)->selection.conditions.emplace_back(std::move(condition));
+        }
+        std::reverse((yyval.sql_node)->selection.conditions.begin(), (yyval.sql_node)->selection.conditions.end());
+        delete (yyvsp[-4].condition_list);
+      }
+
+      // group by
+      if ((yyvsp[-3].expression_list) != nullptr) {
+        (yyval.sql_node)->selection.group_by.swap(*(yyvsp[-3].expression_list));
+        delete (yyvsp[-3].expression_list);
+      }
+
+      // having
+      if ((yyvsp[-2].condition_list) != nullptr) {
+        (yyval.sql_node)->selection.havings.swap(*(yyvsp[-2].condition_list));
+        std::reverse((yyval.sql_node)->selection.havings.begin(), (yyval.sql_node)->selection.havings.end());
+        delete (yyvsp[-2].condition_list);
+      }
+
+      // order by
+      if ((yyvsp[-1].order_by_list) != nullptr) {
+        (yyval.sql_node)->selection.order_by.swap(*(yyvsp[-1].order_by_list));
+        std::reverse((yyval.sql_node)->selection.order_by.begin(), (yyval.sql_node)->selection.order_by.end());
+        delete (yyvsp[-1].order_by_list);
+      }
+
+      // limit
+      (yyval.sql_node)->selection.limit = (yyvsp[0].number);
+    }
+#line 2730 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 88: /* calc_stmt: CALC expression_list  */
+#line 898 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_CALC);
+      (yyval.sql_node)->calc.expressions.swap(*(yyvsp[0].expression_list));
+      delete (yyvsp[0].expression_list);
+    }
+#line 2740 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 89: /* expression_list: expression  */
+#line 907 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.expression_list) = new std::vector<std::unique_ptr<Expression>>;
+      (yyval.expression_list)->emplace_back((yyvsp[0].expression));
+    }
+#line 2749 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 90: /* expression_list: expression ID  */
+#line 911 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                   {
+      (yyval.expression_list) = new std::vector<std::unique_ptr<Expression>>;
+      (yyvsp[-1].expression)->set_alias((yyvsp[0].string));
+      (yyval.expression_list)->emplace_back((yyvsp[-1].expression));
+      free((yyvsp[0].string));
+    }
+#line 2760 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 91: /* expression_list: expression AS ID  */
+#line 917 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                      {
+      (yyval.expression_list) = new std::vector<std::unique_ptr<Expression>>;
+      (yyvsp[-2].expression)->set_alias((yyvsp[0].string));
+      (yyval.expression_list)->emplace_back((yyvsp[-2].expression));
+      free((yyvsp[0].string));
+    }
+#line 2771 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 92: /* expression_list: expression ID COMMA expression_list  */
+#line 924 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      if ((yyvsp[0].expression_list) != nullptr) {
+        (yyval.expression_list) = (yyvsp[0].expression_list);
+      } else {
+        (yyval.expression_list) = new std::vector<std::unique_ptr<Expression>>;
+      }
+      (yyvsp[-3].expression)->set_alias((yyvsp[-2].string));
+      (yyval.expression_list)->emplace((yyval.expression_list)->begin(), (yyvsp[-3].expression));
+      free((yyvsp[-2].string));
+    }
+#line 2786 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 93: /* expression_list: expression AS ID COMMA expression_list  */
+#line 935 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      if ((yyvsp[0].expression_list) != nullptr) {
+        (yyval.expression_list) = (yyvsp[0].expression_list);
+      } else {
+        (yyval.expression_list) = new std::vector<std::unique_ptr<Expression>>;
+      }
+      (yyvsp[-4].expression)->set_alias((yyvsp[-2].string));
+      (yyval.expression_list)->emplace((yyval.expression_list)->begin(), (yyvsp[-4].expression));
+      free((yyvsp[-2].string));
+    }
+#line 2801 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 94: /* expression_list: expression COMMA expression_list  */
+#line 946 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      if ((yyvsp[0].expression_list) != nullptr) {
+        (yyval.expression_list) = (yyvsp[0].expression_list);
+      } else {
+        (yyval.expression_list) = new std::vector<std::unique_ptr<Expression>>;
+      }
+      (yyval.expression_list)->emplace((yyval.expression_list)->begin(), (yyvsp[-2].expression));
+    }
+#line 2814 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 95: /* expression: COUNT LBRACE expression RBRACE  */
+#line 957 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.expression) = create_aggregate_expression(AggregateType::COUNT, (yyvsp[-1].expression), sql_string, &(yyloc));
+    }
+#line 2822 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 96: /* expression: MAX LBRACE expression RBRACE  */
+#line 961 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.expression) = create_aggregate_expression(AggregateType::MAX, (yyvsp[-1].expression), sql_string, &(yyloc));
+    }
+#line 2830 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 97: /* expression: MIN LBRACE expression RBRACE  */
+#line 965 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.expression) = create_aggregate_expression(AggregateType::MIN, (yyvsp[-1].expression), sql_string, &(yyloc));
+    }
+#line 2838 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 98: /* expression: AVG LBRACE expression RBRACE  */
+#line 969 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.expression) = create_aggregate_expression(AggregateType::AVG, (yyvsp[-1].expression), sql_string, &(yyloc));
+    }
+#line 2846 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 99: /* expression: SUM LBRACE expression RBRACE  */
+#line 973 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.expression) = create_aggregate_expression(AggregateType::SUM, (yyvsp[-1].expression), sql_string, &(yyloc));
+    }
+#line 2854 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 100: /* expression: expression '+' expression  */
+#line 976 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                                {
+      (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::ADD, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
+    }
+#line 2862 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 101: /* expression: expression '-' expression  */
+#line 979 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                                {
+      (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::SUB, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
+    }
+#line 2870 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 102: /* expression: expression '*' expression  */
+#line 982 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                                {
+      (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::MUL, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
+    }
+#line 2878 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 103: /* expression: expression '/' expression  */
+#line 985 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                                {
+      (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::DIV, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
+    }
+#line 2886 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 104: /* expression: LBRACE select_stmt RBRACE  */
+#line 988 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                                {
+      (yyval.expression) = new SubqueryExpr((yyvsp[-1].sql_node));
+      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
+    }
+#line 2895 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 105: /* expression: LBRACE expression RBRACE  */
+#line 992 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                               {
+      (yyval.expression) = (yyvsp[-1].expression);
+      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
+    }
+#line 2904 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 106: /* expression: '-' expression  */
+#line 996 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                                  {
+      (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::NEGATIVE, nullptr, (yyvsp[0].expression), sql_string, &(yyloc));
+    }
+#line 2912 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 107: /* expression: value  */
+#line 999 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+            {
+      (yyval.expression) = new ValueExpr(*(yyvsp[0].value));
+      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
+      delete (yyvsp[0].value);
+    }
+#line 2922 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 108: /* expression: LBRACE value value_list RBRACE  */
+#line 1004 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                                      {
+      std::vector<Value> *values = (yyvsp[-1].value_list);
+      values->emplace_back(*(yyvsp[-2].value));
+      (yyval.expression) = new ValueListExpr(*values);
+      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
+    }
+#line 2933 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 109: /* expression: rel_attr  */
+#line 1010 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+               {
+      RelAttrSqlNode *node = (yyvsp[0].rel_attr);
+      (yyval.expression) = new UnboundFieldExpr(node->relation_name, node->attribute_name);
+      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
+      delete (yyvsp[0].rel_attr);
+    }
+#line 2944 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 110: /* expression: '*'  */
+#line 1016 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+          {
+      (yyval.expression) = new StarExpr();
+    }
+#line 2952 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 111: /* expression: L2_DISTANCE LBRACE expression COMMA expression RBRACE  */
+#line 1019 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                                                            {
+      (yyval.expression) = new VectorDistanceExpr(VectorDistanceExpr::Type::L2_DISTANCE, (yyvsp[-3].expression), (yyvsp[-1].expression));
+      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
+    }
+#line 2961 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 112: /* expression: COSINE_DISTANCE LBRACE expression COMMA expression RBRACE  */
+#line 1023 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                                                                {
+      (yyval.expression) = new VectorDistanceExpr(VectorDistanceExpr::Type::COSINE_DISTANCE, (yyvsp[-3].expression), (yyvsp[-1].expression));
+      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
+    }
+#line 2970 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 113: /* expression: INNER_PRODUCT LBRACE expression COMMA expression RBRACE  */
+#line 1027 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                                                              {
+      (yyval.expression) = new VectorDistanceExpr(VectorDistanceExpr::Type::INNER_PRODUCT, (yyvsp[-3].expression), (yyvsp[-1].expression));
+      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
+    }
+#line 2979 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 114: /* rel_attr: ID  */
+#line 1034 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+       {
+      (yyval.rel_attr) = new RelAttrSqlNode;
+      (yyval.rel_attr)->attribute_name = (yyvsp[0].string);
+      free((yyvsp[0].string));
+    }
+#line 2989 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 115: /* rel_attr: ID DOT ID  */
+#line 1039 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                {
+      (yyval.rel_attr) = new RelAttrSqlNode;
+      (yyval.rel_attr)->relation_name  = (yyvsp[-2].string);
+      (yyval.rel_attr)->attribute_name = (yyvsp[0].string);
+      free((yyvsp[-2].string));
+      free((yyvsp[0].string));
+    }
+#line 3001 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 116: /* rel_attr: ID DOT '*'  */
+#line 1046 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                 {
+      (yyval.rel_attr) = new RelAttrSqlNode;
+      (yyval.rel_attr)->relation_name  = (yyvsp[-2].string);
+      (yyval.rel_attr)->attribute_name = "*";
+      free((yyvsp[-2].string));
+    }
+#line 3012 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 117: /* relation: ID  */
+#line 1055 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+       {
+      (yyval.relation) = new RelationSqlNode;
+      (yyval.relation)->name = (yyvsp[0].string);
+      free((yyvsp[0].string));
+    }
+#line 3022 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 118: /* relation: ID AS ID  */
+#line 1060 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+               {
+      (yyval.relation) = new RelationSqlNode;
+      (yyval.relation)->name = (yyvsp[-2].string);
+      (yyval.relation)->alias = (yyvsp[0].string);
+      free((yyvsp[-2].string));
+      free((yyvsp[0].string));
+    }
+#line 3034 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 119: /* relation: ID ID  */
+#line 1067 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+            {
+      (yyval.relation) = new RelationSqlNode;
+      (yyval.relation)->name = (yyvsp[-1].string);
+      (yyval.relation)->alias = (yyvsp[0].string);
+      free((yyvsp[-1].string));
+      free((yyvsp[0].string));
+    }
+#line 3046 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 120: /* rel_list: relation  */
+#line 1077 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+             {
+      // $$ = new std::vector<std::string>();
+      // $$->push_back($1);
+      // free($1);
+      (yyval.relation_list) = new std::vector<RelationSqlNode>;
+      (yyval.relation_list)->emplace_back(*(yyvsp[0].relation));
+      // free($1);
+      delete (yyvsp[0].relation);
+    }
+#line 3060 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 121: /* rel_list: relation COMMA rel_list  */
+#line 1086 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                              {
+      if ((yyvsp[0].relation_list) != nullptr) {
+        (yyval.relation_list) = (yyvsp[0].relation_list);
+      } else {
+        (yyval.relation_list) = new std::vector<RelationSqlNode>;
+      }
+      (yyval.relation_list)->emplace_back(*(yyvsp[-2].relation));
+      // free($1);
+      delete (yyvsp[-2].relation);
+    }
+#line 3075 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 122: /* join_list: %empty  */
+#line 1100 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.join_list) = nullptr;
+    }
+#line 3083 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 123: /* join_list: INNER_JOIN relation ON condition_list join_list  */
+#line 1103 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                                                      {
+      if ((yyvsp[0].join_list) != nullptr) {
+        (yyval.join_list) = (yyvsp[0].join_list);
+      } else {
+        (yyval.join_list) = new std::vector<JoinSqlNode>;
+      }
+
+      JoinSqlNode join1;
+      join1.relation = *(yyvsp[-3].relation);
+      delete (yyvsp[-3].relation);
+      // reverse
+      std::reverse((yyvsp[-1].condition_list)->begin(), (yyvsp[-1].condition_list)->end());
+      for (auto &condition : *(yyvsp[-1].condition_list)) {
+        join1.conditions.emplace_back(std::move(condition));
+      }
+      (yyval.join_list)->emplace_back(std::move(join1));
+    }
+#line 3105 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 124: /* where: %empty  */
+#line 1124 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.condition_list) = nullptr;
+    }
+#line 3113 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 125: /* where: WHERE condition_list  */
+#line 1127 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                           {
+      (yyval.condition_list) = (yyvsp[0].condition_list);  
+    }
+#line 3121 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 126: /* condition_list: %empty  */
+#line 1133 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.condition_list) = nullptr;
+    }
+#line 3129 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 127: /* condition_list: condition  */
+#line 1136 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                {
+      (yyval.condition_list) = new std::vector<ConditionSqlNode>;
+      (yyvsp[0].condition)->conjunction_type = 0;
+      (yyval.condition_list)->push_back(std::move(*(yyvsp[0].condition)));
+      delete (yyvsp[0].condition);
+    }
+#line 3140 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 128: /* condition_list: condition AND condition_list  */
+#line 1142 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                                   {
+      (yyval.condition_list) = (yyvsp[0].condition_list);
+      (yyvsp[-2].condition)->conjunction_type = 1;
+      (yyval.condition_list)->push_back(std::move(*(yyvsp[-2].condition)));
+      delete (yyvsp[-2].condition);
+    }
+#line 3151 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 129: /* condition_list: condition OR condition_list  */
+#line 1148 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                                  {
+      (yyval.condition_list) = (yyvsp[0].condition_list);
+      (yyvsp[-2].condition)->conjunction_type = 2;
+      (yyval.condition_list)->push_back(std::move(*(yyvsp[-2].condition)));
+      delete (yyvsp[-2].condition);
+    }
+#line 3162 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 130: /* condition: expression comp_op expression  */
+#line 1157 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->left_expr = std::unique_ptr<Expression>((yyvsp[-2].expression));
+      (yyval.condition)->right_expr = std::unique_ptr<Expression>((yyvsp[0].expression));
+      (yyval.condition)->comp_op = (yyvsp[-1].comp);
+    }
+#line 3173 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 131: /* condition: EXISTS expression  */
+#line 1165 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->comp_op = CompOp::EXISTS;
+      // left_expr: SpecialPlaceholderExpr
+      (yyval.condition)->left_expr = std::make_unique<SpecialPlaceholderExpr>();
+      (yyval.condition)->right_expr = std::unique_ptr<Expression>((yyvsp[0].expression));
+    }
+#line 3185 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 132: /* condition: NOT_EXISTS expression  */
+#line 1173 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->comp_op = CompOp::NOT_EXISTS;
+      (yyval.condition)->left_expr = std::make_unique<SpecialPlaceholderExpr>();
+      (yyval.condition)->right_expr = std::unique_ptr<Expression>((yyvsp[0].expression));
+    }
+#line 3196 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 133: /* comp_op: EQ  */
+#line 1182 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+         { (yyval.comp) = CompOp::EQUAL_TO; }
+#line 3202 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 134: /* comp_op: LT  */
+#line 1183 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+         { (yyval.comp) = CompOp::LESS_THAN; }
+#line 3208 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 135: /* comp_op: GT  */
+#line 1184 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+         { (yyval.comp) = CompOp::GREAT_THAN; }
+#line 3214 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 136: /* comp_op: LE  */
+#line 1185 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+         { (yyval.comp) = CompOp::LESS_EQUAL; }
+#line 3220 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 137: /* comp_op: GE  */
+#line 1186 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+         { (yyval.comp) = CompOp::GREAT_EQUAL; }
+#line 3226 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 138: /* comp_op: NE  */
+#line 1187 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+         { (yyval.comp) = CompOp::NOT_EQUAL; }
+#line 3232 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 139: /* comp_op: LIKE  */
+#line 1188 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+           { (yyval.comp) = CompOp::LIKE; }
+#line 3238 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 140: /* comp_op: NOT LIKE  */
+#line 1189 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+               { (yyval.comp) = CompOp::NOT_LIKE; }
+#line 3244 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 141: /* comp_op: IS  */
+#line 1190 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+         { (yyval.comp) = CompOp::IS; }
+#line 3250 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 142: /* comp_op: IS NOT  */
+#line 1191 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+             { (yyval.comp) = CompOp::NOT_IS; }
+#line 3256 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 143: /* comp_op: IN  */
+#line 1192 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+         { (yyval.comp) = CompOp::IN; }
+#line 3262 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 144: /* comp_op: NOT_IN  */
+#line 1193 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+             { (yyval.comp) = CompOp::NOT_IN; }
+#line 3268 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 145: /* comp_op: EXISTS  */
+#line 1194 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+             { (yyval.comp) = CompOp::EXISTS; }
+#line 3274 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 146: /* comp_op: NOT_EXISTS  */
+#line 1195 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                 { (yyval.comp) = CompOp::NOT_EXISTS; }
+#line 3280 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 147: /* group_by: %empty  */
+#line 1200 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.expression_list) = nullptr;
+    }
+#line 3288 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 148: /* group_by: GROUP BY expression_list  */
+#line 1204 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.expression_list) = new std::vector<std::unique_ptr<Expression>>;
+      (yyval.expression_list)->swap(*(yyvsp[0].expression_list));
+      delete (yyvsp[0].expression_list);
+    }
+#line 3298 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 149: /* having: %empty  */
+#line 1213 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.condition_list) = nullptr;
+    }
+#line 3306 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 150: /* having: HAVING condition_list  */
+#line 1216 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+                            {
+      (yyval.condition_list) = (yyvsp[0].condition_list);
+    }
+#line 3314 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 151: /* order_by: %empty  */
+#line 1223 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.order_by_list) = nullptr;
+    }
+#line 3322 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 152: /* order_by: ORDER BY order_by_list  */
+#line 1227 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.order_by_list) = new std::vector<OrderBySqlNode>;
+      (yyval.order_by_list)->swap(*(yyvsp[0].order_by_list));
+      delete (yyvsp[0].order_by_list);
+    }
+#line 3332 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 153: /* order_by_list: order_by_item  */
+#line 1236 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.order_by_list) = new std::vector<OrderBySqlNode>;
+      (yyval.order_by_list)->push_back(std::move(*(yyvsp[0].order_by_node)));
+      delete (yyvsp[0].order_by_node);
+    }
+#line 3342 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 154: /* order_by_list: order_by_item COMMA order_by_list  */
+#line 1242 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.order_by_list) = (yyvsp[0].order_by_list);
+      (yyval.order_by_list)->push_back(std::move(*(yyvsp[-2].order_by_node)));
+      delete (yyvsp[-2].order_by_node);
+    }
+#line 3352 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 155: /* order_by_item: expression  */
+#line 1251 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.order_by_node) = new OrderBySqlNode;
+      (yyval.order_by_node)->expression = std::unique_ptr<Expression>((yyvsp[0].expression));
+      (yyval.order_by_node)->is_desc = false;
+    }
+#line 3362 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 156: /* order_by_item: expression ASC  */
+#line 1257 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.order_by_node) = new OrderBySqlNode;
+      (yyval.order_by_node)->expression = std::unique_ptr<Expression>((yyvsp[-1].expression));
+      (yyval.order_by_node)->is_desc = false;
+    }
+#line 3372 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 157: /* order_by_item: expression DESC  */
+#line 1263 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.order_by_node) = new OrderBySqlNode;
+      (yyval.order_by_node)->expression = std::unique_ptr<Expression>((yyvsp[-1].expression));
+      (yyval.order_by_node)->is_desc = true;
+    }
+#line 3382 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 158: /* limit: %empty  */
+#line 1272 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.number) = -1;
+    }
+#line 3390 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 159: /* limit: LIMIT NUMBER  */
+#line 1276 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.number) = (yyvsp[0].number);
+    }
+#line 3398 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 160: /* explain_stmt: EXPLAIN command_wrapper  */
+#line 1298 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_EXPLAIN);
+      (yyval.sql_node)->explain.sql_node = std::unique_ptr<ParsedSqlNode>((yyvsp[0].sql_node));
+    }
+#line 3407 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 161: /* set_variable_stmt: SET ID EQ value  */
+#line 1306 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_SET_VARIABLE);
+      (yyval.sql_node)->set_variable.name  = (yyvsp[-2].string);
+      (yyval.sql_node)->set_variable.value = *(yyvsp[0].value);
+      free((yyvsp[-2].string));
+      delete (yyvsp[0].value);
+    }
+#line 3419 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+  case 162: /* set_variable_stmt: SET ID ID  */
+#line 1314 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+    {
+        (yyval.sql_node) = new ParsedSqlNode(SCF_SET_VARIABLE);
+        (yyval.sql_node)->set_variable.name  = (yyvsp[-1].string);
+        (yyval.sql_node)->set_variable.value = Value((yyvsp[0].string), strlen((yyvsp[0].string)));
+        free((yyvsp[-1].string));
+        free((yyvsp[0].string));
+    }
+#line 3431 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+    break;
+
+
+#line 3435 "/root/repo/src/observer/sql/parser/yacc_sql.cpp"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+  *++yylsp = yyloc;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      {
+        yypcontext_t yyctx
+          = {yyssp, yytoken, &yylloc};
+        char const *yymsgp = YY_("syntax error");
+        int yysyntax_error_status;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+        if (yysyntax_error_status == 0)
+          yymsgp = yymsg;
+        else if (yysyntax_error_status == -1)
+          {
+            if (yymsg != yymsgbuf)
+              YYSTACK_FREE (yymsg);
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
+              {
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
+              }
+            else
+              {
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
+              }
+          }
+        yyerror (&yylloc, sql_string, sql_result, scanner, yymsgp);
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
+      }
+    }
+
+  yyerror_range[1] = yylloc;
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, &yylloc, sql_string, sql_result, scanner);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+      yyerror_range[1] = *yylsp;
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp, sql_string, sql_result, scanner);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  yyerror_range[2] = yylloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (&yylloc, sql_string, sql_result, scanner, YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, &yylloc, sql_string, sql_result, scanner);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, sql_string, sql_result, scanner);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+  if (yymsg != yymsgbuf)
+    YYSTACK_FREE (yymsg);
+  return yyresult;
+}
+
+#line 1326 "/root/repo/src/observer/sql/parser/yacc_sql.y"
+
+//_____________________________________________________________________
+extern void scan_string(const char *str, yyscan_t scanner);
+
+int sql_parse(const char *s, ParsedSqlResult *sql_result) {
+  yyscan_t scanner;
+  yylex_init(&scanner);
+  scan_string(s, scanner);
+  int result = yyparse(s, sql_result, scanner);
+  yylex_destroy(scanner);
+  return result;
+}
@@ -117,6 +117,7 @@ UnboundAggregateExpr *create_aggregate_expression(AggregateType type,
         EXPLAIN
         STORAGE
         FORMAT
+        COMPRESSION
         AS
         EQ
         LT
@@ -195,6 +196,7 @@ UnboundAggregateExpr *create_aggregate_expression(AggregateType type,
 %type <number>              limit
 %type <join_list>           join_list
 %type <string>              storage_format
+%type <string>              compression
 %type <relation_list>       rel_list
 %type <expression>          expression
 %type <expression_list>     expression_list
@@ -210,6 +212,7 @@ UnboundAggregateExpr *create_aggregate_expression(AggregateType type,
 %type <sql_node>            create_table_stmt
 %type <sql_node>            drop_table_stmt
 %type <sql_node>            show_tables_stmt
+%type <sql_node>            show_buffer_pool_status_stmt
 %type <sql_node>            desc_table_stmt
 %type <sql_node>            create_view_stmt
 %type <sql_node>            create_index_stmt
@@ -252,6 +255,7 @@ command_wrapper:
   | create_table_stmt
   | drop_table_stmt
   | show_tables_stmt
+  | show_buffer_pool_status_stmt
   | desc_table_stmt
   | create_view_stmt
   | create_index_stmt
@@ -316,6 +320,23 @@ show_tables_stmt:
     }
     ;
 
+show_buffer_pool_status_stmt:
+    /* 不把 BUFFER/POOL/STATUS 作为关键字，以免不能再用它们做表名或者字段名 */
+    SHOW ID ID ID {
+      if (0 == strcasecmp($2, "BUFFER") && 0 == strcasecmp($3, "POOL") && 0 == strcasecmp($4, "STATUS")) {
+        $$ = new ParsedSqlNode(SCF_SHOW_BUFFER_POOL_STATUS);
+      } else {
+        $$ = new ParsedSqlNode(SCF_ERROR);
+        $$->error.error_msg = "unknown show statement";
+        $$->error.line      = @1.first_line;
+        $$->error.column    = @1.first_column;
+      }
+      free($2);
+      free($3);
+      free($4);
+    }
+    ;
+
 desc_table_stmt:
     DESC ID  {
       $$ = new ParsedSqlNode(SCF_DESC_TABLE);
@@ -431,7 +452,7 @@ drop_index_stmt:      /*drop index 语句的语法解析树*/
     }
     ;
 create_table_stmt:    /*create table 语句的语法解析树*/
-    CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE storage_format
+    CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE storage_format compression
     {
       $$ = new ParsedSqlNode(SCF_CREATE_TABLE);
       CreateTableSqlNode &create_table = $$->create_table;
@@ -451,6 +472,10 @@ create_table_stmt:    /*create table 语句的语法解析树*/
         create_table.storage_format = $8;
         free($8);
       }
+      if ($9 != nullptr) {
+        create_table.compression = $9;
+        free($9);
+      }
     }
     // as
     | CREATE TABLE ID AS select_stmt
@@ -754,6 +779,16 @@ storage_format:
       $$ = $4;
     }
     ;
+compression:
+    /* empty */
+    {
+      $$ = nullptr;
+    }
+    | COMPRESSION EQ ID
+    {
+      $$ = $3;
+    }
+    ;
     
 delete_stmt:    /*  delete 语句的语法解析树*/
     DELETE FROM ID where 
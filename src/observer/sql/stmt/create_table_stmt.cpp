@@ -31,6 +31,15 @@ RC CreateTableStmt::create(Db *db, CreateTableSqlNode &create_table, Stmt *&stmt
     return RC::INVALID_ARGUMENT;
   }
 
+  bool page_compression = false;
+  if (create_table.compression.length() != 0) {
+    RC rc = get_page_compression(create_table.compression.c_str(), page_compression);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("invalid compression option: %s", create_table.compression.c_str());
+      return rc;
+    }
+  }
+
   // create table select
   SelectStmt *select_stmt = nullptr;
   Stmt *stmt_ = nullptr;
@@ -52,7 +61,7 @@ RC CreateTableStmt::create(Db *db, CreateTableSqlNode &create_table, Stmt *&stmt
       attr.arr_len = 1;
     }
   }
-  stmt = new CreateTableStmt(create_table.relation_name, create_table.attr_infos, storage_format);
+  stmt = new CreateTableStmt(create_table.relation_name, create_table.attr_infos, storage_format, page_compression);
 
   if (create_table.sub_select != nullptr) {
     CreateTableStmt *create_table_stmt = static_cast<CreateTableStmt *>(stmt);
@@ -70,8 +79,22 @@ StorageFormat CreateTableStmt::get_storage_format(const char *format_str) {
     format = StorageFormat::ROW_FORMAT;
   } else if (0 == strcasecmp(format_str, "PAX")) {
     format = StorageFormat::PAX_FORMAT;
+  } else if (0 == strcasecmp(format_str, "SLOTTED")) {
+    format = StorageFormat::SLOTTED_FORMAT;
   } else {
     format = StorageFormat::UNKNOWN_FORMAT;
   }
   return format;
 }
+
+RC CreateTableStmt::get_page_compression(const char *compression_str, bool &page_compression)
+{
+  if (0 == strcasecmp(compression_str, "LZ")) {
+    page_compression = true;
+  } else if (0 == strcasecmp(compression_str, "NONE")) {
+    page_compression = false;
+  } else {
+    return RC::INVALID_ARGUMENT;
+  }
+  return RC::SUCCESS;
+}
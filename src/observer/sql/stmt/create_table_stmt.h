@@ -33,9 +33,12 @@ class Db;
 class CreateTableStmt : public Stmt
 {
 public:
-  CreateTableStmt(
-      const std::string &table_name, const std::vector<AttrInfoSqlNode> &attr_infos, StorageFormat storage_format)
-      : table_name_(table_name), attr_infos_(attr_infos), storage_format_(storage_format)
+  CreateTableStmt(const std::string &table_name, const std::vector<AttrInfoSqlNode> &attr_infos,
+      StorageFormat storage_format, bool page_compression = false)
+      : table_name_(table_name),
+        attr_infos_(attr_infos),
+        storage_format_(storage_format),
+        page_compression_(page_compression)
   {}
   virtual ~CreateTableStmt() = default;
 
@@ -44,6 +47,7 @@ public:
   const std::string                  &table_name() const { return table_name_; }
   const std::vector<AttrInfoSqlNode> &attr_infos() const { return attr_infos_; }
   const StorageFormat                 storage_format() const { return storage_format_; }
+  bool                                page_compression() const { return page_compression_; }
 
   void set_select_stmt(SelectStmt *select_stmt) { select_stmt_ = select_stmt; }
   void set_physical_operator(std::unique_ptr<PhysicalOperator> physical_operator) { physical_operator_ = std::move(physical_operator); }
@@ -56,10 +60,16 @@ public:
   static RC            create(Db *db, CreateTableSqlNode &create_table, Stmt *&stmt);
   static StorageFormat get_storage_format(const char *format_str);
 
+  /**
+   * @brief 解析 COMPRESSION=xxx 选项，支持 LZ 和 NONE
+   */
+  static RC get_page_compression(const char *compression_str, bool &page_compression);
+
 private:
   std::string                  table_name_;
   std::vector<AttrInfoSqlNode> attr_infos_;
   StorageFormat                storage_format_;
+  bool                         page_compression_ = false;
   
   SelectStmt *select_stmt_ = nullptr;
   std::unique_ptr<PhysicalOperator> physical_operator_ = nullptr;
@@ -0,0 +1,84 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/buffer/buffer_pool_metrics.h"
+#include "common/metrics/metrics_registry.h"
+
+using namespace common;
+
+BufferPoolMetrics::~BufferPoolMetrics() { unregister_metrics(); }
+
+void BufferPoolMetrics::register_metrics(const string &file_name)
+{
+  unregister_metrics();
+
+  tag_prefix_ = "buffer_pool." + file_name + ".";
+
+  MetricsRegistry &registry = get_metrics_registry();
+  registry.register_metric(tag_prefix_ + "hit", &hit_);
+  registry.register_metric(tag_prefix_ + "miss", &miss_);
+  registry.register_metric(tag_prefix_ + "evict", &evict_);
+  registry.register_metric(tag_prefix_ + "flush", &flush_);
+  registry.register_metric(tag_prefix_ + "read_pages", &read_pages_);
+  registry.register_metric(tag_prefix_ + "read_bytes", &read_bytes_);
+  registry.register_metric(tag_prefix_ + "write_pages", &write_pages_);
+  registry.register_metric(tag_prefix_ + "write_bytes", &write_bytes_);
+  registry.register_metric(tag_prefix_ + "read_latency_us", &read_latency_);
+  registry.register_metric(tag_prefix_ + "write_latency_us", &write_latency_);
+}
+
+void BufferPoolMetrics::unregister_metrics()
+{
+  if (tag_prefix_.empty()) {
+    return;
+  }
+
+  MetricsRegistry &registry = get_metrics_registry();
+  for (const char *name : {"hit", "miss", "evict", "flush", "read_pages", "read_bytes", "write_pages", "write_bytes",
+           "read_latency_us", "write_latency_us"}) {
+    registry.unregister(tag_prefix_ + name);
+  }
+  tag_prefix_.clear();
+}
+
+void BufferPoolMetrics::on_read(int pages, int64_t bytes, chrono::steady_clock::time_point start)
+{
+  auto elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+  read_pages_.inc(pages);
+  read_bytes_.inc(bytes);
+  read_latency_.update(elapsed.count());
+}
+
+void BufferPoolMetrics::on_write(int pages, int64_t bytes, chrono::steady_clock::time_point start)
+{
+  auto elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+  write_pages_.inc(pages);
+  write_bytes_.inc(bytes);
+  write_latency_.update(elapsed.count());
+}
+
+BufferPoolStatus BufferPoolMetrics::status(const string &file_name) const
+{
+  BufferPoolStatus status;
+  status.file_name    = file_name;
+  status.hit_count    = hit_.value();
+  status.miss_count   = miss_.value();
+  status.evict_count  = evict_.value();
+  status.flush_count  = flush_.value();
+  status.read_pages   = read_pages_.value();
+  status.read_bytes   = read_bytes_.value();
+  status.write_pages  = write_pages_.value();
+  status.write_bytes  = write_bytes_.value();
+  status.read_avg_us  = read_latency_.mean();
+  status.read_p99_us  = read_latency_.percentile(0.99);
+  status.write_avg_us = write_latency_.mean();
+  status.write_p99_us = write_latency_.percentile(0.99);
+  return status;
+}
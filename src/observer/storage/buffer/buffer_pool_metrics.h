@@ -0,0 +1,88 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/chrono.h"
+#include "common/lang/string.h"
+#include "common/metrics/metrics.h"
+
+/**
+ * @brief 一个缓冲池文件的统计信息快照
+ * @ingroup BufferPool
+ */
+struct BufferPoolStatus
+{
+  string  file_name;
+  int64_t hit_count    = 0;  ///< 访问页面时页面已经在内存中
+  int64_t miss_count   = 0;  ///< 访问页面时需要从磁盘加载
+  int64_t evict_count  = 0;  ///< 为了腾出页帧淘汰的页面个数
+  int64_t flush_count  = 0;  ///< 刷到磁盘的脏页个数
+  int64_t read_pages   = 0;  ///< 从磁盘读取的页面个数，包括预读
+  int64_t read_bytes   = 0;
+  int64_t write_pages  = 0;  ///< 写入磁盘的页面个数
+  int64_t write_bytes  = 0;  ///< 写入磁盘的字节数，开启压缩时比 write_pages 个页面少
+  double  read_avg_us  = 0;  ///< 每次读盘的平均耗时，批量读取算一次
+  int64_t read_p99_us  = 0;
+  double  write_avg_us = 0;  ///< 每次写盘的平均耗时，批量写入算一次
+  int64_t write_p99_us = 0;
+
+  double hit_ratio() const
+  {
+    int64_t total = hit_count + miss_count;
+    return total == 0 ? 0.0 : static_cast<double>(hit_count) / total;
+  }
+};
+
+/**
+ * @brief 一个缓冲池文件的统计信息
+ * @ingroup BufferPool
+ * @details 计数都是原子变量，不加锁。打开文件时注册到 common::MetricsRegistry 中，
+ * 标签是 "buffer_pool.<文件名>.<指标名>"，可以通过注册表的 reporter 定期输出。
+ * SHOW BUFFER POOL STATUS 语句和 __buffer_pool_status__ 虚拟表使用 status 接口读取。
+ */
+class BufferPoolMetrics
+{
+public:
+  BufferPoolMetrics() = default;
+  ~BufferPoolMetrics();
+
+  void register_metrics(const string &file_name);
+  void unregister_metrics();
+
+  void on_hit() { hit_.inc(); }
+  void on_miss() { miss_.inc(); }
+  void on_evict() { evict_.inc(); }
+  void on_flush() { flush_.inc(); }
+
+  /**
+   * @brief 记录一次读盘
+   * @param pages 本次读取的页面个数
+   * @param start 开始读盘的时间
+   */
+  void on_read(int pages, int64_t bytes, chrono::steady_clock::time_point start);
+  void on_write(int pages, int64_t bytes, chrono::steady_clock::time_point start);
+
+  BufferPoolStatus status(const string &file_name) const;
+
+private:
+  common::Counter          hit_;
+  common::Counter          miss_;
+  common::Counter          evict_;
+  common::Counter          flush_;
+  common::Counter          read_pages_;
+  common::Counter          read_bytes_;
+  common::Counter          write_pages_;
+  common::Counter          write_bytes_;
+  common::LatencyHistogram read_latency_;   ///< 单位是微秒
+  common::LatencyHistogram write_latency_;  ///< 单位是微秒
+
+  string tag_prefix_;  ///< 为空表示没有注册
+};
@@ -0,0 +1,266 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/buffer/buffer_pool_warmer.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/chrono.h"
+#include "common/lang/filesystem.h"
+#include "common/lang/fstream.h"
+#include "common/lang/map.h"
+#include "common/lang/vector.h"
+#include "common/log/log.h"
+#include "common/thread/thread_util.h"
+#include "storage/buffer/disk_buffer_pool.h"
+
+using namespace common;
+
+BufferPoolWarmer::BufferPoolWarmer(BufferPoolManager &bp_manager, BPFrameManager &frame_manager)
+    : bp_manager_(bp_manager), frame_manager_(frame_manager)
+{}
+
+BufferPoolWarmer::~BufferPoolWarmer() { stop(); }
+
+RC BufferPoolWarmer::start(const Options &options)
+{
+  if (!options.enabled) {
+    LOG_INFO("buffer pool warm up is disabled");
+    return RC::SUCCESS;
+  }
+
+  if (options.dump_file.empty()) {
+    LOG_WARN("buffer pool warm up is enabled without dump file");
+    return RC::INVALID_ARGUMENT;
+  }
+
+  if (running_.load()) {
+    LOG_ERROR("buffer pool warmer has been started");
+    return RC::INTERNAL;
+  }
+
+  options_                   = options;
+  options_.dump_interval_sec = max(0, options_.dump_interval_sec);
+  stop_requested_.store(false);
+  running_.store(true);
+
+#ifdef CONCURRENCY
+  thread_ = make_unique<thread>(&BufferPoolWarmer::thread_func, this);
+#else
+  // 没有并发控制时不能和请求同时加载页面，只能在启动时同步加载
+  (void)load(options_.dump_file.c_str());
+#endif
+
+  LOG_INFO("buffer pool warmer started. dump file=%s, dump interval=%ds",
+           options_.dump_file.c_str(), options_.dump_interval_sec);
+  return RC::SUCCESS;
+}
+
+RC BufferPoolWarmer::stop()
+{
+  if (!running_.load()) {
+    return RC::SUCCESS;
+  }
+
+  stop_requested_.store(true);
+  running_.store(false);
+  if (thread_) {
+    {
+      lock_guard<mutex> guard(wakeup_lock_);
+    }
+    wakeup_cv_.notify_all();
+
+    thread_->join();
+    thread_.reset();
+  }
+
+  RC rc = dump(options_.dump_file.c_str());
+  LOG_INFO("buffer pool warmer stopped. rc=%s", strrc(rc));
+  return rc;
+}
+
+void BufferPoolWarmer::thread_func()
+{
+  thread_set_name("BPWarmer");
+  LOG_INFO("buffer pool warmer thread started");
+
+  (void)load(options_.dump_file.c_str());
+
+  while (running_.load()) {
+    unique_lock<mutex> guard(wakeup_lock_);
+    if (options_.dump_interval_sec == 0) {
+      wakeup_cv_.wait(guard, [this]() { return !running_.load(); });
+    } else {
+      wakeup_cv_.wait_for(guard, chrono::seconds(options_.dump_interval_sec), [this]() { return !running_.load(); });
+    }
+    guard.unlock();
+
+    if (running_.load()) {
+      (void)dump(options_.dump_file.c_str());
+    }
+  }
+
+  LOG_INFO("buffer pool warmer thread exit");
+}
+
+RC BufferPoolWarmer::dump(const char *dump_file)
+{
+  lock_guard<mutex> dump_guard(dump_lock_);
+
+  vector<FrameId> frame_ids;
+  frame_manager_.frame_ids(frame_ids);
+  sort(frame_ids.begin(), frame_ids.end(), [](const FrameId &a, const FrameId &b) {
+    if (a.buffer_pool_id() != b.buffer_pool_id()) {
+      return a.buffer_pool_id() < b.buffer_pool_id();
+    }
+    return a.page_num() < b.page_num();
+  });
+
+  string temp_file = string(dump_file) + ".tmp";
+  ofstream out(temp_file, ios::out | ios::trunc);
+  if (!out) {
+    LOG_WARN("failed to open buffer pool dump file %s. error=%s", temp_file.c_str(), strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+
+  int64_t page_count = 0;
+  {
+    // 关闭文件时会加排他锁，保证读取文件名时buffer pool不会被释放
+    shared_lock<common::SharedMutex> file_guard(bp_manager_.file_lifetime_lock());
+
+    int32_t         last_id = -1;
+    DiskBufferPool *bp      = nullptr;
+    for (const FrameId &frame_id : frame_ids) {
+      if (frame_id.buffer_pool_id() != last_id) {
+        last_id = frame_id.buffer_pool_id();
+        if (OB_FAIL(bp_manager_.get_buffer_pool(last_id, bp))) {
+          bp = nullptr;
+        }
+      }
+
+      // 文件头一直在内存中，不需要记录
+      if (bp == nullptr || frame_id.page_num() == BP_HEADER_PAGE) {
+        continue;
+      }
+
+      out << frame_id.page_num() << ' ' << bp->filename() << '\n';
+      page_count++;
+    }
+  }
+
+  out.close();
+  if (!out) {
+    LOG_WARN("failed to write buffer pool dump file %s", temp_file.c_str());
+    return RC::IOERR_WRITE;
+  }
+
+  error_code ec;
+  filesystem::rename(temp_file, dump_file, ec);
+  if (ec) {
+    LOG_WARN("failed to rename buffer pool dump file %s. error=%s", temp_file.c_str(), ec.message().c_str());
+    return RC::IOERR_WRITE;
+  }
+
+  LOG_INFO("dump buffer pool pages done. file=%s, page count=%ld", dump_file, page_count);
+  return RC::SUCCESS;
+}
+
+RC BufferPoolWarmer::load(const char *dump_file)
+{
+  ifstream in(dump_file);
+  if (!in) {
+    LOG_INFO("no buffer pool dump file %s, skip warm up", dump_file);
+    return RC::SUCCESS;
+  }
+
+  // 同一个文件的页面从小到大排列，加载时尽量顺序读盘
+  map<string, vector<PageNum>> file_pages;
+  int64_t                      total_pages = 0;
+  string                       line;
+  while (getline(in, line)) {
+    size_t pos = line.find(' ');
+    if (pos == string::npos || pos + 1 >= line.size()) {
+      continue;
+    }
+
+    PageNum page_num = atoi(line.substr(0, pos).c_str());
+    if (page_num <= BP_HEADER_PAGE) {
+      continue;
+    }
+    file_pages[line.substr(pos + 1)].push_back(page_num);
+    total_pages++;
+  }
+
+  loading_.store(true);
+  total_pages_.store(total_pages);
+  done_pages_.store(0);
+  loaded_pages_.store(0);
+  LOG_INFO("buffer pool warm up begin. dump file=%s, file count=%d, page count=%ld",
+           dump_file, static_cast<int>(file_pages.size()), total_pages);
+
+  auto    begin_time       = chrono::steady_clock::now();
+  int64_t next_report_done = total_pages / 10;
+  bool    stopped          = false;
+  for (auto &[file_name, page_nums] : file_pages) {
+    sort(page_nums.begin(), page_nums.end());
+    page_nums.erase(unique(page_nums.begin(), page_nums.end()), page_nums.end());
+
+    for (size_t begin = 0; begin < page_nums.size() && !stopped; begin += LOAD_BATCH_PAGES) {
+      if (stop_requested_.load()) {
+        stopped = true;
+        break;
+      }
+
+      if (frame_manager_.frame_num() >= frame_manager_.total_frame_num()) {
+        LOG_INFO("buffer pool is full, stop warm up");
+        stopped = true;
+        break;
+      }
+
+      const size_t    end = min(page_nums.size(), begin + LOAD_BATCH_PAGES);
+      vector<PageNum> batch(page_nums.begin() + begin, page_nums.begin() + end);
+
+      // 关闭文件时会加排他锁，持有共享锁加载页面，文件不会在加载过程中被关闭，后台刷脏也不受影响
+      shared_lock<common::SharedMutex> file_guard(bp_manager_.file_lifetime_lock());
+
+      DiskBufferPool *bp = nullptr;
+      if (OB_FAIL(bp_manager_.get_buffer_pool(file_name.c_str(), bp))) {
+        LOG_INFO("buffer pool file is not opened, skip warm up it. file=%s", file_name.c_str());
+        done_pages_.fetch_add(page_nums.size() - begin);
+        break;
+      }
+
+      // 已经释放的页面不会被加载
+      loaded_pages_.fetch_add(bp->preload_pages(batch));
+      done_pages_.fetch_add(end - begin);
+
+      if (done_pages_.load() >= next_report_done && next_report_done > 0) {
+        LOG_INFO("buffer pool warm up progress: %ld/%ld pages, loaded=%ld",
+                 done_pages_.load(), total_pages, loaded_pages_.load());
+        next_report_done += max(total_pages / 10, static_cast<int64_t>(1));
+      }
+    }
+  }
+
+  loading_.store(false);
+  auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - begin_time);
+  LOG_INFO("buffer pool warm up %s. done=%ld/%ld pages, loaded=%ld, elapsed=%ldms",
+           stopped ? "stopped" : "finished", done_pages_.load(), total_pages, loaded_pages_.load(),
+           static_cast<int64_t>(elapsed.count()));
+  return RC::SUCCESS;
+}
+
+BufferPoolWarmer::Progress BufferPoolWarmer::progress() const
+{
+  Progress progress;
+  progress.loading      = loading_.load();
+  progress.total_pages  = total_pages_.load();
+  progress.done_pages   = done_pages_.load();
+  progress.loaded_pages = loaded_pages_.load();
+  return progress;
+}
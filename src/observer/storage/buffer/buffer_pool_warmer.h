@@ -0,0 +1,110 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/atomic.h"
+#include "common/lang/memory.h"
+#include "common/lang/mutex.h"
+#include "common/lang/string.h"
+#include "common/lang/thread.h"
+#include "common/rc.h"
+
+class BufferPoolManager;
+class BPFrameManager;
+
+/**
+ * @brief 缓冲池预热
+ * @ingroup BufferPool
+ * @details 重启以后缓冲池是空的，需要很长时间才能把热点页面重新加载到内存中，这期间请求的延迟会很高。
+ * 预热的做法是：
+ * 1. 正常关闭时(以及运行期间定期)把内存中所有页面的(文件名, 页面号)列表保存到文件中；
+ * 2. 启动时在后台线程中读取这个列表，按照文件和页面号排序后批量加载，尽量让读盘是顺序的。
+ *
+ * 加载时只使用空闲的页帧，不会淘汰已经在内存中的页面，所以可以和正常的请求同时进行。
+ * 加载进度可以通过 progress 获取，在 __buffer_pool_status__ 虚拟表中显示，也会打印到日志中。
+ * 没有CONCURRENCY时，启动时同步加载，并且不会定期保存页面列表。
+ */
+class BufferPoolWarmer
+{
+public:
+  struct Options
+  {
+    bool   enabled = false;
+    string dump_file;                ///< 保存页面列表的文件
+    int    dump_interval_sec = 300;  ///< 定期保存页面列表的间隔，0表示只在关闭时保存
+  };
+
+  /**
+   * @brief 加载进度
+   */
+  struct Progress
+  {
+    bool    loading      = false;  ///< 是否正在加载
+    int64_t total_pages  = 0;      ///< 页面列表中的页面个数
+    int64_t done_pages   = 0;      ///< 已经处理过的页面个数，包括已经在内存中和文件已经不存在的页面
+    int64_t loaded_pages = 0;      ///< 真正从磁盘加载的页面个数
+  };
+
+public:
+  BufferPoolWarmer(BufferPoolManager &bp_manager, BPFrameManager &frame_manager);
+  ~BufferPoolWarmer();
+
+  /**
+   * @brief 在后台加载页面列表，并定期保存页面列表
+   * @details 需要在打开所有的文件之后调用
+   */
+  RC start(const Options &options);
+
+  /**
+   * @brief 停止后台线程，并保存一次页面列表
+   * @details 需要在关闭文件之前调用
+   */
+  RC stop();
+
+  /**
+   * @brief 把内存中所有页面的列表保存到文件中
+   * @details 先写临时文件再改名，保存过程中崩溃不会破坏原来的文件
+   */
+  RC dump(const char *dump_file);
+
+  /**
+   * @brief 加载文件中记录的页面
+   * @details 后台线程调用，测试时也可以直接调用
+   */
+  RC load(const char *dump_file);
+
+  Progress progress() const;
+
+private:
+  void thread_func();
+
+private:
+  /// 每次加载多少个页面
+  static constexpr int LOAD_BATCH_PAGES = 64;
+
+  BufferPoolManager &bp_manager_;
+  BPFrameManager    &frame_manager_;
+  Options            options_;
+
+  atomic<bool>       running_{false};
+  atomic<bool>       stop_requested_{false};  ///< 加载过程中可以停止
+  unique_ptr<thread> thread_;
+
+  mutex              wakeup_lock_;
+  condition_variable wakeup_cv_;
+
+  mutex dump_lock_;  ///< 同一时间只有一个线程在保存页面列表
+
+  atomic<bool>    loading_{false};
+  atomic<int64_t> total_pages_{0};
+  atomic<int64_t> done_pages_{0};
+  atomic<int64_t> loaded_pages_{0};
+};
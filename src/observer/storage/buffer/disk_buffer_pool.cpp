@@ -13,6 +13,9 @@ See the Mulan PSL v2 for more details. */
 //
 #include <errno.h>
 #include <string.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
 
 #include "common/io/io.h"
 #include "common/lang/mutex.h"
@@ -21,6 +24,7 @@ See the Mulan PSL v2 for more details. */
 #include "common/math/crc.h"
 #include "storage/buffer/disk_buffer_pool.h"
 #include "storage/buffer/buffer_pool_log.h"
+#include "storage/buffer/page_compressor.h"
 #include "storage/db/db.h"
 
 using namespace common;
@@ -32,7 +36,8 @@ static const int MEM_POOL_ITEM_NUM = 20;
 string BPFileHeader::to_string() const
 {
   stringstream ss;
-  ss << "pageCount:" << page_count << ", allocatedCount:" << allocated_pages;
+  ss << "pageCount:" << page_count << ", allocatedCount:" << allocated_pages
+     << ", spaceMapCount:" << (page_count + PAGES_PER_SPACE_MAP - 1) / PAGES_PER_SPACE_MAP;
   return ss.str();
 }
 
@@ -40,36 +45,152 @@ string BPFileHeader::to_string() const
 
 BPFrameManager::BPFrameManager(const char *name) : allocator_(name) {}
 
-RC BPFrameManager::init(int pool_num)
+RC BPFrameManager::init(int pool_num, int partition_num /* = DEFAULT_PARTITION_NUM */,
+    const char *eviction_policy /* = nullptr */, const FrameArenaOptions &arena_options /* = FrameArenaOptions() */)
 {
   int ret = allocator_.init(false, pool_num);
-  if (ret == 0) {
-    return RC::SUCCESS;
+  if (ret != 0) {
+    return RC::NOMEM;
+  }
+
+  const int frame_count = allocator_.get_size();
+  partition_num         = max(1, min(partition_num, frame_count));
+
+  partitions_.clear();
+  partitions_.reserve(partition_num);
+  for (int i = 0; i < partition_num; i++) {
+    FrameReplacer *replacer = nullptr;
+    RC             rc       = FrameReplacer::create(eviction_policy, frame_count / partition_num, replacer);
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("failed to create frame replacer. eviction policy=%s, rc=%s", eviction_policy, strrc(rc));
+      partitions_.clear();
+      return rc;
+    }
+
+    partitions_.emplace_back(make_unique<Partition>());
+    partitions_.back()->replacer.reset(replacer);
   }
-  return RC::NOMEM;
+
+  // 页面内存单独按照 BP_IO_ALIGN 对齐申请，这样直接IO(O_DIRECT)可以直接读写页帧
+  // 所有页帧的内存是一整块，可以使用大页减少TLB缺失
+  RC rc = page_arena_.init(static_cast<size_t>(frame_count) * sizeof(Page), arena_options);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("failed to allocate page memory. frame count=%d, rc=%s", frame_count, strrc(rc));
+    partitions_.clear();
+    return rc;
+  }
+
+  // 一次性把所有的页帧从内存池中申请出来，平均分给各个分区
+  // 之后页帧只会在各个分区的空闲链表和LRU之间流转，直到cleanup时才还给内存池
+  for (int i = 0; i < frame_count; i++) {
+    Frame *frame = allocator_.alloc();
+    if (frame == nullptr) {
+      LOG_ERROR("failed to alloc frame from memory pool. index=%d, frame count=%d", i, frame_count);
+      return RC::NOMEM;
+    }
+    frame->bind_page(&page_arena_.pages()[i]);
+    partitions_[i % partition_num]->free_frames.push_back(frame);
+  }
+
+  LOG_INFO("frame manager init done. frame count=%d, partition num=%d, eviction policy=%s",
+           frame_count, partition_num, partitions_.front()->replacer->name());
+  return RC::SUCCESS;
 }
 
 RC BPFrameManager::cleanup()
 {
-  if (frames_.count() > 0) {
+  if (frame_num() > 0) {
     return RC::INTERNAL;
   }
 
-  frames_.destroy();
+  for (unique_ptr<Partition> &partition : partitions_) {
+    for (Frame *frame : partition->free_frames) {
+      allocator_.free(frame);
+    }
+    partition->free_frames.clear();
+  }
+  partitions_.clear();
   return RC::SUCCESS;
 }
 
-int BPFrameManager::purge_frames(int count, function<RC(Frame *frame)> purger)
+int BPFrameManager::partition_index(const FrameId &frame_id) const
 {
-  lock_guard<mutex> lock_guard(lock_);
+  // FrameId 的哈希值低位就是页面编号，连续的页面会落在不同的分区上
+  const uint64_t hash = static_cast<uint64_t>(frame_id.hash()) * 0x9E3779B97F4A7C15ULL;
+  return static_cast<int>((hash >> 32) % partitions_.size());
+}
 
-  vector<Frame *> frames_can_purge;
+size_t BPFrameManager::frame_num() const
+{
+  size_t count = 0;
+  for (const unique_ptr<Partition> &partition : partitions_) {
+    lock_guard<mutex> lock_guard(partition->lock);
+    count += partition->frames.size();
+  }
+  return count;
+}
+
+void BPFrameManager::frame_ids(vector<FrameId> &frame_ids) const
+{
+  for (const unique_ptr<Partition> &partition : partitions_) {
+    lock_guard<mutex> lock_guard(partition->lock);
+    for (const auto &[frame_id, frame] : partition->frames) {
+      frame_ids.push_back(frame_id);
+    }
+  }
+}
+
+BPFrameManager::Stat BPFrameManager::stat() const
+{
+  Stat stat;
+  for (const unique_ptr<Partition> &partition : partitions_) {
+    lock_guard<mutex> lock_guard(partition->lock);
+    stat.hit_count += partition->stat.hit_count;
+    stat.miss_count += partition->stat.miss_count;
+    stat.evict_count += partition->stat.evict_count;
+  }
+  return stat;
+}
+
+int BPFrameManager::purge_frames(int count, function<RC(Frame *frame)> purger)
+{
   if (count <= 0) {
     count = 1;
   }
+
+  // 每次从不同的分区开始淘汰，避免总是淘汰同一个分区中的页面
+  const int partition_num = static_cast<int>(partitions_.size());
+  const int start         = purge_cursor_.fetch_add(1) % partition_num;
+
+  int freed_count = 0;
+  for (int i = 0; i < partition_num && freed_count < count; i++) {
+    Partition &partition = *partitions_[(start + i) % partition_num];
+    freed_count += purge_partition(partition, count - freed_count, purger);
+  }
+  LOG_INFO("purge frame done. number=%d", freed_count);
+  return freed_count;
+}
+
+int BPFrameManager::purge_partition(Partition &partition, int count, function<RC(Frame *frame)> &purger)
+{
+  lock_guard<mutex> lock_guard(partition.lock);
+
+  vector<Frame *> frames_can_purge;
   frames_can_purge.reserve(count);
 
-  auto purge_finder = [&frames_can_purge, count](const FrameId &frame_id, Frame *const frame) {
+  // 先在淘汰顺序最靠前的一些页帧中找干净的，找不到足够的再淘汰脏页帧
+  int  scanned_count = 0;
+  auto clean_finder  = [&frames_can_purge, &scanned_count, count](Frame *frame) {
+    if (frame->can_purge() && !frame->dirty()) {
+      frame->pin();
+      frames_can_purge.push_back(frame);
+      if (frames_can_purge.size() >= static_cast<size_t>(count)) {
+        return false;  // false to break the progress
+      }
+    }
+    return ++scanned_count < CLEAN_SCAN_DEPTH;
+  };
+  auto purge_finder = [&frames_can_purge, count](Frame *frame) {
     if (frame->can_purge()) {
       frame->pin();
       frames_can_purge.push_back(frame);
@@ -80,138 +201,372 @@ int BPFrameManager::purge_frames(int count, function<RC(Frame *frame)> purger)
     return true;  // true continue to look up
   };
 
-  frames_.foreach_reverse(purge_finder);
-  LOG_INFO("purge frames find %ld pages total", frames_can_purge.size());
+  partition.replacer->foreach_victim(clean_finder);
+  if (frames_can_purge.size() < static_cast<size_t>(count)) {
+    partition.replacer->foreach_victim(purge_finder);
+  }
+  LOG_TRACE("purge frames find %ld pages total", frames_can_purge.size());
 
-  /// 当前还在frameManager的锁内，而 purger 是一个非常耗时的操作
-  /// 他需要把脏页数据刷新到磁盘上去，所以这里会极大地降低并发度
+  /// 当前还在分区的锁内，而 purger 是一个非常耗时的操作
+  /// 他需要把脏页数据刷新到磁盘上去，不过只会阻塞访问当前分区的线程
   int freed_count = 0;
   for (Frame *frame : frames_can_purge) {
     RC rc = purger(frame);
     if (RC::SUCCESS == rc) {
-      free_internal(frame->frame_id(), frame);
+      free_internal(partition, frame->frame_id(), frame, true /*evicted*/);
       freed_count++;
+      partition.stat.evict_count++;
     } else {
       frame->unpin();
       LOG_WARN("failed to purge frame. frame_id=%s, rc=%s", 
                frame->frame_id().to_string().c_str(), strrc(rc));
     }
   }
-  LOG_INFO("purge frame done. number=%d", freed_count);
   return freed_count;
 }
 
-Frame *BPFrameManager::get(int buffer_pool_id, PageNum page_num)
+bool BPFrameManager::contains(int buffer_pool_id, PageNum page_num)
+{
+  FrameId    frame_id(buffer_pool_id, page_num);
+  Partition &partition = *partitions_[partition_index(frame_id)];
+
+  lock_guard<mutex> lock_guard(partition.lock);
+  return partition.frames.find(frame_id) != partition.frames.end();
+}
+
+size_t BPFrameManager::dirty_frame_num()
 {
-  FrameId                     frame_id(buffer_pool_id, page_num);
+  size_t count = 0;
+  for (unique_ptr<Partition> &partition : partitions_) {
+    lock_guard<mutex> lock_guard(partition->lock);
+    for (auto &[frame_id, frame] : partition->frames) {
+      count += frame->dirty() ? 1 : 0;
+    }
+  }
+  return count;
+}
+
+void BPFrameManager::find_dirty_frames(
+    int victim_depth, size_t max_other_count, vector<Frame *> &victim_frames, vector<Frame *> &other_frames)
+{
+  vector<Frame *> candidates;
+  for (unique_ptr<Partition> &partition : partitions_) {
+    lock_guard<mutex> lock_guard(partition->lock);
+
+    int depth = 0;
+    partition->replacer->foreach_victim([&victim_frames, &depth, victim_depth](Frame *frame) {
+      if (frame->dirty()) {
+        frame->pin();
+        victim_frames.push_back(frame);
+      }
+      return ++depth < victim_depth;
+    });
+
+    if (max_other_count == 0) {
+      continue;
+    }
 
-  lock_guard<mutex> lock_guard(lock_);
-  return get_internal(frame_id);
+    // 淘汰顺序靠前的页帧刚才已经pin过了，这里不再重复收集
+    const size_t victim_end = victim_frames.size();
+    const size_t victim_begin = victim_end - min(victim_end, static_cast<size_t>(victim_depth));
+    candidates.clear();
+    for (auto &[frame_id, frame] : partition->frames) {
+      if (!frame->dirty()) {
+        continue;
+      }
+      if (find(victim_frames.begin() + victim_begin, victim_frames.end(), frame) != victim_frames.end()) {
+        continue;
+      }
+      candidates.push_back(frame);
+    }
+
+    // 每个分区只 pin 最老的 max_other_count 个页帧，不需要把所有的脏页帧都 pin 一遍
+    if (candidates.size() > max_other_count) {
+      nth_element(candidates.begin(), candidates.begin() + max_other_count, candidates.end(),
+          [](Frame *a, Frame *b) { return a->lsn() < b->lsn(); });
+      candidates.resize(max_other_count);
+    }
+    for (Frame *frame : candidates) {
+      frame->pin();
+      other_frames.push_back(frame);
+    }
+  }
 }
 
-Frame *BPFrameManager::get_internal(const FrameId &frame_id)
+Frame *BPFrameManager::get(int buffer_pool_id, PageNum page_num)
 {
-  Frame *frame = nullptr;
-  (void)frames_.get(frame_id, frame);
+  FrameId    frame_id(buffer_pool_id, page_num);
+  Partition &partition = *partitions_[partition_index(frame_id)];
+
+  lock_guard<mutex> lock_guard(partition.lock);
+  Frame *frame = get_internal(partition, frame_id);
   if (frame != nullptr) {
-    frame->pin();
+    partition.stat.hit_count++;
+  } else {
+    partition.stat.miss_count++;
   }
   return frame;
 }
 
+Frame *BPFrameManager::get_without_stat(int buffer_pool_id, PageNum page_num)
+{
+  FrameId    frame_id(buffer_pool_id, page_num);
+  Partition &partition = *partitions_[partition_index(frame_id)];
+
+  lock_guard<mutex> lock_guard(partition.lock);
+  return get_internal(partition, frame_id);
+}
+
+Frame *BPFrameManager::get_internal(Partition &partition, const FrameId &frame_id)
+{
+  auto iter = partition.frames.find(frame_id);
+  if (iter == partition.frames.end()) {
+    return nullptr;
+  }
+
+  Frame *frame = iter->second;
+  frame->pin();
+  partition.replacer->touch(frame);
+  return frame;
+}
+
 Frame *BPFrameManager::alloc(int buffer_pool_id, PageNum page_num)
 {
-  FrameId frame_id(buffer_pool_id, page_num);
+  FrameId    frame_id(buffer_pool_id, page_num);
+  const int  index     = partition_index(frame_id);
+  Partition &partition = *partitions_[index];
 
-  lock_guard<mutex> lock_guard(lock_);
+  for (bool stolen = false; ; stolen = true) {
+    {
+      lock_guard<mutex> lock_guard(partition.lock);
 
-  Frame                      *frame = get_internal(frame_id);
-  if (frame != nullptr) {
-    return frame;
+      Frame *frame = get_internal(partition, frame_id);
+      if (frame != nullptr) {
+        return frame;
+      }
+
+      if (!partition.free_frames.empty()) {
+        frame = partition.free_frames.front();
+        partition.free_frames.pop_front();
+        frame->reinit();
+
+        ASSERT(frame->pin_count() == 0, "got an invalid frame that pin count is not 0. frame=%s", 
+               frame->to_string().c_str());
+        frame->set_buffer_pool_id(buffer_pool_id);
+        frame->set_page_num(page_num);
+        frame->pin();
+        partition.frames.emplace(frame_id, frame);
+        partition.replacer->insert(frame);
+        return frame;
+      }
+    }
+
+    // 偷页帧时不能持有当前分区的锁，偷完之后重新检查一遍，因为可能有其它线程已经加载了这个页面
+    if (stolen || steal_free_frames(index) == 0) {
+      return nullptr;
+    }
   }
+  return nullptr;
+}
 
-  frame = allocator_.alloc();
-  if (frame != nullptr) {
-    ASSERT(frame->pin_count() == 0, "got an invalid frame that pin count is not 0. frame=%s", 
-           frame->to_string().c_str());
-    frame->set_buffer_pool_id(buffer_pool_id);
-    frame->set_page_num(page_num);
-    frame->pin();
-    frames_.put(frame_id, frame);
+int BPFrameManager::steal_free_frames(int home_index)
+{
+  const int     partition_num = static_cast<int>(partitions_.size());
+  list<Frame *> stolen_frames;
+  for (int i = 1; i < partition_num && stolen_frames.empty(); i++) {
+    Partition &victim = *partitions_[(home_index + i) % partition_num];
+
+    lock_guard<mutex> lock_guard(victim.lock);
+    // 最多偷一半，不要把别人的空闲页帧都拿走
+    const size_t steal_count = min(static_cast<size_t>(STEAL_BATCH_SIZE), (victim.free_frames.size() + 1) / 2);
+    auto         end_iter    = victim.free_frames.begin();
+    advance(end_iter, steal_count);
+    stolen_frames.splice(stolen_frames.end(), victim.free_frames, victim.free_frames.begin(), end_iter);
   }
-  return frame;
+
+  const int stolen_count = static_cast<int>(stolen_frames.size());
+  if (stolen_count > 0) {
+    Partition &home = *partitions_[home_index];
+
+    lock_guard<mutex> lock_guard(home.lock);
+    home.free_frames.splice(home.free_frames.end(), stolen_frames);
+  }
+  return stolen_count;
 }
 
 RC BPFrameManager::free(int buffer_pool_id, PageNum page_num, Frame *frame)
 {
-  FrameId frame_id(buffer_pool_id, page_num);
+  FrameId    frame_id(buffer_pool_id, page_num);
+  Partition &partition = *partitions_[partition_index(frame_id)];
 
-  lock_guard<mutex> lock_guard(lock_);
-  return free_internal(frame_id, frame);
+  lock_guard<mutex> lock_guard(partition.lock);
+  return free_internal(partition, frame_id, frame, false /*evicted*/);
 }
 
-RC BPFrameManager::free_internal(const FrameId &frame_id, Frame *frame)
+RC BPFrameManager::free_internal(Partition &partition, const FrameId &frame_id, Frame *frame, bool evicted)
 {
-  Frame                *frame_source = nullptr;
-  [[maybe_unused]] bool found        = frames_.get(frame_id, frame_source);
+  auto                   iter         = partition.frames.find(frame_id);
+  [[maybe_unused]] bool  found        = iter != partition.frames.end();
+  [[maybe_unused]] Frame *frame_source = found ? iter->second : nullptr;
   ASSERT(found && frame == frame_source && frame->pin_count() == 1,
       "failed to free frame. found=%d, frameId=%s, frame_source=%p, frame=%p, pinCount=%d, lbt=%s",
       found, frame_id.to_string().c_str(), frame_source, frame, frame->pin_count(), lbt());
+  if (!found) {
+    return RC::INTERNAL;
+  }
 
+  partition.replacer->remove(frame, evicted);
   frame->set_page_num(-1);
   frame->unpin();
-  frames_.remove(frame_id);
-  allocator_.free(frame);
+  partition.frames.erase(iter);
+  frame->reset();
+  partition.free_frames.push_back(frame);
   return RC::SUCCESS;
 }
 
 list<Frame *> BPFrameManager::find_list(int buffer_pool_id)
 {
-  lock_guard<mutex> lock_guard(lock_);
-
   list<Frame *> frames;
-  auto               fetcher = [&frames, buffer_pool_id](const FrameId &frame_id, Frame *const frame) -> bool {
-    if (buffer_pool_id == frame_id.buffer_pool_id()) {
-      frame->pin();
-      frames.push_back(frame);
+  for (unique_ptr<Partition> &partition : partitions_) {
+    lock_guard<mutex> lock_guard(partition->lock);
+    for (auto &[frame_id, frame] : partition->frames) {
+      if (buffer_pool_id == frame_id.buffer_pool_id()) {
+        frame->pin();
+        frames.push_back(frame);
+      }
     }
-    return true;
-  };
-  frames_.foreach (fetcher);
+  }
   return frames;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 BufferPoolIterator::BufferPoolIterator() {}
 BufferPoolIterator::~BufferPoolIterator() {}
-RC BufferPoolIterator::init(DiskBufferPool &bp, PageNum start_page /* = 0 */)
+RC BufferPoolIterator::init(DiskBufferPool &bp, PageNum start_page /* = 0 */, PageNum end_page /* = max */)
 {
-  bitmap_.init(bp.file_header_->bitmap, bp.file_header_->page_count);
+  buffer_pool_  = &bp;
+  end_page_num_ = end_page;
   if (start_page <= 0) {
     current_page_num_ = -1;
   } else {
     current_page_num_ = start_page - 1;
   }
+  next_page_num_ = BP_INVALID_PAGE_NUM;
+
+  sequential_count_  = 0;
+  read_ahead_marker_ = -1;
+  read_ahead_end_    = -1;
   return RC::SUCCESS;
 }
 
-bool BufferPoolIterator::has_next() { return bitmap_.next_setted_bit(current_page_num_ + 1) != -1; }
+bool BufferPoolIterator::has_next()
+{
+  next_page_num_ = buffer_pool_->next_allocated_page(current_page_num_ + 1);
+  if (next_page_num_ >= end_page_num_) {
+    next_page_num_ = BP_INVALID_PAGE_NUM;
+  }
+  return next_page_num_ != BP_INVALID_PAGE_NUM;
+}
 
 PageNum BufferPoolIterator::next()
 {
-  PageNum next_page = bitmap_.next_setted_bit(current_page_num_ + 1);
-  if (next_page != -1) {
+  PageNum next_page = next_page_num_;
+  if (next_page <= current_page_num_) {
+    next_page = buffer_pool_->next_allocated_page(current_page_num_ + 1);
+  }
+  if (next_page >= end_page_num_) {
+    next_page = BP_INVALID_PAGE_NUM;
+  }
+  if (next_page != BP_INVALID_PAGE_NUM) {
     current_page_num_ = next_page;
+    try_read_ahead();
   }
   return next_page;
 }
 
 RC BufferPoolIterator::reset()
 {
-  current_page_num_ = 0;
+  current_page_num_  = 0;
+  next_page_num_     = BP_INVALID_PAGE_NUM;
+  sequential_count_  = 0;
+  read_ahead_marker_ = -1;
+  read_ahead_end_    = -1;
   return RC::SUCCESS;
 }
 
+void BufferPoolIterator::try_read_ahead()
+{
+  const int window = buffer_pool_->bp_manager_.read_ahead_window();
+  if (window <= 0) {
+    return;
+  }
+
+  if (++sequential_count_ < READ_AHEAD_TRIGGER || current_page_num_ < read_ahead_marker_) {
+    return;
+  }
+
+  vector<PageNum> page_nums;
+  page_nums.reserve(window);
+  for (PageNum page_num = max(current_page_num_, read_ahead_end_); static_cast<int>(page_nums.size()) < window;) {
+    page_num = buffer_pool_->next_allocated_page(page_num + 1);
+    if (page_num == BP_INVALID_PAGE_NUM || page_num >= end_page_num_) {
+      break;
+    }
+    page_nums.push_back(page_num);
+  }
+
+  if (page_nums.empty()) {
+    // 已经预读到文件末尾了
+    read_ahead_marker_ = numeric_limits<PageNum>::max();
+    return;
+  }
+
+  read_ahead_marker_ = page_nums.front();
+  read_ahead_end_    = page_nums.back();
+  buffer_pool_->read_ahead(std::move(page_nums));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PageMorselQueue::PageMorselQueue(int morsel_pages /* = DEFAULT_MORSEL_PAGES */)
+    : morsel_pages_(max(morsel_pages, 1))
+{}
+
+void PageMorselQueue::init(DiskBufferPool &bp)
+{
+  if (inited_.load()) {
+    return;
+  }
+
+  lock_guard<mutex> guard(init_lock_);
+  if (!inited_.load()) {
+    end_page_.store(bp.page_count());
+    inited_.store(true);
+  }
+}
+
+bool PageMorselQueue::next(PageNum &begin, PageNum &end)
+{
+  const PageNum end_page = end_page_.load();
+  if (next_page_.load() >= end_page) {
+    return false;
+  }
+
+  begin = next_page_.fetch_add(morsel_pages_);
+  if (begin >= end_page) {
+    return false;
+  }
+  end = min(begin + morsel_pages_, end_page);
+  return true;
+}
+
+void PageMorselQueue::reset()
+{
+  lock_guard<mutex> guard(init_lock_);
+  next_page_.store(1);
+  end_page_.store(0);
+  inited_.store(false);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 DiskBufferPool::DiskBufferPool(
     BufferPoolManager &bp_manager, BPFrameManager &frame_manager, DoubleWriteBuffer &dblwr_manager, LogHandler &log_handler)
@@ -226,29 +581,47 @@ DiskBufferPool::~DiskBufferPool()
 
 RC DiskBufferPool::open_file(const char *file_name)
 {
-  int fd = open(file_name, O_RDWR);
+  int fd = -1;
+  if (bp_manager_.direct_io()) {
+    fd = open(file_name, O_RDWR | O_DIRECT);
+    if (fd < 0 && errno == EINVAL) {
+      LOG_WARN("file system does not support O_DIRECT, use buffered io instead. file=%s", file_name);
+    }
+  }
+  direct_io_ = fd >= 0;
+  if (fd < 0) {
+    fd = open(file_name, O_RDWR);
+  }
   if (fd < 0) {
     LOG_ERROR("Failed to open file %s, because %s.", file_name, strerror(errno));
     return RC::IOERR_ACCESS;
   }
-  LOG_INFO("Successfully open buffer pool file %s.", file_name);
+  LOG_INFO("Successfully open buffer pool file %s. direct io=%d", file_name, direct_io_);
 
   file_name_ = file_name;
   file_desc_ = fd;
+  metrics_.register_metrics(file_name_);
 
-  Page header_page;
-  int ret = readn(file_desc_, &header_page, sizeof(header_page));
-  if (ret != 0) {
-    LOG_ERROR("Failed to read first page of %s, due to %s.", file_name, strerror(errno));
+  struct stat st;
+  file_size_.store(fstat(fd, &st) == 0 ? st.st_size : 0);
+  punch_hole_.store(true);
+
+  AlignedBuffer header_page;
+  RC            rc = header_page.init(sizeof(Page));
+  if (OB_SUCC(rc)) {
+    rc = bp_manager_.io_backend().read(file_desc_, 0, header_page.data(), sizeof(Page));
+  }
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to read first page of %s. rc=%s", file_name, strrc(rc));
     close(fd);
     file_desc_ = -1;
-    return RC::IOERR_READ;
+    return rc;
   }
 
-  BPFileHeader *tmp_file_header = reinterpret_cast<BPFileHeader *>(header_page.data);
+  BPFileHeader *tmp_file_header = reinterpret_cast<BPFileHeader *>(header_page.pages()->data);
   buffer_pool_id_ = tmp_file_header->buffer_pool_id;
 
-  RC rc = allocate_frame(BP_HEADER_PAGE, &hdr_frame_);
+  rc = allocate_frame(BP_HEADER_PAGE, &hdr_frame_);
   if (rc != RC::SUCCESS) {
     LOG_ERROR("failed to allocate frame for header. file name %s", file_name_.c_str());
     close(fd);
@@ -269,6 +642,14 @@ RC DiskBufferPool::open_file(const char *file_name)
 
   file_header_ = (BPFileHeader *)hdr_frame_->data();
 
+  free_groups_.clear();
+  if (file_header_->allocated_pages < file_header_->page_count) {
+    for (PageNum group_start = 0; group_start < file_header_->page_count;
+         group_start += BPFileHeader::PAGES_PER_SPACE_MAP) {
+      free_groups_.emplace(group_start / BPFileHeader::PAGES_PER_SPACE_MAP, group_start);
+    }
+  }
+
   LOG_INFO("Successfully open %s. file_desc=%d, hdr_frame=%p, file header=%s",
            file_name, file_desc_, hdr_frame_, file_header_->to_string().c_str());
   return RC::SUCCESS;
@@ -281,6 +662,12 @@ RC DiskBufferPool::close_file()
     return rc;
   }
 
+  // 预读会把页面放到当前文件的页帧中
+  wait_read_ahead();
+
+  // 后台线程可能pin住了当前文件的页帧，等它们访问结束再关闭文件
+  unique_lock<common::SharedMutex> file_guard(bp_manager_.file_lifetime_lock());
+
   hdr_frame_->unpin();
 
   // TODO: 理论上是在回放时回滚未提交事务，但目前没有undo log，因此不下刷数据page，只通过redo log回放
@@ -297,6 +684,7 @@ RC DiskBufferPool::close_file()
   }
 
   disposed_pages_.clear();
+  free_groups_.clear();
 
   if (close(file_desc_) < 0) {
     LOG_ERROR("Failed to close fileId:%d, fileName:%s, error:%s", file_desc_, file_name_.c_str(), strerror(errno));
@@ -305,6 +693,7 @@ RC DiskBufferPool::close_file()
   LOG_INFO("Successfully close file %d:%s.", file_desc_, file_name_.c_str());
   file_desc_ = -1;
 
+  metrics_.unregister_metrics();
   bp_manager_.close_file(file_name_.c_str());
   return RC::SUCCESS;
 }
@@ -318,11 +707,24 @@ RC DiskBufferPool::get_this_page(PageNum page_num, Frame **frame)
   if (used_match_frame != nullptr) {
     used_match_frame->access();
     *frame = used_match_frame;
+    metrics_.on_hit();
     return RC::SUCCESS;
   }
 
   scoped_lock lock_guard(lock_);  // 直接加了一把大锁，其实可以根据访问的页面来细化提高并行度
 
+  // 等锁的时候其它线程可能已经加载了这个页面，不需要再从磁盘读取。上面已经统计过一次，这里不再统计
+  used_match_frame = frame_manager_.get_without_stat(id(), page_num);
+  if (used_match_frame != nullptr) {
+    used_match_frame->access();
+    *frame = used_match_frame;
+    metrics_.on_hit();
+    return RC::SUCCESS;
+  }
+
+  // 只有真正从磁盘读取页面时才算未命中
+  metrics_.on_miss();
+
   // Allocate one page and load the data into this page
   Frame *allocated_frame = nullptr;
 
@@ -352,39 +754,68 @@ RC DiskBufferPool::allocate_page(Frame **frame)
 
   lock_.lock();
 
-  int byte = 0, bit = 0;
-  if ((file_header_->allocated_pages) < (file_header_->page_count)) {
-    // There is one free page
-    for (int i = 0; i < file_header_->page_count; i++) {
-      byte = i / 8;
-      bit  = i % 8;
-      if (((file_header_->bitmap[byte]) & (1 << bit)) == 0) {
-        (file_header_->allocated_pages)++;
-        file_header_->bitmap[byte] |= (1 << bit);
-        // TODO,  do we need clean the loaded page's data?
-        hdr_frame_->mark_dirty();
-        LSN lsn = 0;
-        rc = log_handler_.allocate_page(i, lsn);
-        if (OB_FAIL(rc)) {
-          LOG_ERROR("Failed to log allocate page %d, rc=%s", i, strrc(rc));
-          // 忽略了错误
-        }
-
-        hdr_frame_->set_lsn(lsn);
-
+  // There may be some free pages. 只查找可能有空闲页面的组，发现组满了就不再查找它
+  while (file_header_->allocated_pages < file_header_->page_count && !free_groups_.empty()) {
+    auto          iter        = free_groups_.begin();
+    const int32_t group       = iter->first;
+    const PageNum group_start = group * BPFileHeader::PAGES_PER_SPACE_MAP;
+
+    Frame *map_frame = nullptr;
+    char  *bitmap    = file_header_->bitmap;
+    if (group > 0) {
+      if (OB_FAIL(rc = get_space_map_frame(group_start, map_frame))) {
+        LOG_WARN("failed to get space map page. file=%s, group=%d, rc=%s", file_name_.c_str(), group, strrc(rc));
         lock_.unlock();
-        return get_this_page(i, frame);
+        return rc;
       }
+      bitmap = map_frame->data();
+    }
+
+    const int bit_count = min(BPFileHeader::PAGES_PER_SPACE_MAP, file_header_->page_count - group_start);
+    const int index     = Bitmap(bitmap, bit_count).next_unsetted_bit(iter->second - group_start);
+    if (map_frame != nullptr) {
+      map_frame->unpin();
+    }
+
+    if (index == -1) {
+      free_groups_.erase(iter);
+      continue;
+    }
+
+    const PageNum page_num = group_start + index;
+    iter->second           = page_num + 1;
+
+    // TODO,  do we need clean the loaded page's data?
+    LSN lsn = 0;
+    rc      = log_handler_.allocate_page(page_num, lsn);
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("Failed to log allocate page %d, rc=%s", page_num, strrc(rc));
+      // 忽略了错误
+    }
+
+    rc = set_page_allocated(page_num, true, lsn);
+    lock_.unlock();
+    if (OB_FAIL(rc)) {
+      return rc;
     }
+    return get_this_page(page_num, frame);
   }
 
-  if (file_header_->page_count >= BPFileHeader::MAX_PAGE_NUM) {
+  if (file_header_->page_count >= BPFileHeader::MAX_PAGE_NUM - 1) {
     LOG_WARN("file buffer pool is full. page count %d, max page count %d",
         file_header_->page_count, BPFileHeader::MAX_PAGE_NUM);
     lock_.unlock();
     return RC::BUFFERPOOL_NOBUF;
   }
 
+  // 新的一组页面，第一个页面用作位图
+  if (BPFileHeader::is_space_map_page(file_header_->page_count)) {
+    if (OB_FAIL(rc = extend_space_map())) {
+      lock_.unlock();
+      return rc;
+    }
+  }
+
   LSN lsn = 0;
   rc = log_handler_.allocate_page(file_header_->page_count, lsn);
   if (OB_FAIL(rc)) {
@@ -404,21 +835,24 @@ RC DiskBufferPool::allocate_page(Frame **frame)
   LOG_INFO("allocate new page. file=%s, pageNum=%d, pin=%d",
            file_name_.c_str(), page_num, allocated_frame->pin_count());
 
-  file_header_->allocated_pages++;
   file_header_->page_count++;
-
-  byte = page_num / 8;
-  bit  = page_num % 8;
-  file_header_->bitmap[byte] |= (1 << bit);
-  hdr_frame_->mark_dirty();
+  if (OB_FAIL(rc = set_page_allocated(page_num, true, lsn))) {
+    LOG_ERROR("Failed to set page allocated. file=%s, page num=%d, rc=%s", file_name_.c_str(), page_num, strrc(rc));
+    file_header_->page_count--;
+    frame_manager_.free(id(), page_num, allocated_frame);
+    lock_.unlock();
+    return rc;
+  }
 
   allocated_frame->set_buffer_pool_id(id());
   allocated_frame->access();
   allocated_frame->clear_page();
-  allocated_frame->set_page_num(file_header_->page_count - 1);
+  allocated_frame->set_page_num(page_num);
 
-  // Use flush operation to extension file
-  if ((rc = flush_page_internal(*allocated_frame)) != RC::SUCCESS) {
+  // 直接写数据文件来扩展文件，不经过 double write buffer。全零的新页面不怕只写了一半，
+  // 而 double write buffer 要攒够一批才写回，如果文件头先写回了，崩溃恢复时会读不到这个页面
+  allocated_frame->set_check_sum(crc32(allocated_frame->data(), BP_PAGE_DATA_SIZE));
+  if ((rc = write_page(page_num, allocated_frame->page())) != RC::SUCCESS) {
     LOG_WARN("Failed to alloc page %s , due to failed to extend one page.", file_name_.c_str());
     // skip return false, delay flush the extended page
     // return tmp;
@@ -432,11 +866,15 @@ RC DiskBufferPool::allocate_page(Frame **frame)
 
 RC DiskBufferPool::dispose_page(PageNum page_num)
 {
-  if (page_num == 0) {
-    LOG_ERROR("Failed to dispose page %d, because it is the first page. filename=%s", page_num, file_name_.c_str());
+  if (page_num == 0 || BPFileHeader::is_space_map_page(page_num)) {
+    LOG_ERROR("Failed to dispose page %d, because it is the header or a space map page. filename=%s",
+              page_num, file_name_.c_str());
     return RC::INTERNAL;
   }
   
+  // 后台线程pin住页帧时不能释放它
+  unique_lock<common::SharedMutex> file_guard(bp_manager_.file_lifetime_lock());
+
   scoped_lock lock_guard(lock_);
   Frame           *used_frame = frame_manager_.get(id(), page_num);
   if (used_frame != nullptr) {
@@ -453,12 +891,7 @@ RC DiskBufferPool::dispose_page(PageNum page_num)
     // ignore error handle
   }
 
-  hdr_frame_->set_lsn(lsn);
-  hdr_frame_->mark_dirty();
-  file_header_->allocated_pages--;
-  char tmp = 1 << (page_num % 8);
-  file_header_->bitmap[page_num / 8] &= ~tmp;
-  return RC::SUCCESS;
+  return set_page_allocated(page_num, false, lsn);
 }
 
 RC DiskBufferPool::unpin_page(Frame *frame)
@@ -550,14 +983,17 @@ RC DiskBufferPool::flush_page_internal(Frame &frame)
     // ignore error handle
   }
 
-  frame.set_check_sum(crc32(frame.page().data, BP_PAGE_DATA_SIZE));
+  // 在副本上计算校验和，不修改页帧。后台刷脏时只持有页帧的读锁，其它线程可能同时在读这个页面
+  Page page = frame.page();
+  page.check_sum = crc32(page.data, BP_PAGE_DATA_SIZE);
 
-  rc = dblwr_manager_.add_page(this, frame.page_num(), frame.page());
+  rc = dblwr_manager_.add_page(this, frame.page_num(), page);
   if (OB_FAIL(rc)) {
     return rc;
   }
 
   frame.clear_dirty();
+  metrics_.on_flush();
   // LOG_DEBUG("Flush block. file desc=%d, frame=%s", file_desc_, frame.to_string().c_str());
 
   return RC::SUCCESS;
@@ -579,116 +1015,378 @@ RC DiskBufferPool::flush_all_pages()
 
 RC DiskBufferPool::recover_page(PageNum page_num)
 {
-  int byte = 0, bit = 0;
-  byte = page_num / 8;
-  bit  = page_num % 8;
-
   scoped_lock lock_guard(lock_);
-  if (!(file_header_->bitmap[byte] & (1 << bit))) {
-    file_header_->bitmap[byte] |= (1 << bit);
-    file_header_->allocated_pages++;
-    file_header_->page_count++;
-    hdr_frame_->mark_dirty();
+  if (is_page_allocated(page_num)) {
+    return RC::SUCCESS;
   }
-  return RC::SUCCESS;
+
+  if (page_num >= file_header_->page_count) {
+    file_header_->page_count = page_num + 1;
+  }
+  return set_page_allocated(page_num, true, 0 /*lsn*/);
+}
+
+PageNum DiskBufferPool::next_allocated_page(PageNum start_page)
+{
+  const PageNum page_count = file_header_->page_count;
+  for (PageNum page_num = max(start_page, 0); page_num < page_count;) {
+    const int32_t group       = page_num / BPFileHeader::PAGES_PER_SPACE_MAP;
+    const PageNum group_start = group * BPFileHeader::PAGES_PER_SPACE_MAP;
+
+    Frame *map_frame = nullptr;
+    char  *bitmap    = file_header_->bitmap;
+    if (group > 0) {
+      RC rc = get_this_page(group_start, &map_frame);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to get space map page. file=%s, page num=%d, rc=%s", file_name_.c_str(), group_start, strrc(rc));
+        return BP_INVALID_PAGE_NUM;
+      }
+      bitmap = map_frame->data();
+    }
+
+    // 位图页面自己不是数据页面，跳过
+    const int bit_count = min(BPFileHeader::PAGES_PER_SPACE_MAP, page_count - group_start);
+    const int start_bit = group > 0 ? max(page_num - group_start, 1) : page_num - group_start;
+    const int index     = Bitmap(bitmap, bit_count).next_setted_bit(start_bit);
+    if (map_frame != nullptr) {
+      map_frame->unpin();
+    }
+
+    if (index != -1) {
+      return group_start + index;
+    }
+    page_num = group_start + BPFileHeader::PAGES_PER_SPACE_MAP;
+  }
+  return BP_INVALID_PAGE_NUM;
 }
 
 RC DiskBufferPool::write_page(PageNum page_num, Page &page)
 {
-  scoped_lock lock_guard(wr_lock_);
-  int64_t     offset = ((int64_t)page_num) * sizeof(Page);
-  if (lseek(file_desc_, offset, SEEK_SET) == -1) {
-    LOG_ERROR("Failed to write page %lld of %d due to failed to seek %s.", offset, file_desc_, strerror(errno));
-    return RC::IOERR_SEEK;
+  RC rc = write_pages({{page_num, &page}});
+  if (OB_SUCC(rc)) {
+    LOG_TRACE("write_page: buffer_pool_id:%d, page_num:%d, lsn=%d, check_sum=%d", id(), page_num, page.lsn, page.check_sum);
   }
+  return rc;
+}
 
-  if (writen(file_desc_, &page, sizeof(Page)) != 0) {
-    LOG_ERROR("Failed to write page %lld of %d due to %s.", offset, file_desc_, strerror(errno));
-    return RC::IOERR_WRITE;
+RC DiskBufferPool::write_pages(const vector<pair<PageNum, Page *>> &pages)
+{
+  // 直接IO要求内存对齐，页帧中的页面是对齐的，double write buffer 中的页面不一定，需要先复制一份
+  size_t unaligned_count = 0;
+  if (direct_io_) {
+    for (const auto &[page_num, page] : pages) {
+      unaligned_count += reinterpret_cast<uintptr_t>(page) % BP_IO_ALIGN != 0 ? 1 : 0;
+    }
+  }
+
+  AlignedBuffer bounce_pages;
+  if (unaligned_count > 0) {
+    RC rc = bounce_pages.init(unaligned_count * sizeof(Page));
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
+  // 压缩后的页面，按照 BP_IO_ALIGN 对齐，直接IO也可以使用
+  const bool    compression = page_compression();
+  AlignedBuffer compressed_pages;
+  if (compression) {
+    RC rc = compressed_pages.init(pages.size() * sizeof(Page));
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
   }
 
-  LOG_TRACE("write_page: buffer_pool_id:%d, page_num:%d, lsn=%d, check_sum=%d", id(), page_num, page.lsn, page.check_sum);
+  vector<IoRequest> requests;
+  requests.reserve(pages.size());
+  size_t  bounce_index = 0;
+  int64_t max_end      = 0;
+  for (size_t i = 0; i < pages.size(); i++) {
+    const auto &[page_num, page] = pages[i];
+
+    IoRequest &request = requests.emplace_back();
+    request.fd         = file_desc_;
+    request.offset     = ((int64_t)page_num) * sizeof(Page);
+    request.buffer     = page;
+    request.size       = sizeof(Page);
+    max_end            = max(max_end, request.offset + static_cast<int64_t>(sizeof(Page)));
+
+    if (compression && page_num != BP_HEADER_PAGE) {
+      Page *buffer = &compressed_pages.pages()[i];
+      int   size   = PageCompressor::compress(*page, reinterpret_cast<char *>(buffer));
+      if (size > 0 && OB_SUCC(extend_file(request.offset, sizeof(Page)))) {
+        request.buffer = buffer;
+        request.size   = size;
+        continue;
+      }
+    }
+
+    if (unaligned_count > 0 && reinterpret_cast<uintptr_t>(page) % BP_IO_ALIGN != 0) {
+      Page *buffer = &bounce_pages.pages()[bounce_index++];
+      memcpy(buffer, page, sizeof(Page));
+      request.buffer = buffer;
+    }
+  }
+
+  int64_t write_bytes = 0;
+  for (const IoRequest &request : requests) {
+    write_bytes += request.size;
+  }
+
+  const auto start_time = chrono::steady_clock::now();
+  write_version_.fetch_add(1);
+  RC rc = bp_manager_.io_backend().write_batch(requests);
+  write_version_.fetch_add(1);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to write pages of %s. page count=%d, rc=%s", file_name_.c_str(), static_cast<int>(pages.size()), strrc(rc));
+    return rc;
+  }
+  metrics_.on_write(static_cast<int>(pages.size()), write_bytes, start_time);
+
+  int64_t file_size = file_size_.load();
+  while (file_size < max_end && !file_size_.compare_exchange_weak(file_size, max_end)) {
+  }
+
+  for (const IoRequest &request : requests) {
+    if (request.size < static_cast<int>(sizeof(Page))) {
+      punch_hole(request.offset + request.size, sizeof(Page) - request.size);
+    }
+  }
+
+  LOG_TRACE("write_pages: buffer_pool_id:%d, page count:%d", id(), static_cast<int>(pages.size()));
   return RC::SUCCESS;
 }
 
 RC DiskBufferPool::redo_allocate_page(LSN lsn, PageNum page_num)
 {
-  if (hdr_frame_->lsn() >= lsn) {
-    return RC::SUCCESS;
+  // scoped_lock lock_guard(lock_); // redo 过程中可以不加锁
+  // 文件头和位图页面是分别写回的，需要分别根据它们的LSN判断是否需要重做
+  if (hdr_frame_->lsn() < lsn && page_num >= file_header_->page_count) {
+    if (page_num > file_header_->page_count) {
+      LOG_WARN("page %d is not continuous. file=%s, page_count=%d",
+               page_num, file_name_.c_str(), file_header_->page_count);
+      return RC::INTERNAL;
+    }
+
+    // page_num == file_header_->page_count
+    if (file_header_->page_count >= BPFileHeader::MAX_PAGE_NUM - 1) {
+      LOG_WARN("file buffer pool is full. page count %d, max page count %d",
+          file_header_->page_count, BPFileHeader::MAX_PAGE_NUM);
+      return RC::INTERNAL;
+    }
+
+    // TODO 应该检查文件是否足够大，包含了当前新分配的页面
+    file_header_->page_count++;
   }
 
-  // scoped_lock lock_guard(lock_); // redo 过程中可以不加锁
-  if (page_num < file_header_->page_count) {
-    Bitmap bitmap(file_header_->bitmap, file_header_->page_count);
-    if (bitmap.get_bit(page_num)) {
-      LOG_WARN("page %d has been allocated. file=%s", page_num, file_name_.c_str());
-      return RC::SUCCESS;
+  if (BPFileHeader::is_space_map_page(page_num)) {
+    // 位图页面可能还没有写到磁盘上，这时在内存中重新创建
+    Frame *map_frame = nullptr;
+    if (OB_FAIL(get_space_map_frame(page_num, map_frame))) {
+      RC rc = get_space_map_frame(page_num, map_frame, true /*create*/);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to create space map page. file=%s, page num=%d, rc=%s", file_name_.c_str(), page_num, strrc(rc));
+        return rc;
+      }
+    } else if (map_frame->lsn() < lsn) {
+      memset(map_frame->data(), 0, BP_PAGE_DATA_SIZE);
+      Bitmap(map_frame->data(), BPFileHeader::PAGES_PER_SPACE_MAP).set_bit(0);
     }
 
-    bitmap.set_bit(page_num);
-    file_header_->allocated_pages++;
-    hdr_frame_->mark_dirty();
+    if (map_frame->lsn() < lsn) {
+      map_frame->set_lsn(lsn);
+      map_frame->mark_dirty();
+    }
+    map_frame->unpin();
+
+    if (hdr_frame_->lsn() < lsn) {
+      file_header_->allocated_pages++;
+      hdr_frame_->set_lsn(lsn);
+      hdr_frame_->mark_dirty();
+    }
+    LOG_TRACE("[redo] allocate space map page. file=%s, pageNum=%d", file_name_.c_str(), page_num);
     return RC::SUCCESS;
   }
 
-  if (page_num > file_header_->page_count) {
-    LOG_WARN("page %d is not continuous. file=%s, page_count=%d",
-             page_num, file_name_.c_str(), file_header_->page_count);
+  RC rc = set_page_allocated(page_num, true, lsn, true /*redo*/);
+  LOG_TRACE("[redo] allocate page. file=%s, pageNum=%d, rc=%s", file_name_.c_str(), page_num, strrc(rc));
+  return rc;
+}
+
+RC DiskBufferPool::redo_deallocate_page(LSN lsn, PageNum page_num)
+{
+  if (hdr_frame_->lsn() < lsn && page_num >= file_header_->page_count) {
+    LOG_WARN("page %d is not exist. file=%s", page_num, file_name_.c_str());
     return RC::INTERNAL;
   }
 
-  // page_num == file_header_->page_count
-  if (file_header_->page_count >= BPFileHeader::MAX_PAGE_NUM) {
-    LOG_WARN("file buffer pool is full. page count %d, max page count %d",
-        file_header_->page_count, BPFileHeader::MAX_PAGE_NUM);
-    return RC::INTERNAL;
+  RC rc = set_page_allocated(page_num, false, lsn, true /*redo*/);
+  LOG_TRACE("[redo] deallocate page. file=%s, pageNum=%d, rc=%s", file_name_.c_str(), page_num, strrc(rc));
+  return rc;
+}
+
+RC DiskBufferPool::get_space_map_frame(PageNum page_num, Frame *&frame, bool create /* = false */)
+{
+  const PageNum map_page_num = page_num / BPFileHeader::PAGES_PER_SPACE_MAP * BPFileHeader::PAGES_PER_SPACE_MAP;
+  ASSERT(map_page_num > 0, "the space map of the first group is in the file header. page num=%d", page_num);
+
+  if (!create) {
+    frame = frame_manager_.get(id(), map_page_num);
+    if (frame != nullptr) {
+      frame->access();
+      return RC::SUCCESS;
+    }
   }
 
-  file_header_->allocated_pages++;
-  file_header_->page_count++;
-  hdr_frame_->set_lsn(lsn);
-  hdr_frame_->mark_dirty();
-  
-  // TODO 应该检查文件是否足够大，包含了当前新分配的页面
+  RC rc = allocate_frame(map_page_num, &frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to allocate frame for space map page. file=%s, page num=%d, rc=%s",
+             file_name_.c_str(), map_page_num, strrc(rc));
+    return rc;
+  }
 
-  Bitmap bitmap(file_header_->bitmap, file_header_->page_count);
-  bitmap.set_bit(page_num);
-  LOG_TRACE("[redo] allocate new page. file=%s, pageNum=%d", file_name_.c_str(), page_num);
+  frame->set_buffer_pool_id(id());
+  frame->access();
+
+  if (!create) {
+    if (OB_FAIL(rc = load_page(map_page_num, frame))) {
+      purge_frame(map_page_num, frame);
+      frame = nullptr;
+    }
+    return rc;
+  }
+
+  frame->clear_page();
+  frame->set_page_num(map_page_num);
+  Bitmap(frame->data(), BPFileHeader::PAGES_PER_SPACE_MAP).set_bit(0);
   return RC::SUCCESS;
 }
 
-RC DiskBufferPool::redo_deallocate_page(LSN lsn, PageNum page_num)
+RC DiskBufferPool::set_page_allocated(PageNum page_num, bool allocated, LSN lsn, bool redo /* = false */)
 {
-  if (hdr_frame_->lsn() >= lsn) {
-    return RC::SUCCESS;
+  const int32_t group        = page_num / BPFileHeader::PAGES_PER_SPACE_MAP;
+  const int     index        = page_num % BPFileHeader::PAGES_PER_SPACE_MAP;
+  const bool    apply_header = !redo || hdr_frame_->lsn() < lsn;
+
+  Frame *map_frame = nullptr;
+  if (group > 0) {
+    RC rc = get_space_map_frame(page_num, map_frame);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
   }
 
-  if (page_num >= file_header_->page_count) {
-    LOG_WARN("page %d is not exist. file=%s", page_num, file_name_.c_str());
-    return RC::INTERNAL;
+  // 第0组的位图在文件头中，跟随文件头的LSN
+  Frame *bitmap_frame = map_frame != nullptr ? map_frame : hdr_frame_;
+  char  *bitmap_data  = map_frame != nullptr ? map_frame->data() : file_header_->bitmap;
+  if (!redo || bitmap_frame->lsn() < lsn) {
+    Bitmap bitmap(bitmap_data, BPFileHeader::PAGES_PER_SPACE_MAP);
+    if (bitmap.get_bit(index) == allocated) {
+      LOG_WARN("page %d has been %s. file=%s", page_num, allocated ? "allocated" : "deallocated", file_name_.c_str());
+      if (map_frame != nullptr) {
+        map_frame->unpin();
+      }
+      return allocated ? RC::SUCCESS : RC::INTERNAL;
+    }
+
+    if (allocated) {
+      bitmap.set_bit(index);
+    } else {
+      bitmap.clear_bit(index);
+    }
+
+    if (map_frame != nullptr) {
+      map_frame->set_lsn(max(map_frame->lsn(), lsn));
+      map_frame->mark_dirty();
+    }
   }
 
-  Bitmap bitmap(file_header_->bitmap, file_header_->page_count);
-  if (!bitmap.get_bit(page_num)) {
-    LOG_WARN("page %d has been deallocated. file=%s", page_num, file_name_.c_str());
-    return RC::INTERNAL;
+  if (map_frame != nullptr) {
+    map_frame->unpin();
+  }
+
+  if (apply_header) {
+    file_header_->allocated_pages += allocated ? 1 : -1;
+    hdr_frame_->set_lsn(max(hdr_frame_->lsn(), lsn));
+    hdr_frame_->mark_dirty();
+  }
+
+  if (!allocated) {
+    auto iter = free_groups_.find(group);
+    if (iter == free_groups_.end()) {
+      free_groups_.emplace(group, page_num);
+    } else {
+      iter->second = min(iter->second, page_num);
+    }
+  }
+  return RC::SUCCESS;
+}
+
+bool DiskBufferPool::is_page_allocated(PageNum page_num)
+{
+  if (page_num < 0 || page_num >= file_header_->page_count) {
+    return false;
+  }
+
+  const int index = page_num % BPFileHeader::PAGES_PER_SPACE_MAP;
+  if (page_num < BPFileHeader::PAGES_PER_SPACE_MAP) {
+    return Bitmap(file_header_->bitmap, BPFileHeader::PAGES_PER_SPACE_MAP).get_bit(index);
   }
 
-  bitmap.clear_bit(page_num);
-  file_header_->allocated_pages--;
+  Frame *map_frame = nullptr;
+  if (OB_FAIL(get_space_map_frame(page_num, map_frame))) {
+    return false;
+  }
+  const bool allocated = Bitmap(map_frame->data(), BPFileHeader::PAGES_PER_SPACE_MAP).get_bit(index);
+  map_frame->unpin();
+  return allocated;
+}
+
+RC DiskBufferPool::extend_space_map()
+{
+  const PageNum page_num = file_header_->page_count;
+
+  LSN lsn = 0;
+  RC  rc  = log_handler_.allocate_page(page_num, lsn);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to log allocate space map page %d, rc=%s", page_num, strrc(rc));
+    // 忽略了错误
+  }
+
+  Frame *map_frame = nullptr;
+  if (OB_FAIL(rc = get_space_map_frame(page_num, map_frame, true /*create*/))) {
+    return rc;
+  }
+
+  // 与新的数据页面一样，直接写数据文件来扩展文件
+  map_frame->set_lsn(lsn);
+  map_frame->set_check_sum(crc32(map_frame->data(), BP_PAGE_DATA_SIZE));
+  if (OB_FAIL(rc = write_page(page_num, map_frame->page()))) {
+    LOG_WARN("Failed to write space map page %s:%d, rc=%s", file_name_.c_str(), page_num, strrc(rc));
+    map_frame->mark_dirty();
+  }
+  map_frame->unpin();
+
+  file_header_->page_count++;
+  file_header_->allocated_pages++;
   hdr_frame_->set_lsn(lsn);
   hdr_frame_->mark_dirty();
-  LOG_TRACE("[redo] deallocate page. file=%s, pageNum=%d", file_name_.c_str(), page_num);
+
+  LOG_INFO("extend space map. file=%s, page num=%d", file_name_.c_str(), page_num);
   return RC::SUCCESS;
 }
 
-RC DiskBufferPool::allocate_frame(PageNum page_num, Frame **buffer)
+RC DiskBufferPool::allocate_frame(PageNum page_num, Frame **buffer, bool blocking /* = true */)
 {
   auto purger = [this](Frame *frame) {
     if (!frame->dirty()) {
+      record_eviction(*frame);
       return RC::SUCCESS;
     }
 
+    // 只能淘汰脏页帧，说明干净的页帧不够了，让后台线程赶紧刷脏
+    bp_manager_.page_cleaner().wakeup();
+
     RC rc = RC::SUCCESS;
     if (frame->buffer_pool_id() == id()) {
       rc = this->flush_page_internal(*frame);
@@ -698,11 +1396,13 @@ RC DiskBufferPool::allocate_frame(PageNum page_num, Frame **buffer)
 
     if (rc != RC::SUCCESS) {
       LOG_ERROR("Failed to aclloc block due to failed to flush old block. rc=%s", strrc(rc));
+    } else {
+      record_eviction(*frame);
     }
     return rc;
   };
 
-  while (true) {
+  for (bool tried = false; ;) {
     Frame *frame = frame_manager_.alloc(id(), page_num);
     if (frame != nullptr) {
       *buffer = frame;
@@ -710,46 +1410,249 @@ RC DiskBufferPool::allocate_frame(PageNum page_num, Frame **buffer)
       return RC::SUCCESS;
     }
 
+    if (!blocking && tried) {
+      break;
+    }
+
     LOG_TRACE("frames are all allocated, so we should purge some frames to get one free frame");
     (void)frame_manager_.purge_frames(1 /*count*/, purger);
+    tried = true;
   }
   return RC::BUFFERPOOL_NOBUF;
 }
 
+void DiskBufferPool::record_eviction(const Frame &frame)
+{
+  if (frame.buffer_pool_id() == id()) {
+    metrics_.on_evict();
+    return;
+  }
+
+  DiskBufferPool *owner = nullptr;
+  if (OB_SUCC(bp_manager_.get_buffer_pool(frame.buffer_pool_id(), owner))) {
+    owner->metrics().on_evict();
+  }
+}
+
+void DiskBufferPool::read_ahead(vector<PageNum> page_nums)
+{
+  if (page_nums.empty()) {
+    return;
+  }
+
+  common::ThreadPoolExecutor *executor = bp_manager_.read_ahead_executor();
+  if (executor == nullptr) {
+    load_pages_ahead(page_nums);
+    return;
+  }
+
+  {
+    lock_guard<mutex> guard(read_ahead_lock_);
+    read_ahead_pending_++;
+  }
+
+  int ret = executor->execute([this, page_nums = std::move(page_nums)]() {
+    load_pages_ahead(page_nums);
+
+    lock_guard<mutex> guard(read_ahead_lock_);
+    read_ahead_pending_--;
+    read_ahead_cv_.notify_all();
+  });
+
+  if (ret != 0) {
+    LOG_WARN("failed to submit read ahead task. file=%s", file_name_.c_str());
+    lock_guard<mutex> guard(read_ahead_lock_);
+    read_ahead_pending_--;
+    read_ahead_cv_.notify_all();
+  }
+}
+
+int DiskBufferPool::preload_pages(const vector<PageNum> &page_nums)
+{
+  if (page_nums.empty()) {
+    return 0;
+  }
+  return load_pages_ahead(page_nums);
+}
+
+void DiskBufferPool::wait_read_ahead()
+{
+  unique_lock<mutex> guard(read_ahead_lock_);
+  read_ahead_cv_.wait(guard, [this]() { return read_ahead_pending_ == 0; });
+}
+
+int DiskBufferPool::load_pages_ahead(const vector<PageNum> &page_nums)
+{
+  vector<PageNum> missing_pages;
+  missing_pages.reserve(page_nums.size());
+  for (PageNum page_num : page_nums) {
+    if (!frame_manager_.contains(id(), page_num)) {
+      missing_pages.push_back(page_num);
+    }
+  }
+
+  if (missing_pages.empty()) {
+    return 0;
+  }
+
+  const int64_t version = write_version_.load();
+
+  // 批量读取，连续的页面会合并成一次读取
+  AlignedBuffer buffer;
+  RC            rc = buffer.init(missing_pages.size() * sizeof(Page));
+  if (OB_FAIL(rc)) {
+    return 0;
+  }
+
+  Page             *pages = buffer.pages();
+  vector<IoRequest> requests(missing_pages.size());
+  for (size_t i = 0; i < missing_pages.size(); i++) {
+    requests[i].fd     = file_desc_;
+    requests[i].offset = ((int64_t)missing_pages[i]) * BP_PAGE_SIZE;
+    requests[i].buffer = &pages[i];
+    requests[i].size   = BP_PAGE_SIZE;
+  }
+
+  const auto start_time = chrono::steady_clock::now();
+  rc = bp_manager_.io_backend().read_batch(requests);
+  metrics_.on_read(static_cast<int>(requests.size()), static_cast<int64_t>(requests.size()) * BP_PAGE_SIZE, start_time);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to read ahead some pages. file=%s, first page=%d, count=%d, rc=%s",
+             file_name_.c_str(), missing_pages.front(), static_cast<int>(missing_pages.size()), strrc(rc));
+  }
+
+  scoped_lock lock_guard(lock_);
+
+  // 读盘期间有页面写回了磁盘，读到的数据可能是旧的，只能使用 double write buffer 中的数据
+  const bool file_changed = write_version_.load() != version;
+  int        loaded_count = 0;
+  for (size_t i = 0; i < missing_pages.size(); i++) {
+    const PageNum page_num = missing_pages[i];
+    if (!is_page_allocated(page_num) || frame_manager_.contains(id(), page_num)) {
+      continue;
+    }
+
+    Frame *frame = nullptr;
+    rc           = allocate_frame(page_num, &frame, false /*blocking*/);
+    if (OB_FAIL(rc)) {
+      LOG_TRACE("no free frame for read ahead. file=%s, page num=%d", file_name_.c_str(), page_num);
+      break;
+    }
+
+    frame->begin_update();
+    rc = dblwr_manager_.read_page(this, page_num, frame->page());
+    if (OB_FAIL(rc)) {
+      if (OB_FAIL(requests[i].rc) || file_changed) {
+        frame->end_update();
+        frame_manager_.free(id(), page_num, frame);
+        continue;
+      }
+      memcpy(&frame->page(), &pages[i], BP_PAGE_SIZE);
+      if (OB_FAIL(decompress_page(page_num, frame->page()))) {
+        frame->end_update();
+        frame_manager_.free(id(), page_num, frame);
+        continue;
+      }
+    }
+    frame->end_update();
+
+    frame->set_buffer_pool_id(id());
+    frame->set_page_num(page_num);
+    frame->access();
+    frame->unpin();
+    loaded_count++;
+  }
+
+  LOG_DEBUG("read ahead pages. file=%s, first page=%d, request=%d, loaded=%d",
+            file_name_.c_str(), page_nums.front(), static_cast<int>(page_nums.size()), loaded_count);
+  return loaded_count;
+}
+
 RC DiskBufferPool::check_page_num(PageNum page_num)
 {
-  if (page_num >= file_header_->page_count) {
+  scoped_lock lock_guard(lock_);
+  if (!is_page_allocated(page_num)) {
     LOG_ERROR("Invalid pageNum:%d, file's name:%s", page_num, file_name_.c_str());
     return RC::BUFFERPOOL_INVALID_PAGE_NUM;
   }
-  if ((file_header_->bitmap[page_num / 8] & (1 << (page_num % 8))) == 0) {
-    LOG_ERROR("Invalid pageNum:%d, file's name:%s", page_num, file_name_.c_str());
-    return RC::BUFFERPOOL_INVALID_PAGE_NUM;
+  return RC::SUCCESS;
+}
+
+RC DiskBufferPool::extend_file(int64_t offset, int64_t length)
+{
+  const int64_t end = offset + length;
+  if (file_size_.load() >= end) {
+    return RC::SUCCESS;
+  }
+
+  // 只分配这个页面的空间，前面没有写过的部分是文件空洞
+  if (fallocate(file_desc_, 0 /*mode*/, offset, length) != 0) {
+    LOG_WARN("failed to extend file. file=%s, offset=%ld, length=%ld, error=%s",
+             file_name_.c_str(), offset, length, strerror(errno));
+    return RC::IOERR_WRITE;
+  }
+
+  int64_t file_size = file_size_.load();
+  while (file_size < end && !file_size_.compare_exchange_weak(file_size, end)) {
   }
   return RC::SUCCESS;
 }
 
+void DiskBufferPool::punch_hole(int64_t offset, int64_t length)
+{
+  if (!punch_hole_.load()) {
+    return;
+  }
+
+  if (fallocate(file_desc_, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, offset, length) != 0) {
+    if (errno == EOPNOTSUPP || errno == ENOSYS) {
+      punch_hole_.store(false);
+      LOG_WARN("file system does not support punch hole, compressed pages will not save disk space. file=%s",
+               file_name_.c_str());
+    } else {
+      LOG_WARN("failed to punch hole. file=%s, offset=%ld, length=%ld, error=%s",
+               file_name_.c_str(), offset, length, strerror(errno));
+    }
+  }
+}
+
+RC DiskBufferPool::decompress_page(PageNum page_num, Page &page)
+{
+  if (!PageCompressor::is_compressed(page)) {
+    return RC::SUCCESS;
+  }
+
+  RC rc = PageCompressor::decompress(page);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("failed to decompress page. file=%s, page num=%d, rc=%s", file_name_.c_str(), page_num, strrc(rc));
+  }
+  return rc;
+}
+
 RC DiskBufferPool::load_page(PageNum page_num, Frame *frame)
 {
+  // 加载页面会覆盖页帧中的内容，与加写锁修改页面一样需要更新版本号，让乐观读能够发现
+  frame->begin_update();
+
   Page &page = frame->page();
   RC rc = dblwr_manager_.read_page(this, page_num, page);
   if (OB_SUCC(rc)) {
+    frame->end_update();
     return rc;
   }
 
-  scoped_lock lock_guard(wr_lock_);
-  int64_t          offset = ((int64_t)page_num) * BP_PAGE_SIZE;
-  if (lseek(file_desc_, offset, SEEK_SET) == -1) {
-    LOG_ERROR("Failed to load page %s:%d, due to failed to lseek:%s.", file_name_.c_str(), page_num, strerror(errno));
-
-    return RC::IOERR_SEEK;
+  int64_t    offset     = ((int64_t)page_num) * BP_PAGE_SIZE;
+  const auto start_time = chrono::steady_clock::now();
+  rc = bp_manager_.io_backend().read(file_desc_, offset, &page, BP_PAGE_SIZE);
+  metrics_.on_read(1, BP_PAGE_SIZE, start_time);
+  if (OB_SUCC(rc)) {
+    rc = decompress_page(page_num, page);
   }
-
-  int ret = readn(file_desc_, &page, BP_PAGE_SIZE);
-  if (ret != 0) {
-    LOG_ERROR("Failed to load page %s, file_desc:%d, page num:%d, due to failed to read data:%s, ret=%d, page count=%d",
-              file_name_.c_str(), file_desc_, page_num, strerror(errno), ret, file_header_->allocated_pages);
-    return RC::IOERR_READ;
+  frame->end_update();
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to load page %s, file_desc:%d, page num:%d, rc=%s, page count=%d",
+              file_name_.c_str(), file_desc_, page_num, strrc(rc), file_header_->allocated_pages);
+    return rc;
   }
 
   frame->set_page_num(page_num);
@@ -762,19 +1665,43 @@ RC DiskBufferPool::load_page(PageNum page_num, Frame *frame)
 int DiskBufferPool::file_desc() const { return file_desc_; }
 
 ////////////////////////////////////////////////////////////////////////////////
-BufferPoolManager::BufferPoolManager(int memory_size /* = 0 */)
+BufferPoolManager::BufferPoolManager(int64_t memory_size /* = 0 */, const char *eviction_policy /* = nullptr */,
+    const FrameArenaOptions &arena_options /* = FrameArenaOptions() */)
 {
+  (void)IoBackend::create(nullptr, io_backend_);
+
   if (memory_size <= 0) {
-    memory_size = MEM_POOL_ITEM_NUM * DEFAULT_ITEM_NUM_PER_POOL * BP_PAGE_SIZE;
+    memory_size = static_cast<int64_t>(MEM_POOL_ITEM_NUM) * DEFAULT_ITEM_NUM_PER_POOL * BP_PAGE_SIZE;
   }
-  const int pool_num = max(memory_size / BP_PAGE_SIZE / DEFAULT_ITEM_NUM_PER_POOL, 1);
-  frame_manager_.init(pool_num);
-  LOG_INFO("buffer pool manager init with memory size %d, page num: %d, pool num: %d",
+  const int64_t pool_size = static_cast<int64_t>(BP_PAGE_SIZE) * DEFAULT_ITEM_NUM_PER_POOL;
+  const int     pool_num  = static_cast<int>(max(memory_size / pool_size, static_cast<int64_t>(1)));
+  RC rc = frame_manager_.init(pool_num, BPFrameManager::DEFAULT_PARTITION_NUM, eviction_policy, arena_options);
+  if (rc == RC::INVALID_ARGUMENT) {
+    LOG_WARN("invalid eviction policy %s, use the default one", eviction_policy);
+    rc = frame_manager_.init(pool_num, BPFrameManager::DEFAULT_PARTITION_NUM, nullptr, arena_options);
+  }
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("failed to init frame manager. rc=%s", strrc(rc));
+  }
+  LOG_INFO("buffer pool manager init with memory size %ld, page num: %d, pool num: %d",
            memory_size, pool_num * DEFAULT_ITEM_NUM_PER_POOL, pool_num);
 }
 
 BufferPoolManager::~BufferPoolManager()
 {
+  warmer_.stop();
+  page_cleaner_.stop();
+
+  if (read_ahead_executor_) {
+    read_ahead_executor_->shutdown();
+    read_ahead_executor_->await_termination();
+    read_ahead_executor_.reset();
+  }
+
+  BPFrameManager::Stat stat = frame_manager_.stat();
+  LOG_INFO("buffer pool manager exit. hit=%lu, miss=%lu, evict=%lu, hit ratio=%.4f",
+           stat.hit_count, stat.miss_count, stat.evict_count, stat.hit_ratio());
+
   unordered_map<string, DiskBufferPool *> tmp_bps;
   tmp_bps.swap(buffer_pools_);
 
@@ -789,6 +1716,44 @@ RC BufferPoolManager::init(unique_ptr<DoubleWriteBuffer> dblwr_buffer)
   return RC::SUCCESS;
 }
 
+RC BufferPoolManager::init_io_backend(const char *name)
+{
+  unique_ptr<IoBackend> backend;
+  RC                    rc = IoBackend::create(name, backend);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to create io backend %s, keep using %s. rc=%s", name, io_backend_->name(), strrc(rc));
+    return rc;
+  }
+
+  io_backend_ = std::move(backend);
+  LOG_INFO("buffer pool use io backend %s", io_backend_->name());
+  return RC::SUCCESS;
+}
+
+RC BufferPoolManager::init_read_ahead(int window_pages)
+{
+  read_ahead_window_ = max(0, min(window_pages, MAX_READ_AHEAD_WINDOW));
+  if (read_ahead_window_ == 0) {
+    LOG_INFO("read ahead is disabled");
+    return RC::SUCCESS;
+  }
+
+#ifdef CONCURRENCY
+  if (!read_ahead_executor_) {
+    auto executor = make_unique<common::ThreadPoolExecutor>();
+    int  ret      = executor->init("ReadAhead", 1, READ_AHEAD_THREAD_NUM, 60 * 1000 /*keep_alive_time_ms*/);
+    if (ret != 0) {
+      LOG_WARN("failed to init read ahead thread pool, read ahead synchronously. ret=%d", ret);
+    } else {
+      read_ahead_executor_ = std::move(executor);
+    }
+  }
+#endif
+
+  LOG_INFO("read ahead window is %d pages, %s", read_ahead_window_, read_ahead_executor_ ? "async" : "sync");
+  return RC::SUCCESS;
+}
+
 RC BufferPoolManager::create_file(const char *file_name)
 {
   int fd = open(file_name, O_RDWR | O_CREAT | O_EXCL, S_IREAD | S_IWRITE);
@@ -891,17 +1856,33 @@ RC BufferPoolManager::flush_page(Frame &frame)
 {
   int buffer_pool_id = frame.buffer_pool_id();
 
-  scoped_lock lock_guard(lock_);
-  auto             iter = id_to_buffer_pools_.find(buffer_pool_id);
-  if (iter == id_to_buffer_pools_.end()) {
-    LOG_WARN("unknown buffer pool of id %d", buffer_pool_id);
-    return RC::INTERNAL;
+  // 刷页面时 double write buffer 可能需要刷一整批页面，会再调用 get_buffer_pool，这里不能一直持有锁。
+  // 调用方持有这个文件的页帧，文件不会在这期间关闭
+  DiskBufferPool *bp = nullptr;
+  RC              rc = get_buffer_pool(buffer_pool_id, bp);
+  if (OB_FAIL(rc)) {
+    return rc;
   }
 
-  DiskBufferPool *bp = iter->second;
   return bp->flush_page(frame);
 }
 
+RC BufferPoolManager::get_buffer_pool(const char *file_name, DiskBufferPool *&bp)
+{
+  bp = nullptr;
+
+  scoped_lock lock_guard(lock_);
+
+  auto iter = buffer_pools_.find(file_name);
+  if (iter == buffer_pools_.end()) {
+    LOG_TRACE("file has not opened: %s", file_name);
+    return RC::FILE_NOT_EXIST;
+  }
+
+  bp = iter->second;
+  return RC::SUCCESS;
+}
+
 RC BufferPoolManager::get_buffer_pool(int32_t id, DiskBufferPool *&bp)
 {
   bp = nullptr;
@@ -918,3 +1899,17 @@ RC BufferPoolManager::get_buffer_pool(int32_t id, DiskBufferPool *&bp)
   return RC::SUCCESS;
 }
 
+
+void BufferPoolManager::all_status(vector<BufferPoolStatus> &status_list)
+{
+  scoped_lock lock_guard(lock_);
+
+  status_list.clear();
+  status_list.reserve(buffer_pools_.size());
+  for (const auto &[file_name, bp] : buffer_pools_) {
+    status_list.push_back(bp->status());
+  }
+
+  sort(status_list.begin(), status_list.end(),
+      [](const BufferPoolStatus &left, const BufferPoolStatus &right) { return left.file_name < right.file_name; });
+}
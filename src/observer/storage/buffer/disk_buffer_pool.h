@@ -25,15 +25,25 @@ See the Mulan PSL v2 for more details. */
 #include <time.h>
 #include <optional>
 
+#include "common/lang/atomic.h"
 #include "common/lang/bitmap.h"
-#include "common/lang/lru_cache.h"
+#include "common/lang/limits.h"
+#include "common/lang/map.h"
 #include "common/lang/mutex.h"
 #include "common/lang/memory.h"
 #include "common/lang/unordered_map.h"
+#include "common/lang/vector.h"
 #include "common/mm/mem_pool.h"
 #include "common/rc.h"
+#include "common/thread/thread_pool_executor.h"
 #include "common/types.h"
+#include "storage/buffer/buffer_pool_metrics.h"
 #include "storage/buffer/frame.h"
+#include "storage/buffer/frame_arena.h"
+#include "storage/buffer/frame_replacer.h"
+#include "storage/buffer/io_backend.h"
+#include "storage/buffer/buffer_pool_warmer.h"
+#include "storage/buffer/page_cleaner.h"
 #include "storage/buffer/page.h"
 #include "storage/buffer/buffer_pool_log.h"
 
@@ -51,27 +61,37 @@ class BufferPoolLogHandler;
 #define BP_FILE_SUB_HDR_SIZE (sizeof(BPFileSubHeader))
 
 /**
- * @brief BufferPool的文件第一个页面，存放一些元数据信息，包括了后面每页的分配信息。
+ * @brief BufferPool的文件第一个页面，存放一些元数据信息，包括了前面一组页面的分配信息。
  * @ingroup BufferPool
- * @details
- * @code
- * TODO 1. 当前的做法，只能分配比较少的页面，你可以扩展一下，支持更多的页面或无限多的页面吗？
- *         可以参考Linux ext(n)和Windows NTFS等文件系统
- *      2. 当前使用bitmap存放页面分配情况，但是这种方法在页面非常多的时候，查找空闲页面的
- *         效率非常低，你有办法优化吗？
- * @endcode
+ * @details 一个位图放不下所有页面的分配信息，所以把文件按照 PAGES_PER_SPACE_MAP 个页面划分成组，
+ * 每组的分配信息放在一个位图页面(space map)中：
+ * - 第0组的位图就在文件头中，与原来的文件格式兼容；
+ * - 第g(g>0)组的位图放在这一组的第一个页面，即第 g * PAGES_PER_SPACE_MAP 个页面中，位图页面自己对应的位总是1。
+ * 这样根据页面号就可以直接算出位图页面，文件可以一直扩展到页面号用完(约16T)。
+ * 哪些组可能有空闲页面记录在内存中，参考 DiskBufferPool::free_groups_。
  */
 struct BPFileHeader
 {
   int32_t buffer_pool_id;   //! buffer pool id
-  int32_t page_count;       //! 当前文件一共有多少个页面
-  int32_t allocated_pages;  //! 已经分配了多少个页面
-  char    bitmap[0];        //! 页面分配位图, 第0个页面(就是当前页面)，总是1
+  int32_t page_count;       //! 当前文件一共有多少个页面，包括位图页面
+  int32_t allocated_pages;  //! 已经分配了多少个页面，包括位图页面
+  char    bitmap[0];        //! 第0组页面的分配位图, 第0个页面(就是当前页面)，总是1
 
   /**
-   * 能够分配的最大的页面个数，即bitmap的字节数 乘以8
+   * 一个位图能够管理的页面个数，即文件头中bitmap的字节数 乘以8。位图页面也使用同样的大小
    */
-  static const int MAX_PAGE_NUM = (BP_PAGE_DATA_SIZE - sizeof(page_count) - sizeof(allocated_pages)) * 8;
+  static constexpr int PAGES_PER_SPACE_MAP =
+      (BP_PAGE_DATA_SIZE - sizeof(buffer_pool_id) - sizeof(page_count) - sizeof(allocated_pages)) * 8;
+
+  /**
+   * 能够分配的最大的页面个数
+   */
+  static constexpr int MAX_PAGE_NUM = numeric_limits<int32_t>::max();
+
+  /**
+   * @brief 页面是否是某一组的位图页面。文件头不算
+   */
+  static bool is_space_map_page(PageNum page_num) { return page_num > 0 && page_num % PAGES_PER_SPACE_MAP == 0; }
 
   string to_string() const;
 };
@@ -83,13 +103,31 @@ struct BPFileHeader
  * 当内存中的页帧不够用时，需要从内存中淘汰一些页帧，以便为新的页帧腾出空间。
  * 这个管理器负责为所有的BufferPool提供页帧管理服务，也就是所有的BufferPool磁盘文件
  * 在访问时都使用这个管理器映射到内存。
+ *
+ * 为了避免所有的页面访问都在同一把锁上排队，页帧表按照 FrameId 的哈希值划分成多个分区，
+ * 每个分区有自己的锁、淘汰策略和空闲页帧链表。某个分区的空闲页帧用完时，会从其它分区
+ * "偷"一些空闲页帧过来。
+ * 淘汰策略可以配置，参考 FrameReplacer。
  */
 class BPFrameManager
 {
+public:
+  /// 默认的分区个数
+  static constexpr int DEFAULT_PARTITION_NUM = 16;
+
 public:
   BPFrameManager(const char *tag);
 
-  RC init(int pool_num);
+  /**
+   * @brief 初始化
+   *
+   * @param pool_num 内存池的个数，每个内存池包含 DEFAULT_ITEM_NUM_PER_POOL 个页帧
+   * @param partition_num 页帧表的分区个数，不会超过页帧的总数
+   * @param eviction_policy 页帧淘汰策略的名字，参考 FrameReplacer::create
+   * @param arena_options 页面内存的申请方式，比如是否使用大页
+   */
+  RC init(int pool_num, int partition_num = DEFAULT_PARTITION_NUM, const char *eviction_policy = nullptr,
+      const FrameArenaOptions &arena_options = FrameArenaOptions());
   RC cleanup();
 
   /**
@@ -101,6 +139,18 @@ public:
    */
   Frame *get(int buffer_pool_id, PageNum page_num);
 
+  /**
+   * @brief 与 get 相同，但是不计入命中率统计
+   * @details 调用方已经用 get 查找过一次，加锁后再次查找同一个页面时使用，避免重复统计
+   */
+  Frame *get_without_stat(int buffer_pool_id, PageNum page_num);
+
+  /**
+   * @brief 页面是否已经在内存中
+   * @details 与 get 不同，不会pin页帧，也不会影响淘汰顺序和命中率统计
+   */
+  bool contains(int buffer_pool_id, PageNum page_num);
+
   /**
    * @brief 列出所有指定文件的页面
    *
@@ -133,16 +183,57 @@ public:
    */
   int purge_frames(int count, function<RC(Frame *frame)> purger);
 
-  size_t frame_num() const { return frames_.count(); }
+  /**
+   * @brief 找出需要刷盘的脏页帧，给后台刷脏使用
+   * @details 返回的页帧都已经pin过，使用完需要unpin
+   * @param victim_depth 每个分区按照淘汰顺序，检查前面多少个页帧
+   * @param max_other_count 每个分区最多返回多少个其它的脏页帧，选 LSN 最小的
+   * @param[out] victim_frames 淘汰顺序最靠前的脏页帧，这些页帧最好尽快刷到磁盘
+   * @param[out] other_frames 其它的脏页帧
+   */
+  void find_dirty_frames(
+      int victim_depth, size_t max_other_count, vector<Frame *> &victim_frames, vector<Frame *> &other_frames);
+
+  /**
+   * @brief 脏页帧的个数，不会 pin 页帧
+   */
+  size_t dirty_frame_num();
+
+  /**
+   * @brief 当前在使用中(已经映射到某个页面)的页帧个数
+   */
+  size_t frame_num() const;
+
+  /**
+   * @brief 列出所有在内存中的页面，不会pin页帧，给缓冲池预热使用
+   */
+  void frame_ids(vector<FrameId> &frame_ids) const;
 
   /**
    * 测试使用。返回已经从内存申请的个数
    */
   size_t total_frame_num() const { return allocator_.get_size(); }
 
-private:
-  Frame *get_internal(const FrameId &frame_id);
-  RC     free_internal(const FrameId &frame_id, Frame *frame);
+  int partition_num() const { return static_cast<int>(partitions_.size()); }
+
+  /**
+   * @brief 页面访问的统计信息
+   * @details hit/miss 只统计 get 接口，可以用来对比不同淘汰策略的命中率
+   */
+  struct Stat
+  {
+    uint64_t hit_count   = 0;  ///< get 时页面已经在内存中
+    uint64_t miss_count  = 0;  ///< get 时页面不在内存中
+    uint64_t evict_count = 0;  ///< 为了腾出空间淘汰的页面个数
+
+    double hit_ratio() const
+    {
+      uint64_t total = hit_count + miss_count;
+      return total == 0 ? 0.0 : static_cast<double>(hit_count) / total;
+    }
+  };
+
+  Stat stat() const;
 
 private:
   class BPFrameIdHasher
@@ -151,12 +242,48 @@ private:
     size_t operator()(const FrameId &frame_id) const { return frame_id.hash(); }
   };
 
-  using FrameLruCache  = common::LruCache<FrameId, Frame *, BPFrameIdHasher>;
+  using FrameTable     = unordered_map<FrameId, Frame *, BPFrameIdHasher>;
   using FrameAllocator = common::MemPoolSimple<Frame>;
 
-  mutex          lock_;
-  FrameLruCache  frames_;
-  FrameAllocator allocator_;
+  /**
+   * @brief 页帧表的一个分区
+   * @details 一个页面总是映射到固定的分区上，访问这个页面只需要持有这个分区的锁。
+   */
+  struct Partition
+  {
+    mutex                     lock;
+    FrameTable                frames;       ///< 当前分区中正在使用的页帧
+    unique_ptr<FrameReplacer> replacer;     ///< 决定先淘汰哪些页帧
+    list<Frame *>             free_frames;  ///< 当前分区的空闲页帧
+    Stat                      stat;
+  };
+
+  /// 从其它分区偷空闲页帧时，一次最多偷多少个
+  static constexpr int STEAL_BATCH_SIZE = 8;
+
+  /// 淘汰页帧时，优先在淘汰顺序最靠前的这么多个页帧中找干净的，这样不需要同步写盘
+  static constexpr int CLEAN_SCAN_DEPTH = 32;
+
+private:
+  int partition_index(const FrameId &frame_id) const;
+
+  Frame *get_internal(Partition &partition, const FrameId &frame_id);
+  RC     free_internal(Partition &partition, const FrameId &frame_id, Frame *frame, bool evicted);
+
+  /**
+   * @brief 从其它分区的空闲链表中拿一些页帧放到指定分区
+   * @details 调用时不能持有任何分区的锁，每次只会加一个分区的锁，所以不会死锁。
+   * @return 偷到的页帧个数
+   */
+  int steal_free_frames(int home_index);
+
+  int purge_partition(Partition &partition, int count, function<RC(Frame *frame)> &purger);
+
+private:
+  vector<unique_ptr<Partition>> partitions_;
+  FrameAllocator                allocator_;
+  FrameArena                    page_arena_;       ///< 所有页帧的页面内存，按照 BP_IO_ALIGN 对齐
+  atomic<int>                   purge_cursor_{0};  ///< 下一次淘汰时从哪个分区开始
 };
 
 /**
@@ -169,14 +296,71 @@ public:
   BufferPoolIterator();
   ~BufferPoolIterator();
 
-  RC      init(DiskBufferPool &bp, PageNum start_page = 0);
+  /**
+   * @param end_page 只遍历 [start_page, end_page) 中的页面
+   */
+  RC      init(DiskBufferPool &bp, PageNum start_page = 0, PageNum end_page = numeric_limits<PageNum>::max());
   bool    has_next();
   PageNum next();
   RC      reset();
 
 private:
-  common::Bitmap bitmap_;
-  PageNum        current_page_num_ = -1;
+  /**
+   * @brief 顺序访问时，预读后面的页面
+   * @details 连续访问 READ_AHEAD_TRIGGER 个页面后发起第一次预读。之后每当访问到上一次预读的第一个页面时，
+   * 就发起下一次预读，这样预读总是比扫描提前一个窗口，读盘和处理数据可以同时进行。
+   */
+  void try_read_ahead();
+
+private:
+  /// 连续访问多少个页面后开始预读，只访问一两个页面的场景不需要预读
+  static constexpr int READ_AHEAD_TRIGGER = 2;
+
+  DiskBufferPool *buffer_pool_       = nullptr;
+  PageNum         current_page_num_  = -1;
+  PageNum         next_page_num_     = -1;    ///< has_next 查到的下一个页面，避免 next 时再查一遍
+  PageNum         end_page_num_      = numeric_limits<PageNum>::max();  ///< 遍历到这个页面为止(不包含)
+  int             sequential_count_  = 0;   ///< 已经顺序访问了多少个页面
+  PageNum         read_ahead_marker_ = -1;  ///< 访问到这个页面时发起下一次预读
+  PageNum         read_ahead_end_    = -1;  ///< 已经预读的最后一个页面
+};
+
+/**
+ * @brief 把文件中的页面按照页面号划分成多个连续的范围(morsel)，分给多个线程并行扫描
+ * @ingroup BufferPool
+ * @details 第一次调用 init 时记下文件当前的页面数，之后新分配的页面不会分出去。
+ * 每个 morsel 中没有分配的页面由 BufferPoolIterator 跳过。所有接口都可以在多个线程中同时调用。
+ */
+class PageMorselQueue
+{
+public:
+  static constexpr int DEFAULT_MORSEL_PAGES = 16;
+
+  explicit PageMorselQueue(int morsel_pages = DEFAULT_MORSEL_PAGES);
+
+  /**
+   * @brief 记下要扫描的页面范围，只有第一次调用生效
+   */
+  void init(DiskBufferPool &bp);
+
+  /**
+   * @brief 取出下一个 morsel，页面范围是 [begin, end)
+   * @return 所有的页面都已经分出去时返回 false
+   */
+  bool next(PageNum &begin, PageNum &end);
+
+  /**
+   * @brief 回到初始状态，下次 init 时重新记下页面范围
+   * @details 重新执行扫描前调用，调用时不能有线程在使用这个队列
+   */
+  void reset();
+
+private:
+  const int       morsel_pages_;
+  mutex           init_lock_;
+  atomic<bool>    inited_{false};
+  atomic<PageNum> next_page_{1};  ///< 第0个页面是文件头，不需要扫描
+  atomic<PageNum> end_page_{0};
 };
 
 /**
@@ -245,6 +429,24 @@ public:
 
   int file_desc() const;
 
+  /**
+   * @brief 文件是否使用直接IO(O_DIRECT)打开
+   */
+  bool direct_io() const { return direct_io_; }
+
+  /**
+   * @brief 是否压缩写入磁盘的页面
+   * @details 参考 PageCompressor。只影响之后写入的页面，读取时总是能识别压缩过的页面。文件头页面不压缩
+   */
+  void set_page_compression(bool enabled) { page_compression_.store(enabled); }
+  bool page_compression() const { return page_compression_.load(); }
+
+  /**
+   * @brief 访问和读写当前文件的统计信息
+   */
+  BufferPoolMetrics &metrics() { return metrics_; }
+  BufferPoolStatus   status() const { return metrics_.status(file_name_); }
+
   /**
    * 如果页面是脏的，就将数据刷新到double write buffer
    */
@@ -256,25 +458,71 @@ public:
   RC flush_all_pages();
 
   /**
-   * 回放日志时处理page0中已被认定为不存在的page
+   * 回放日志时处理位图中已被认定为不存在的page
    */
   RC recover_page(PageNum page_num);
 
+  /**
+   * @brief 查找第一个不小于 start_page 的已分配的页面，跳过位图页面
+   * @return 页面号，没有时返回 BP_INVALID_PAGE_NUM
+   */
+  PageNum next_allocated_page(PageNum start_page);
+
+  /**
+   * @brief 文件当前的页面数，包括没有分配的页面和位图页面
+   */
+  PageNum page_count() const { return file_header_->page_count; }
+
   /**
    * 刷新页面到磁盘
    */
   RC write_page(PageNum page_num, Page &page);
 
+  /**
+   * @brief 批量刷新页面到磁盘
+   * @details 通过 IoBackend 一次提交，页面号连续的会合并成一次写入
+   */
+  RC write_pages(const vector<pair<PageNum, Page *>> &pages);
+
   RC redo_allocate_page(LSN lsn, PageNum page_num);
   RC redo_deallocate_page(LSN lsn, PageNum page_num);
 
+  /**
+   * @brief 把指定的页面预读到缓冲区中
+   * @details 有预读线程时异步执行，否则在当前线程中执行。预读只是优化，失败时不会影响正常的读取。
+   * @param page_nums 从小到大排列的页面号
+   */
+  void read_ahead(vector<PageNum> page_nums);
+
+  /**
+   * @brief 同步加载一批页面
+   * @details 与预读一样，只使用空闲的页帧，不会淘汰已经在内存中的页面。缓冲池预热时使用
+   * @return 新加载到内存中的页面个数
+   */
+  int preload_pages(const vector<PageNum> &page_nums);
+
+  /**
+   * @brief 等待当前文件所有的异步预读完成
+   */
+  void wait_read_ahead();
+
 public:
   int32_t id() const { return buffer_pool_id_; }
 
   const char *filename() const { return file_name_.c_str(); }
 
 protected:
-  RC allocate_frame(PageNum page_num, Frame **buf);
+  /**
+   * @brief 给页面分配一个页帧
+   * @param blocking 没有空闲页帧时是否一直淘汰其它页帧直到成功。为false时只尝试淘汰一次
+   */
+  RC allocate_frame(PageNum page_num, Frame **buf, bool blocking = true);
+
+  /**
+   * @brief 页帧被淘汰时，记录到页面所属的文件的统计信息中
+   * @details 为了腾出页帧，可能会淘汰其它文件的页面
+   */
+  void record_eviction(const Frame &frame);
 
   /**
    * 刷新指定页面到磁盘(flush)，并且释放关联的Frame
@@ -282,33 +530,101 @@ protected:
   RC purge_frame(PageNum page_num, Frame *used_frame);
   RC check_page_num(PageNum page_num);
 
+  /**
+   * @brief 获取管理 page_num 的位图页面，并pin住
+   * @details 第0组的位图在文件头中，不需要调用这个函数。调用者需要持有 lock_，使用完需要unpin
+   * @param create 是否是新扩展出来的位图页面。磁盘上还没有这个页面，直接在内存中初始化
+   */
+  RC get_space_map_frame(PageNum page_num, Frame *&frame, bool create = false);
+
+  /**
+   * @brief 修改页面在位图中对应的位
+   * @details 调用者需要持有 lock_。第0组修改文件头，其它组修改位图页面，并设置对应页面的LSN
+   * @param redo 是否是回放日志。回放时位图页面的LSN不小于日志的LSN，说明已经修改过了
+   */
+  RC set_page_allocated(PageNum page_num, bool allocated, LSN lsn, bool redo = false);
+
+  /**
+   * @brief 页面是否已经分配。调用者需要持有 lock_
+   */
+  bool is_page_allocated(PageNum page_num);
+
+  /**
+   * @brief 扩展文件，新增一个位图页面
+   * @details 调用者需要持有 lock_。位图页面也需要记录分配日志，回放时才能重新创建出来
+   */
+  RC extend_space_map();
+
   /**
    * 加载指定页面的数据到内存中
    */
   RC load_page(PageNum page_num, Frame *frame);
 
+  /**
+   * @brief 从磁盘读到的页面如果是压缩过的，就解压
+   */
+  RC decompress_page(PageNum page_num, Page &page);
+
+  /**
+   * @brief 保证文件包含 [offset, offset + length) 这段空间
+   * @details 压缩的页面只写入一部分，写在文件末尾时文件长度不够一个完整的页面，之后读取整个页面会失败，
+   * 所以先用 fallocate 把文件扩展到足够的长度。fallocate 不会缩小文件，多个线程同时调用也是安全的
+   */
+  RC extend_file(int64_t offset, int64_t length);
+
+  /**
+   * @brief 释放压缩页面后面不再使用的空间
+   */
+  void punch_hole(int64_t offset, int64_t length);
+
   /**
    * 如果页面是脏的，就将数据刷新到磁盘
    */
   RC flush_page_internal(Frame &frame);
 
+  /**
+   * @brief 执行预读
+   * @details 先过滤掉已经在内存中的页面，然后不持有锁，把连续的页面用一次系统调用读出来，
+   * 最后再加锁放到页帧中。页帧在页帧表中出现时数据总是完整的，其它线程不会读到一半的数据。
+   * 如果读盘期间有页面写回磁盘，读到的数据可能已经过期，就放弃这次预读。
+   */
+  int load_pages_ahead(const vector<PageNum> &page_nums);
+
 private:
   BufferPoolManager   &bp_manager_;     /// BufferPool 管理器
   BPFrameManager      &frame_manager_;  /// Frame 管理器
   DoubleWriteBuffer   &dblwr_manager_;  /// Double Write Buffer 管理器
   BufferPoolLogHandler log_handler_;    /// BufferPool 日志处理器
 
-  int file_desc_ = -1;  /// 文件描述符
+  int  file_desc_ = -1;     /// 文件描述符
+  bool direct_io_ = false;  /// 是否使用O_DIRECT打开，这时读写的内存必须按照 BP_IO_ALIGN 对齐
   /// 由于在最开始打开文件时，没有正确的buffer pool id不能加载header frame，所以单独从文件中读取此标识
   int32_t       buffer_pool_id_ = -1;
   Frame        *hdr_frame_      = nullptr;  /// 文件头页面
   BPFileHeader *file_header_    = nullptr;  /// 文件头
   set<PageNum>  disposed_pages_;            /// 已经释放的页面
 
+  /// 可能有空闲页面的组，以及组内可能空闲的最小页面号。打开文件时不读取所有的位图页面，
+  /// 先认为所有的组都可能有空闲页面，分配时发现某个组满了再删掉，释放页面时再加回来。
+  /// 这样分配页面时不需要扫描所有的位图，均摊下来是O(1)的
+  map<int32_t, PageNum> free_groups_;
+
   string file_name_;  /// 文件名
 
   common::Mutex lock_;
-  common::Mutex wr_lock_;
+
+  /// 写磁盘开始和结束时都会增加，预读根据它判断读盘期间有没有页面被写回
+  atomic<int64_t> write_version_{0};
+
+  atomic<bool>    page_compression_{false};  ///< 是否压缩写入的页面
+  atomic<bool>    punch_hole_{true};         ///< 文件系统是否支持打洞，不支持时压缩只能减少写入的数据量
+  atomic<int64_t> file_size_{0};             ///< 文件的长度，只会增加
+
+  BufferPoolMetrics metrics_;
+
+  mutex              read_ahead_lock_;
+  condition_variable read_ahead_cv_;
+  int                read_ahead_pending_ = 0;  ///< 还没有执行完的异步预读个数
 
 private:
   friend class BufferPoolIterator;
@@ -321,7 +637,13 @@ private:
 class BufferPoolManager final
 {
 public:
-  BufferPoolManager(int memory_size = 0);
+  /**
+   * @param memory_size 用于缓存页面的内存大小，单位是字节，不大于0时使用默认值
+   * @param eviction_policy 页帧淘汰策略，参考 FrameReplacer::create
+   * @param arena_options 页面内存的申请方式，比如是否使用大页、NUMA交错分配
+   */
+  BufferPoolManager(int64_t memory_size = 0, const char *eviction_policy = nullptr,
+      const FrameArenaOptions &arena_options = FrameArenaOptions());
   ~BufferPoolManager();
 
   RC init(unique_ptr<DoubleWriteBuffer> dblwr_buffer);
@@ -332,9 +654,43 @@ public:
 
   RC flush_page(Frame &frame);
 
+  /**
+   * @brief 设置页面读写的后端，参考 IoBackend::create
+   * @details 需要在打开文件之前调用。创建失败时继续使用原来的后端
+   */
+  RC init_io_backend(const char *name);
+
+  IoBackend &io_backend() { return *io_backend_; }
+
+  /**
+   * @brief 使用直接IO(O_DIRECT)打开数据和索引文件，绕过操作系统的页缓存
+   * @details 需要在打开文件之前调用。文件系统不支持O_DIRECT时(比如tmpfs)，会退化成普通的读写
+   */
+  void set_direct_io(bool direct_io) { direct_io_ = direct_io; }
+  bool direct_io() const { return direct_io_; }
+
+  /**
+   * @brief 初始化顺序扫描预读
+   * @details 在CONCURRENCY模式下会启动预读线程池，否则在扫描线程中同步预读，依然可以减少读盘的系统调用次数。
+   * @param window_pages 每次预读多少个页面，0表示关闭预读
+   */
+  RC init_read_ahead(int window_pages);
+
+  int                         read_ahead_window() const { return read_ahead_window_; }
+  common::ThreadPoolExecutor *read_ahead_executor() { return read_ahead_executor_.get(); }
+
   BPFrameManager    &get_frame_manager() { return frame_manager_; }
+  PageCleaner       &page_cleaner() { return page_cleaner_; }
+  BufferPoolWarmer  &warmer() { return warmer_; }
   DoubleWriteBuffer *get_dblwr_buffer() { return dblwr_buffer_.get(); }
 
+  /**
+   * @brief 文件生命周期锁
+   * @details 后台线程(比如刷脏)根据ID找到文件并pin住它的页帧时加共享锁，关闭文件和释放页面时加排他锁，
+   * 保证后台线程访问期间文件不会被关闭，pin住的页面也不会被释放
+   */
+  common::SharedMutex &file_lifetime_lock() { return file_lifetime_lock_; }
+
   /**
    * @brief 根据ID获取对应的BufferPool对象
    * @details 在做redo时，需要根据ID获取对应的BufferPool对象，然后让bufferPool对象自己做redo
@@ -343,11 +699,33 @@ public:
    */
   RC get_buffer_pool(int32_t id, DiskBufferPool *&bp);
 
+  /**
+   * @brief 根据文件名获取已经打开的BufferPool对象
+   * @param file_name 打开文件时使用的文件名
+   */
+  RC get_buffer_pool(const char *file_name, DiskBufferPool *&bp);
+
+  /**
+   * @brief 所有打开的文件的统计信息，按照文件名排序
+   */
+  void all_status(vector<BufferPoolStatus> &status_list);
+
 private:
   BPFrameManager frame_manager_{"BufPool"};
+  PageCleaner      page_cleaner_{*this, frame_manager_};
+  BufferPoolWarmer warmer_{*this, frame_manager_};
 
   unique_ptr<DoubleWriteBuffer> dblwr_buffer_;
+  unique_ptr<IoBackend>         io_backend_;
+  bool                          direct_io_ = false;
+
+  static constexpr int MAX_READ_AHEAD_WINDOW = 256;
+  static constexpr int READ_AHEAD_THREAD_NUM = 4;
+
+  int                                    read_ahead_window_ = 0;
+  unique_ptr<common::ThreadPoolExecutor> read_ahead_executor_;
 
+  common::SharedMutex                      file_lifetime_lock_;
   common::Mutex                            lock_;
   unordered_map<string, DiskBufferPool *>  buffer_pools_;
   unordered_map<int32_t, DiskBufferPool *> id_to_buffer_pools_;
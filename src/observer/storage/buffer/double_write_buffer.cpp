@@ -75,117 +75,206 @@ RC DiskDoubleWriteBuffer::open_file(const char *filename)
   return load_pages();
 }
 
-RC DiskDoubleWriteBuffer::flush_page()
+RC DiskDoubleWriteBuffer::flush_page() { return flush_batch(1); }
+
+RC DiskDoubleWriteBuffer::add_page(DiskBufferPool *bp, PageNum page_num, Page &page)
 {
-  sync();
+  bool batch_full = false;
+  {
+    scoped_lock lock_guard(lock_);
+    DoubleWritePageKey key{bp->id(), page_num};
+    auto iter = dblwr_pages_.find(key);
+    if (iter != dblwr_pages_.end()) {
+      iter->second->page = page;
+      LOG_TRACE("[cache hit]add page into double write buffer. buffer_pool_id:%d,page_num:%d,lsn=%d, dwb size=%d",
+                bp->id(), page_num, page.lsn, static_cast<int>(dblwr_pages_.size()));
+      return RC::SUCCESS;
+    }
+
+    DoubleWritePage *dblwr_page = new DoubleWritePage(bp->id(), page_num, -1 /*page_index*/, page);
+    dblwr_pages_.insert(std::pair<DoubleWritePageKey, DoubleWritePage *>(key, dblwr_page));
+    LOG_TRACE("insert page into double write buffer. buffer_pool_id:%d,page_num:%d,lsn=%d, dwb size:%d",
+              bp->id(), page_num, page.lsn, static_cast<int>(dblwr_pages_.size()));
 
-  for (const auto &pair : dblwr_pages_) {
-    RC rc = write_page(pair.second);
+    batch_full = static_cast<int>(dblwr_pages_.size()) >= max_pages_;
+  }
+
+  if (batch_full) {
+    RC rc = flush_batch(max_pages_);
     if (rc != RC::SUCCESS) {
+      LOG_ERROR("Failed to flush pages in double write buffer");
       return rc;
     }
-    pair.second->valid = false;
-    write_page_internal(pair.second);
-    delete pair.second;
   }
 
-  dblwr_pages_.clear();
-  header_.page_cnt = 0;
-
   return RC::SUCCESS;
 }
 
-RC DiskDoubleWriteBuffer::add_page(DiskBufferPool *bp, PageNum page_num, Page &page)
+RC DiskDoubleWriteBuffer::flush_batch(size_t min_pages)
 {
+  lock_guard<mutex> flush_guard(flush_lock_);
+
+  vector<DoubleWritePage *> pages;
+  {
+    scoped_lock lock_guard(lock_);
+    // 等待期间，其它线程可能已经把当前批次刷下去了
+    if (dblwr_pages_.empty() || dblwr_pages_.size() < min_pages) {
+      return RC::SUCCESS;
+    }
+
+    flushing_pages_.swap(dblwr_pages_);
+    pages.reserve(flushing_pages_.size());
+    for (const auto &pair : flushing_pages_) {
+      pages.push_back(pair.second);
+    }
+  }
+
+  RC rc = write_batch(pages);
+  if (OB_SUCC(rc)) {
+    rc = write_pages(pages);
+  }
+  if (OB_SUCC(rc)) {
+    finish_batch();
+  }
+
   scoped_lock lock_guard(lock_);
-  DoubleWritePageKey key{bp->id(), page_num};
-  auto iter = dblwr_pages_.find(key);
-  if (iter != dblwr_pages_.end()) {
-    iter->second->page = page;
-    LOG_TRACE("[cache hit]add page into double write buffer. buffer_pool_id:%d,page_num:%d,lsn=%d, dwb size=%d",
-              bp->id(), page_num, page.lsn, static_cast<int>(dblwr_pages_.size()));
-    return write_page_internal(iter->second);
+  if (OB_FAIL(rc)) {
+    // 刷盘失败，页面放回当前批次，下次再刷。刷盘期间又加入的同一个页面更新
+    for (const auto &pair : flushing_pages_) {
+      if (!dblwr_pages_.insert(pair).second) {
+        delete pair.second;
+      }
+    }
+  } else {
+    for (const auto &pair : flushing_pages_) {
+      delete pair.second;
+    }
   }
+  flushing_pages_.clear();
+  return rc;
+}
 
-  int64_t          page_cnt   = dblwr_pages_.size();
-  DoubleWritePage *dblwr_page = new DoubleWritePage(bp->id(), page_num, page_cnt, page);
-  dblwr_pages_.insert(std::pair<DoubleWritePageKey, DoubleWritePage *>(key, dblwr_page));
-  LOG_TRACE("insert page into double write buffer. buffer_pool_id:%d,page_num:%d,lsn=%d, dwb size:%d",
-            bp->id(), page_num, page.lsn, static_cast<int>(dblwr_pages_.size()));
+RC DiskDoubleWriteBuffer::write_batch(vector<DoubleWritePage *> &pages)
+{
+  header_.page_cnt = static_cast<int32_t>(pages.size());
+
+  // 文件头和页面在文件中是连续的，会合并成一次顺序写
+  vector<IoRequest> requests;
+  requests.reserve(pages.size() + 1);
+
+  IoRequest &header_request = requests.emplace_back();
+  header_request.fd         = file_desc_;
+  header_request.offset     = 0;
+  header_request.buffer     = &header_;
+  header_request.size       = DoubleWriteBufferHeader::SIZE;
+
+  for (size_t i = 0; i < pages.size(); i++) {
+    pages[i]->page_index = static_cast<int32_t>(i);
+
+    IoRequest &request = requests.emplace_back();
+    request.fd         = file_desc_;
+    request.offset     = i * DoubleWritePage::SIZE + DoubleWriteBufferHeader::SIZE;
+    request.buffer     = pages[i];
+    request.size       = DoubleWritePage::SIZE;
+  }
 
-  RC rc = write_page_internal(dblwr_page);
+  RC rc = bp_manager_.io_backend().write_batch(requests);
   if (OB_FAIL(rc)) {
-    LOG_WARN("failed to write page into double write buffer. rc=%s buffer_pool_id:%d,page_num:%d,lsn=%d.",
-        strrc(rc), bp->id(), page_num, page.lsn);
+    LOG_ERROR("Failed to write pages into double write buffer. page count=%d, rc=%s",
+              static_cast<int>(pages.size()), strrc(rc));
     return rc;
   }
 
-  if (page_cnt + 1 > header_.page_cnt) {
-    header_.page_cnt = page_cnt + 1;
-    if (lseek(file_desc_, 0, SEEK_SET) == -1) {
-      LOG_ERROR("Failed to add page header due to failed to seek %s.", strerror(errno));
-      return RC::IOERR_SEEK;
+  if (fdatasync(file_desc_) != 0) {
+    LOG_ERROR("Failed to sync double write buffer file. error=%s", strerror(errno));
+    return RC::IOERR_SYNC;
+  }
+
+  LOG_TRACE("double write buffer write batch. page count:%d", static_cast<int>(pages.size()));
+  return RC::SUCCESS;
+}
+
+RC DiskDoubleWriteBuffer::write_pages(vector<DoubleWritePage *> &pages)
+{
+  // 按照文件和页面号排序，同一个文件的页面一次批量写入，连续的页面可以合并
+  sort(pages.begin(), pages.end(), [](DoubleWritePage *a, DoubleWritePage *b) {
+    if (a->key.buffer_pool_id != b->key.buffer_pool_id) {
+      return a->key.buffer_pool_id < b->key.buffer_pool_id;
     }
+    return a->key.page_num < b->key.page_num;
+  });
 
-    if (writen(file_desc_, &header_, sizeof(header_)) != 0) {
-      LOG_ERROR("Failed to add page header due to %s.", strerror(errno));
-      return RC::IOERR_WRITE;
+  vector<pair<PageNum, Page *>> bp_pages;
+  for (size_t begin = 0, end = 0; begin < pages.size(); begin = end) {
+    const int32_t buffer_pool_id = pages[begin]->key.buffer_pool_id;
+
+    bp_pages.clear();
+    for (end = begin; end < pages.size() && pages[end]->key.buffer_pool_id == buffer_pool_id; end++) {
+      // skip invalid page
+      if (pages[end]->valid) {
+        bp_pages.emplace_back(pages[end]->key.page_num, &pages[end]->page);
+      }
     }
-  }
 
-  if (static_cast<int>(dblwr_pages_.size()) >= max_pages_) {
-    RC rc = flush_page();
-    if (rc != RC::SUCCESS) {
-      LOG_ERROR("Failed to flush pages in double write buffer");
+    if (bp_pages.empty()) {
+      continue;
+    }
+
+    DiskBufferPool *disk_buffer = nullptr;
+    RC rc = bp_manager_.get_buffer_pool(buffer_pool_id, disk_buffer);
+    ASSERT(OB_SUCC(rc) && disk_buffer != nullptr, "failed to get disk buffer pool of %d", buffer_pool_id);
+
+    LOG_TRACE("double write buffer write pages. buffer_pool_id:%d, page count:%d",
+              buffer_pool_id, static_cast<int>(bp_pages.size()));
+
+    rc = write_buffer_pool_pages(disk_buffer, bp_pages);
+    if (OB_FAIL(rc)) {
       return rc;
     }
   }
-
   return RC::SUCCESS;
 }
 
-RC DiskDoubleWriteBuffer::write_page_internal(DoubleWritePage *page)
+RC DiskDoubleWriteBuffer::write_buffer_pool_pages(DiskBufferPool *buffer_pool, const vector<pair<PageNum, Page *>> &pages)
 {
-  int32_t page_index = page->page_index;
-  int64_t offset = page_index * DoubleWritePage::SIZE + DoubleWriteBufferHeader::SIZE;
-  if (lseek(file_desc_, offset, SEEK_SET) == -1) {
-    LOG_ERROR("Failed to add page %lld of %d due to failed to seek %s.", offset, file_desc_, strerror(errno));
-    return RC::IOERR_SEEK;
+  RC rc = buffer_pool->write_pages(pages);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("Failed to write pages to disk buffer pool %s. rc=%s", buffer_pool->filename(), strrc(rc));
+    return rc;
   }
 
-  if (writen(file_desc_, page, DoubleWritePage::SIZE) != 0) {
-    LOG_ERROR("Failed to add page %lld of %d due to %s.", offset, file_desc_, strerror(errno));
-    return RC::IOERR_WRITE;
+  // 数据文件落盘以后，double write buffer文件中的这个批次才可以被覆盖
+  if (fdatasync(buffer_pool->file_desc()) != 0) {
+    LOG_ERROR("Failed to sync buffer pool file %s. error=%s", buffer_pool->filename(), strerror(errno));
+    return RC::IOERR_SYNC;
   }
-
   return RC::SUCCESS;
 }
 
-RC DiskDoubleWriteBuffer::write_page(DoubleWritePage *dblwr_page)
+void DiskDoubleWriteBuffer::finish_batch()
 {
-  DiskBufferPool *disk_buffer = nullptr;
-  // skip invalid page
-  if (!dblwr_page->valid) {
-    LOG_TRACE("double write buffer write page invalid. buffer_pool_id:%d,page_num:%d,lsn=%d",
-              dblwr_page->key.buffer_pool_id, dblwr_page->key.page_num, dblwr_page->page.lsn);
-    return RC::SUCCESS;
-  }
-  RC rc = bp_manager_.get_buffer_pool(dblwr_page->key.buffer_pool_id, disk_buffer);
-  ASSERT(OB_SUCC(rc) && disk_buffer != nullptr, "failed to get disk buffer pool of %d", dblwr_page->key.buffer_pool_id);
-
-  LOG_TRACE("double write buffer write page. buffer_pool_id:%d,page_num:%d,lsn=%d",
-            dblwr_page->key.buffer_pool_id, dblwr_page->key.page_num, dblwr_page->page.lsn);
+  header_.page_cnt = 0;
 
-  return disk_buffer->write_page(dblwr_page->key.page_num, dblwr_page->page);
+  // 页面在数据文件中已经写成功了，这里失败只会导致重启时多写一次
+  RC rc = bp_manager_.io_backend().write(file_desc_, 0, &header_, DoubleWriteBufferHeader::SIZE);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to reset double write buffer header. rc=%s", strrc(rc));
+  }
 }
 
 RC DiskDoubleWriteBuffer::read_page(DiskBufferPool *bp, PageNum page_num, Page &page)
 {
   scoped_lock lock_guard(lock_);
   DoubleWritePageKey key{bp->id(), page_num};
-  auto iter = dblwr_pages_.find(key);
-  if (iter != dblwr_pages_.end()) {
-    page = iter->second->page;
+  DoubleWritePage *dblwr_page = nullptr;
+  if (auto iter = dblwr_pages_.find(key); iter != dblwr_pages_.end()) {
+    dblwr_page = iter->second;
+  } else if (auto iter = flushing_pages_.find(key); iter != flushing_pages_.end()) {
+    dblwr_page = iter->second;
+  }
+
+  if (dblwr_page != nullptr) {
+    page = dblwr_page->page;
     LOG_TRACE("double write buffer read page success. bp id=%d, page_num:%d, lsn:%d", bp->id(), page_num, page.lsn);
     return RC::SUCCESS;
   }
@@ -206,6 +295,9 @@ RC DiskDoubleWriteBuffer::clear_pages(DiskBufferPool *buffer_pool)
     return false;
   };
 
+  // 等待正在刷盘的批次完成，它可能包含这个文件的页面
+  lock_guard<mutex> flush_guard(flush_lock_);
+
   lock_.lock();
   erase_if(dblwr_pages_, remove_pred);
   lock_.unlock();
@@ -213,21 +305,30 @@ RC DiskDoubleWriteBuffer::clear_pages(DiskBufferPool *buffer_pool)
   LOG_INFO("clear pages in double write buffer. file name=%s, page count=%d",
            buffer_pool->filename(), spec_pages.size());
 
-  // 页面从小到大排序，防止出现小页面还没有写入，而页面编号更大的seek失败的情况
+  if (spec_pages.empty()) {
+    return RC::SUCCESS;
+  }
+
+  // 页面从小到大排序，连续的页面可以合并写入
   sort(spec_pages.begin(), spec_pages.end(), [](DoubleWritePage *a, DoubleWritePage *b) {
     return a->key.page_num < b->key.page_num;
   });
 
-  RC rc = RC::SUCCESS;
+  vector<pair<PageNum, Page *>> bp_pages;
+  bp_pages.reserve(spec_pages.size());
   for (DoubleWritePage *dbl_page : spec_pages) {
-    rc = buffer_pool->write_page(dbl_page->key.page_num, dbl_page->page);
-    if (OB_FAIL(rc)) {
-      LOG_WARN("Failed to write page %s:%d to disk buffer pool. rc=%s",
-               buffer_pool->filename(), dbl_page->key.page_num, strrc(rc));
-      break;
+    if (dbl_page->valid) {
+      bp_pages.emplace_back(dbl_page->key.page_num, &dbl_page->page);
     }
-    dbl_page->valid = false;
-    write_page_internal(dbl_page);
+  }
+
+  // 这个文件的页面单独作为一个批次，同样先写double write buffer文件，再写数据文件
+  RC rc = write_batch(spec_pages);
+  if (OB_SUCC(rc)) {
+    rc = write_buffer_pool_pages(buffer_pool, bp_pages);
+  }
+  if (OB_SUCC(rc)) {
+    finish_batch();
   }
 
   for_each(spec_pages.begin(), spec_pages.end(), [](DoubleWritePage *dbl_page) { delete dbl_page; });
@@ -16,6 +16,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/lang/mutex.h"
 #include "common/lang/unordered_map.h"
+#include "common/lang/vector.h"
 #include "common/types.h"
 #include "common/rc.h"
 #include "storage/buffer/page.h"
@@ -80,7 +81,15 @@ struct DoubleWritePageKeyHash
  * 当我们从磁盘中读取页面时，会校验页面的checksum，如果校验失败，则说明页面写入不完整，这时候可以从
  * DoubleWriteBuffer中读取数据。
  *
- * @note 每次都要保证，不管在内存中还是在文件中，这里的数据都是最新的，都比Buffer pool中的数据要新
+ * 页面按批(组)刷盘：add_page 只是把页面复制到内存中当前的批次，批次满了以后，由装满批次的线程
+ * 一次性刷盘，其它线程可以继续向新的批次中添加页面。一个批次的刷盘过程：
+ * 1. 文件头和批次中所有的页面连续存放，一次顺序写入double write buffer文件，然后fsync一次；
+ * 2. 页面批量写入各自的数据文件，每个数据文件fsync一次；
+ * 3. 把文件头中的页面个数改成0，表示这个批次已经完成，不需要再fsync。
+ * 同一时间只有一个批次在刷盘。第2步完成前崩溃，重启时从double write buffer文件中恢复完整的页面；
+ * 第1步完成前崩溃，数据文件还没有被修改，页面的修改可以通过重做日志恢复。
+ *
+ * @note 每次都要保证，在内存中这里的数据都是最新的，都比Buffer pool中的数据要新
  */
 class DiskDoubleWriteBuffer : public DoubleWriteBuffer
 {
@@ -100,13 +109,12 @@ public:
   RC open_file(const char *filename);
 
   /**
-   * 将buffer中的页全部写入磁盘，并且清空buffer
-   * TODO 目前的解决方案是等buffer装满后再刷盘，可能会导致程序卡住一段时间
+   * 将当前批次的页面全部写入磁盘，并且清空buffer
    */
   RC flush_page();
 
   /**
-   * 将页面加入buffer，并且写入磁盘中的共享表空间
+   * 将页面加入当前批次，批次满了以后整批刷盘
    */
   RC add_page(DiskBufferPool *bp, PageNum page_num, Page &page) override;
 
@@ -123,17 +131,35 @@ public:
   RC recover();
 
 private:
+  using DoubleWritePageMap = unordered_map<DoubleWritePageKey, DoubleWritePage *, DoubleWritePageKeyHash>;
+
+  /**
+   * @brief 当前批次至少有 min_pages 个页面时，把它刷到磁盘
+   * @details 调用时不能持有 lock_。如果有其它线程正在刷盘，会等它完成后再检查一次，
+   * 很可能它已经把当前线程的页面一起刷下去了。
+   */
+  RC flush_batch(size_t min_pages);
+
+  /**
+   * 将一个批次的页面连同文件头一次写入double write buffer文件，并fsync
+   */
+  RC write_batch(vector<DoubleWritePage *> &pages);
+
+  /**
+   * 将buffer中的页面批量写入对应的磁盘，并fsync涉及到的数据文件
+   */
+  RC write_pages(vector<DoubleWritePage *> &pages);
+
   /**
-   * 将buffer中的页面写入对应的磁盘
+   * 将同一个数据文件的页面批量写入磁盘，并fsync这个文件
    */
-  RC write_page(DoubleWritePage *page);
+  RC write_buffer_pool_pages(DiskBufferPool *buffer_pool, const vector<pair<PageNum, Page *>> &pages);
 
   /**
-   * 将页面写到当前double write buffer文件中
-   * @details 每次页面更新都应该写入到磁盘中。保证double write buffer
-   * 内存和文件中的数据都是最新的。
+   * @brief 页面已经写入数据文件后，把文件头中的页面个数清零
+   * @details 不需要fsync，丢失了也只会在重启时把同样的页面再写一次
    */
-  RC write_page_internal(DoubleWritePage *page);
+  void finish_batch();
 
   /**
    * @brief 将磁盘文件中的内容加载到内存中。在启动时调用
@@ -143,11 +169,13 @@ private:
 private:
   int                     file_desc_ = -1;
   int                     max_pages_ = 0;
-  common::Mutex           lock_;
+  common::Mutex           lock_;        ///< 保护 dblwr_pages_ 和 flushing_pages_
+  mutex                   flush_lock_;  ///< 同一时间只有一个批次在刷盘，先加这个锁再加 lock_
   BufferPoolManager      &bp_manager_;
   DoubleWriteBufferHeader header_;
 
-  unordered_map<DoubleWritePageKey, DoubleWritePage *, DoubleWritePageKeyHash> dblwr_pages_;
+  DoubleWritePageMap dblwr_pages_;     ///< 当前批次，还在接收新的页面
+  DoubleWritePageMap flushing_pages_;  ///< 正在刷盘的批次，读页面时也需要查找
 };
 
 class VacuousDoubleWriteBuffer : public DoubleWriteBuffer
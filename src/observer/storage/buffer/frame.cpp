@@ -75,6 +75,9 @@ void Frame::write_latch(intptr_t xid)
   }
 
   lock_.lock();
+  if (write_depth_++ == 0) {
+    begin_update();
+  }
 
 #ifdef DEBUG
   write_locker_ = xid;
@@ -110,6 +113,9 @@ void Frame::write_unlatch(intptr_t xid)
   }
   debug_lock_.unlock();
 
+  if (--write_depth_ == 0) {
+    end_update();
+  }
   lock_.unlock();
 }
 
@@ -78,7 +78,14 @@ public:
   void reinit() {}
   void reset() {}
 
-  void clear_page() { memset(&page_, 0, sizeof(page_)); }
+  void clear_page() { memset(page_, 0, sizeof(Page)); }
+
+  /**
+   * @brief 设置页帧使用的页面内存
+   * @details 页面内存由 BPFrameManager 统一按照 BP_IO_ALIGN 对齐申请，方便使用 O_DIRECT 读写，
+   * 也避免了把页帧对象本身对齐造成的内存浪费。页帧在内存池中的整个生命周期内都使用同一块页面内存。
+   */
+  void bind_page(Page *page) { page_ = page; }
 
   int  buffer_pool_id() const { return frame_id_.buffer_pool_id(); }
   void set_buffer_pool_id(int id) { frame_id_.set_buffer_pool_id(id); }
@@ -88,7 +95,7 @@ public:
    * @details 磁盘文件划分为一个个页面，每次从磁盘加载到内存中，也是一个页面，就是 Page。
    * frame 是为了管理这些页面而维护的一个数据结构。
    */
-  Page &page() { return page_; }
+  Page &page() { return *page_; }
 
   /**
    * @brief 每个页面都有一个编号
@@ -103,15 +110,15 @@ public:
    * @details 如果当前页面从磁盘中加载出来时，它的日志序列号比当前WAL(Write-Ahead-Logging)中的一些
    * 序列号要小，那就可以从日志中读取这些更大序列号的日志，做重做操作，将页面恢复到最新状态，也就是redo。
    */
-  LSN  lsn() const { return page_.lsn; }
-  void set_lsn(LSN lsn) { page_.lsn = lsn; }
+  LSN  lsn() const { return page_->lsn; }
+  void set_lsn(LSN lsn) { page_->lsn = lsn; }
 
   /**
    * @brief 页面校验和
    * @details 用于校验页面完整性。如果页面写入一半时出现异常，可以通过校验和检测出来。
    */
-  CheckSum check_sum() const { return page_.check_sum; }
-  void     set_check_sum(CheckSum check_sum) { page_.check_sum = check_sum; }
+  CheckSum check_sum() const { return page_->check_sum; }
+  void     set_check_sum(CheckSum check_sum) { page_->check_sum = check_sum; }
 
   /**
    * @brief 刷新当前内存页面的访问时间
@@ -135,7 +142,7 @@ public:
   void clear_dirty() { dirty_ = false; }
   bool dirty() const { return dirty_; }
 
-  char *data() { return page_.data; }
+  char *data() { return page_->data; }
 
   bool can_purge() { return pin_count_.load() == 0; }
 
@@ -166,6 +173,27 @@ public:
   void read_unlatch();
   void read_unlatch(intptr_t xid);
 
+  /**
+   * @brief 页面版本号，用于乐观读
+   * @details 每次修改页面(加写锁或者从磁盘加载)前后各加一，所以奇数表示页面正在被修改。
+   * 乐观读不加锁，先记下版本号再读取页面内容，读完以后校验版本号没有变化，就说明读到的内容是一致的。
+   * 注意读取过程中页面可能被修改，读出来的数据只能在校验通过以后使用。
+   * 版本号在页帧的整个生命周期内只增不减，页帧被复用到其它页面时也不会重置。
+   */
+  uint64_t version() const { return version_.load(memory_order_acquire); }
+  bool     validate_version(uint64_t version) const
+  {
+    atomic_thread_fence(memory_order_acquire);
+    return version_.load(memory_order_relaxed) == version;
+  }
+
+  /**
+   * @brief 开始和结束修改页面
+   * @details 加写锁时会自动调用。不加写锁修改页面的地方(比如从磁盘加载页面)需要自己调用。
+   */
+  void begin_update() { version_.fetch_add(1, memory_order_acq_rel); }
+  void end_update() { version_.fetch_add(1, memory_order_release); }
+
   string to_string() const;
 
 private:
@@ -175,7 +203,10 @@ private:
   atomic<int>   pin_count_{0};
   unsigned long acc_time_ = 0;
   FrameId       frame_id_;
-  Page          page_;
+  Page         *page_    = nullptr;
+
+  atomic<uint64_t> version_{0};
+  int              write_depth_ = 0;  ///< 写锁的重入次数，只有加着写锁才能访问
 
   /// 在非并发编译时，加锁解锁动作将什么都不做
   common::RecursiveSharedMutex lock_;
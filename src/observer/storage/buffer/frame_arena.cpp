@@ -0,0 +1,204 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if defined(LINUX)
+#include <sys/syscall.h>
+#endif
+
+#include "storage/buffer/frame_arena.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/fstream.h"
+#include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "common/log/log.h"
+
+namespace {
+
+/// 大页的大小。x86_64和aarch64(4K基础页)上默认的大页都是2M
+constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+size_t align_up(size_t size, size_t align) { return (size + align - 1) / align * align; }
+
+/**
+ * @brief 读取在线的NUMA节点，格式类似 "0-1,3"
+ */
+vector<int> online_numa_nodes()
+{
+  vector<int> nodes;
+  ifstream    in("/sys/devices/system/node/online");
+  string      line;
+  if (!in || !getline(in, line)) {
+    return nodes;
+  }
+
+  vector<string> ranges;
+  common::split_string(line, ",", ranges);
+  for (const string &range : ranges) {
+    if (common::is_blank(range.c_str())) {
+      continue;
+    }
+    size_t    pos   = range.find('-');
+    const int begin = atoi(range.substr(0, pos).c_str());
+    const int end   = pos == string::npos ? begin : atoi(range.substr(pos + 1).c_str());
+    for (int node = begin; node <= end; node++) {
+      nodes.push_back(node);
+    }
+  }
+  return nodes;
+}
+
+/**
+ * @brief 设置内存在所有NUMA节点上交错分配
+ * @details 需要在第一次访问内存之前设置。不依赖libnuma，直接调用mbind系统调用
+ */
+bool numa_interleave(void *addr, size_t size)
+{
+#if defined(LINUX) && defined(SYS_mbind)
+  const vector<int> nodes = online_numa_nodes();
+  if (nodes.size() <= 1) {
+    LOG_INFO("numa node number is %d, skip interleave", static_cast<int>(nodes.size()));
+    return false;
+  }
+
+  constexpr int       MPOL_INTERLEAVE_MODE = 3;  // MPOL_INTERLEAVE in <linux/mempolicy.h>
+  constexpr int       BITS_PER_MASK        = sizeof(unsigned long) * 8;
+  const int           max_node             = *max_element(nodes.begin(), nodes.end());
+  vector<unsigned long> node_mask(max_node / BITS_PER_MASK + 1, 0);
+  for (int node : nodes) {
+    node_mask[node / BITS_PER_MASK] |= 1UL << (node % BITS_PER_MASK);
+  }
+
+  long ret = syscall(SYS_mbind, addr, size, MPOL_INTERLEAVE_MODE, node_mask.data(), max_node + 2, 0);
+  if (ret != 0) {
+    LOG_WARN("failed to interleave memory on numa nodes. error=%s", strerror(errno));
+    return false;
+  }
+  LOG_INFO("interleave memory on %d numa nodes", static_cast<int>(nodes.size()));
+  return true;
+#else
+  LOG_INFO("numa interleave is not supported on this platform");
+  return false;
+#endif
+}
+
+/**
+ * @brief 申请一段按照大页对齐的匿名内存
+ * @details 多申请一个大页，再把首尾多余的部分释放掉
+ */
+void *mmap_huge_page_aligned(size_t size)
+{
+  const size_t map_size = size + HUGE_PAGE_SIZE;
+  void        *addr     = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (addr == MAP_FAILED) {
+    return nullptr;
+  }
+
+  char *begin   = static_cast<char *>(addr);
+  char *aligned = reinterpret_cast<char *>(align_up(reinterpret_cast<uintptr_t>(begin), HUGE_PAGE_SIZE));
+  if (aligned > begin) {
+    munmap(begin, aligned - begin);
+  }
+  const size_t tail_size = begin + map_size - (aligned + size);
+  if (tail_size > 0) {
+    munmap(aligned + size, tail_size);
+  }
+  return aligned;
+}
+
+}  // namespace
+
+FrameArena::~FrameArena() { release(); }
+
+void FrameArena::release()
+{
+  if (map_addr_ != nullptr) {
+    munmap(map_addr_, map_size_);
+  }
+  buffer_.init(0);
+  data_     = nullptr;
+  size_     = 0;
+  map_addr_ = nullptr;
+  map_size_ = 0;
+}
+
+RC FrameArena::init_buffer(size_t size)
+{
+  RC rc = buffer_.init(size);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+  return RC::SUCCESS;
+}
+
+RC FrameArena::init(size_t size, const FrameArenaOptions &options)
+{
+  release();
+
+  const size_t aligned_size = align_up(size, BP_IO_ALIGN);
+  if (aligned_size == 0 || (!options.huge_page && !options.numa_interleave)) {
+    return init_buffer(size);
+  }
+
+  const char *mode     = "normal";
+  void       *addr     = nullptr;
+  size_t      map_size = aligned_size;
+  if (options.huge_page) {
+    map_size = align_up(aligned_size, HUGE_PAGE_SIZE);
+#ifdef MAP_HUGETLB
+    // 需要预留大页，比如 sysctl vm.nr_hugepages
+    addr = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (addr == MAP_FAILED) {
+      LOG_INFO("failed to mmap huge pages, try transparent huge page. size=%ld, error=%s", map_size, strerror(errno));
+      addr = nullptr;
+    } else {
+      mode = "hugetlb";
+    }
+#endif
+
+    if (addr == nullptr) {
+      addr = mmap_huge_page_aligned(map_size);
+#ifdef MADV_HUGEPAGE
+      if (addr != nullptr && madvise(addr, map_size, MADV_HUGEPAGE) == 0) {
+        mode = "transparent huge page";
+      }
+#endif
+    }
+  } else {
+    addr = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addr == MAP_FAILED) {
+      addr = nullptr;
+    }
+  }
+
+  if (addr == nullptr) {
+    LOG_WARN("failed to mmap frame arena, fallback to aligned alloc. size=%ld, error=%s", map_size, strerror(errno));
+    return init_buffer(size);
+  }
+
+  bool interleaved = false;
+  if (options.numa_interleave) {
+    interleaved = numa_interleave(addr, map_size);
+  }
+
+  data_     = static_cast<char *>(addr);
+  size_     = aligned_size;
+  map_addr_ = addr;
+  map_size_ = map_size;
+  LOG_INFO("frame arena allocated. size=%ld, mapped size=%ld, page mode=%s, numa interleave=%d",
+           size_, map_size_, mode, interleaved);
+  return RC::SUCCESS;
+}
@@ -0,0 +1,64 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/rc.h"
+#include "storage/buffer/io_backend.h"
+#include "storage/buffer/page.h"
+
+/**
+ * @brief 页帧内存的申请方式
+ * @ingroup BufferPool
+ */
+struct FrameArenaOptions
+{
+  bool huge_page       = false;  ///< 使用大页(MAP_HUGETLB，失败时退化成透明大页)，减少TLB缺失
+  bool numa_interleave = false;  ///< 在所有NUMA节点上交错分配，避免内存都集中在一个节点上
+};
+
+/**
+ * @brief 所有页帧的页面内存
+ * @ingroup BufferPool
+ * @details 使用mmap申请一大块内存，可以使用大页减少TLB缺失，也可以在NUMA节点之间交错分配。
+ * 和 AlignedBuffer 一样按照 BP_IO_ALIGN 对齐，直接IO可以直接读写页帧。
+ */
+class FrameArena
+{
+public:
+  FrameArena() = default;
+  ~FrameArena();
+
+  FrameArena(const FrameArena &)            = delete;
+  FrameArena &operator=(const FrameArena &) = delete;
+
+  /**
+   * @brief 申请内存，原来的内存会释放掉
+   * @details 按照 options 尝试使用大页以及NUMA交错分配，不支持时逐步退化，最后退化成 AlignedBuffer。
+   * 大小会向上对齐到 BP_IO_ALIGN。mmap申请出来的内存是0，并且在第一次访问时才真正分配物理内存。
+   */
+  RC init(size_t size, const FrameArenaOptions &options);
+
+  char  *data() { return data_; }
+  size_t size() const { return size_; }
+
+  Page *pages() { return reinterpret_cast<Page *>(data_); }
+
+private:
+  void release();
+  RC   init_buffer(size_t size);
+
+private:
+  char         *data_     = nullptr;
+  size_t        size_     = 0;
+  void         *map_addr_ = nullptr;  ///< mmap 出来的内存，不是mmap申请的时候为空
+  size_t        map_size_ = 0;
+  AlignedBuffer buffer_;              ///< 不使用mmap时的内存
+};
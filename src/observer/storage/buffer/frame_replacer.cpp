@@ -0,0 +1,157 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/buffer/frame_replacer.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/string.h"
+#include "common/log/log.h"
+
+RC FrameReplacer::create(const char *name, int capacity, FrameReplacer *&replacer)
+{
+  if (name == nullptr || common::is_blank(name)) {
+    name = "lru";
+  }
+
+  if (strcasecmp(name, "lru") == 0) {
+    replacer = new LruFrameReplacer();
+  } else if (strcasecmp(name, "2q") == 0) {
+    replacer = new TwoQueueFrameReplacer(capacity);
+  } else {
+    LOG_ERROR("unknown frame replacer name. name=%s", name);
+    return RC::INVALID_ARGUMENT;
+  }
+  return RC::SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LruFrameReplacer::insert(Frame *frame)
+{
+  lru_list_.push_front(frame);
+  index_[frame] = lru_list_.begin();
+}
+
+void LruFrameReplacer::touch(Frame *frame)
+{
+  auto iter = index_.find(frame);
+  if (iter == index_.end()) {
+    return;
+  }
+
+  lru_list_.splice(lru_list_.begin(), lru_list_, iter->second);
+}
+
+void LruFrameReplacer::remove(Frame *frame, bool /*evicted*/)
+{
+  auto iter = index_.find(frame);
+  if (iter == index_.end()) {
+    return;
+  }
+
+  lru_list_.erase(iter->second);
+  index_.erase(iter);
+}
+
+void LruFrameReplacer::foreach_victim(const function<bool(Frame *)> &func)
+{
+  for (auto iter = lru_list_.rbegin(); iter != lru_list_.rend(); ++iter) {
+    if (!func(*iter)) {
+      break;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TwoQueueFrameReplacer::TwoQueueFrameReplacer(int capacity)
+{
+  // 论文中推荐 A1in 占 25%，A1out 记录 50% 页帧个数的页面标识
+  capacity        = max(capacity, 1);
+  a1in_max_size_  = max(capacity / 4, 1);
+  a1out_max_size_ = max(capacity / 2, 1);
+}
+
+void TwoQueueFrameReplacer::insert(Frame *frame)
+{
+  auto ghost_iter = a1out_index_.find(frame->frame_id());
+  if (ghost_iter != a1out_index_.end()) {
+    a1out_list_.erase(ghost_iter->second);
+    a1out_index_.erase(ghost_iter);
+
+    am_list_.push_front(frame);
+    index_[frame] = Position{true, am_list_.begin()};
+  } else {
+    a1in_list_.push_front(frame);
+    index_[frame] = Position{false, a1in_list_.begin()};
+  }
+}
+
+void TwoQueueFrameReplacer::touch(Frame *frame)
+{
+  auto iter = index_.find(frame);
+  if (iter == index_.end() || !iter->second.in_am) {
+    return;
+  }
+
+  am_list_.splice(am_list_.begin(), am_list_, iter->second.iter);
+}
+
+void TwoQueueFrameReplacer::remove(Frame *frame, bool evicted)
+{
+  auto iter = index_.find(frame);
+  if (iter == index_.end()) {
+    return;
+  }
+
+  if (iter->second.in_am) {
+    am_list_.erase(iter->second.iter);
+  } else {
+    a1in_list_.erase(iter->second.iter);
+    // 只记住真正被淘汰的页面。被删除的页面即使页号被重新使用，也是一个新的页面
+    if (evicted) {
+      remember_evicted(frame->frame_id());
+    }
+  }
+  index_.erase(iter);
+}
+
+void TwoQueueFrameReplacer::remember_evicted(const FrameId &frame_id)
+{
+  a1out_list_.push_front(frame_id);
+  a1out_index_[frame_id] = a1out_list_.begin();
+
+  while (a1out_list_.size() > a1out_max_size_) {
+    a1out_index_.erase(a1out_list_.back());
+    a1out_list_.pop_back();
+  }
+}
+
+void TwoQueueFrameReplacer::foreach_victim(const function<bool(Frame *)> &func)
+{
+  auto visit = [&func](list<Frame *> &frames) {
+    for (auto iter = frames.rbegin(); iter != frames.rend(); ++iter) {
+      if (!func(*iter)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // A1in 超过目标大小时优先淘汰A1in中最早加载的页面，否则淘汰Am中最久没有访问的页面
+  if (a1in_list_.size() > a1in_max_size_ || am_list_.empty()) {
+    if (visit(a1in_list_)) {
+      visit(am_list_);
+    }
+  } else {
+    if (visit(am_list_)) {
+      visit(a1in_list_);
+    }
+  }
+}
@@ -0,0 +1,136 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/functional.h"
+#include "common/lang/list.h"
+#include "common/lang/unordered_map.h"
+#include "common/rc.h"
+#include "storage/buffer/frame.h"
+
+/**
+ * @brief 页帧淘汰策略
+ * @ingroup BufferPool
+ * @details 决定内存不足时先淘汰哪些页帧。BPFrameManager 的每个分区都有一个淘汰策略对象，
+ * 调用时总是持有分区的锁，所以这里的实现都不需要考虑并发。
+ * 淘汰策略只负责给出淘汰顺序，页帧是否真的可以淘汰(比如pin count是否为0)由调用者判断。
+ */
+class FrameReplacer
+{
+public:
+  virtual ~FrameReplacer() = default;
+
+  virtual const char *name() const = 0;
+
+  /**
+   * @brief 一个新的页面被加载到页帧中
+   */
+  virtual void insert(Frame *frame) = 0;
+
+  /**
+   * @brief 访问了一个已经在内存中的页面
+   */
+  virtual void touch(Frame *frame) = 0;
+
+  /**
+   * @brief 页帧被释放(淘汰或者页面被删除)
+   * @details 调用时页帧中的 FrameId 依然有效
+   * @param evicted 是否因为缓存不够被淘汰。页面被删除或者加载失败时为 false
+   */
+  virtual void remove(Frame *frame, bool evicted) = 0;
+
+  /**
+   * @brief 按照淘汰的优先级从高到低遍历页帧
+   * @param func 返回false时停止遍历
+   */
+  virtual void foreach_victim(const function<bool(Frame *)> &func) = 0;
+
+  /**
+   * @brief 根据名字创建淘汰策略
+   *
+   * @param name 策略名字，当前支持 lru 和 2q，为空时使用 lru
+   * @param capacity 预计管理的页帧个数，有些策略需要根据它来确定各个队列的大小
+   * @param replacer 创建出来的对象
+   */
+  static RC create(const char *name, int capacity, FrameReplacer *&replacer);
+};
+
+/**
+ * @brief 最简单的LRU淘汰策略
+ * @ingroup BufferPool
+ * @details 一次全表扫描就会把所有的热点页面都淘汰出去。
+ */
+class LruFrameReplacer : public FrameReplacer
+{
+public:
+  LruFrameReplacer()          = default;
+  virtual ~LruFrameReplacer() = default;
+
+  const char *name() const override { return "lru"; }
+
+  void insert(Frame *frame) override;
+  void touch(Frame *frame) override;
+  void remove(Frame *frame, bool evicted) override;
+  void foreach_victim(const function<bool(Frame *)> &func) override;
+
+private:
+  list<Frame *>                                    lru_list_;  ///< 头部是最近访问过的
+  unordered_map<Frame *, list<Frame *>::iterator> index_;
+};
+
+/**
+ * @brief 2Q 淘汰策略，可以抵抗全表扫描对缓存的污染
+ * @ingroup BufferPool
+ * @details 参考 Johnson & Shasha, "2Q: A Low Overhead High Performance Buffer Management Replacement Algorithm"。
+ * 第一次加载的页面放在 A1in 先进先出队列中，在 A1in 中再次访问不会改变它的位置，因为这通常是同一次操作
+ * 中的相关访问。从 A1in 淘汰的页面会在 A1out 中记住页面标识(不占用页帧)，如果在 A1out 中的页面又被访问了，
+ * 说明这是一个真正的热点页面，就放到 Am LRU 队列中。
+ * 全表扫描的页面只会访问一次，只会在 A1in 中流转，不会把 Am 中的热点页面挤出去。
+ */
+class TwoQueueFrameReplacer : public FrameReplacer
+{
+public:
+  explicit TwoQueueFrameReplacer(int capacity);
+  virtual ~TwoQueueFrameReplacer() = default;
+
+  const char *name() const override { return "2q"; }
+
+  void insert(Frame *frame) override;
+  void touch(Frame *frame) override;
+  void remove(Frame *frame, bool evicted) override;
+  void foreach_victim(const function<bool(Frame *)> &func) override;
+
+private:
+  class FrameIdHasher
+  {
+  public:
+    size_t operator()(const FrameId &frame_id) const { return frame_id.hash(); }
+  };
+
+  struct Position
+  {
+    bool                     in_am;  ///< 在Am队列还是A1in队列中
+    list<Frame *>::iterator  iter;
+  };
+
+  void remember_evicted(const FrameId &frame_id);
+
+private:
+  size_t a1in_max_size_;   ///< A1in 的目标大小，超过时优先从A1in中淘汰
+  size_t a1out_max_size_;  ///< A1out 中最多记录多少个页面标识
+
+  list<Frame *>                   a1in_list_;  ///< 头部是最新加载的
+  list<Frame *>                   am_list_;    ///< 头部是最近访问过的
+  unordered_map<Frame *, Position> index_;
+
+  list<FrameId>                                                    a1out_list_;  ///< 头部是最近淘汰的
+  unordered_map<FrameId, list<FrameId>::iterator, FrameIdHasher> a1out_index_;
+};
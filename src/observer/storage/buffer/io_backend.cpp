@@ -0,0 +1,438 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+#include <unistd.h>
+
+#if defined(LINUX) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define MINIOB_HAVE_IO_URING 1
+#endif
+
+#include "storage/buffer/io_backend.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/string.h"
+#include "common/log/log.h"
+
+AlignedBuffer::~AlignedBuffer() { free(data_); }
+
+RC AlignedBuffer::init(size_t size)
+{
+  free(data_);
+  data_ = nullptr;
+  size_ = 0;
+
+  const size_t aligned_size = (size + BP_IO_ALIGN - 1) / BP_IO_ALIGN * BP_IO_ALIGN;
+  if (aligned_size == 0) {
+    return RC::SUCCESS;
+  }
+
+  data_ = static_cast<char *>(aligned_alloc(BP_IO_ALIGN, aligned_size));
+  if (data_ == nullptr) {
+    LOG_ERROR("failed to allocate aligned memory. size=%ld", aligned_size);
+    return RC::NOMEM;
+  }
+  size_ = aligned_size;
+  return RC::SUCCESS;
+}
+
+RC IoBackend::create(const char *name, unique_ptr<IoBackend> &backend)
+{
+  if (name == nullptr || common::is_blank(name)) {
+    name = "psync";
+  }
+
+  if (strcasecmp(name, "psync") == 0) {
+    backend = make_unique<PsyncIoBackend>();
+  } else if (strcasecmp(name, "io_uring") == 0) {
+    auto io_uring_backend = make_unique<IoUringBackend>();
+    RC   rc               = io_uring_backend->init();
+    if (OB_FAIL(rc)) {
+      LOG_WARN("io_uring is not supported, use psync instead. rc=%s", strrc(rc));
+      backend = make_unique<PsyncIoBackend>();
+    } else {
+      backend = std::move(io_uring_backend);
+    }
+  } else {
+    LOG_ERROR("unknown io backend name. name=%s", name);
+    return RC::INVALID_ARGUMENT;
+  }
+  return RC::SUCCESS;
+}
+
+RC IoBackend::read(int fd, int64_t offset, void *buffer, int size)
+{
+  for (int done = 0; done < size;) {
+    ssize_t ret = pread(fd, static_cast<char *>(buffer) + done, size - done, offset + done);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      LOG_WARN("failed to read. fd=%d, offset=%ld, size=%d, error=%s", fd, offset, size, strerror(errno));
+      return RC::IOERR_READ;
+    }
+    if (ret == 0) {
+      LOG_WARN("read to the end of file. fd=%d, offset=%ld, size=%d, done=%d", fd, offset, size, done);
+      return RC::IOERR_READ;
+    }
+    done += ret;
+  }
+  return RC::SUCCESS;
+}
+
+RC IoBackend::write(int fd, int64_t offset, const void *buffer, int size)
+{
+  for (int done = 0; done < size;) {
+    ssize_t ret = pwrite(fd, static_cast<const char *>(buffer) + done, size - done, offset + done);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      LOG_WARN("failed to write. fd=%d, offset=%ld, size=%d, error=%s", fd, offset, size, strerror(errno));
+      return RC::IOERR_WRITE;
+    }
+    done += ret;
+  }
+  return RC::SUCCESS;
+}
+
+RC IoBackend::submit_batch(bool write, span<IoRequest> requests)
+{
+  if (requests.empty()) {
+    return RC::SUCCESS;
+  }
+
+  // 文件相同、位置连续的请求合并成一次向量读写
+  vector<IoRun> runs;
+  for (size_t i = 0; i < requests.size(); i++) {
+    IoRequest &request = requests[i];
+    if (runs.empty() || runs.back().fd != request.fd || runs.back().offset + runs.back().size != request.offset ||
+        runs.back().iovecs.size() >= IOV_MAX) {
+      IoRun &run = runs.emplace_back();
+      run.fd     = request.fd;
+      run.offset = request.offset;
+      run.first  = i;
+    }
+
+    IoRun &run = runs.back();
+    run.iovecs.push_back(iovec{request.buffer, static_cast<size_t>(request.size)});
+    run.size += request.size;
+    run.count++;
+  }
+
+  submit_runs(write, runs);
+
+  RC rc = RC::SUCCESS;
+  for (IoRun &run : runs) {
+    if (run.result != run.size) {
+      // 被信号中断或者没有读写完整，再同步执行一次
+      run.result = run_sync(write, run);
+    }
+
+    RC run_rc = RC::SUCCESS;
+    if (run.result != run.size) {
+      LOG_WARN("failed to %s. fd=%d, offset=%ld, size=%ld, result=%ld, error=%s",
+               write ? "write" : "read", run.fd, run.offset, run.size, run.result,
+               run.result < 0 ? strerror(static_cast<int>(-run.result)) : "short io");
+      run_rc = write ? RC::IOERR_WRITE : RC::IOERR_READ;
+      if (OB_SUCC(rc)) {
+        rc = run_rc;
+      }
+    }
+
+    for (size_t i = run.first; i < run.first + run.count; i++) {
+      requests[i].rc = run_rc;
+    }
+  }
+  return rc;
+}
+
+int64_t IoBackend::run_sync(bool write, IoRun &run)
+{
+  vector<iovec> iovecs = run.iovecs;
+  iovec        *iov    = iovecs.data();
+  int           iovcnt = static_cast<int>(iovecs.size());
+
+  int64_t done = 0;
+  while (done < run.size) {
+    ssize_t ret = write ? pwritev(run.fd, iov, iovcnt, run.offset + done) : preadv(run.fd, iov, iovcnt, run.offset + done);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return -errno;
+    }
+    if (ret == 0) {
+      break;
+    }
+
+    done += ret;
+    // 跳过已经完成的部分
+    while (iovcnt > 0 && static_cast<size_t>(ret) >= iov->iov_len) {
+      ret -= iov->iov_len;
+      iov++;
+      iovcnt--;
+    }
+    if (iovcnt > 0) {
+      iov->iov_base = static_cast<char *>(iov->iov_base) + ret;
+      iov->iov_len -= ret;
+    }
+  }
+  return done;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void PsyncIoBackend::submit_runs(bool write, vector<IoRun> &runs)
+{
+  for (IoRun &run : runs) {
+    run.result = run_sync(write, run);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef MINIOB_HAVE_IO_URING
+
+/**
+ * @brief 一个 io_uring 实例
+ * @details 提交队列和完成队列都是和内核共享的环形缓冲区，这里只有一个线程使用，
+ * 只需要在读写头尾指针时使用 acquire/release 语义与内核同步。
+ */
+class IoUring
+{
+public:
+  IoUring() = default;
+  ~IoUring()
+  {
+    if (sqes_ != nullptr) {
+      munmap(sqes_, sqes_size_);
+    }
+    if (cq_ptr_ != nullptr && cq_ptr_ != sq_ptr_) {
+      munmap(cq_ptr_, cq_size_);
+    }
+    if (sq_ptr_ != nullptr) {
+      munmap(sq_ptr_, sq_size_);
+    }
+    if (ring_fd_ >= 0) {
+      close(ring_fd_);
+    }
+  }
+
+  RC init(unsigned entries)
+  {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (ring_fd_ < 0) {
+      LOG_WARN("failed to setup io_uring. error=%s", strerror(errno));
+      return RC::UNSUPPORTED;
+    }
+
+    sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+      sq_size_ = cq_size_ = max(sq_size_, cq_size_);
+    }
+
+    sq_ptr_ = mmap(nullptr, sq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+    if (sq_ptr_ == MAP_FAILED) {
+      sq_ptr_ = nullptr;
+      LOG_WARN("failed to mmap io_uring sq ring. error=%s", strerror(errno));
+      return RC::IOERR_ACCESS;
+    }
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+      cq_ptr_ = sq_ptr_;
+    } else {
+      cq_ptr_ = mmap(nullptr, cq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+      if (cq_ptr_ == MAP_FAILED) {
+        cq_ptr_ = nullptr;
+        LOG_WARN("failed to mmap io_uring cq ring. error=%s", strerror(errno));
+        return RC::IOERR_ACCESS;
+      }
+    }
+
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    void *sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+      LOG_WARN("failed to mmap io_uring sqes. error=%s", strerror(errno));
+      return RC::IOERR_ACCESS;
+    }
+    sqes_ = static_cast<io_uring_sqe *>(sqes);
+
+    char *sq_ptr = static_cast<char *>(sq_ptr_);
+    sq_tail_     = reinterpret_cast<unsigned *>(sq_ptr + params.sq_off.tail);
+    sq_mask_     = *reinterpret_cast<unsigned *>(sq_ptr + params.sq_off.ring_mask);
+    sq_array_    = reinterpret_cast<unsigned *>(sq_ptr + params.sq_off.array);
+    sq_entries_  = params.sq_entries;
+
+    char *cq_ptr = static_cast<char *>(cq_ptr_);
+    cq_head_     = reinterpret_cast<unsigned *>(cq_ptr + params.cq_off.head);
+    cq_tail_     = reinterpret_cast<unsigned *>(cq_ptr + params.cq_off.tail);
+    cq_mask_     = *reinterpret_cast<unsigned *>(cq_ptr + params.cq_off.ring_mask);
+    cqes_        = reinterpret_cast<io_uring_cqe *>(cq_ptr + params.cq_off.cqes);
+    return RC::SUCCESS;
+  }
+
+  /**
+   * @brief 提交所有的请求并等待完成
+   * @details 请求个数超过队列长度时，分多次提交。没有完成的请求结果保持不变，调用者会同步重试
+   * @return 出现了无法恢复的错误时返回false，这时可能还有请求没有完成，不能再释放这个实例
+   */
+  bool submit_and_wait(bool write, vector<IoBackend::IoRun> &runs)
+  {
+    for (size_t begin = 0; begin < runs.size();) {
+      const size_t end = min(runs.size(), begin + sq_entries_);
+
+      unsigned tail = *sq_tail_;
+      for (size_t i = begin; i < end; i++) {
+        const unsigned index = tail & sq_mask_;
+        io_uring_sqe  *sqe   = &sqes_[index];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode      = write ? IORING_OP_WRITEV : IORING_OP_READV;
+        sqe->fd          = runs[i].fd;
+        sqe->addr        = reinterpret_cast<uint64_t>(runs[i].iovecs.data());
+        sqe->len         = static_cast<unsigned>(runs[i].iovecs.size());
+        sqe->off         = static_cast<uint64_t>(runs[i].offset);
+        sqe->user_data   = i;
+        sq_array_[index] = index;
+        tail++;
+      }
+      __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+
+      unsigned to_submit = static_cast<unsigned>(end - begin);
+      unsigned inflight  = 0;
+      while (to_submit > 0 || inflight > 0) {
+        int ret = static_cast<int>(syscall(
+            __NR_io_uring_enter, ring_fd_, to_submit, to_submit + inflight, IORING_ENTER_GETEVENTS, nullptr, 0));
+        if (ret >= 0) {
+          to_submit -= static_cast<unsigned>(ret);
+          inflight += static_cast<unsigned>(ret);
+        } else if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+          LOG_WARN("failed to enter io_uring. error=%s", strerror(errno));
+          if (to_submit == 0) {
+            return false;
+          }
+          // 没有使用 SQPOLL，内核只在 io_uring_enter 中消费提交队列，可以把还没有提交的请求撤回来
+          __atomic_store_n(sq_tail_, tail - to_submit, __ATOMIC_RELEASE);
+          to_submit = 0;
+        }
+
+        unsigned head  = *cq_head_;
+        unsigned ctail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        for (; head != ctail; head++) {
+          io_uring_cqe *cqe = &cqes_[head & cq_mask_];
+          runs[cqe->user_data].result = cqe->res;
+          inflight--;
+        }
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+      }
+
+      begin = end;
+    }
+    return true;
+  }
+
+private:
+  int    ring_fd_   = -1;
+  void  *sq_ptr_    = nullptr;
+  void  *cq_ptr_    = nullptr;
+  size_t sq_size_   = 0;
+  size_t cq_size_   = 0;
+  size_t sqes_size_ = 0;
+
+  io_uring_sqe *sqes_       = nullptr;
+  unsigned     *sq_tail_    = nullptr;
+  unsigned      sq_mask_    = 0;
+  unsigned     *sq_array_   = nullptr;
+  unsigned      sq_entries_ = 0;
+
+  unsigned     *cq_head_ = nullptr;
+  unsigned     *cq_tail_ = nullptr;
+  unsigned      cq_mask_ = 0;
+  io_uring_cqe *cqes_    = nullptr;
+};
+
+#else  // MINIOB_HAVE_IO_URING
+
+class IoUring
+{
+public:
+  RC init(unsigned entries) { return RC::UNSUPPORTED; }
+
+  bool submit_and_wait(bool write, vector<IoBackend::IoRun> &runs) { return true; }
+};
+
+#endif  // MINIOB_HAVE_IO_URING
+
+IoUringBackend::IoUringBackend() = default;
+
+IoUringBackend::~IoUringBackend() = default;
+
+RC IoUringBackend::init()
+{
+  unique_ptr<IoUring> ring;
+  RC                  rc = acquire(ring);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  release(std::move(ring));
+  return RC::SUCCESS;
+}
+
+RC IoUringBackend::acquire(unique_ptr<IoUring> &ring)
+{
+  {
+    lock_guard<mutex> guard(lock_);
+    if (!idle_rings_.empty()) {
+      ring = std::move(idle_rings_.back());
+      idle_rings_.pop_back();
+      return RC::SUCCESS;
+    }
+  }
+
+  ring  = make_unique<IoUring>();
+  RC rc = ring->init(RING_ENTRIES);
+  if (OB_FAIL(rc)) {
+    ring.reset();
+  }
+  return rc;
+}
+
+void IoUringBackend::release(unique_ptr<IoUring> ring)
+{
+  lock_guard<mutex> guard(lock_);
+  if (idle_rings_.size() < MAX_IDLE_RING) {
+    idle_rings_.push_back(std::move(ring));
+  }
+}
+
+void IoUringBackend::submit_runs(bool write, vector<IoRun> &runs)
+{
+  unique_ptr<IoUring> ring;
+  if (OB_FAIL(acquire(ring))) {
+    // 结果保持为0，会同步重试
+    return;
+  }
+
+  if (!ring->submit_and_wait(write, runs)) {
+    // 内核可能还在使用这个实例中的请求，不能关闭它
+    LOG_ERROR("io_uring is broken, leak it");
+    (void)ring.release();
+    return;
+  }
+  release(std::move(ring));
+}
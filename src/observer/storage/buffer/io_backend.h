@@ -0,0 +1,183 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <sys/uio.h>
+
+#include "common/lang/memory.h"
+#include "common/lang/mutex.h"
+#include "common/lang/span.h"
+#include "common/lang/vector.h"
+#include "common/rc.h"
+#include "storage/buffer/page.h"
+
+/**
+ * @brief 按照 BP_IO_ALIGN 对齐的一段内存
+ * @ingroup BufferPool
+ * @details 使用 O_DIRECT 读写文件时，内存地址需要对齐，页帧、预读等使用的页面内存都从这里申请。
+ */
+class AlignedBuffer
+{
+public:
+  AlignedBuffer() = default;
+  ~AlignedBuffer();
+
+  AlignedBuffer(const AlignedBuffer &)            = delete;
+  AlignedBuffer &operator=(const AlignedBuffer &) = delete;
+
+  /**
+   * @brief 申请内存，原来的内存会释放掉
+   * @details 大小会向上对齐到 BP_IO_ALIGN，申请出来的内存没有初始化
+   */
+  RC init(size_t size);
+
+  char  *data() { return data_; }
+  size_t size() const { return size_; }
+
+  Page *pages() { return reinterpret_cast<Page *>(data_); }
+
+private:
+  char  *data_ = nullptr;
+  size_t size_ = 0;
+};
+
+/**
+ * @brief 一次读写请求
+ * @ingroup BufferPool
+ */
+struct IoRequest
+{
+  int     fd     = -1;
+  int64_t offset = 0;
+  void   *buffer = nullptr;
+  int     size   = 0;
+  RC      rc     = RC::SUCCESS;  ///< 执行结果，由IoBackend填写
+};
+
+/**
+ * @brief 页面读写的后端
+ * @ingroup BufferPool
+ * @details 单个页面的读写直接使用 pread/pwrite，批量读写由具体的实现决定如何提交。
+ * 批量请求中文件相同、位置连续的请求会合并成一次向量读写。
+ * 批量读写的使用者有：预读、double write buffer 把页面写回数据文件(包括后台刷脏触发的写回)。
+ * 所有的接口都是线程安全的。
+ */
+class IoBackend
+{
+public:
+  virtual ~IoBackend() = default;
+
+  virtual const char *name() const = 0;
+
+  /**
+   * @brief 读取指定位置的数据，读到文件末尾时返回 RC::IOERR_READ
+   */
+  RC read(int fd, int64_t offset, void *buffer, int size);
+  RC write(int fd, int64_t offset, const void *buffer, int size);
+
+  /**
+   * @brief 批量读写，等待所有请求完成后返回
+   * @details 每个请求的结果记录在请求的 rc 中
+   * @return 所有请求都成功时返回 RC::SUCCESS，否则返回第一个失败的请求结果
+   */
+  RC read_batch(span<IoRequest> requests) { return submit_batch(false /*write*/, requests); }
+  RC write_batch(span<IoRequest> requests) { return submit_batch(true /*write*/, requests); }
+
+  /**
+   * @brief 根据名字创建读写后端
+   * @details 当前支持 psync 和 io_uring，为空时使用 psync。
+   * 系统不支持 io_uring 时(比如内核版本太低或者被安全策略禁止)，会退化成 psync。
+   */
+  static RC create(const char *name, unique_ptr<IoBackend> &backend);
+
+public:
+  /**
+   * @brief 合并后的一次向量读写
+   */
+  struct IoRun
+  {
+    int           fd     = -1;
+    int64_t       offset = 0;
+    int64_t       size   = 0;
+    vector<iovec> iovecs;
+    size_t        first  = 0;  ///< 第一个请求的下标
+    size_t        count  = 0;  ///< 合并了多少个请求
+    int64_t       result = 0;  ///< 读写的字节数，失败时是 -errno
+  };
+
+protected:
+  /**
+   * @brief 执行合并后的读写请求，把结果填写到 IoRun::result 中
+   * @details 没有读写完整的请求，会再同步执行一遍
+   */
+  virtual void submit_runs(bool write, vector<IoRun> &runs) = 0;
+
+  /**
+   * @brief 同步执行一次向量读写，直到全部完成或者出错
+   */
+  static int64_t run_sync(bool write, IoRun &run);
+
+private:
+  RC submit_batch(bool write, span<IoRequest> requests);
+};
+
+/**
+ * @brief 使用 preadv/pwritev 的读写后端，每次向量读写一次系统调用
+ * @ingroup BufferPool
+ */
+class PsyncIoBackend : public IoBackend
+{
+public:
+  PsyncIoBackend()          = default;
+  virtual ~PsyncIoBackend() = default;
+
+  const char *name() const override { return "psync"; }
+
+protected:
+  void submit_runs(bool write, vector<IoRun> &runs) override;
+};
+
+class IoUring;
+
+/**
+ * @brief 使用 io_uring 的读写后端
+ * @ingroup BufferPool
+ * @details 一批请求一次提交，内核并发执行，再一起等待完成，即使页面不连续，也只需要一两次系统调用。
+ * 每次批量读写从空闲列表中拿一个 io_uring 实例，用完再放回去，多个线程可以同时提交。
+ * 没有使用 liburing，直接调用系统调用，不需要额外的依赖。
+ */
+class IoUringBackend : public IoBackend
+{
+public:
+  IoUringBackend();
+  virtual ~IoUringBackend();
+
+  const char *name() const override { return "io_uring"; }
+
+  /**
+   * @brief 检查系统是否支持 io_uring
+   */
+  RC init();
+
+protected:
+  void submit_runs(bool write, vector<IoRun> &runs) override;
+
+private:
+  RC   acquire(unique_ptr<IoUring> &ring);
+  void release(unique_ptr<IoUring> ring);
+
+private:
+  static constexpr unsigned RING_ENTRIES  = 64;
+  static constexpr size_t   MAX_IDLE_RING = 8;
+
+  mutex                       lock_;
+  vector<unique_ptr<IoUring>> idle_rings_;
+};
@@ -36,3 +36,8 @@ struct Page
   CheckSum check_sum;
   char     data[BP_PAGE_DATA_SIZE];
 };
+
+static_assert(sizeof(Page) == BP_PAGE_SIZE, "page size must be BP_PAGE_SIZE");
+
+/// 使用 O_DIRECT 读写文件时，内存地址、文件偏移和读写长度都需要按照这个大小对齐
+static constexpr const int BP_IO_ALIGN = 4096;
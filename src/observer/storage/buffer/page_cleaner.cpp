@@ -0,0 +1,164 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/buffer/page_cleaner.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/chrono.h"
+#include "common/log/log.h"
+#include "common/thread/thread_util.h"
+#include "storage/buffer/disk_buffer_pool.h"
+
+using namespace common;
+
+PageCleaner::PageCleaner(BufferPoolManager &bp_manager, BPFrameManager &frame_manager)
+    : bp_manager_(bp_manager), frame_manager_(frame_manager)
+{}
+
+PageCleaner::~PageCleaner() { stop(); }
+
+RC PageCleaner::start(const Options &options)
+{
+  if (!options.enabled) {
+    LOG_INFO("page cleaner is disabled");
+    return RC::SUCCESS;
+  }
+
+#ifndef CONCURRENCY
+  LOG_WARN("page cleaner is only supported when CONCURRENCY is enabled");
+  return RC::UNSUPPORTED;
+#endif
+
+  if (thread_) {
+    LOG_ERROR("page cleaner has been started");
+    return RC::INTERNAL;
+  }
+
+  options_ = options;
+  options_.dirty_ratio_percent = max(0, min(options_.dirty_ratio_percent, 100));
+  options_.clean_frame_reserve = max(0, options_.clean_frame_reserve);
+  options_.interval_ms         = max(1, options_.interval_ms);
+
+  running_.store(true);
+  thread_ = make_unique<thread>(&PageCleaner::thread_func, this);
+  LOG_INFO("page cleaner started. dirty ratio=%d%%, clean frame reserve=%d, interval=%dms",
+           options_.dirty_ratio_percent, options_.clean_frame_reserve, options_.interval_ms);
+  return RC::SUCCESS;
+}
+
+RC PageCleaner::stop()
+{
+  if (!thread_) {
+    return RC::SUCCESS;
+  }
+
+  running_.store(false);
+  wakeup();
+
+  thread_->join();
+  thread_.reset();
+  LOG_INFO("page cleaner stopped");
+  return RC::SUCCESS;
+}
+
+void PageCleaner::wakeup()
+{
+  {
+    lock_guard<mutex> guard(wakeup_lock_);
+    wakeup_ = true;
+  }
+  wakeup_cv_.notify_one();
+}
+
+unique_lock<mutex> PageCleaner::pause() { return unique_lock<mutex>(round_lock_); }
+
+void PageCleaner::thread_func()
+{
+  thread_set_name("PageCleaner");
+  LOG_INFO("page cleaner thread started");
+
+  while (running_.load()) {
+    {
+      unique_lock<mutex> guard(wakeup_lock_);
+      wakeup_cv_.wait_for(guard, chrono::milliseconds(options_.interval_ms), [this]() { return wakeup_; });
+      wakeup_ = false;
+    }
+
+    if (!running_.load()) {
+      break;
+    }
+
+    clean();
+  }
+
+  LOG_INFO("page cleaner thread exit");
+}
+
+int PageCleaner::clean()
+{
+  lock_guard<mutex> round_guard(round_lock_);
+  // 这一轮会pin住各个文件的页帧，不允许这期间关闭文件
+  shared_lock<common::SharedMutex> file_guard(bp_manager_.file_lifetime_lock());
+
+  const int victim_depth = max(1, options_.clean_frame_reserve / max(1, frame_manager_.partition_num()));
+
+  // 先不 pin 页帧，只统计脏页帧的个数，脏页比例没有超过目标值时只需要 pin 淘汰顺序靠前的页帧
+  const int64_t total_count  = static_cast<int64_t>(frame_manager_.total_frame_num());
+  const int64_t dirty_count  = static_cast<int64_t>(frame_manager_.dirty_frame_num());
+  const int64_t target_count = total_count * options_.dirty_ratio_percent / 100;
+  const int64_t extra_count  = max(static_cast<int64_t>(0), dirty_count - target_count);
+
+  vector<Frame *> victim_frames;
+  vector<Frame *> other_frames;
+  frame_manager_.find_dirty_frames(victim_depth, static_cast<size_t>(extra_count), victim_frames, other_frames);
+
+  // 先刷最老的页面，它们的日志通常已经落盘了，不需要在 wait_lsn 上等待
+  sort(victim_frames.begin(), victim_frames.end(), [](Frame *a, Frame *b) { return a->lsn() < b->lsn(); });
+  sort(other_frames.begin(), other_frames.end(), [](Frame *a, Frame *b) { return a->lsn() < b->lsn(); });
+
+  int flushed_count = 0;
+  for (Frame *frame : victim_frames) {
+    flushed_count += flush_frame(frame) ? 1 : 0;
+  }
+
+  for (int64_t i = 0; i < static_cast<int64_t>(other_frames.size()); i++) {
+    Frame *frame = other_frames[i];
+    if (i < extra_count) {
+      flushed_count += flush_frame(frame) ? 1 : 0;
+    } else {
+      frame->unpin();
+    }
+  }
+
+  if (flushed_count > 0) {
+    LOG_DEBUG("page cleaner flushed %d pages. dirty=%ld, target=%ld, total=%ld",
+              flushed_count, dirty_count, target_count, total_count);
+  }
+  return flushed_count;
+}
+
+bool PageCleaner::flush_frame(Frame *frame)
+{
+  bool flushed = false;
+  // 有人在修改页面时就跳过，不能把修改了一半的页面刷到磁盘上，也不能在这里等待，防止死锁
+  if (frame->try_read_latch()) {
+    if (frame->dirty()) {
+      RC rc = bp_manager_.flush_page(*frame);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("page cleaner failed to flush page. frame=%s, rc=%s", frame->to_string().c_str(), strrc(rc));
+      } else {
+        flushed = true;
+      }
+    }
+    frame->read_unlatch();
+  }
+
+  frame->unpin();
+  return flushed;
+}
@@ -0,0 +1,97 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/atomic.h"
+#include "common/lang/memory.h"
+#include "common/lang/mutex.h"
+#include "common/lang/thread.h"
+#include "common/lang/vector.h"
+#include "common/rc.h"
+
+class BufferPoolManager;
+class BPFrameManager;
+class Frame;
+
+/**
+ * @brief 后台刷脏页
+ * @ingroup BufferPool
+ * @details 没有后台刷脏时，只有在淘汰页面或者 flush_all_pages 时才会把脏页写到磁盘，
+ * 前台请求需要空闲页帧时就要同步等待写盘(包括 double write buffer)。
+ * PageCleaner 在后台线程中周期性地做两件事情：
+ * 1. 每个分区中淘汰顺序最靠前的一些页帧如果是脏的，就刷到磁盘，保证淘汰时总有干净的页帧可用；
+ * 2. 脏页比例超过目标值时，按照LSN从小到大刷新脏页，直到脏页比例回到目标值以下。
+ * 刷页面时会调用 LogHandler::wait_lsn 保证日志先落盘(WAL)，因为按照LSN从小到大刷，通常不需要等待。
+ *
+ * 后台线程会和前台线程并发访问页面，所以只在CONCURRENCY编译模式下才会启动。
+ */
+class PageCleaner
+{
+public:
+  struct Options
+  {
+    bool enabled             = false;
+    int  dirty_ratio_percent = 30;   ///< 目标脏页比例
+    int  clean_frame_reserve = 64;   ///< 淘汰顺序最靠前的多少个页帧要保持干净，所有分区加起来
+    int  interval_ms         = 100;  ///< 两次刷脏之间最多间隔多久
+  };
+
+public:
+  PageCleaner(BufferPoolManager &bp_manager, BPFrameManager &frame_manager);
+  ~PageCleaner();
+
+  RC start(const Options &options);
+  RC stop();
+
+  bool running() const { return running_.load(); }
+
+  /**
+   * @brief 唤醒后台线程立即做一次刷脏
+   * @details 淘汰页面时发现只能淘汰脏页帧，说明干净的页帧不够了
+   */
+  void wakeup();
+
+  /**
+   * @brief 暂停后台刷脏，直到返回的锁被释放
+   * @details 只用来暂停刷脏。文件的生命周期由 BufferPoolManager::file_lifetime_lock 保护
+   */
+  unique_lock<mutex> pause();
+
+  /**
+   * @brief 做一轮刷脏
+   * @details 后台线程调用，测试时也可以直接调用
+   * @return 本轮刷新的页面个数
+   */
+  int clean();
+
+private:
+  void thread_func();
+
+  /**
+   * @brief 刷新一个页帧并unpin
+   * @return 是否写了脏页
+   */
+  bool flush_frame(Frame *frame);
+
+private:
+  BufferPoolManager &bp_manager_;
+  BPFrameManager    &frame_manager_;
+  Options            options_;
+
+  atomic<bool>       running_{false};
+  unique_ptr<thread> thread_;
+
+  mutex              wakeup_lock_;
+  condition_variable wakeup_cv_;
+  bool               wakeup_ = false;
+
+  mutex round_lock_;  ///< 每一轮刷脏都持有这个锁
+};
@@ -0,0 +1,78 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+
+#include "storage/buffer/page_compressor.h"
+#include "common/compress/lz_codec.h"
+#include "common/log/log.h"
+#include "common/math/crc.h"
+
+using namespace common;
+
+static_assert(BP_PAGE_SIZE % BP_IO_ALIGN == 0, "page size must be a multiple of BP_IO_ALIGN");
+
+int PageCompressor::compress(const Page &page, char *buffer)
+{
+  constexpr int header_size = static_cast<int>(sizeof(CompressedPageHeader));
+
+  // 压缩以后至少要节省一个 BP_IO_ALIGN，否则没有意义
+  const int capacity = BP_PAGE_SIZE - BP_IO_ALIGN - header_size;
+
+  char *payload         = buffer + header_size;
+  int   compressed_size = LzCodec::compress(reinterpret_cast<const char *>(&page), BP_PAGE_SIZE, payload, capacity);
+  if (compressed_size < 0) {
+    return 0;
+  }
+
+  auto *header            = reinterpret_cast<CompressedPageHeader *>(buffer);
+  header->magic           = CompressedPageHeader::MAGIC;
+  header->compressed_size = compressed_size;
+  header->check_sum       = crc32(payload, compressed_size);
+
+  const int size         = header_size + compressed_size;
+  const int aligned_size = (size + BP_IO_ALIGN - 1) / BP_IO_ALIGN * BP_IO_ALIGN;
+  memset(buffer + size, 0, aligned_size - size);
+  return aligned_size;
+}
+
+bool PageCompressor::is_compressed(const Page &page)
+{
+  return reinterpret_cast<const CompressedPageHeader *>(&page)->magic == CompressedPageHeader::MAGIC;
+}
+
+RC PageCompressor::decompress(Page &page)
+{
+  constexpr int header_size = static_cast<int>(sizeof(CompressedPageHeader));
+
+  const auto *header          = reinterpret_cast<const CompressedPageHeader *>(&page);
+  const int   compressed_size = header->compressed_size;
+  if (compressed_size <= 0 || compressed_size > BP_PAGE_SIZE - header_size) {
+    LOG_WARN("invalid compressed page. compressed size=%d", compressed_size);
+    return RC::IOERR_READ;
+  }
+
+  const char *payload = reinterpret_cast<const char *>(&page) + header_size;
+  if (crc32(payload, compressed_size) != header->check_sum) {
+    LOG_WARN("compressed page check sum mismatch. compressed size=%d", compressed_size);
+    return RC::IOERR_READ;
+  }
+
+  // 压缩数据和解压结果都在页面中，先复制出来
+  char compressed[BP_PAGE_SIZE];
+  memcpy(compressed, payload, compressed_size);
+
+  int size = LzCodec::decompress(compressed, compressed_size, reinterpret_cast<char *>(&page), BP_PAGE_SIZE);
+  if (size != BP_PAGE_SIZE) {
+    LOG_WARN("failed to decompress page. compressed size=%d, decompressed size=%d", compressed_size, size);
+    return RC::IOERR_READ;
+  }
+  return RC::SUCCESS;
+}
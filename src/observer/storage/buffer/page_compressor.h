@@ -0,0 +1,60 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/rc.h"
+#include "storage/buffer/page.h"
+
+/**
+ * @brief 压缩后写到磁盘上的页面头
+ * @ingroup BufferPool
+ * @details magic 与普通页面开头的 LSN 在同一个位置，LSN 不会是负数，所以可以区分两种页面。
+ */
+struct CompressedPageHeader
+{
+  static constexpr int64_t MAGIC = -0x4C5A504147454CLL;
+
+  int64_t  magic;
+  int32_t  compressed_size;  ///< 压缩数据的长度，不包括页面头
+  CheckSum check_sum;        ///< 压缩数据的校验和
+};
+
+/**
+ * @brief 页面压缩
+ * @ingroup BufferPool
+ * @details 开启压缩的文件在写页面时压缩整个页面(包括LSN和校验和)，压缩后的数据仍然放在页面原来的位置，
+ * 只写入按照 BP_IO_ALIGN 对齐以后的长度，页面剩下的部分在文件中打洞(punch hole)释放掉。
+ * 页面在文件中的位置不变，不需要额外的映射表。读取时仍然读取整个页面，文件空洞的部分不会真正读盘。
+ *
+ * 压缩和没有压缩的页面可以在同一个文件中，读取时根据页面头区分，所以关闭压缩以后仍然能读取以前压缩过的页面。
+ * 压缩以后节省不了一个 BP_IO_ALIGN 的页面按照原样写入。
+ */
+class PageCompressor
+{
+public:
+  /**
+   * @brief 压缩页面
+   * @param buffer 压缩结果，至少有 BP_PAGE_SIZE 个字节，剩余部分填0
+   * @return 需要写入磁盘的长度，是 BP_IO_ALIGN 的整数倍。不值得压缩时返回0
+   */
+  static int compress(const Page &page, char *buffer);
+
+  /**
+   * @brief 页面是否是压缩过的
+   */
+  static bool is_compressed(const Page &page);
+
+  /**
+   * @brief 就地解压页面
+   * @return 数据损坏时返回 RC::IOERR_READ
+   */
+  static RC decompress(Page &page);
+};
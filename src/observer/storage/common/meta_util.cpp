@@ -33,6 +33,11 @@ string table_data_file(const char *base_dir, const char *table_name)
   return filesystem::path(base_dir) / (string(table_name) + TABLE_DATA_SUFFIX);
 }
 
+string table_free_space_map_file(const char *base_dir, const char *table_name)
+{
+  return filesystem::path(base_dir) / (string(table_name) + TABLE_FREE_SPACE_MAP_SUFFIX);
+}
+
 string table_index_file(const char *base_dir, const char *table_name, const char *index_name)
 {
   return filesystem::path(base_dir) / (string(table_name) + "-" + index_name + TABLE_INDEX_SUFFIX);
@@ -22,19 +22,69 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/string.h"
 #include "common/log/log.h"
 #include "common/os/path.h"
+#include "common/os/process_param.h"
 #include "common/global_context.h"
+#include "common/ini_setting.h"
+#include "common/conf/ini.h"
 #include "storage/common/meta_util.h"
 #include "storage/table/table.h"
 #include "storage/table/table_meta.h"
 #include "storage/trx/trx.h"
+#include "storage/trx/mvcc_trx.h"
 #include "storage/clog/disk_log_handler.h"
 #include "storage/clog/integrated_log_replayer.h"
 #include "sql/expr/tuple.h"
 
 using namespace common;
 
+/**
+ * @brief 解析开关类型的配置项，true/on/1 表示打开
+ */
+static bool is_option_enabled(const string &value)
+{
+  return strcasecmp(value.c_str(), "true") == 0 || strcasecmp(value.c_str(), "on") == 0 || value == "1";
+}
+
+/**
+ * @brief 解析内存大小，可以带单位 K/M/G，比如 512M
+ */
+static bool parse_memory_size(const string &value, int64_t &size)
+{
+  string  str  = value;
+  int64_t unit = 1;
+  common::strip(str);
+  if (!str.empty()) {
+    switch (toupper(str.back())) {
+      case 'K': unit = 1L << 10; break;
+      case 'M': unit = 1L << 20; break;
+      case 'G': unit = 1L << 30; break;
+      default: break;
+    }
+    if (unit != 1) {
+      str.pop_back();
+    }
+  }
+
+  int64_t number = 0;
+  if (str.empty() || !common::str_to_val(str, number) || number < 0) {
+    return false;
+  }
+  size = number * unit;
+  return true;
+}
+
 Db::~Db()
 {
+  // 后台回收会访问表和事务管理器
+  vacuum_.reset();
+
+  if (buffer_pool_manager_) {
+    // 关闭表之前保存缓冲池中的页面列表，下次启动时预热
+    buffer_pool_manager_->warmer().stop();
+    // 后台刷脏会访问所有打开的文件和日志，需要最先停止
+    buffer_pool_manager_->page_cleaner().stop();
+  }
+
   for (auto &iter : opened_tables_) {
     delete iter.second;
   }
@@ -70,8 +120,35 @@ RC Db::init(const char *name, const char *dbpath, const char *trx_kit_name, cons
 
   trx_kit_.reset(trx_kit);
 
-  buffer_pool_manager_ = make_unique<BufferPoolManager>();
-  auto dblwr_buffer    = make_unique<DiskDoubleWriteBuffer>(*buffer_pool_manager_);
+  // 缓冲池大小，单位是字节。启动参数 -n 优先
+  int64_t      buffer_pool_size = 0;
+  const string size_option      = get_properties()->get(BUFFER_POOL_MEMORY_SIZE, "", BUFFER_POOL);
+  if (!size_option.empty() && !parse_memory_size(size_option, buffer_pool_size)) {
+    LOG_WARN("invalid buffer pool size %s, use the default one", size_option.c_str());
+    buffer_pool_size = 0;
+  }
+  if (common::the_process_param()->buffer_pool_memory_size() > 0) {
+    buffer_pool_size = common::the_process_param()->buffer_pool_memory_size();
+  }
+
+  FrameArenaOptions arena_options;
+  arena_options.huge_page       = is_option_enabled(get_properties()->get(BUFFER_POOL_HUGE_PAGE, "false", BUFFER_POOL));
+  arena_options.numa_interleave = is_option_enabled(get_properties()->get(BUFFER_POOL_NUMA_INTERLEAVE, "false", BUFFER_POOL));
+
+  const string eviction_policy = get_properties()->get(BUFFER_POOL_EVICTION_POLICY, "", BUFFER_POOL);
+  buffer_pool_manager_ = make_unique<BufferPoolManager>(buffer_pool_size, eviction_policy.c_str(), arena_options);
+
+  const string io_backend = get_properties()->get(BUFFER_POOL_IO_BACKEND, "", BUFFER_POOL);
+  rc                      = buffer_pool_manager_->init_io_backend(io_backend.c_str());
+  if (OB_FAIL(rc)) {
+    LOG_WARN("Failed to init io backend %s, use the default one. rc=%s", io_backend.c_str(), strrc(rc));
+    rc = RC::SUCCESS;
+  }
+
+  const string direct_io = get_properties()->get(BUFFER_POOL_DIRECT_IO, "false", BUFFER_POOL);
+  buffer_pool_manager_->set_direct_io(is_option_enabled(direct_io));
+
+  auto dblwr_buffer = make_unique<DiskDoubleWriteBuffer>(*buffer_pool_manager_);
 
   const char      *double_write_buffer_filename  = "dblwr.db";
   filesystem::path double_write_buffer_file_path = filesystem::path(dbpath) / double_write_buffer_filename;
@@ -88,6 +165,21 @@ RC Db::init(const char *name, const char *dbpath, const char *trx_kit_name, cons
     return rc;
   }
 
+  int read_ahead_pages = 0;
+  str_to_val(get_properties()->get(BUFFER_POOL_READ_AHEAD_PAGES, "16", BUFFER_POOL), read_ahead_pages);
+  rc = buffer_pool_manager_->init_read_ahead(read_ahead_pages);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to init read ahead. dbpath=%s, rc=%s", dbpath, strrc(rc));
+    return rc;
+  }
+
+  // 每张表缓存向量数据的大小，单位是字节
+  const string vector_cache_option = get_properties()->get(BUFFER_POOL_VECTOR_CACHE_SIZE, "", BUFFER_POOL);
+  if (!vector_cache_option.empty() && !parse_memory_size(vector_cache_option, vector_cache_size_)) {
+    LOG_WARN("invalid vector cache size %s, use the default one", vector_cache_option.c_str());
+    vector_cache_size_ = VectorDataManager::DEFAULT_CACHE_SIZE;
+  }
+
   filesystem::path clog_path       = filesystem::path(dbpath) / "clog";
   LogHandler      *tmp_log_handler = nullptr;
   rc                               = LogHandler::create(log_handler_name, tmp_log_handler);
@@ -127,6 +219,8 @@ RC Db::init(const char *name, const char *dbpath, const char *trx_kit_name, cons
     return rc;
   }
 
+  system_views_[BufferPoolStatusView::NAME] = make_unique<BufferPoolStatusView>(*buffer_pool_manager_, next_view_id_++);
+
   rc = init_dblwr_buffer();
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to init dblwr buffer. rc = %s", strrc(rc));
@@ -140,12 +234,32 @@ RC Db::init(const char *name, const char *dbpath, const char *trx_kit_name, cons
     return rc;
   }
 
+  rc = start_page_cleaner();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to start page cleaner, run without it. dbpath=%s, rc=%s", dbpath, strrc(rc));
+    rc = RC::SUCCESS;
+  }
+
+  rc = start_warmer();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to start buffer pool warmer, run without it. dbpath=%s, rc=%s", dbpath, strrc(rc));
+    rc = RC::SUCCESS;
+  }
+
+  rc = start_vacuum();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to start mvcc vacuum, run without it. dbpath=%s, rc=%s", dbpath, strrc(rc));
+    rc = RC::SUCCESS;
+  }
+
   return rc;
 }
 
-RC Db::create_table(const char *table_name, span<const AttrInfoSqlNode> attributes, const StorageFormat storage_format)
+RC Db::create_table(
+    const char *table_name, span<const AttrInfoSqlNode> attributes, const StorageFormat storage_format, bool page_compression)
 {
   RC rc = RC::SUCCESS;
+  auto vacuum_guard = pause_vacuum();
   // check table_name
   if (opened_tables_.count(table_name) != 0) {
     LOG_WARN("%s has been opened before.", table_name);
@@ -156,7 +270,8 @@ RC Db::create_table(const char *table_name, span<const AttrInfoSqlNode> attribut
   string  table_file_path = table_meta_file(path_.c_str(), table_name);
   Table  *table           = new Table();
   int32_t table_id        = next_table_id_++;
-  rc = table->create(this, table_id, table_file_path.c_str(), table_name, path_.c_str(), attributes, storage_format);
+  rc = table->create(this, table_id, table_file_path.c_str(), table_name, path_.c_str(), attributes, storage_format,
+      page_compression);
   if (rc != RC::SUCCESS) {
     LOG_ERROR("Failed to create table %s.", table_name);
     delete table;
@@ -170,8 +285,13 @@ RC Db::create_table(const char *table_name, span<const AttrInfoSqlNode> attribut
 
 RC Db::drop_table(const char *table_name)
 {
+  auto vacuum_guard = pause_vacuum();
   Table *table = find_table(table_name);
   assert(table != nullptr);
+  if (opened_tables_.count(table_name) == 0 && system_views_.count(table_name) != 0) {
+    LOG_WARN("cannot drop system table %s", table_name);
+    return RC::INVALID_ARGUMENT;
+  }
   RC rc = table->drop(this, table_name, path_.c_str());
   if (rc != RC::SUCCESS) {
     return rc;
@@ -190,7 +310,16 @@ Table *Db::find_table(const char *table_name) const
   // find view
   // 为了让前端无感支持视图，这里查一下视图。
   auto view = find_view(table_name);
-  return view;
+  if (view != nullptr) {
+    return view;
+  }
+
+  // 系统虚拟表不需要解析视图的定义，所以不在 find_view 中返回
+  auto system_view_iter = system_views_.find(table_name);
+  if (system_view_iter != system_views_.end()) {
+    return system_view_iter->second.get();
+  }
+  return nullptr;
 }
 
 View *Db::find_view(const char *view_name) const
@@ -376,6 +505,62 @@ RC Db::sync()
   return rc;
 }
 
+RC Db::start_page_cleaner()
+{
+  PageCleaner::Options options;
+
+  Ini *properties = get_properties();
+  const string enabled = properties->get(BUFFER_POOL_PAGE_CLEANER, "false", BUFFER_POOL);
+  options.enabled = is_option_enabled(enabled);
+  str_to_val(properties->get(BUFFER_POOL_DIRTY_PAGE_RATIO, "30", BUFFER_POOL), options.dirty_ratio_percent);
+  str_to_val(properties->get(BUFFER_POOL_CLEAN_FRAME_RESERVE, "64", BUFFER_POOL), options.clean_frame_reserve);
+  str_to_val(properties->get(BUFFER_POOL_PAGE_CLEANER_INTERVAL_MS, "100", BUFFER_POOL), options.interval_ms);
+
+  return buffer_pool_manager_->page_cleaner().start(options);
+}
+
+RC Db::start_warmer()
+{
+  BufferPoolWarmer::Options options;
+
+  Ini *properties = get_properties();
+  const string enabled = properties->get(BUFFER_POOL_WARM_UP, "false", BUFFER_POOL);
+  options.enabled   = is_option_enabled(enabled);
+  options.dump_file = (filesystem::path(path_) / "buffer_pool.dump").string();
+  str_to_val(properties->get(BUFFER_POOL_WARM_UP_DUMP_INTERVAL_SEC, "300", BUFFER_POOL), options.dump_interval_sec);
+
+  return buffer_pool_manager_->warmer().start(options);
+}
+
+RC Db::start_vacuum()
+{
+  MvccTrxKit *mvcc_trx_kit = dynamic_cast<MvccTrxKit *>(trx_kit_.get());
+  if (mvcc_trx_kit == nullptr) {
+    return RC::SUCCESS;
+  }
+
+  vacuum_ = make_unique<MvccVacuum>(*this, *mvcc_trx_kit);
+
+  MvccVacuum::Options options;
+
+  Ini *properties = get_properties();
+  const string enabled = properties->get(TRX_VACUUM, "false", TRX);
+  options.enabled = is_option_enabled(enabled);
+  str_to_val(properties->get(TRX_VACUUM_INTERVAL_MS, "1000", TRX), options.interval_ms);
+  str_to_val(properties->get(TRX_VACUUM_PAGES_PER_BATCH, "16", TRX), options.pages_per_batch);
+  str_to_val(properties->get(TRX_VACUUM_BATCH_SLEEP_MS, "1", TRX), options.batch_sleep_ms);
+
+  return vacuum_->start(options);
+}
+
+unique_lock<mutex> Db::pause_vacuum()
+{
+  if (!vacuum_) {
+    return unique_lock<mutex>();
+  }
+  return vacuum_->pause();
+}
+
 RC Db::recover()
 {
   LOG_TRACE("db recover begin. check_point_lsn=%d", check_point_lsn_);
@@ -19,11 +19,15 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/string.h"
 #include "common/lang/unordered_map.h"
 #include "common/lang/memory.h"
+#include "common/lang/mutex.h"
 #include "common/lang/span.h"
 #include "sql/parser/parse_defs.h"
 #include "storage/buffer/disk_buffer_pool.h"
 #include "storage/clog/disk_log_handler.h"
 #include "storage/buffer/double_write_buffer.h"
+#include "storage/trx/mvcc_vacuum.h"
+#include "storage/table/buffer_pool_status_view.h"
+#include "storage/table/vector_data_manager.h"
 #include "storage/table/view.h"
 
 class Table;
@@ -63,9 +67,10 @@ public:
    * @param table_name 表名
    * @param attributes 表的属性
    * @param storage_format 表的存储格式
+   * @param page_compression 表的数据和索引文件是否开启页面压缩
    */
   RC create_table(const char *table_name, span<const AttrInfoSqlNode> attributes,
-      const StorageFormat storage_format = StorageFormat::ROW_FORMAT);
+      const StorageFormat storage_format = StorageFormat::ROW_FORMAT, bool page_compression = false);
 
   RC drop_table(const char *table_name);
   /**
@@ -101,6 +106,18 @@ public:
   /// @brief 获取当前数据库的事务管理器
   TrxKit &trx_kit();
 
+  /// @brief 每张表缓存向量数据页面的内存大小，单位是字节
+  size_t vector_cache_size() const { return static_cast<size_t>(vector_cache_size_); }
+
+  /// @brief 后台回收MVCC删除记录的任务，只有MVCC事务模型才有，没有时返回nullptr
+  MvccVacuum *vacuum() const { return vacuum_.get(); }
+
+  /**
+   * @brief 暂停后台回收，直到返回的锁被释放
+   * @details 创建、删除表和索引时调用，防止后台线程同时访问这张表
+   */
+  unique_lock<mutex> pause_vacuum();
+
 private:
   /// @brief 打开所有的表。在数据库初始化的时候会执行
   RC open_all_tables();
@@ -108,6 +125,12 @@ private:
   RC open_all_views();
   /// @brief 恢复数据。在数据库初始化的时候运行。
   RC recover();
+  /// @brief 按照配置启动后台刷脏线程。在数据库恢复完成后运行。
+  RC start_page_cleaner();
+  /// @brief 按照配置启动缓冲池预热，在后台加载上次关闭前缓存的页面。在数据库恢复完成后运行。
+  RC start_warmer();
+  /// @brief 按照配置启动MVCC记录回收。在数据库恢复完成后运行。
+  RC start_vacuum();
 
   /// @brief 初始化元数据。在数据库初始化的时候，加载元数据
   RC init_meta();
@@ -125,6 +148,11 @@ private:
   unique_ptr<BufferPoolManager>  buffer_pool_manager_;  ///< 当前数据库的buffer pool管理器
   unique_ptr<LogHandler>         log_handler_;          ///< 当前数据库的日志处理器
   unique_ptr<TrxKit>             trx_kit_;              ///< 当前数据库的事务管理器
+  unique_ptr<MvccVacuum>         vacuum_;               ///< 后台回收MVCC删除的记录
+
+  int64_t vector_cache_size_ = VectorDataManager::DEFAULT_CACHE_SIZE;  ///< 每张表缓存向量数据的大小
+
+  unordered_map<string, unique_ptr<View>> system_views_;  ///< 系统虚拟表，比如缓冲池的统计信息，只能查询
 
   /// 给每个table都分配一个ID，用来记录日志。这里假设所有的DDL都不会并发操作，所以相关的数据都不上锁
   int32_t next_table_id_ = 0;
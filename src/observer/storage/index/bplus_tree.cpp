@@ -16,6 +16,7 @@ See the Mulan PSL v2 for more details. */
 #include <span>
 
 #include "storage/index/bplus_tree.h"
+#include "common/lang/algorithm.h"
 #include "common/lang/lower_bound.h"
 #include "common/log/log.h"
 #include "common/global_context.h"
@@ -35,7 +36,7 @@ int calc_internal_page_capacity(const std::vector<int> &attr_lengths)
 {
   int item_size = 0;
   for (int attr_length : attr_lengths) {
-    item_size += attr_length;
+    item_size += attr_length + KEY_NULL_BYTE;  // 和 key_length 一样，每个字段都带有判断 null 的标志位
   }
   item_size += sizeof(PageNum) + sizeof(RID);
   int capacity  = ((int)BP_PAGE_DATA_SIZE - InternalIndexNode::HEADER_SIZE) / item_size;
@@ -46,7 +47,7 @@ int calc_leaf_page_capacity(const std::vector<int> &attr_lengths)
 {
   int item_size = 0;
   for (int attr_length : attr_lengths) {
-    item_size += attr_length;
+    item_size += attr_length + KEY_NULL_BYTE;  // 和 key_length 一样，每个字段都带有判断 null 的标志位
   }
   item_size += sizeof(RID) + sizeof(RID);
   int capacity  = ((int)BP_PAGE_DATA_SIZE - LeafIndexNode::HEADER_SIZE) / item_size;
@@ -1223,6 +1224,15 @@ RC BplusTreeHandler::find_leaf_internal(BplusTreeMiniTransaction &mtr, BplusTree
 {
   LatchMemo &latch_memo = mtr.latch_memo();
 
+  // 读操作先尝试不加锁的乐观查找，冲突太多时再按照crabing protocol加锁查找
+  if (op == BplusTreeOperationType::READ) {
+    RC rc = optimistic_find_leaf(mtr, child_page_getter, frame);
+    if (rc != RC::LOCKED_CONCURRENCY_CONFLICT) {
+      return rc;
+    }
+    LOG_TRACE("optimistic find leaf failed, fall back to crabing protocol");
+  }
+
   // root locked
   if (op != BplusTreeOperationType::READ) {
     latch_memo.xlatch(&root_lock_);
@@ -1256,6 +1266,93 @@ RC BplusTreeHandler::find_leaf_internal(BplusTreeMiniTransaction &mtr, BplusTree
   return RC::SUCCESS;
 }
 
+RC BplusTreeHandler::optimistic_find_leaf(BplusTreeMiniTransaction &mtr,
+    const function<PageNum(InternalIndexNodeHandler &)> &child_page_getter, Frame *&frame)
+{
+  LatchMemo &latch_memo  = mtr.latch_memo();
+  const int  start_point = latch_memo.memo_point();
+
+  // 发现冲突时释放本次查找pin住的页面，从根节点重新开始
+  for (int retry = 0; retry < OPTIMISTIC_READ_RETRY_TIMES; retry++) {
+    if (retry > 0) {
+      latch_memo.release_from(start_point);
+    }
+
+    const uint64_t root_version = root_version_.load(memory_order_acquire);
+    if (root_version % 2 != 0) {
+      continue;
+    }
+
+    const PageNum root_page = file_header_.root_page;
+    if (root_page == BP_INVALID_PAGE_NUM) {
+      if (root_version_.load(memory_order_acquire) != root_version) {
+        continue;
+      }
+      return RC::EMPTY;
+    }
+
+    // 页面读取失败也可能是因为读到的页号已经被释放了，同样当做冲突处理
+    if (OB_FAIL(latch_memo.get_page(root_page, frame))) {
+      continue;
+    }
+
+    uint64_t version = frame->version();
+    if (version % 2 != 0 || root_version_.load(memory_order_acquire) != root_version) {
+      continue;
+    }
+
+    bool conflict = false;
+    while (!conflict) {
+      IndexNodeHandler node(mtr, file_header_, frame);
+      const bool       is_leaf = node.is_leaf();
+      if (is_leaf) {
+        const int leaf_point = latch_memo.memo_point();
+        latch_memo.slatch(frame);
+        if (!frame->validate_version(version)) {
+          conflict = true;
+          break;
+        }
+
+        // 与crabing protocol一样，只保留叶子节点上的pin和锁
+        latch_memo.release_to(leaf_point - 1);
+        return RC::SUCCESS;
+      }
+
+      // 正在被修改的节点可能是不一致的，页号等数据都不能使用
+      const int size = node.size();
+      if (size <= 0 || size > node.max_size()) {
+        conflict = true;
+        break;
+      }
+
+      InternalIndexNodeHandler internal_node(mtr, file_header_, frame);
+      const PageNum            child_page = child_page_getter(internal_node);
+      if (!frame->validate_version(version)) {
+        conflict = true;
+        break;
+      }
+
+      Frame *parent_frame = frame;
+      if (OB_FAIL(latch_memo.get_page(child_page, frame))) {
+        conflict = true;
+        break;
+      }
+
+      // 确认拿到子节点的版本号时，父节点还没有变化，即子节点还是父节点指向的那个页面
+      const uint64_t child_version = frame->version();
+      if (child_version % 2 != 0 || !parent_frame->validate_version(version)) {
+        conflict = true;
+        break;
+      }
+      version = child_version;
+    }
+  }
+
+  latch_memo.release_from(start_point);
+  frame = nullptr;
+  return RC::LOCKED_CONCURRENCY_CONFLICT;
+}
+
 RC BplusTreeHandler::crabing_protocal_fetch_page(
     BplusTreeMiniTransaction &mtr, BplusTreeOperationType op, PageNum page_num, bool is_root_node, Frame *&frame)
 {
@@ -1485,7 +1582,9 @@ void BplusTreeHandler::update_root_page_num_locked(BplusTreeMiniTransaction &mtr
   IndexFileHeader *file_header = reinterpret_cast<IndexFileHeader *>(frame->data());
   mtr.logger().update_root_page(frame, root_page_num, file_header->root_page);
   file_header->root_page = root_page_num;
+  root_version_.fetch_add(1, memory_order_acq_rel);
   file_header_.root_page = root_page_num;
+  root_version_.fetch_add(1, memory_order_release);
   header_dirty_          = true;
   frame->mark_dirty();
   LOG_DEBUG("set root page to %d", root_page_num);
@@ -1549,12 +1648,68 @@ RC BplusTreeHandler::insert_entry(const std::vector<IndexUserKey> &user_keys, co
     return RC::NOMEM;
   }
 
+  return insert_key(static_cast<char *>(pkey.get()), rid);
+}
+
+RC BplusTreeHandler::insert_entries(const std::vector<std::vector<IndexUserKey>> &user_keys_list, span<const RID> rids)
+{
+  if (user_keys_list.size() != rids.size()) {
+    LOG_WARN("Invalid arguments, key count %d does not match rid count %d",
+             static_cast<int>(user_keys_list.size()), static_cast<int>(rids.size()));
+    return RC::INVALID_ARGUMENT;
+  }
+
+  std::vector<common::MemPoolItem::item_unique_ptr> keys;
+  keys.reserve(user_keys_list.size());
+  for (size_t i = 0; i < user_keys_list.size(); i++) {
+    if (user_keys_list[i].empty()) {
+      LOG_WARN("Invalid arguments, key is empty");
+      return RC::INVALID_ARGUMENT;
+    }
+    auto pkey = make_key(user_keys_list[i], &rids[i]);
+    if (pkey == nullptr) {
+      LOG_WARN("Failed to alloc memory for key.");
+      return RC::NOMEM;
+    }
+    keys.push_back(std::move(pkey));
+  }
+
+  // 排序时总是带上RID比较。key_comparator_ 在插入唯一索引时会临时修改，这里用一个副本
+  KeyComparator comparator = key_comparator_;
+  comparator.set_not_compare_rid(false);
+
+  std::vector<int> order(keys.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    order[i] = static_cast<int>(i);
+  }
+  std::sort(order.begin(), order.end(), [&](int a, int b) {
+    return comparator(static_cast<const char *>(keys[a].get()), static_cast<const char *>(keys[b].get())) < 0;
+  });
+
+  RC rc = RC::SUCCESS;
+  for (size_t i = 0; i < order.size(); i++) {
+    const int index = order[i];
+    rc = insert_key(static_cast<const char *>(keys[index].get()), &rids[index]);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("Failed to insert entry in batch, rid:%s. rc=%s", rids[index].to_string().c_str(), strrc(rc));
+      for (size_t j = 0; j < i; j++) {
+        RC rc2 = delete_entry(user_keys_list[order[j]], &rids[order[j]]);
+        if (OB_FAIL(rc2)) {
+          LOG_ERROR("Failed to rollback index entry, rid:%s. rc=%s", rids[order[j]].to_string().c_str(), strrc(rc2));
+        }
+      }
+      return rc;
+    }
+  }
+  return rc;
+}
+
+RC BplusTreeHandler::insert_key(const char *key, const RID *rid)
+{
   RC rc = RC::SUCCESS;
 
   BplusTreeMiniTransaction mtr(*this, &rc);
 
-  char *key = static_cast<char *>(pkey.get());
-
   if (is_empty()) {
     root_lock_.lock();
     rc = create_new_tree(mtr, key, rid);
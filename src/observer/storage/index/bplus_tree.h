@@ -21,6 +21,7 @@ See the Mulan PSL v2 for more details. */
 #include <string>
 #include <vector>
 
+#include "common/lang/atomic.h"
 #include "common/lang/comparator.h"
 #include "common/lang/memory.h"
 #include "common/lang/sstream.h"
@@ -533,6 +534,15 @@ public:
    * @note 这里假设user_key的内存大小与attr_length 一致
    */
   RC insert_entry(const std::vector<IndexUserKey> &user_keys, const RID *rid);
+
+  /**
+   * @brief 批量插入索引项
+   * @details 先按照键值排序再插入，相邻的键值大多落在同一个叶子节点上，访问的页面更集中。
+   * 失败时删除这一批中已经插入的索引项
+   * @param user_keys_list 每个索引项的用户键值
+   * @param rids           每个索引项对应的记录位置
+   */
+  RC insert_entries(const std::vector<std::vector<IndexUserKey>> &user_keys_list, span<const RID> rids);
   /**
    * @brief 从IndexHandle句柄对应的索引中删除一个值为（user_key，rid）的索引项
    * @return RECORD_INVALID_KEY 指定值不存在
@@ -617,6 +627,18 @@ protected:
   RC find_leaf_internal(BplusTreeMiniTransaction &mtr, BplusTreeOperationType op,
       const function<PageNum(InternalIndexNodeHandler &)> &child_page_getter, Frame *&frame);
 
+  /**
+   * @brief 乐观地查找叶子节点，只用于读操作
+   * @details 从根节点向下查找时不对内部节点加锁，只记录页面的版本号(参考 Frame::version)。
+   * 读取子节点的页号以后，校验父节点的版本号没有变化，说明读到的页号是有效的，再继续向下查找。
+   * 找到叶子节点以后对叶子节点加读锁，并确认加锁前后叶子节点的版本号一致。
+   * 内部节点仍然要pin住，防止页帧被淘汰或复用，但是不会修改页帧上的锁，避免了读多写少时
+   * 根节点等上层节点的锁成为多个CPU之间争抢的热点。
+   * 多次校验失败时返回 RC::LOCKED_CONCURRENCY_CONFLICT，调用者需要退回到crabing protocol。
+   */
+  RC optimistic_find_leaf(BplusTreeMiniTransaction &mtr,
+      const function<PageNum(InternalIndexNodeHandler &)> &child_page_getter, Frame *&frame);
+
   /**
    * @brief 使用crabing protocol 获取页面
    */
@@ -661,6 +683,11 @@ protected:
    */
   RC insert_entry_into_parent(BplusTreeMiniTransaction &mtr, Frame *frame, Frame *new_frame, const char *key);
 
+  /**
+   * @brief 插入一个已经构造好的B+树键值(用户键值+RID)
+   */
+  RC insert_key(const char *key, const RID *rid);
+
   /**
    * @brief 在叶子节点插入一个元素
    */
@@ -697,6 +724,12 @@ protected:
   // 这个锁可以使用递归读写锁，但是这里偷懒先不改
   common::SharedMutex root_lock_;
 
+  // 根节点页号的版本号，修改根节点页号前后各加一，奇数表示正在修改。乐观读使用它校验读到的根节点页号
+  atomic<uint64_t> root_version_{0};
+
+  /// 乐观读最多尝试的次数，超过以后退回到crabing protocol
+  static constexpr int OPTIMISTIC_READ_RETRY_TIMES = 3;
+
   KeyComparator key_comparator_;
   KeyPrinter    key_printer_;
 
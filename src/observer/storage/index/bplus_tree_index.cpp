@@ -46,6 +46,7 @@ RC BplusTreeIndex::create(Table *table, const std::string &file_name, const Inde
         file_name.c_str(), index_meta.name().c_str(), strrc(rc));
     return rc;
   }
+  index_handler_.buffer_pool().set_page_compression(table->table_meta().page_compression());
 
   inited_ = true;
   table_  = table;
@@ -71,6 +72,7 @@ RC BplusTreeIndex::open(Table *table, const std::string &file_name, const IndexM
         file_name.c_str(), index_meta.name().c_str(), strrc(rc));
     return rc;
   }
+  index_handler_.buffer_pool().set_page_compression(table->table_meta().page_compression());
 
   inited_ = true;
   table_  = table;
@@ -97,6 +99,15 @@ RC BplusTreeIndex::insert_entry(const char *record, const RID *rid)
   return index_handler_.insert_entry(user_keys, rid);
 }
 
+RC BplusTreeIndex::insert_entries(span<const char *const> records, span<const RID> rids)
+{
+  std::vector<std::vector<IndexUserKey>> user_keys_list(records.size());
+  for (size_t i = 0; i < records.size(); i++) {
+    make_user_keys(records[i], user_keys_list[i]);
+  }
+  return index_handler_.insert_entries(user_keys_list, rids);
+}
+
 RC BplusTreeIndex::delete_entry(const char *record, const RID *rid)
 {
   std::vector<IndexUserKey> user_keys;
@@ -33,6 +33,7 @@ public:
   RC close();
 
   RC insert_entry(const char *record, const RID *rid) override;
+  RC insert_entries(span<const char *const> records, span<const RID> rids) override;
   RC delete_entry(const char *record, const RID *rid) override;
 
   RC update_entry(const char *old_record, const char *new_record, const RID *rid) override;
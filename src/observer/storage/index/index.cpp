@@ -13,9 +13,28 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "storage/index/index.h"
+#include "common/log/log.h"
 
 RC Index::init(const IndexMeta &index_meta)
 {
   index_meta_ = index_meta;
   return RC::SUCCESS;
 }
+
+RC Index::insert_entries(span<const char *const> records, span<const RID> rids)
+{
+  RC rc = RC::SUCCESS;
+  for (size_t i = 0; i < records.size(); i++) {
+    rc = insert_entry(records[i], &rids[i]);
+    if (OB_FAIL(rc)) {
+      for (size_t j = 0; j < i; j++) {
+        RC rc2 = delete_entry(records[j], &rids[j]);
+        if (OB_FAIL(rc2)) {
+          LOG_ERROR("failed to rollback index entry. rid=%s, rc=%s", rids[j].to_string().c_str(), strrc(rc2));
+        }
+      }
+      return rc;
+    }
+  }
+  return rc;
+}
@@ -56,6 +56,14 @@ public:
    */
   virtual RC insert_entry(const char *record, const RID *rid) = 0;
 
+  /**
+   * @brief 批量插入数据
+   * @details 默认逐条插入。失败时会删除这一批中已经插入的数据，要么全部插入，要么都不插入
+   * @param records 插入的记录
+   * @param rids    每条记录的位置，与 records 一一对应
+   */
+  virtual RC insert_entries(span<const char *const> records, span<const RID> rids);
+
   /**
    * @brief 删除一条数据
    *
@@ -158,3 +158,15 @@ void LatchMemo::release_to(int point)
   }
   items_.erase(items_.begin(), iter);
 }
+
+void LatchMemo::release_from(int point)
+{
+  ASSERT(point >= 0 && point <= static_cast<int>(items_.size()),
+         "invalid memo point. point=%d, items size=%d",
+         point, static_cast<int>(items_.size()));
+
+  for (int i = static_cast<int>(items_.size()) - 1; i >= point; i--) {
+    release_item(items_[i]);
+  }
+  items_.erase(items_.begin() + point, items_.end());
+}
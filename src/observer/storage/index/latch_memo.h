@@ -76,8 +76,12 @@ public:
 
   void release();
 
+  /// @brief 释放 [0, point) 之间的锁和页面
   void release_to(int point);
 
+  /// @brief 释放 [point, memo_point()) 之间的锁和页面，按照获取的相反顺序释放
+  void release_from(int point);
+
   int memo_point() const { return static_cast<int>(items_.size()); }
 
 private:
@@ -0,0 +1,410 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+
+#include "storage/record/column_encoding.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/string_view.h"
+#include "common/lang/unordered_map.h"
+#include "common/lang/vector.h"
+#include "common/log/log.h"
+
+namespace {
+
+/// 可以按位压缩的整数类型
+bool is_packable(AttrType attr_type, int attr_len)
+{
+  return (attr_type == AttrType::INTS || attr_type == AttrType::DATES) && attr_len == sizeof(int32_t);
+}
+
+int32_t int_at(const char *values, int index)
+{
+  int32_t value = 0;
+  memcpy(&value, values + index * sizeof(int32_t), sizeof(value));
+  return value;
+}
+
+/// 表示 [0, max_value] 需要的位数
+int bit_width_of(uint64_t max_value)
+{
+  int width = 0;
+  while (max_value != 0) {
+    width++;
+    max_value >>= 1;
+  }
+  return width;
+}
+
+/// 按位压缩以后的大小。末尾多留8个字节，读取时总是可以加载一个完整的 uint64_t
+int bit_packed_size(int count, int bit_width)
+{
+  return static_cast<int>((static_cast<int64_t>(count) * bit_width + 7) / 8 + sizeof(uint64_t));
+}
+
+void pack_bits(const vector<uint32_t> &codes, int bit_width, char *out)
+{
+  memset(out, 0, bit_packed_size(static_cast<int>(codes.size()), bit_width));
+  if (bit_width == 0) {
+    return;
+  }
+
+  for (size_t i = 0; i < codes.size(); i++) {
+    const uint64_t bit = static_cast<uint64_t>(i) * bit_width;
+    uint64_t       word;
+    memcpy(&word, out + bit / 8, sizeof(word));
+    word |= static_cast<uint64_t>(codes[i]) << (bit % 8);
+    memcpy(out + bit / 8, &word, sizeof(word));
+  }
+}
+
+template <typename T>
+bool compare(T left, T right, CompOp op)
+{
+  switch (op) {
+    case CompOp::EQUAL_TO: return left == right;
+    case CompOp::NOT_EQUAL: return left != right;
+    case CompOp::LESS_THAN: return left < right;
+    case CompOp::LESS_EQUAL: return left <= right;
+    case CompOp::GREAT_THAN: return left > right;
+    case CompOp::GREAT_EQUAL: return left >= right;
+    default: return true;
+  }
+}
+
+}  // namespace
+
+const char *column_encoding_name(ColumnEncoding encoding)
+{
+  switch (encoding) {
+    case ColumnEncoding::PLAIN: return "PLAIN";
+    case ColumnEncoding::DICTIONARY: return "DICTIONARY";
+    case ColumnEncoding::RLE: return "RLE";
+    case ColumnEncoding::BIT_PACKING: return "BIT_PACKING";
+    case ColumnEncoding::FRAME_OF_REFERENCE: return "FRAME_OF_REFERENCE";
+    default: return "UNKNOWN";
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ColumnEncoder
+
+ColumnEncoding ColumnEncoder::choose(
+    AttrType attr_type, int attr_len, const char *values, int count, int &encoded_size)
+{
+  ColumnEncoding best = ColumnEncoding::PLAIN;
+  encoded_size        = attr_len * count;
+  if (count <= 0 || attr_len <= 0) {
+    return best;
+  }
+
+  auto consider = [&best, &encoded_size](ColumnEncoding encoding, int size) {
+    if (size < encoded_size) {
+      best         = encoding;
+      encoded_size = size;
+    }
+  };
+
+  unordered_map<string_view, int> dictionary;
+  int                             run_num = 0;
+  for (int i = 0; i < count; i++) {
+    const char *value = values + i * attr_len;
+    if (i == 0 || memcmp(value, value - attr_len, attr_len) != 0) {
+      run_num++;
+    }
+    dictionary.emplace(string_view(value, attr_len), 0);
+  }
+
+  const int header_size = sizeof(EncodedColumnHeader);
+  consider(ColumnEncoding::RLE, header_size + run_num * (sizeof(int32_t) + attr_len));
+
+  if (is_packable(attr_type, attr_len)) {
+    int64_t min_value = int_at(values, 0);
+    int64_t max_value = min_value;
+    for (int i = 1; i < count; i++) {
+      const int64_t value = int_at(values, i);
+      min_value           = min(min_value, value);
+      max_value           = max(max_value, value);
+    }
+    if (min_value >= 0) {
+      consider(ColumnEncoding::BIT_PACKING, header_size + bit_packed_size(count, bit_width_of(max_value)));
+    }
+    consider(ColumnEncoding::FRAME_OF_REFERENCE,
+        header_size + bit_packed_size(count, bit_width_of(static_cast<uint64_t>(max_value - min_value))));
+  }
+
+  const int entry_num = static_cast<int>(dictionary.size());
+  consider(ColumnEncoding::DICTIONARY,
+      header_size + entry_num * attr_len + bit_packed_size(count, bit_width_of(entry_num - 1)));
+  return best;
+}
+
+void ColumnEncoder::encode(
+    ColumnEncoding encoding, AttrType attr_type, int attr_len, const char *values, int count, char *out)
+{
+  EncodedColumnHeader header;
+  memset(&header, 0, sizeof(header));
+  header.count = count;
+
+  char *body = out + sizeof(header);
+  switch (encoding) {
+    case ColumnEncoding::DICTIONARY: {
+      // 字典中的值按照第一次出现的顺序存放
+      unordered_map<string_view, uint32_t> dictionary;
+      vector<uint32_t>                     codes(count);
+      for (int i = 0; i < count; i++) {
+        const char *value  = values + i * attr_len;
+        auto        result = dictionary.emplace(string_view(value, attr_len), static_cast<uint32_t>(dictionary.size()));
+        if (result.second) {
+          memcpy(body + result.first->second * attr_len, value, attr_len);
+        }
+        codes[i] = result.first->second;
+      }
+      header.entry_num = static_cast<int32_t>(dictionary.size());
+      header.bit_width = bit_width_of(header.entry_num - 1);
+      pack_bits(codes, header.bit_width, body + header.entry_num * attr_len);
+    } break;
+
+    case ColumnEncoding::RLE: {
+      vector<int32_t> run_ends;
+      vector<int>     run_starts;
+      for (int i = 0; i < count; i++) {
+        if (i == 0 || memcmp(values + i * attr_len, values + (i - 1) * attr_len, attr_len) != 0) {
+          if (i > 0) {
+            run_ends.push_back(i);
+          }
+          run_starts.push_back(i);
+        }
+      }
+      run_ends.push_back(count);
+
+      header.entry_num = static_cast<int32_t>(run_ends.size());
+      memcpy(body, run_ends.data(), run_ends.size() * sizeof(int32_t));
+      char *run_values = body + run_ends.size() * sizeof(int32_t);
+      for (size_t run = 0; run < run_starts.size(); run++) {
+        memcpy(run_values + run * attr_len, values + run_starts[run] * attr_len, attr_len);
+      }
+    } break;
+
+    case ColumnEncoding::BIT_PACKING:
+    case ColumnEncoding::FRAME_OF_REFERENCE: {
+      ASSERT(is_packable(attr_type, attr_len), "cannot pack the type. type=%s, len=%d", attr_type_to_string(attr_type), attr_len);
+      int32_t min_value = int_at(values, 0);
+      int32_t max_value = min_value;
+      for (int i = 1; i < count; i++) {
+        min_value = min(min_value, int_at(values, i));
+        max_value = max(max_value, int_at(values, i));
+      }
+      header.base = encoding == ColumnEncoding::BIT_PACKING ? 0 : min_value;
+
+      vector<uint32_t> codes(count);
+      for (int i = 0; i < count; i++) {
+        codes[i] = static_cast<uint32_t>(static_cast<int64_t>(int_at(values, i)) - header.base);
+      }
+      header.bit_width = bit_width_of(static_cast<uint64_t>(static_cast<int64_t>(max_value) - header.base));
+      pack_bits(codes, header.bit_width, body);
+    } break;
+
+    default: {
+      ASSERT(false, "cannot encode column. encoding=%s", column_encoding_name(encoding));
+    } break;
+  }
+
+  memcpy(out, &header, sizeof(header));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// EncodedColumn
+
+EncodedColumn::EncodedColumn(ColumnEncoding encoding, int attr_len, const char *data)
+    : encoding_(encoding), attr_len_(attr_len)
+{
+  memcpy(&header_, data, sizeof(header_));
+  const char *body = data + sizeof(header_);
+  switch (encoding) {
+    case ColumnEncoding::DICTIONARY: {
+      entries_ = body;
+      codes_   = body + header_.entry_num * attr_len;
+    } break;
+    case ColumnEncoding::RLE: {
+      codes_   = body;
+      entries_ = body + header_.entry_num * sizeof(int32_t);
+    } break;
+    case ColumnEncoding::BIT_PACKING:
+    case ColumnEncoding::FRAME_OF_REFERENCE: {
+      codes_ = body;
+    } break;
+    default: {
+      ASSERT(false, "not an encoded column. encoding=%s", column_encoding_name(encoding));
+    } break;
+  }
+}
+
+uint32_t EncodedColumn::code(int index) const
+{
+  if (header_.bit_width == 0) {
+    return 0;
+  }
+  const uint64_t bit = static_cast<uint64_t>(index) * header_.bit_width;
+  uint64_t       word;
+  memcpy(&word, codes_ + bit / 8, sizeof(word));
+  return static_cast<uint32_t>((word >> (bit % 8)) & ((static_cast<uint64_t>(1) << header_.bit_width) - 1));
+}
+
+int EncodedColumn::run_end(int run) const
+{
+  int32_t end;
+  memcpy(&end, codes_ + run * sizeof(int32_t), sizeof(end));
+  return end;
+}
+
+int EncodedColumn::run_of(int index) const
+{
+  // 第一个结束位置大于 index 的 run
+  int low = 0, high = header_.entry_num - 1;
+  while (low < high) {
+    const int mid = (low + high) / 2;
+    if (run_end(mid) > index) {
+      high = mid;
+    } else {
+      low = mid + 1;
+    }
+  }
+  return low;
+}
+
+void EncodedColumn::get(int index, char *out) const
+{
+  switch (encoding_) {
+    case ColumnEncoding::DICTIONARY: {
+      memcpy(out, entries_ + code(index) * attr_len_, attr_len_);
+    } break;
+    case ColumnEncoding::RLE: {
+      memcpy(out, entries_ + run_of(index) * attr_len_, attr_len_);
+    } break;
+    default: {
+      const int32_t value = static_cast<int32_t>(static_cast<int64_t>(header_.base) + code(index));
+      memcpy(out, &value, sizeof(value));
+    } break;
+  }
+}
+
+bool EncodedColumn::equal_to(int index, const char *value) const
+{
+  switch (encoding_) {
+    case ColumnEncoding::DICTIONARY: return memcmp(entries_ + code(index) * attr_len_, value, attr_len_) == 0;
+    case ColumnEncoding::RLE: return memcmp(entries_ + run_of(index) * attr_len_, value, attr_len_) == 0;
+    default: {
+      int32_t current;
+      get(index, reinterpret_cast<char *>(&current));
+      return memcmp(&current, value, sizeof(current)) == 0;
+    }
+  }
+}
+
+void EncodedColumn::decode(int begin, int count, char *out) const
+{
+  if (encoding_ != ColumnEncoding::RLE) {
+    for (int i = 0; i < count; i++) {
+      get(begin + i, out + i * attr_len_);
+    }
+    return;
+  }
+
+  // 游程编码一个 run 一个 run 地展开，不需要每个值都查找一次
+  const int end = begin + count;
+  for (int run = run_of(begin), pos = begin; pos < end; run++) {
+    const int   run_stop = min(run_end(run), end);
+    const char *value    = entries_ + run * attr_len_;
+    for (; pos < run_stop; pos++, out += attr_len_) {
+      memcpy(out, value, attr_len_);
+    }
+  }
+}
+
+bool EncodedColumn::filter(AttrType attr_type, CompOp op, const Value &value, uint8_t *select) const
+{
+  switch (op) {
+    case CompOp::EQUAL_TO:
+    case CompOp::NOT_EQUAL:
+    case CompOp::LESS_THAN:
+    case CompOp::LESS_EQUAL:
+    case CompOp::GREAT_THAN:
+    case CompOp::GREAT_EQUAL: break;
+    default: return false;
+  }
+  if (value.attr_type() != attr_type || attr_len_ != 4 || value.is_null()) {
+    return false;
+  }
+
+  if (attr_type == AttrType::INTS) {
+    if (encoding_ == ColumnEncoding::BIT_PACKING || encoding_ == ColumnEncoding::FRAME_OF_REFERENCE) {
+      return filter_codes(op, static_cast<int64_t>(value.get_int()) - header_.base, select);
+    }
+    return filter_values<int>(op, value.get_int(), select);
+  }
+  if (attr_type == AttrType::FLOATS) {
+    return filter_values<float>(op, value.get_float(), select);
+  }
+  return false;
+}
+
+template <typename T>
+bool EncodedColumn::filter_values(CompOp op, T value, uint8_t *select) const
+{
+  T entry;
+  switch (encoding_) {
+    case ColumnEncoding::DICTIONARY: {
+      // 字典中的每个值只比较一次
+      vector<uint8_t> matched(header_.entry_num);
+      for (int i = 0; i < header_.entry_num; i++) {
+        memcpy(&entry, entries_ + i * sizeof(T), sizeof(T));
+        matched[i] = compare(entry, value, op);
+      }
+      for (int i = 0; i < header_.count; i++) {
+        if (select[i] && !matched[code(i)]) {
+          select[i] = 0;
+        }
+      }
+    } break;
+
+    case ColumnEncoding::RLE: {
+      for (int run = 0, begin = 0; run < header_.entry_num; run++) {
+        const int end = run_end(run);
+        memcpy(&entry, entries_ + run * sizeof(T), sizeof(T));
+        if (!compare(entry, value, op)) {
+          memset(select + begin, 0, end - begin);
+        }
+        begin = end;
+      }
+    } break;
+
+    default: {
+      for (int i = 0; i < header_.count; i++) {
+        get(i, reinterpret_cast<char *>(&entry));
+        if (select[i] && !compare(entry, value, op)) {
+          select[i] = 0;
+        }
+      }
+    } break;
+  }
+  return true;
+}
+
+bool EncodedColumn::filter_codes(CompOp op, int64_t value, uint8_t *select) const
+{
+  // 所有的值都是 base 加上一个非负的差值，直接比较差值就可以
+  for (int i = 0; i < header_.count; i++) {
+    if (select[i] && !compare(static_cast<int64_t>(code(i)), value, op)) {
+      select[i] = 0;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,127 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "common/value.h"
+#include "sql/parser/parse_defs.h"
+
+/**
+ * @brief PAX 页面中一列数据的编码方式
+ * @ingroup RecordManager
+ */
+enum class ColumnEncoding : int32_t
+{
+  PLAIN = 0,           ///< 不编码，每个值按照字段长度依次存放
+  DICTIONARY,          ///< 字典编码，不同的值放在字典中，每个值存放字典中的下标(按位压缩)
+  RLE,                 ///< 游程编码，连续相同的值只存放一次
+  BIT_PACKING,         ///< 非负整数按位压缩
+  FRAME_OF_REFERENCE,  ///< 整数减去最小值以后按位压缩
+};
+
+const char *column_encoding_name(ColumnEncoding encoding);
+
+/**
+ * @brief 编码以后的列数据的头部
+ * @ingroup RecordManager
+ * @details 编码以后的数据布局：
+ * - DICTIONARY: | header | 字典(entry_num 个值) | 下标(每个 bit_width 位) |
+ * - RLE: | header | 每个 run 的结束位置(int32_t) | 每个 run 的值 |
+ * - BIT_PACKING/FRAME_OF_REFERENCE: | header | 与 base 的差值(每个 bit_width 位) |
+ */
+struct EncodedColumnHeader
+{
+  int32_t count;      ///< 值的个数
+  int32_t bit_width;  ///< 按位压缩时每个值占用的位数
+  int32_t entry_num;  ///< 字典中值的个数，或者 run 的个数
+  int32_t base;       ///< FRAME_OF_REFERENCE 的基准值，BIT_PACKING 时是0
+};
+
+/**
+ * @brief 为一列定长数据选择编码方式并编码
+ * @ingroup RecordManager
+ * @details 字典编码和游程编码适用于所有类型，按位压缩只适用于4个字节的整数(INTS/DATES)。
+ * 数据在页面写满的时候编码一次，所以编码时不需要考虑速度，选择编码以后最小的方式。
+ */
+class ColumnEncoder
+{
+public:
+  /**
+   * @brief 选择编码以后最小的编码方式
+   * @param values 连续存放的 count 个值
+   * @param encoded_size 返回编码以后的大小
+   * @return 编码以后不比原始数据小时返回 PLAIN
+   */
+  static ColumnEncoding choose(AttrType attr_type, int attr_len, const char *values, int count, int &encoded_size);
+
+  /**
+   * @brief 按照指定的方式编码
+   * @param out 大小至少是 choose 返回的 encoded_size
+   */
+  static void encode(
+      ColumnEncoding encoding, AttrType attr_type, int attr_len, const char *values, int count, char *out);
+};
+
+/**
+ * @brief 读取编码以后的一列数据
+ * @ingroup RecordManager
+ * @details 只是引用编码以后的数据，不复制。除了解码以外，还可以直接在编码以后的数据上做比较：
+ * 字典编码只需要与字典中的每个值比较一次，游程编码每个 run 比较一次，按位压缩的整数把常量
+ * 换算成差值以后直接比较。
+ */
+class EncodedColumn
+{
+public:
+  EncodedColumn(ColumnEncoding encoding, int attr_len, const char *data);
+
+  int count() const { return header_.count; }
+
+  /**
+   * @brief 获取第 index 个值
+   * @param out 至少 attr_len 个字节
+   */
+  void get(int index, char *out) const;
+
+  /**
+   * @brief 第 index 个值是否与 value 相同(按字节比较)
+   */
+  bool equal_to(int index, const char *value) const;
+
+  /**
+   * @brief 解码 [begin, begin + count) 的值，连续存放到 out 中
+   */
+  void decode(int begin, int count, char *out) const;
+
+  /**
+   * @brief 计算每个值与常量的比较结果，不满足条件的值把 select 中对应的位置清零
+   * @details 只支持 INTS/FLOATS 与相同类型的常量比较，比较的方式与向量化执行的 ComparisonExpr 一致。
+   * @param select 大小至少是 count()
+   * @return 不支持的类型或者比较方式不做任何修改，返回 false
+   */
+  bool filter(AttrType attr_type, CompOp op, const Value &value, uint8_t *select) const;
+
+private:
+  uint32_t code(int index) const;
+  int      run_of(int index) const;
+  int      run_end(int run) const;
+
+  template <typename T>
+  bool filter_values(CompOp op, T value, uint8_t *select) const;
+  bool filter_codes(CompOp op, int64_t value, uint8_t *select) const;
+
+private:
+  ColumnEncoding      encoding_;
+  int                 attr_len_;
+  EncodedColumnHeader header_;
+  const char         *entries_ = nullptr;  ///< 字典中的值，或者每个 run 的值
+  const char         *codes_   = nullptr;  ///< 按位压缩的数据，或者每个 run 的结束位置
+};
@@ -0,0 +1,265 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "storage/record/free_space_map.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/fstream.h"
+#include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "common/log/log.h"
+#include "common/math/crc.h"
+#include "storage/buffer/page.h"
+
+using namespace common;
+
+namespace {
+
+/// 保存到文件中的头部，后面跟着每个页面的剩余空间等级
+struct FreeSpaceMapFileHeader
+{
+  static constexpr uint32_t MAGIC = 0x31505346;  // "FSP1"
+
+  uint32_t magic;
+  int32_t  page_count;
+  uint32_t check_sum;  ///< 页面等级数据的校验和
+};
+
+}  // namespace
+
+FreeSpaceMap::~FreeSpaceMap()
+{
+  for (atomic<Chunk *> &chunk : chunks_) {
+    delete chunk.load(memory_order_relaxed);
+  }
+}
+
+int FreeSpaceMap::level(int free_bytes)
+{
+  if (free_bytes <= 0) {
+    return 1;
+  }
+  return min(MAX_LEVEL, 1 + static_cast<int>(static_cast<int64_t>(free_bytes) * (MAX_LEVEL - 1) / BP_PAGE_DATA_SIZE));
+}
+
+FreeSpaceMap::Chunk *FreeSpaceMap::get_or_create_chunk(int chunk_index)
+{
+  Chunk *chunk = get_chunk(chunk_index);
+  if (chunk != nullptr) {
+    return chunk;
+  }
+
+  Chunk *new_chunk = new Chunk;
+  if (chunks_[chunk_index].compare_exchange_strong(chunk, new_chunk, memory_order_acq_rel)) {
+    chunk = new_chunk;
+  } else {
+    delete new_chunk;  // 其它线程已经创建了
+  }
+
+  int chunk_num = chunk_num_.load(memory_order_relaxed);
+  while (chunk_num <= chunk_index &&
+         !chunk_num_.compare_exchange_weak(chunk_num, chunk_index + 1, memory_order_release)) {
+  }
+  return chunk;
+}
+
+void FreeSpaceMap::set_entry(PageNum page_num, int level, bool clear_claimed)
+{
+  if (page_num < 0 || page_num >= MAX_CHUNKS * CHUNK_PAGES) {
+    return;
+  }
+
+  const int chunk_index = page_num / CHUNK_PAGES;
+  const int index       = page_num % CHUNK_PAGES;
+
+  level = min(level, MAX_LEVEL);
+  Chunk *chunk = level > 0 ? get_or_create_chunk(chunk_index) : get_chunk(chunk_index);
+  if (chunk == nullptr) {
+    return;  // 还没有记录过这块的页面，都当做已满
+  }
+
+  atomic<uint8_t> &entry     = chunk->entries[index];
+  uint8_t          old_value = entry.load(memory_order_relaxed);
+  uint8_t          new_value = 0;
+  do {
+    new_value = static_cast<uint8_t>(level);
+    if (!clear_claimed) {
+      new_value |= old_value & CLAIMED_FLAG;
+    }
+  } while (!entry.compare_exchange_weak(old_value, new_value, memory_order_seq_cst));
+
+  const bool was_free = (old_value & MAX_LEVEL) != 0;
+  const bool is_free  = level != 0;
+  if (was_free == is_free) {
+    return;
+  }
+
+  if (is_free) {
+    chunk->free_count.fetch_add(1, memory_order_relaxed);
+    lower_search_hint(chunk, index);
+  } else {
+    chunk->free_count.fetch_sub(1, memory_order_relaxed);
+  }
+}
+
+void FreeSpaceMap::lower_search_hint(Chunk *chunk, int index)
+{
+  int hint = chunk->search_hint.load(memory_order_seq_cst);
+  while (hint > index && !chunk->search_hint.compare_exchange_weak(hint, index, memory_order_seq_cst)) {
+  }
+}
+
+void FreeSpaceMap::update(PageNum page_num, int level) { set_entry(page_num, level, false /*clear_claimed*/); }
+
+void FreeSpaceMap::release(PageNum page_num, int level) { set_entry(page_num, level, true /*clear_claimed*/); }
+
+PageNum FreeSpaceMap::claim()
+{
+  const int chunk_num = chunk_num_.load(memory_order_acquire);
+  for (int chunk_index = 0; chunk_index < chunk_num; chunk_index++) {
+    Chunk *chunk = get_chunk(chunk_index);
+    if (chunk == nullptr || chunk->free_count.load(memory_order_relaxed) <= 0) {
+      continue;
+    }
+
+    for (int index = chunk->search_hint.load(memory_order_relaxed); index < CHUNK_PAGES; index++) {
+      atomic<uint8_t> &entry = chunk->entries[index];
+      uint8_t          value = entry.load(memory_order_relaxed);
+      if ((value & MAX_LEVEL) == 0) {
+        // 从提示位置开始连续的满页面，下次可以直接跳过。
+        // 推进提示的同时页面可能变成了空闲的，而 set_entry 看到的还是旧的提示，没有把提示调回来，
+        // 所以推进以后再检查一次页面。set_entry 先修改页面再读取提示，这里先修改提示再读取页面，
+        // 都使用 seq_cst，至少有一方能看到另一方的修改，页面不会被漏掉
+        int expected = index;
+        if (chunk->search_hint.compare_exchange_strong(expected, index + 1, memory_order_seq_cst) &&
+            (entry.load(memory_order_seq_cst) & MAX_LEVEL) != 0) {
+          lower_search_hint(chunk, index);
+        }
+        continue;
+      }
+
+      while ((value & MAX_LEVEL) != 0 && (value & CLAIMED_FLAG) == 0) {
+        if (entry.compare_exchange_weak(value, value | CLAIMED_FLAG, memory_order_acq_rel)) {
+          return chunk_index * CHUNK_PAGES + index;
+        }
+      }
+    }
+  }
+  return BP_INVALID_PAGE_NUM;
+}
+
+int FreeSpaceMap::get_level(PageNum page_num) const
+{
+  if (page_num < 0 || page_num >= MAX_CHUNKS * CHUNK_PAGES) {
+    return 0;
+  }
+  Chunk *chunk = get_chunk(page_num / CHUNK_PAGES);
+  if (chunk == nullptr) {
+    return 0;
+  }
+  return chunk->entries[page_num % CHUNK_PAGES].load(memory_order_relaxed) & MAX_LEVEL;
+}
+
+void FreeSpaceMap::clear()
+{
+  const int chunk_num = chunk_num_.load(memory_order_acquire);
+  for (int chunk_index = 0; chunk_index < chunk_num; chunk_index++) {
+    Chunk *chunk = get_chunk(chunk_index);
+    if (chunk == nullptr) {
+      continue;
+    }
+    for (int index = 0; index < CHUNK_PAGES; index++) {
+      release(chunk_index * CHUNK_PAGES + index, 0);
+    }
+  }
+}
+
+RC FreeSpaceMap::save(const char *file_name) const
+{
+  // 只保存到最后一个有剩余空间的页面
+  const int    chunk_num = chunk_num_.load(memory_order_acquire);
+  vector<char> levels;
+  levels.reserve(static_cast<size_t>(chunk_num) * CHUNK_PAGES);
+  for (int chunk_index = 0; chunk_index < chunk_num; chunk_index++) {
+    Chunk *chunk = get_chunk(chunk_index);
+    for (int index = 0; index < CHUNK_PAGES; index++) {
+      levels.push_back(chunk == nullptr ? 0 : chunk->entries[index].load(memory_order_relaxed) & MAX_LEVEL);
+    }
+  }
+  while (!levels.empty() && levels.back() == 0) {
+    levels.pop_back();
+  }
+
+  FreeSpaceMapFileHeader header;
+  header.magic      = FreeSpaceMapFileHeader::MAGIC;
+  header.page_count = static_cast<int32_t>(levels.size());
+  header.check_sum  = crc32(levels.data(), static_cast<unsigned int>(levels.size()));
+
+  const string tmp_file_name = string(file_name) + ".tmp";
+  fstream      fs;
+  fs.open(tmp_file_name, ios_base::out | ios_base::binary | ios_base::trunc);
+  if (!fs.is_open()) {
+    LOG_WARN("failed to open free space map file for write. file name=%s, errmsg=%s", tmp_file_name.c_str(), strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+
+  fs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  fs.write(levels.data(), levels.size());
+  fs.close();
+  if (fs.fail()) {
+    LOG_WARN("failed to write free space map file. file name=%s", tmp_file_name.c_str());
+    ::remove(tmp_file_name.c_str());
+    return RC::IOERR_WRITE;
+  }
+
+  if (::rename(tmp_file_name.c_str(), file_name) != 0) {
+    LOG_WARN("failed to rename free space map file. %s -> %s, errmsg=%s", tmp_file_name.c_str(), file_name, strerror(errno));
+    ::remove(tmp_file_name.c_str());
+    return RC::IOERR_WRITE;
+  }
+
+  LOG_INFO("save free space map done. file name=%s, page count=%d", file_name, header.page_count);
+  return RC::SUCCESS;
+}
+
+RC FreeSpaceMap::load(const char *file_name)
+{
+  fstream fs;
+  fs.open(file_name, ios_base::in | ios_base::binary);
+  if (!fs.is_open()) {
+    LOG_INFO("free space map file does not exist. file name=%s", file_name);
+    return RC::FILE_NOT_EXIST;
+  }
+
+  FreeSpaceMapFileHeader header;
+  fs.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (fs.gcount() != sizeof(header) || header.magic != FreeSpaceMapFileHeader::MAGIC || header.page_count < 0 ||
+      header.page_count > MAX_CHUNKS * CHUNK_PAGES) {
+    LOG_WARN("invalid free space map file header. file name=%s", file_name);
+    return RC::IOERR_READ;
+  }
+
+  vector<char> levels(header.page_count);
+  fs.read(levels.data(), levels.size());
+  if (fs.gcount() != header.page_count ||
+      crc32(levels.data(), static_cast<unsigned int>(levels.size())) != header.check_sum) {
+    LOG_WARN("free space map file is corrupted. file name=%s", file_name);
+    return RC::IOERR_READ;
+  }
+
+  clear();
+  for (PageNum page_num = 0; page_num < header.page_count; page_num++) {
+    release(page_num, levels[page_num] & MAX_LEVEL);
+  }
+  LOG_INFO("load free space map done. file name=%s, page count=%d", file_name, header.page_count);
+  return RC::SUCCESS;
+}
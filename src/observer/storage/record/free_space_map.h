@@ -0,0 +1,119 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "common/lang/atomic.h"
+#include "common/lang/memory.h"
+#include "common/rc.h"
+#include "common/types.h"
+
+/**
+ * @brief 记录文件的空闲空间表(free space map)
+ * @ingroup RecordManager
+ * @details 每个页面用一个字节记录剩余空间的等级，0 表示页面已满(或者不是记录页面)，
+ * 越大表示剩余空间越多。最高位表示页面已经被某个插入线程占用(claim)，
+ * 其它线程查找空闲页面时会跳过被占用的页面，这样并发插入的线程会分散到不同的页面上，
+ * 不会都去争抢同一个页面的写锁。
+ *
+ * 所有的操作都是无锁的。页面按照 CHUNK_PAGES 分成若干块，块在第一次用到的时候分配；
+ * 每块记录空闲页面的个数，以及可能空闲的最小位置，查找时可以跳过已经满了的部分。
+ * 最多跟踪 MAX_CHUNKS * CHUNK_PAGES 个页面，超出的页面不会被记录，只是不能复用其中的空闲空间。
+ *
+ * 空闲空间表只是一个提示，不写日志。与页面的实际情况不一致时，插入的时候会发现页面已满，
+ * 修正以后再找下一个页面；漏掉的空闲页面只是暂时浪费一些空间。
+ * 正常关闭时保存到文件中，下次打开时直接加载，不需要扫描整个数据文件。
+ */
+class FreeSpaceMap
+{
+public:
+  static constexpr int MAX_LEVEL   = 0x7F;
+  static constexpr int CHUNK_PAGES = 4096;
+  static constexpr int MAX_CHUNKS  = 4096;
+
+public:
+  FreeSpaceMap() = default;
+  ~FreeSpaceMap();
+
+  /**
+   * @brief 把页面的剩余空间换算成等级
+   * @param free_bytes 剩余空间
+   * @return 至少是1。页面已满时不需要调用，直接使用等级0
+   */
+  static int level(int free_bytes);
+
+  /**
+   * @brief 更新页面的剩余空间等级，不改变页面的占用状态
+   */
+  void update(PageNum page_num, int level);
+
+  /**
+   * @brief 找到一个有剩余空间并且没有被占用的页面，并占用它
+   * @return 没有找到时返回 BP_INVALID_PAGE_NUM
+   */
+  PageNum claim();
+
+  /**
+   * @brief 更新页面的剩余空间等级，并释放占用
+   */
+  void release(PageNum page_num, int level);
+
+  /**
+   * @brief 获取页面当前的剩余空间等级
+   */
+  int get_level(PageNum page_num) const;
+
+  /**
+   * @brief 清空所有记录
+   */
+  void clear();
+
+  /**
+   * @brief 保存到文件中
+   * @details 先写到临时文件再改名，不会留下写了一半的文件
+   */
+  RC save(const char *file_name) const;
+
+  /**
+   * @brief 从文件中加载
+   * @details 文件不存在或者已经损坏时返回错误，调用方需要重新扫描数据文件
+   */
+  RC load(const char *file_name);
+
+private:
+  struct Chunk
+  {
+    atomic<uint8_t> entries[CHUNK_PAGES] = {};
+    atomic<int>     free_count{0};   ///< 有剩余空间的页面个数
+    atomic<int>     search_hint{0};  ///< 这个位置前面的页面都是满的
+  };
+
+  static constexpr uint8_t CLAIMED_FLAG = 0x80;
+
+  Chunk *get_chunk(int chunk_index) const { return chunks_[chunk_index].load(memory_order_acquire); }
+  Chunk *get_or_create_chunk(int chunk_index);
+
+  /**
+   * @brief 修改页面对应的字节
+   * @param clear_claimed 是否同时清除占用标记
+   */
+  void set_entry(PageNum page_num, int level, bool clear_claimed);
+
+  /**
+   * @brief 页面变成空闲的以后，把查找的提示位置调整到不超过这个页面
+   */
+  static void lower_search_hint(Chunk *chunk, int index);
+
+private:
+  atomic<Chunk *> chunks_[MAX_CHUNKS] = {};
+  atomic<int>     chunk_num_{0};  ///< 已经用到的块个数
+};
@@ -22,6 +22,7 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/vector.h"
 #include "common/lang/sstream.h"
 #include "common/lang/limits.h"
+#include "storage/buffer/frame.h"
 #include "storage/field/field_meta.h"
 #include "storage/index/index_meta.h"
 
@@ -96,6 +97,11 @@ struct RIDHash
  * @details 当前的记录都是连续存放的空间（内存或磁盘上）。
  * 为了提高访问的效率，record通常直接记录指向页面上的内存，但是需要保证访问这种数据时，拿着锁资源。
  * 为了方便，也提供了复制内存的方法。可以参考set_data_owner
+ *
+ * 直接指向页帧内存的记录(参考set_frame_data)会持有页帧的一个pin，保证记录存在期间页面不会被淘汰，
+ * 复制这种记录只增加pin计数，不复制数据。pin只能保证内存有效，页面内容不被修改仍然需要页面锁来保证，
+ * 比如扫描时当前页面一直加着锁。需要在页面锁释放以后继续使用记录的算子(比如先收集再删除)，
+ * 应该调用materialize复制一份自己管理的数据。
  * @note 可以拆分成两种实现，一个是需要自己管理内存的，一个是不需要自己管理内存的。
  */
 class Record
@@ -108,6 +114,7 @@ public:
       free(data_);
       data_ = nullptr;
     }
+    release_frame();
   }
 
   Record(const Record &other)
@@ -117,6 +124,12 @@ public:
     len_   = other.len_;
     owner_ = other.owner_;
 
+    if (other.frame_ != nullptr) {
+      // 原记录持有pin，页帧不会被淘汰，这里不需要加frame manager的锁
+      frame_ = other.frame_;
+      frame_->pin();
+    }
+
     if (other.owner_) {
       char *tmp = (char *)malloc(other.len_);
       ASSERT(nullptr != tmp, "failed to allocate memory. size=%d", other.len_);
@@ -131,6 +144,14 @@ public:
       return *this;
     }
 
+    if (!owner_ && !other.owner_ && frame_ == other.frame_) {
+      // 指向同一个页帧(或者都不在页帧上)的记录，只需要修改指针，pin计数不变
+      rid_  = other.rid_;
+      data_ = other.data_;
+      len_  = other.len_;
+      return *this;
+    }
+
     if (!owner_ || len_ != other.len_) {
       this->~Record();
       new (this) Record(other);
@@ -145,6 +166,9 @@ public:
   {
     rid_ = other.rid_;
 
+    frame_       = other.frame_;
+    other.frame_ = nullptr;
+
     if (!other.owner_) {
       data_        = other.data_;
       len_         = other.len_;
@@ -173,6 +197,7 @@ public:
 
   void set_data(char *data, int len = 0)
   {
+    release_frame();
     this->data_ = data;
     this->len_  = len;
   }
@@ -186,6 +211,36 @@ public:
     this->owner_ = true;
   }
 
+  /**
+   * @brief 直接指向页帧中的记录数据，不复制
+   * @details 会给页帧增加一个pin，记录释放或者指向其它数据时再unpin。
+   * 调用方需要已经pin住了这个页帧，比如持有它的RecordPageHandler，所以这里不需要加frame manager的锁。
+   */
+  void set_frame_data(Frame *frame, char *data, int len)
+  {
+    if (frame_ != frame) {
+      this->~Record();
+      frame->pin();
+      frame_ = frame;
+    }
+
+    this->data_  = data;
+    this->len_   = len;
+    this->owner_ = false;
+  }
+
+  /**
+   * @brief 如果数据不是自己管理的，就复制一份
+   * @details 记录需要在页面锁释放以后继续使用时调用，同时会释放页帧的pin
+   */
+  RC materialize()
+  {
+    if (owner_ || data_ == nullptr) {
+      return RC::SUCCESS;
+    }
+    return copy_data(data_, len_);
+  }
+
   RC copy_data(const char *data, int len)
   {
     ASSERT(len!= 0, "the len of data should not be 0");
@@ -240,10 +295,23 @@ public:
   RID       &rid() { return rid_; }
   const RID &rid() const { return rid_; }
 
+  /// 当前记录是否直接指向页帧内存
+  bool pinned() const { return frame_ != nullptr; }
+
+private:
+  void release_frame()
+  {
+    if (frame_ != nullptr) {
+      frame_->unpin();
+      frame_ = nullptr;
+    }
+  }
+
 private:
   RID rid_;
 
-  char *data_  = nullptr;
-  int   len_   = 0;      /// 如果不是record自己来管理内存，这个字段可能是无效的
-  bool  owner_ = false;  /// 表示当前是否由record来管理内存
+  char  *data_  = nullptr;
+  int    len_   = 0;        /// 如果不是record自己来管理内存，这个字段可能是无效的
+  bool   owner_ = false;    /// 表示当前是否由record来管理内存
+  Frame *frame_ = nullptr;  /// 记录数据所在的页帧，不为空时持有这个页帧的一个pin
 };
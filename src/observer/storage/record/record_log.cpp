@@ -37,6 +37,7 @@ string RecordOperation::to_string() const
     case Type::INSERT: return ret + "INSERT";
     case Type::DELETE: return ret + "DELETE";
     case Type::UPDATE: return ret + "UPDATE";
+    case Type::INSERT_BATCH: return ret + "INSERT_BATCH";
     default: return ret + "UNKNOWN";
   }
 }
@@ -53,7 +54,8 @@ string RecordLogHeader::to_string() const
      << ", page_num:" << page_num;
 
   switch (RecordOperation(operation_type).type()) {
-    case RecordOperation::Type::INIT_PAGE: {
+    case RecordOperation::Type::INIT_PAGE:
+    case RecordOperation::Type::INSERT_BATCH: {
       ss << ", record_size:" << record_size;
     } break;
     case RecordOperation::Type::INSERT:
@@ -129,6 +131,41 @@ RC RecordLogHandler::insert_record(Frame *frame, const RID &rid, const char *rec
   return rc;
 }
 
+RC RecordLogHandler::insert_records(
+    Frame *frame, PageNum page_num, span<const SlotNum> slot_nums, span<const char *const> records)
+{
+  ASSERT(slot_nums.size() == records.size(), "slot number count mismatch. slot nums=%d, records=%d",
+         static_cast<int>(slot_nums.size()), static_cast<int>(records.size()));
+
+  // 日志内容: | header | record_num | slot_num[record_num] | record[record_num] |
+  const int32_t    record_num       = static_cast<int32_t>(records.size());
+  const int        slots_size       = static_cast<int>(sizeof(int32_t) + sizeof(SlotNum) * record_num);
+  const int        log_payload_size = RecordLogHeader::SIZE + slots_size + record_size_ * record_num;
+  vector<char>     log_payload(log_payload_size);
+  RecordLogHeader *header = reinterpret_cast<RecordLogHeader *>(log_payload.data());
+  header->buffer_pool_id  = buffer_pool_id_;
+  header->operation_type  = RecordOperation(RecordOperation::Type::INSERT_BATCH).type_id();
+  header->page_num        = page_num;
+  header->record_size     = record_size_;
+  header->storage_format  = static_cast<int>(storage_format_);
+
+  char *data = log_payload.data() + RecordLogHeader::SIZE;
+  memcpy(data, &record_num, sizeof(record_num));
+  memcpy(data + sizeof(record_num), slot_nums.data(), sizeof(SlotNum) * record_num);
+  data += slots_size;
+  for (const char *record : records) {
+    memcpy(data, record, record_size_);
+    data += record_size_;
+  }
+
+  LSN lsn = 0;
+  RC  rc  = log_handler_->append(lsn, LogModule::Id::RECORD_MANAGER, std::move(log_payload));
+  if (OB_SUCC(rc) && lsn > 0) {
+    frame->set_lsn(lsn);
+  }
+  return rc;
+}
+
 RC RecordLogHandler::update_record(Frame *frame, const RID &rid, const char *record)
 {
   const int        log_payload_size = RecordLogHeader::SIZE + record_size_;
@@ -220,6 +257,9 @@ RC RecordLogReplayer::replay(const LogEntry &entry)
     case RecordOperation::Type::INSERT: {
       rc = replay_insert(*buffer_pool, *log_header);
     } break;
+    case RecordOperation::Type::INSERT_BATCH: {
+      rc = replay_insert_batch(*buffer_pool, *log_header);
+    } break;
     case RecordOperation::Type::DELETE: {
       rc = replay_delete(*buffer_pool, *log_header);
     } break;
@@ -285,6 +325,35 @@ RC RecordLogReplayer::replay_insert(DiskBufferPool &buffer_pool, const RecordLog
   return rc;
 }
 
+RC RecordLogReplayer::replay_insert_batch(DiskBufferPool &buffer_pool, const RecordLogHeader &log_header)
+{
+  VacuousLogHandler             vacuous_log_handler;
+  unique_ptr<RecordPageHandler> record_page_handler(
+      RecordPageHandler::create(StorageFormat(log_header.storage_format)));
+
+  RC rc = record_page_handler->init(buffer_pool, vacuous_log_handler, log_header.page_num, ReadWriteMode::READ_WRITE);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("fail to init record page handler. page num=%d, rc=%s", log_header.page_num, strrc(rc));
+    return rc;
+  }
+
+  int32_t record_num = 0;
+  memcpy(&record_num, log_header.data, sizeof(record_num));
+  const SlotNum *slot_nums = reinterpret_cast<const SlotNum *>(log_header.data + sizeof(record_num));
+  const char    *record    = log_header.data + sizeof(record_num) + sizeof(SlotNum) * record_num;
+  for (int32_t i = 0; i < record_num; i++, record += log_header.record_size) {
+    RID rid(log_header.page_num, slot_nums[i]);
+    rc = record_page_handler->recover_insert_record(record, rid);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("fail to recover insert record. page num=%d, slot num=%d, rc=%s",
+               log_header.page_num, slot_nums[i], strrc(rc));
+      return rc;
+    }
+  }
+
+  return rc;
+}
+
 RC RecordLogReplayer::replay_delete(DiskBufferPool &buffer_pool, const RecordLogHeader &log_header)
 {
   VacuousLogHandler             vacuous_log_handler;
@@ -41,7 +41,8 @@ public:
     INIT_PAGE,  /// 初始化空页面
     INSERT,     /// 插入一条记录
     DELETE,     /// 删除一条记录
-    UPDATE      /// 更新一条记录
+    UPDATE,     /// 更新一条记录
+    INSERT_BATCH  /// 在同一个页面中插入多条记录
   };
 
 public:
@@ -109,6 +110,16 @@ public:
    */
   RC insert_record(Frame *frame, const RID &rid, const char *record);
 
+  /**
+   * @brief 在同一个页面中插入多条记录
+   * @details 整个页面只记录一条日志，日志内容是记录条数、每条记录的槽位，以及所有记录的内容
+   * @param frame 页帧
+   * @param page_num 页面编号
+   * @param slot_nums 每条记录的槽位
+   * @param records 每条记录的内容，与 slot_nums 一一对应
+   */
+  RC insert_records(Frame *frame, PageNum page_num, span<const SlotNum> slot_nums, span<const char *const> records);
+
   /**
    * @brief 删除一条记录
    * @param frame 页帧
@@ -147,6 +158,7 @@ public:
 private:
   RC replay_init_page(DiskBufferPool &buffer_pool, const RecordLogHeader &log_header);
   RC replay_insert(DiskBufferPool &buffer_pool, const RecordLogHeader &log_header);
+  RC replay_insert_batch(DiskBufferPool &buffer_pool, const RecordLogHeader &log_header);
   RC replay_delete(DiskBufferPool &buffer_pool, const RecordLogHeader &log_header);
   RC replay_update(DiskBufferPool &buffer_pool, const RecordLogHeader &log_header);
 
@@ -12,7 +12,9 @@ See the Mulan PSL v2 for more details. */
 // Created by Meiyi & Longda on 2021/4/13.
 //
 #include "storage/record/record_manager.h"
+#include "common/lang/algorithm.h"
 #include "common/log/log.h"
+#include "sql/expr/expression.h"
 #include "storage/common/condition_filter.h"
 #include "storage/trx/trx.h"
 #include "storage/clog/log_handler.h"
@@ -22,10 +24,10 @@ using namespace common;
 static constexpr int PAGE_HEADER_SIZE = (sizeof(PageHeader));
 RecordPageHandler   *RecordPageHandler::create(StorageFormat format)
 {
-  if (format == StorageFormat::ROW_FORMAT) {
-    return new RowRecordPageHandler();
-  } else {
-    return new PaxRecordPageHandler();
+  switch (format) {
+    case StorageFormat::ROW_FORMAT: return new RowRecordPageHandler();
+    case StorageFormat::SLOTTED_FORMAT: return new SlottedRecordPageHandler();
+    default: return new PaxRecordPageHandler();
   }
 }
 /**
@@ -409,11 +411,50 @@ RC RowRecordPageHandler::get_record(const RID &rid, Record &record)
     return RC::RECORD_NOT_EXIST;
   }
 
+  // 行存格式的记录在页面上是连续存放的，直接指向页帧内存，不复制
   record.set_rid(rid);
-  record.copy_data(get_record_data(rid.slot_num), page_header_->record_real_size);
+  record.set_frame_data(frame_, get_record_data(rid.slot_num), page_header_->record_real_size);
   return RC::SUCCESS;
 }
 
+RC RecordPageHandler::insert_records(span<const char *const> records, RID *rids, int &inserted)
+{
+  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY, 
+         "cannot insert record into page while the page is readonly");
+
+  inserted = 0;
+
+  RC              rc = RC::SUCCESS;
+  vector<SlotNum> slot_nums;
+  Bitmap          bitmap(bitmap_, page_header_->record_capacity);
+  int             index = -1;
+  while (inserted < static_cast<int>(records.size()) && !is_full()) {
+    // 前面的槽位都已经用过了，从上一次的位置继续找
+    index = bitmap.next_unsetted_bit(index + 1);
+    RID rid(get_page_num(), index);
+    rc = recover_insert_record(records[inserted], rid);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to insert record. page_num %d:%d, rc=%s", 
+               disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
+      break;
+    }
+
+    rids[inserted] = rid;
+    slot_nums.push_back(index);
+    inserted++;
+  }
+
+  if (inserted > 0) {
+    RC log_rc = log_handler_.insert_records(frame_, get_page_num(), slot_nums, records.subspan(0, inserted));
+    if (OB_FAIL(log_rc)) {
+      LOG_ERROR("Failed to log inserted records. page_num %d:%d. rc=%s", 
+                disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(log_rc));
+      // ignore errors, the same as insert_record
+    }
+  }
+  return rc;
+}
+
 PageNum RecordPageHandler::get_page_num() const
 {
   if (nullptr == page_header_) {
@@ -424,10 +465,293 @@ PageNum RecordPageHandler::get_page_num() const
 
 bool RecordPageHandler::is_full() const { return page_header_->record_num >= page_header_->record_capacity; }
 
+int RecordPageHandler::free_space() const
+{
+  return (page_header_->record_capacity - page_header_->record_num) * page_header_->record_size;
+}
+
+RC PaxRecordPageHandler::init_empty_page(
+    DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, int record_size, TableMeta *table_meta)
+{
+  RC rc = init(buffer_pool, log_handler, page_num, ReadWriteMode::READ_WRITE);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to init empty page page_num:record_size %d:%d. rc=%s", page_num, record_size, strrc(rc));
+    return rc;
+  }
+
+  (void)log_handler_.init(log_handler, buffer_pool.id(), record_size, storage_format_);
+
+  const int field_num = table_meta == nullptr ? 0 : table_meta->field_num();
+
+  // 每个字段一列。没有设置偏移的字段认为紧跟在前一个字段后面
+  vector<int>           field_lens(field_num + 1);
+  vector<PaxColumnMeta> column_metas(field_num + 1);
+  vector<bool>          covered(record_size, false);
+  int                   next_offset = 0;
+  for (int i = 0; i < field_num; i++) {
+    const FieldMeta *field = table_meta->field(i);
+    // 事务字段的 field_id 是负数，只按位置检查普通字段
+    ASSERT(field->field_id() < 0 || i == field->field_id(), "i should be the col_id of fields[i]");
+    const int offset = field->offset() >= 0 ? field->offset() : next_offset;
+    ASSERT(offset + field->len() <= record_size, "field overflow the record. offset=%d, len=%d, record size=%d",
+           offset, field->len(), record_size);
+
+    field_lens[i]                 = field->len();
+    column_metas[i].record_offset = offset;
+    column_metas[i].attr_type     = static_cast<int32_t>(field->type());
+    column_metas[i].null_bit      = -1;
+    column_metas[i].encoding      = static_cast<int32_t>(ColumnEncoding::PLAIN);
+    fill(covered.begin() + offset, covered.begin() + offset + field->len(), true);
+    next_offset = offset + field->len();
+  }
+
+  // 剩下的部分(NULL 位图)是连续的一段，放在最后一列
+  auto gap_begin = find(covered.begin(), covered.end(), false);
+  auto gap_end   = find(gap_begin, covered.end(), true);
+  if (find(gap_end, covered.end(), false) != covered.end()) {
+    LOG_ERROR("Failed to init pax page: record has more than one unused range. page_num=%d", page_num);
+    return RC::INTERNAL;
+  }
+  PaxColumnMeta &null_column_meta = column_metas[field_num];
+  null_column_meta.record_offset  = static_cast<int32_t>(gap_begin - covered.begin());
+  null_column_meta.attr_type      = static_cast<int32_t>(AttrType::UNDEFINED);
+  null_column_meta.null_bit       = -1;
+  null_column_meta.encoding       = static_cast<int32_t>(ColumnEncoding::PLAIN);
+  field_lens[field_num]           = static_cast<int>(gap_end - gap_begin);
+
+  if (table_meta != nullptr && field_lens[field_num] > 0 &&
+      null_column_meta.record_offset == table_meta->null_bitmap_start()) {
+    const int sys_field_num = table_meta->sys_field_num();
+    for (int i = sys_field_num; i < field_num; i++) {
+      column_metas[i].null_bit = i - sys_field_num;
+    }
+  }
+
+  init_pax_page(record_size, field_num + 1, field_lens.data(), column_metas.data());
+
+  // 日志中记录每一列的长度和列描述
+  vector<char> log_data(field_lens.size() * sizeof(int) + column_metas.size() * sizeof(PaxColumnMeta));
+  memcpy(log_data.data(), field_lens.data(), field_lens.size() * sizeof(int));
+  memcpy(log_data.data() + field_lens.size() * sizeof(int), column_metas.data(),
+      column_metas.size() * sizeof(PaxColumnMeta));
+  rc = log_handler_.init_new_page(frame_, page_num, log_data);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to init empty page: write log failed. page_num:record_size %d:%d. rc=%s",
+              page_num, record_size, strrc(rc));
+    return rc;
+  }
+  return RC::SUCCESS;
+}
+
+RC PaxRecordPageHandler::init_empty_page(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num,
+    int record_size, int col_num, const char *col_idx_data)
+{
+  RC rc = init(buffer_pool, log_handler, page_num, ReadWriteMode::READ_WRITE);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to init empty page page_num:record_size %d:%d. rc=%s", page_num, record_size, strrc(rc));
+    return rc;
+  }
+
+  (void)log_handler_.init(log_handler, buffer_pool.id(), record_size, storage_format_);
+
+  // 日志中是每一列的长度和列描述，col_num 是按 int 计数的
+  const int column_num = col_num * sizeof(int) / (sizeof(int) + sizeof(PaxColumnMeta));
+
+  vector<int>           field_lens(column_num);
+  vector<PaxColumnMeta> column_metas(column_num);
+  memcpy(field_lens.data(), col_idx_data, column_num * sizeof(int));
+  memcpy(column_metas.data(), col_idx_data + column_num * sizeof(int), column_num * sizeof(PaxColumnMeta));
+
+  init_pax_page(record_size, column_num, field_lens.data(), column_metas.data());
+  return RC::SUCCESS;
+}
+
+void PaxRecordPageHandler::init_pax_page(
+    int record_size, int column_num, const int *field_lens, const PaxColumnMeta *metas)
+{
+  const int meta_size = column_num * (sizeof(int) + sizeof(PaxColumnMeta) + sizeof(ZoneMap));
+
+  page_header_->record_num       = 0;
+  page_header_->column_num       = column_num;
+  page_header_->record_real_size = record_size;
+  page_header_->record_size      = align8(record_size);
+  // 每一列都是紧凑存放的，不需要按照对齐以后的记录大小计算容量
+  page_header_->record_capacity  = page_record_capacity(BP_PAGE_DATA_SIZE, record_size, meta_size);
+  page_header_->col_idx_offset   = align8(PAGE_HEADER_SIZE + page_bitmap_size(page_header_->record_capacity));
+  page_header_->data_offset      = align8(page_header_->col_idx_offset + meta_size);
+  while (page_header_->data_offset + page_header_->record_capacity * record_size > BP_PAGE_DATA_SIZE) {
+    page_header_->record_capacity--;
+  }
+
+  bitmap_ = frame_->data() + PAGE_HEADER_SIZE;
+  memset(bitmap_, 0, page_bitmap_size(page_header_->record_capacity));
+
+  // column_index[i] store the end offset of column `i` or the start offset of column `i+1`
+  int *column_index = reinterpret_cast<int *>(frame_->data() + page_header_->col_idx_offset);
+  for (int i = 0; i < column_num; i++) {
+    column_index[i] = field_lens[i] * page_header_->record_capacity + (i == 0 ? 0 : column_index[i - 1]);
+  }
+  memcpy(column_metas(), metas, column_num * sizeof(PaxColumnMeta));
+
+  ZoneMap *zone_map_array = zone_maps();
+  for (int i = 0; i < column_num; i++) {
+    zone_map_array[i].init();
+  }
+
+  frame_->mark_dirty();
+}
+
+bool PaxRecordPageHandler::is_null(const char *null_bits, int col_id) const
+{
+  const int null_bit = column_metas()[col_id].null_bit;
+  if (null_bit < 0) {
+    return false;
+  }
+  return Bitmap(const_cast<char *>(null_bits), get_field_len(null_column()) * 8).get_bit(null_bit);
+}
+
+void PaxRecordPageHandler::put_record(SlotNum slot_num, const char *data)
+{
+  const PaxColumnMeta *metas     = column_metas();
+  ZoneMap             *zone_map  = zone_maps();
+  const char          *null_bits = data + metas[null_column()].record_offset;
+  for (int col_id = 0; col_id < page_header_->column_num; col_id++) {
+    const int   len   = get_field_len(col_id);
+    const char *field = data + metas[col_id].record_offset;
+    zone_map[col_id].add(static_cast<AttrType>(metas[col_id].attr_type), len, field, is_null(null_bits, col_id));
+
+    // 值没有变化的列不需要解码
+    if (is_encoded(col_id)) {
+      if (encoded_column(col_id).equal_to(slot_num, field)) {
+        continue;
+      }
+      decode_column(col_id);
+    }
+    memcpy(get_field_data(slot_num, col_id), field, len);
+  }
+}
+
+void PaxRecordPageHandler::remove_from_zone_maps(SlotNum slot_num)
+{
+  ZoneMap     *zone_map = zone_maps();
+  vector<char> null_bits(get_field_len(null_column()));
+  read_field(slot_num, null_column(), null_bits.data());
+  for (int col_id = 0; col_id < page_header_->column_num; col_id++) {
+    zone_map[col_id].remove(is_null(null_bits.data(), col_id));
+  }
+}
+
+EncodedColumn PaxRecordPageHandler::encoded_column(int col_id) const
+{
+  return EncodedColumn(column_encoding(col_id), get_field_len(col_id), get_field_data(0, col_id));
+}
+
+void PaxRecordPageHandler::read_field(SlotNum slot_num, int col_id, char *out) const
+{
+  if (is_encoded(col_id)) {
+    encoded_column(col_id).get(slot_num, out);
+  } else {
+    memcpy(out, get_field_data(slot_num, col_id), get_field_len(col_id));
+  }
+}
+
+void PaxRecordPageHandler::encode_columns()
+{
+  const int    capacity = page_header_->record_capacity;
+  vector<char> encoded;
+  for (int col_id = 0; col_id < page_header_->column_num; col_id++) {
+    if (is_encoded(col_id)) {
+      continue;
+    }
+
+    PaxColumnMeta &meta         = column_metas()[col_id];
+    const int      len          = get_field_len(col_id);
+    char          *column_data  = get_field_data(0, col_id);
+    int            encoded_size = 0;
+    ColumnEncoding encoding     = ColumnEncoder::choose(
+        static_cast<AttrType>(meta.attr_type), len, column_data, capacity, encoded_size);
+    if (encoding == ColumnEncoding::PLAIN) {
+      continue;
+    }
+
+    encoded.resize(encoded_size);
+    ColumnEncoder::encode(encoding, static_cast<AttrType>(meta.attr_type), len, column_data, capacity, encoded.data());
+    // 编码以后剩下的空间清零，页面压缩时可以节省更多的空间
+    memcpy(column_data, encoded.data(), encoded_size);
+    memset(column_data + encoded_size, 0, len * capacity - encoded_size);
+    meta.encoding = static_cast<int32_t>(encoding);
+    LOG_TRACE("encode pax column. page_num=%d, col_id=%d, encoding=%s, size=%d->%d",
+              frame_->page_num(), col_id, column_encoding_name(encoding), len * capacity, encoded_size);
+  }
+  frame_->mark_dirty();
+}
+
+void PaxRecordPageHandler::decode_column(int col_id)
+{
+  const int    len = get_field_len(col_id);
+  vector<char> decoded(len * page_header_->record_capacity);
+  encoded_column(col_id).decode(0, page_header_->record_capacity, decoded.data());
+  memcpy(get_field_data(0, col_id), decoded.data(), decoded.size());
+  column_metas()[col_id].encoding = static_cast<int32_t>(ColumnEncoding::PLAIN);
+  frame_->mark_dirty();
+}
+
 RC PaxRecordPageHandler::insert_record(const char *data, RID *rid)
 {
-  // your code here
-  exit(-1);
+  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY, 
+         "cannot insert record into page while the page is readonly");
+
+  if (page_header_->record_num == page_header_->record_capacity) {
+    LOG_WARN("Page is full, page_num %d:%d.", disk_buffer_pool_->file_desc(), frame_->page_num());
+    return RC::RECORD_NOMEM;
+  }
+
+  // 找到空闲位置
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  int    index = bitmap.next_unsetted_bit(0);
+  bitmap.set_bit(index);
+  page_header_->record_num++;
+
+  RC rc = log_handler_.insert_record(frame_, RID(get_page_num(), index), data);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to insert record. page_num %d:%d. rc=%s", disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
+    // return rc; // ignore errors
+  }
+
+  put_record(index, data);
+  if (is_full()) {
+    encode_columns();
+  }
+  frame_->mark_dirty();
+
+  if (rid) {
+    rid->page_num = get_page_num();
+    rid->slot_num = index;
+  }
+  return RC::SUCCESS;
+}
+
+RC PaxRecordPageHandler::recover_insert_record(const char *data, const RID &rid)
+{
+  if (rid.slot_num >= page_header_->record_capacity) {
+    LOG_WARN("slot_num illegal, slot_num(%d) > record_capacity(%d).", rid.slot_num, page_header_->record_capacity);
+    return RC::RECORD_INVALID_RID;
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (!bitmap.get_bit(rid.slot_num)) {
+    bitmap.set_bit(rid.slot_num);
+    page_header_->record_num++;
+  } else {
+    remove_from_zone_maps(rid.slot_num);
+  }
+
+  put_record(rid.slot_num, data);
+  if (is_full()) {
+    encode_columns();
+  }
+  frame_->mark_dirty();
+  return RC::SUCCESS;
 }
 
 RC PaxRecordPageHandler::delete_record(const RID *rid)
@@ -439,6 +763,7 @@ RC PaxRecordPageHandler::delete_record(const RID *rid)
   if (bitmap.get_bit(rid->slot_num)) {
     bitmap.clear_bit(rid->slot_num);
     page_header_->record_num--;
+    remove_from_zone_maps(rid->slot_num);
     frame_->mark_dirty();
 
     RC rc = log_handler_.delete_record(frame_, *rid);
@@ -454,20 +779,141 @@ RC PaxRecordPageHandler::delete_record(const RID *rid)
   }
 }
 
+RC PaxRecordPageHandler::update_record(const RID &rid, const char *data)
+{
+  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY, "cannot update record into page while the page is readonly");
+
+  if (rid.slot_num >= page_header_->record_capacity) {
+    LOG_ERROR("Invalid slot_num %d, exceed page's record capacity, frame=%s, page_header=%s",
+              rid.slot_num, frame_->to_string().c_str(), page_header_->to_string().c_str());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (!bitmap.get_bit(rid.slot_num)) {
+    LOG_DEBUG("Invalid slot_num %d, slot is empty, page_num %d.", rid.slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST;
+  }
+
+  RC rc = log_handler_.update_record(frame_, rid, data);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to update record. page_num %d:%d. rc=%s", disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
+    // return rc; // ignore errors
+  }
+
+  remove_from_zone_maps(rid.slot_num);
+  put_record(rid.slot_num, data);
+  frame_->mark_dirty();
+  return RC::SUCCESS;
+}
+
 RC PaxRecordPageHandler::get_record(const RID &rid, Record &record)
 {
-  // your code here
-  exit(-1);
+  if (rid.slot_num < 0 || rid.slot_num >= page_header_->record_capacity) {
+    LOG_ERROR("Invalid slot_num %d, exceed page's record capacity, frame=%s, page_header=%s",
+              rid.slot_num, frame_->to_string().c_str(), page_header_->to_string().c_str());
+    return RC::RECORD_INVALID_RID;
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (!bitmap.get_bit(rid.slot_num)) {
+    LOG_TRACE("Invalid slot_num:%d, slot is empty, page_num %d.", rid.slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST;
+  }
+
+  // 列数据不是连续存放的，需要复制出来组装成一条记录
+  RC rc = record.new_record(page_header_->record_real_size);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  const PaxColumnMeta *metas = column_metas();
+  for (int col_id = 0; col_id < page_header_->column_num; col_id++) {
+    read_field(rid.slot_num, col_id, record.data() + metas[col_id].record_offset);
+  }
+  record.set_rid(rid);
+  return RC::SUCCESS;
+}
+
+RC PaxRecordPageHandler::get_chunk(Chunk &chunk) { return get_chunk(chunk, {}); }
+
+RC PaxRecordPageHandler::get_chunk(Chunk &chunk, span<const ZoneMapPredicate> predicates)
+{
+  const int capacity = page_header_->record_capacity;
+
+  // 先在编码以后的列上计算条件，得到需要输出的记录
+  Bitmap          bitmap(bitmap_, capacity);
+  vector<uint8_t> select(capacity);
+  for (int i = 0; i < capacity; i++) {
+    select[i] = bitmap.get_bit(i) ? 1 : 0;
+  }
+  for (const ZoneMapPredicate &predicate : predicates) {
+    if (predicate.col_id >= 0 && predicate.col_id < null_column() && is_encoded(predicate.col_id)) {
+      const AttrType attr_type = static_cast<AttrType>(column_metas()[predicate.col_id].attr_type);
+      encoded_column(predicate.col_id).filter(attr_type, predicate.op, predicate.value, select.data());
+    }
+  }
+
+  // 按照连续的有效记录成段复制，没有删除过记录的页面每一列只需要复制一次
+  vector<char> decoded;
+  for (int i = 0; i < chunk.column_num(); i++) {
+    Column   &column = chunk.column(i);
+    const int col_id = chunk.column_ids(i);
+    if (col_id < 0 || col_id >= null_column() || column.attr_len() != get_field_len(col_id)) {
+      LOG_WARN("column does not match the page. col_id=%d, attr_len=%d", col_id, column.attr_len());
+      return RC::INVALID_ARGUMENT;
+    }
+
+    const int len         = get_field_len(col_id);
+    char     *column_data = get_field_data(0, col_id);
+    if (is_encoded(col_id)) {
+      decoded.resize(len * capacity);
+      encoded_column(col_id).decode(0, capacity, decoded.data());
+      column_data = decoded.data();
+    }
+
+    for (int begin = 0; begin < capacity;) {
+      if (!select[begin]) {
+        begin++;
+        continue;
+      }
+      int end = begin + 1;
+      while (end < capacity && select[end]) {
+        end++;
+      }
+
+      RC rc = column.append(column_data + begin * len, end - begin);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to append data to column. col_id=%d, rc=%s", col_id, strrc(rc));
+        return rc;
+      }
+      begin = end;
+    }
+  }
+  return RC::SUCCESS;
 }
 
-// TODO: specify the column_ids that chunk needed. currenly we get all columns
-RC PaxRecordPageHandler::get_chunk(Chunk &chunk)
+bool PaxRecordPageHandler::may_match(span<const ZoneMapPredicate> predicates) const
 {
-  // your code here
-  exit(-1);
+  if (page_header_->record_num == 0) {
+    return false;
+  }
+
+  const PaxColumnMeta *metas    = column_metas();
+  const ZoneMap       *zone_map = zone_maps();
+  for (const ZoneMapPredicate &predicate : predicates) {
+    if (predicate.col_id < 0 || predicate.col_id >= null_column()) {
+      continue;
+    }
+    const AttrType attr_type = static_cast<AttrType>(metas[predicate.col_id].attr_type);
+    if (!zone_map[predicate.col_id].may_match(attr_type, get_field_len(predicate.col_id), predicate)) {
+      return false;
+    }
+  }
+  return true;
 }
 
-char *PaxRecordPageHandler::get_field_data(SlotNum slot_num, int col_id)
+char *PaxRecordPageHandler::get_field_data(SlotNum slot_num, int col_id) const
 {
   int *col_idx = reinterpret_cast<int *>(frame_->data() + page_header_->col_idx_offset);
   if (col_id == 0) {
@@ -477,7 +923,7 @@ char *PaxRecordPageHandler::get_field_data(SlotNum slot_num, int col_id)
   }
 }
 
-int PaxRecordPageHandler::get_field_len(int col_id)
+int PaxRecordPageHandler::get_field_len(int col_id) const
 {
   int *col_idx = reinterpret_cast<int *>(frame_->data() + page_header_->col_idx_offset);
   if (col_id == 0) {
@@ -489,40 +935,455 @@ int PaxRecordPageHandler::get_field_len(int col_id)
 
 ////////////////////////////////////////////////////////////////////////////////
 
-RecordFileHandler::~RecordFileHandler() { this->close(); }
+static_assert(BP_PAGE_DATA_SIZE <= UINT16_MAX, "slot offset must fit in uint16_t");
+
+/// 变长字段索引中的一项，偏移和长度都小于页面大小，可以放到一个int中
+static int pack_var_field(int offset, int len) { return (offset << 16) | len; }
+static int var_field_offset(int var_field) { return var_field >> 16; }
+static int var_field_len(int var_field) { return var_field & 0xFFFF; }
 
-RC RecordFileHandler::init(DiskBufferPool &buffer_pool, LogHandler &log_handler, TableMeta *table_meta)
+RC SlottedRecordPageHandler::init_empty_page(
+    DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, int record_size, TableMeta *table_meta)
 {
-  if (disk_buffer_pool_ != nullptr) {
-    LOG_ERROR("record file handler has been openned.");
-    return RC::RECORD_OPENNED;
+  RC rc = init(buffer_pool, log_handler, page_num, ReadWriteMode::READ_WRITE);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to init empty page page_num:record_size %d:%d. rc=%s", page_num, record_size, strrc(rc));
+    return rc;
   }
 
-  disk_buffer_pool_ = &buffer_pool;
-  log_handler_      = &log_handler;
-  table_meta_       = table_meta;
+  (void)log_handler_.init(log_handler, buffer_pool.id(), record_size, storage_format_);
+
+  // 只有 CHARS 字段会补齐，其它类型的字段都按照定长存放
+  vector<int> var_field_index;
+  if (table_meta != nullptr) {
+    for (const FieldMeta &field : *table_meta->field_metas()) {
+      if (field.type() == AttrType::CHARS && field.len() > 0) {
+        var_field_index.push_back(pack_var_field(field.offset(), field.len()));
+      }
+    }
+  }
 
-  RC rc = init_free_pages();
+  init_slotted_page(record_size, static_cast<int>(var_field_index.size()), var_field_index.data());
 
-  LOG_INFO("open record file handle done. rc=%s", strrc(rc));
+  rc = log_handler_.init_new_page(frame_,
+      page_num,
+      span(reinterpret_cast<const char *>(var_field_index.data()), var_field_index.size() * sizeof(int)));
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to init empty page: write log failed. page_num:record_size %d:%d. rc=%s",
+              page_num, record_size, strrc(rc));
+    return rc;
+  }
   return RC::SUCCESS;
 }
 
-void RecordFileHandler::close()
+RC SlottedRecordPageHandler::init_empty_page(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num,
+    int record_size, int col_num, const char *col_idx_data)
 {
-  if (disk_buffer_pool_ != nullptr) {
-    free_pages_.clear();
-    disk_buffer_pool_ = nullptr;
-    log_handler_      = nullptr;
-    table_meta_       = nullptr;
+  RC rc = init(buffer_pool, log_handler, page_num, ReadWriteMode::READ_WRITE);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to init empty page page_num:record_size %d:%d. rc=%s", page_num, record_size, strrc(rc));
+    return rc;
   }
-}
 
-RC RecordFileHandler::init_free_pages()
-{
-  // 遍历当前文件上所有页面，找到没有满的页面
-  // 这个效率很低，会降低启动速度
-  // NOTE: 由于是初始化时的动作，所以不需要加锁控制并发
+  (void)log_handler_.init(log_handler, buffer_pool.id(), record_size, storage_format_);
+
+  vector<int> var_field_index(col_num);
+  if (col_num > 0) {
+    memcpy(var_field_index.data(), col_idx_data, col_num * sizeof(int));
+  }
+  init_slotted_page(record_size, col_num, var_field_index.data());
+  return RC::SUCCESS;
+}
+
+void SlottedRecordPageHandler::init_slotted_page(int record_size, int var_field_num, const int *var_field_index)
+{
+  // 最短的记录：所有变长字段都是空的
+  int min_encoded_size = record_size;
+  for (int i = 0; i < var_field_num; i++) {
+    min_encoded_size -= var_field_len(var_field_index[i]) - 2;
+  }
+
+  const int meta_size = sizeof(SlottedPageHeader) + var_field_num * sizeof(int);
+
+  page_header_->record_num       = 0;
+  page_header_->column_num       = var_field_num;
+  page_header_->record_real_size = record_size;
+  page_header_->record_size      = align8(record_size);
+  // 按照最短的记录计算最多能放多少条记录，决定 bitmap 的大小，槽目录则按需增长
+  page_header_->record_capacity = page_record_capacity(BP_PAGE_DATA_SIZE, min_encoded_size + sizeof(Slot), meta_size);
+  page_header_->col_idx_offset  = align8(PAGE_HEADER_SIZE + page_bitmap_size(page_header_->record_capacity));
+  page_header_->data_offset     = align8(page_header_->col_idx_offset + meta_size);
+  ASSERT(page_header_->data_offset + max_encoded_size() + static_cast<int>(sizeof(Slot)) <= BP_PAGE_DATA_SIZE,
+         "Record overflow the page size");
+
+  bitmap_ = frame_->data() + PAGE_HEADER_SIZE;
+  memset(bitmap_, 0, page_bitmap_size(page_header_->record_capacity));
+
+  SlottedPageHeader *header = slotted_header();
+  header->slot_count        = 0;
+  header->heap_offset       = BP_PAGE_DATA_SIZE;
+  header->fragmented_size   = 0;
+  if (var_field_num > 0) {
+    memcpy(const_cast<int *>(var_fields()), var_field_index, var_field_num * sizeof(int));
+  }
+
+  frame_->mark_dirty();
+}
+
+int SlottedRecordPageHandler::contiguous_free_space() const
+{
+  const SlottedPageHeader *header = slotted_header();
+  return header->heap_offset - (page_header_->data_offset + header->slot_count * static_cast<int>(sizeof(Slot)));
+}
+
+int SlottedRecordPageHandler::free_space() const { return contiguous_free_space() + slotted_header()->fragmented_size; }
+
+bool SlottedRecordPageHandler::is_full() const
+{
+  return page_header_->record_num >= page_header_->record_capacity ||
+         free_space() < max_encoded_size() + static_cast<int>(sizeof(Slot));
+}
+
+int SlottedRecordPageHandler::encode(const char *data, char *buf) const
+{
+  const int *var_field_index = var_fields();
+  int        record_pos      = 0;
+  char      *out             = buf;
+  for (int i = 0; i < page_header_->column_num; i++) {
+    const int offset = var_field_offset(var_field_index[i]);
+    const int len    = var_field_len(var_field_index[i]);
+    memcpy(out, data + record_pos, offset - record_pos);
+    out += offset - record_pos;
+
+    uint16_t trimmed_len = len;
+    while (trimmed_len > 0 && data[offset + trimmed_len - 1] == 0) {
+      trimmed_len--;
+    }
+    memcpy(out, &trimmed_len, sizeof(trimmed_len));
+    out += sizeof(trimmed_len);
+    memcpy(out, data + offset, trimmed_len);
+    out += trimmed_len;
+
+    record_pos = offset + len;
+  }
+  memcpy(out, data + record_pos, page_header_->record_real_size - record_pos);
+  out += page_header_->record_real_size - record_pos;
+  return static_cast<int>(out - buf);
+}
+
+void SlottedRecordPageHandler::decode(const char *buf, char *data) const
+{
+  const int  *var_field_index = var_fields();
+  int         record_pos      = 0;
+  const char *in              = buf;
+  for (int i = 0; i < page_header_->column_num; i++) {
+    const int offset = var_field_offset(var_field_index[i]);
+    const int len    = var_field_len(var_field_index[i]);
+    memcpy(data + record_pos, in, offset - record_pos);
+    in += offset - record_pos;
+
+    uint16_t trimmed_len = 0;
+    memcpy(&trimmed_len, in, sizeof(trimmed_len));
+    in += sizeof(trimmed_len);
+    memcpy(data + offset, in, trimmed_len);
+    memset(data + offset + trimmed_len, 0, len - trimmed_len);
+    in += trimmed_len;
+
+    record_pos = offset + len;
+  }
+  memcpy(data + record_pos, in, page_header_->record_real_size - record_pos);
+}
+
+void SlottedRecordPageHandler::compact()
+{
+  SlottedPageHeader *header = slotted_header();
+  Slot              *slot   = slots();
+  char              *page   = frame_->data();
+
+  char buffer[BP_PAGE_DATA_SIZE];
+  int  heap_offset = BP_PAGE_DATA_SIZE;
+  for (int i = 0; i < header->slot_count; i++) {
+    if (slot[i].length == 0) {
+      continue;
+    }
+    heap_offset -= slot[i].length;
+    memcpy(buffer + heap_offset, page + slot[i].offset, slot[i].length);
+    slot[i].offset = heap_offset;
+  }
+  memcpy(page + heap_offset, buffer + heap_offset, BP_PAGE_DATA_SIZE - heap_offset);
+
+  LOG_TRACE("compact slotted page. page_num=%d, reclaimed=%d", get_page_num(), header->fragmented_size);
+  header->heap_offset     = heap_offset;
+  header->fragmented_size = 0;
+}
+
+int SlottedRecordPageHandler::allocate(SlotNum slot_num, int size)
+{
+  SlottedPageHeader *header = slotted_header();
+
+  const int new_slot_count = max(header->slot_count, slot_num + 1);
+  const int slot_grow_size = (new_slot_count - header->slot_count) * static_cast<int>(sizeof(Slot));
+  if (contiguous_free_space() < size + slot_grow_size) {
+    if (free_space() < size + slot_grow_size) {
+      return -1;
+    }
+    compact();
+  }
+
+  Slot *slot = slots();
+  for (int i = header->slot_count; i < new_slot_count; i++) {
+    slot[i].offset = 0;
+    slot[i].length = 0;
+  }
+  header->slot_count = new_slot_count;
+  header->heap_offset -= size;
+  return header->heap_offset;
+}
+
+RC SlottedRecordPageHandler::put_record(SlotNum slot_num, const char *data)
+{
+  SlottedPageHeader *header = slotted_header();
+
+  char buffer[BP_PAGE_DATA_SIZE];
+  int  size = encode(data, buffer);
+
+  if (slot_num < header->slot_count && slots()[slot_num].length > 0) {
+    Slot &slot = slots()[slot_num];
+    // 变短或者长度不变的时候原地修改
+    if (size <= slot.length) {
+      memcpy(frame_->data() + slot.offset, buffer, size);
+      header->fragmented_size += slot.length - size;
+      slot.length = size;
+      return RC::SUCCESS;
+    }
+
+    if (free_space() + slot.length < size) {
+      return RC::RECORD_NOMEM;
+    }
+
+    header->fragmented_size += slot.length;
+    slot.length = 0;
+  }
+
+  int offset = allocate(slot_num, size);
+  if (offset < 0) {
+    return RC::RECORD_NOMEM;
+  }
+
+  memcpy(frame_->data() + offset, buffer, size);
+  Slot &slot  = slots()[slot_num];
+  slot.offset = offset;
+  slot.length = size;
+  return RC::SUCCESS;
+}
+
+RC SlottedRecordPageHandler::insert_record(const char *data, RID *rid)
+{
+  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY,
+         "cannot insert record into page while the page is readonly");
+
+  if (page_header_->record_num == page_header_->record_capacity) {
+    LOG_WARN("Page is full, page_num %d:%d.", disk_buffer_pool_->file_desc(), frame_->page_num());
+    return RC::RECORD_NOMEM;
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  int    index = bitmap.next_unsetted_bit(0);
+
+  RC rc = put_record(index, data);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("Page has no space for record, page_num %d:%d, free space=%d.",
+             disk_buffer_pool_->file_desc(), frame_->page_num(), free_space());
+    return rc;
+  }
+
+  bitmap.set_bit(index);
+  page_header_->record_num++;
+
+  rc = log_handler_.insert_record(frame_, RID(get_page_num(), index), data);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to insert record. page_num %d:%d. rc=%s", disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
+    // return rc; // ignore errors
+  }
+
+  frame_->mark_dirty();
+
+  if (rid) {
+    rid->page_num = get_page_num();
+    rid->slot_num = index;
+  }
+  return RC::SUCCESS;
+}
+
+RC SlottedRecordPageHandler::recover_insert_record(const char *data, const RID &rid)
+{
+  if (rid.slot_num >= page_header_->record_capacity) {
+    LOG_WARN("slot_num illegal, slot_num(%d) > record_capacity(%d).", rid.slot_num, page_header_->record_capacity);
+    return RC::RECORD_INVALID_RID;
+  }
+
+  RC rc = put_record(rid.slot_num, data);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("Page has no space for record, page_num %d, slot_num %d.", frame_->page_num(), rid.slot_num);
+    return rc;
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (!bitmap.get_bit(rid.slot_num)) {
+    bitmap.set_bit(rid.slot_num);
+    page_header_->record_num++;
+  }
+
+  frame_->mark_dirty();
+  return RC::SUCCESS;
+}
+
+RC SlottedRecordPageHandler::delete_record(const RID *rid)
+{
+  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY,
+         "cannot delete record from page while the page is readonly");
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (rid->slot_num >= page_header_->record_capacity || !bitmap.get_bit(rid->slot_num)) {
+    LOG_DEBUG("Invalid slot_num %d, slot is empty, page_num %d.", rid->slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST;
+  }
+
+  bitmap.clear_bit(rid->slot_num);
+  page_header_->record_num--;
+
+  SlottedPageHeader *header = slotted_header();
+  Slot              *slot   = slots();
+  header->fragmented_size += slot[rid->slot_num].length;
+  slot[rid->slot_num].length = 0;
+
+  // 末尾的空槽可以还给空闲空间，页面空了以后整个记录堆都是空闲的
+  while (header->slot_count > 0 && slot[header->slot_count - 1].length == 0) {
+    header->slot_count--;
+  }
+  if (page_header_->record_num == 0) {
+    header->heap_offset     = BP_PAGE_DATA_SIZE;
+    header->fragmented_size = 0;
+  }
+  frame_->mark_dirty();
+
+  RC rc = log_handler_.delete_record(frame_, *rid);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to delete record. page_num %d:%d. rc=%s", disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
+    // return rc; // ignore errors
+  }
+  return RC::SUCCESS;
+}
+
+RC SlottedRecordPageHandler::update_record(const RID &rid, const char *data)
+{
+  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY, "cannot update record in page while the page is readonly");
+
+  if (rid.slot_num >= page_header_->record_capacity) {
+    LOG_ERROR("Invalid slot_num %d, exceed page's record capacity, frame=%s, page_header=%s",
+              rid.slot_num, frame_->to_string().c_str(), page_header_->to_string().c_str());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (!bitmap.get_bit(rid.slot_num)) {
+    LOG_DEBUG("Invalid slot_num %d, slot is empty, page_num %d.", rid.slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST;
+  }
+
+  RC rc = put_record(rid.slot_num, data);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("Page has no space for updated record. rid=%s, free space=%d, rc=%s",
+             rid.to_string().c_str(), free_space(), strrc(rc));
+    return rc;
+  }
+  frame_->mark_dirty();
+
+  rc = log_handler_.update_record(frame_, rid, data);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to update record. page_num %d:%d. rc=%s",
+              disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
+    // return rc; // ignore errors
+  }
+  return RC::SUCCESS;
+}
+
+RC SlottedRecordPageHandler::get_record(const RID &rid, Record &record)
+{
+  if (rid.slot_num >= page_header_->record_capacity) {
+    LOG_ERROR("Invalid slot_num %d, exceed page's record capacity, frame=%s, page_header=%s",
+              rid.slot_num, frame_->to_string().c_str(), page_header_->to_string().c_str());
+    return RC::RECORD_INVALID_RID;
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (!bitmap.get_bit(rid.slot_num)) {
+    LOG_ERROR("Invalid slot_num:%d, slot is empty, page_num %d.", rid.slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST;
+  }
+
+  record.set_rid(rid);
+  record.new_record(page_header_->record_real_size);
+  decode(frame_->data() + slots()[rid.slot_num].offset, record.data());
+  return RC::SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+RecordFileHandler::~RecordFileHandler() { this->close(); }
+
+RC RecordFileHandler::init(
+    DiskBufferPool &buffer_pool, LogHandler &log_handler, TableMeta *table_meta, const char *free_space_map_file)
+{
+  if (disk_buffer_pool_ != nullptr) {
+    LOG_ERROR("record file handler has been openned.");
+    return RC::RECORD_OPENNED;
+  }
+
+  disk_buffer_pool_ = &buffer_pool;
+  log_handler_      = &log_handler;
+  table_meta_       = table_meta;
+
+  RC rc = RC::SUCCESS;
+  if (free_space_map_file != nullptr) {
+    free_space_map_file_ = free_space_map_file;
+    rc                   = free_space_map_.load(free_space_map_file);
+    // 文件只在正常关闭时写入。加载以后马上删掉，异常退出时下次启动会重新扫描
+    ::remove(free_space_map_file);
+  }
+
+  if (free_space_map_file == nullptr || OB_FAIL(rc)) {
+    rc = init_free_pages();
+  }
+
+  LOG_INFO("open record file handle done. rc=%s", strrc(rc));
+  return RC::SUCCESS;
+}
+
+void RecordFileHandler::close()
+{
+  if (disk_buffer_pool_ != nullptr) {
+    if (!free_space_map_file_.empty()) {
+      (void)free_space_map_.save(free_space_map_file_.c_str());
+      free_space_map_file_.clear();
+    }
+    free_space_map_.clear();
+    disk_buffer_pool_ = nullptr;
+    log_handler_      = nullptr;
+    table_meta_       = nullptr;
+  }
+}
+
+int RecordFileHandler::free_space_level(const RecordPageHandler &page_handler)
+{
+  return page_handler.is_full() ? 0 : FreeSpaceMap::level(page_handler.free_space());
+}
+
+RC RecordFileHandler::init_free_pages()
+{
+  // 遍历当前文件上所有页面，记录每个页面的剩余空间
+  // 这个效率很低，会降低启动速度，所以正常关闭时会把空闲空间表保存下来
+  // NOTE: 由于是初始化时的动作，所以不需要加锁控制并发
 
   RC rc = RC::SUCCESS;
 
@@ -530,6 +1391,7 @@ RC RecordFileHandler::init_free_pages()
   bp_iterator.init(*disk_buffer_pool_, 1);
   unique_ptr<RecordPageHandler> record_page_handler(RecordPageHandler::create(storage_format_));
   PageNum                       current_page_num = 0;
+  int                           free_page_num    = 0;
 
   while (bp_iterator.has_next()) {
     current_page_num = bp_iterator.next();
@@ -540,12 +1402,14 @@ RC RecordFileHandler::init_free_pages()
       return rc;
     }
 
-    if (!record_page_handler->is_full()) {
-      free_pages_.insert(current_page_num);
+    const int level = free_space_level(*record_page_handler);
+    free_space_map_.release(current_page_num, level);
+    if (level > 0) {
+      free_page_num++;
     }
     record_page_handler->cleanup();
   }
-  LOG_INFO("record file handler init free pages done. free page num=%d, rc=%s", free_pages_.size(), strrc(rc));
+  LOG_INFO("record file handler init free pages done. free page num=%d, rc=%s", free_page_num, strrc(rc));
   return rc;
 }
 
@@ -557,16 +1421,11 @@ RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
   bool                          page_found       = false;
   PageNum                       current_page_num = 0;
 
-  // 当前要访问free_pages对象，所以需要加锁。在非并发编译模式下，不需要考虑这个锁
-  lock_.lock();
-
-  // 找到没有填满的页面
-  while (!free_pages_.empty()) {
-    current_page_num = *free_pages_.begin();
-
+  // 从空闲空间表中占用一个页面，并发插入的线程会拿到不同的页面，不需要全局的锁
+  while ((current_page_num = free_space_map_.claim()) != BP_INVALID_PAGE_NUM) {
     ret = record_page_handler->init(*disk_buffer_pool_, *log_handler_, current_page_num, ReadWriteMode::READ_WRITE);
     if (OB_FAIL(ret)) {
-      lock_.unlock();
+      free_space_map_.release(current_page_num, 0);
       LOG_WARN("failed to init record page handler. page num=%d, rc=%d:%s", current_page_num, ret, strrc(ret));
       return ret;
     }
@@ -575,12 +1434,13 @@ RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
       page_found = true;
       break;
     }
+
+    // 空闲空间表只是提示，可能与页面的实际情况不一致
+    free_space_map_.release(current_page_num, 0);
     record_page_handler->cleanup();
-    free_pages_.erase(free_pages_.begin());
   }
-  lock_.unlock();  // 如果找到了一个有效的页面，那么此时已经拿到了页面的写锁
 
-  // 找不到就分配一个新的页面
+  // 找不到就分配一个新的页面。新页面在插入完成之前不在空闲空间表中，其它线程看不到
   if (!page_found) {
     Frame *frame = nullptr;
     if ((ret = disk_buffer_pool_->allocate_page(&frame)) != RC::SUCCESS) {
@@ -601,18 +1461,65 @@ RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
 
     // frame 在allocate_page的时候，是有一个pin的，在init_empty_page时又会增加一个，所以这里手动释放一个
     frame->unpin();
-
-    // 这里的加锁顺序看起来与上面是相反的，但是不会出现死锁
-    // 上面的逻辑是先加lock锁，然后加页面写锁，这里是先加上
-    // 了页面写锁，然后加lock的锁，但是不会引起死锁。
-    // 为什么？
-    lock_.lock();
-    free_pages_.insert(current_page_num);
-    lock_.unlock();
   }
 
   // 找到空闲位置
-  return record_page_handler->insert_record(data, rid);
+  ret = record_page_handler->insert_record(data, rid);
+
+  // 此时仍然持有页面的写锁，空闲空间表中的等级与页面的修改顺序一致
+  free_space_map_.release(current_page_num, free_space_level(*record_page_handler));
+  return ret;
+}
+
+RC RecordFileHandler::insert_records(span<const char *const> records, int record_size, vector<RID> &rids)
+{
+  RC ret = RC::SUCCESS;
+
+  rids.resize(records.size());
+  size_t inserted_total = 0;
+
+  unique_ptr<RecordPageHandler> record_page_handler(RecordPageHandler::create(storage_format_));
+  while (inserted_total < records.size()) {
+    // 与 insert_record 一样先占用一个有空闲空间的页面，找不到再分配新页面
+    PageNum current_page_num = free_space_map_.claim();
+    if (current_page_num != BP_INVALID_PAGE_NUM) {
+      ret = record_page_handler->init(*disk_buffer_pool_, *log_handler_, current_page_num, ReadWriteMode::READ_WRITE);
+      if (OB_FAIL(ret)) {
+        free_space_map_.release(current_page_num, 0);
+        LOG_WARN("failed to init record page handler. page num=%d, rc=%d:%s", current_page_num, ret, strrc(ret));
+        break;
+      }
+    } else {
+      Frame *frame = nullptr;
+      if ((ret = disk_buffer_pool_->allocate_page(&frame)) != RC::SUCCESS) {
+        LOG_ERROR("Failed to allocate page while inserting records. ret:%d", ret);
+        break;
+      }
+
+      current_page_num = frame->page_num();
+
+      ret = record_page_handler->init_empty_page(
+          *disk_buffer_pool_, *log_handler_, current_page_num, record_size, table_meta_);
+      frame->unpin();  // allocate_page 时加的 pin
+      if (OB_FAIL(ret)) {
+        LOG_ERROR("Failed to init empty page. ret:%d", ret);
+        break;
+      }
+    }
+
+    int inserted = 0;
+    ret = record_page_handler->insert_records(records.subspan(inserted_total), rids.data() + inserted_total, inserted);
+    inserted_total += inserted;
+
+    free_space_map_.release(current_page_num, free_space_level(*record_page_handler));
+    record_page_handler->cleanup();
+    if (OB_FAIL(ret)) {
+      break;
+    }
+  }
+
+  rids.resize(inserted_total);
+  return ret;
 }
 
 RC RecordFileHandler::recover_insert_record(const char *data, int record_size, const RID &rid)
@@ -627,7 +1534,9 @@ RC RecordFileHandler::recover_insert_record(const char *data, int record_size, c
     return ret;
   }
 
-  return record_page_handler->recover_insert_record(data, rid);
+  ret = record_page_handler->recover_insert_record(data, rid);
+  free_space_map_.update(rid.page_num, free_space_level(*record_page_handler));
+  return ret;
 }
 
 RC RecordFileHandler::delete_record(const RID *rid)
@@ -643,18 +1552,12 @@ RC RecordFileHandler::delete_record(const RID *rid)
   }
 
   rc = record_page_handler->delete_record(rid);
-  // 📢 这里注意要清理掉资源，否则会与insert_record中的加锁顺序冲突而可能出现死锁
-  // delete record的加锁逻辑是拿到页面锁，删除指定记录，然后加上和释放record manager锁
-  // insert record是加上 record manager锁，然后拿到指定页面锁再释放record manager锁
-  record_page_handler->cleanup();
   if (OB_SUCC(rc)) {
-    // 因为这里已经释放了页面锁，并发时，其它线程可能又把该页面填满了，那就不应该再放入 free_pages_
-    // 中。但是这里可以不关心，因为在查找空闲页面时，会自动过滤掉已经满的页面
-    lock_.lock();
-    free_pages_.insert(rid->page_num);
-    LOG_TRACE("add free page %d to free page list", rid->page_num);
-    lock_.unlock();
+    // 持有页面写锁的时候更新，不会覆盖其它线程对这个页面更新的结果
+    free_space_map_.update(rid->page_num, free_space_level(*record_page_handler));
+    LOG_TRACE("update free space of page %d", rid->page_num);
   }
+  record_page_handler->cleanup();
   return rc;
 }
 
@@ -698,13 +1601,64 @@ RC RecordFileHandler::visit_record(const RID &rid, function<RC(Record &)> update
     LOG_WARN("failed to get record from record page handle. rid=%s, rc=%s", rid.to_string().c_str(), strrc(rc));
     return rc;
   }
+  rc = tmp_record.materialize();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
   rc = updater(tmp_record);
   if (rc == RC::SUCCESS) {
     rc = page_handler->update_record(rid, tmp_record.data());
   }
+  if (OB_SUCC(rc) && storage_format_ == StorageFormat::SLOTTED_FORMAT) {
+    // 只有变长记录的更新会改变页面的剩余空间
+    free_space_map_.update(rid.page_num, free_space_level(*page_handler));
+  }
   return rc;
 }
 
+RC RecordFileHandler::visit_pages(
+    PageNum start_page, int max_pages, function<void(Record &)> visitor, PageNum &next_page)
+{
+  next_page = BP_INVALID_PAGE_NUM;
+
+  BufferPoolIterator bp_iterator;
+  bp_iterator.init(*disk_buffer_pool_, max(start_page, 1));
+  unique_ptr<RecordPageHandler> page_handler(RecordPageHandler::create(storage_format_));
+
+  int visited_pages = 0;
+  while (visited_pages < max_pages && bp_iterator.has_next()) {
+    PageNum page_num = bp_iterator.next();
+
+    RC rc = page_handler->init(*disk_buffer_pool_, *log_handler_, page_num, ReadWriteMode::READ_ONLY);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to init record page handler. page num=%d, rc=%s", page_num, strrc(rc));
+      return rc;
+    }
+
+    RecordPageIterator record_iterator;
+    record_iterator.init(page_handler.get());
+    Record record;
+    while (record_iterator.has_next()) {
+      rc = record_iterator.next(record);
+      if (OB_FAIL(rc)) {
+        break;
+      }
+      visitor(record);
+    }
+    // 记录可能还引用着页帧，需要在释放页面之前放掉
+    record = Record();
+    page_handler->cleanup();
+
+    visited_pages++;
+    next_page = page_num + 1;
+  }
+
+  if (next_page != BP_INVALID_PAGE_NUM && !bp_iterator.has_next()) {
+    next_page = BP_INVALID_PAGE_NUM;
+  }
+  return RC::SUCCESS;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 RecordFileScanner::~RecordFileScanner() { close_scan(); }
@@ -726,11 +1680,8 @@ RC RecordFileScanner::open_scan(Table *table, DiskBufferPool &buffer_pool, Trx *
     return rc;
   }
   condition_filter_ = condition_filter;
-  if (table == nullptr || table->table_meta().storage_format() == StorageFormat::ROW_FORMAT) {
-    record_page_handler_ = new RowRecordPageHandler();
-  } else {
-    record_page_handler_ = new PaxRecordPageHandler();
-  }
+  record_page_handler_ =
+      RecordPageHandler::create(table == nullptr ? StorageFormat::ROW_FORMAT : table->table_meta().storage_format());
 
   return rc;
 }
@@ -776,6 +1727,7 @@ RC RecordFileScanner::fetch_next_record()
   }
 
   // 所有的页面都遍历完了，没有数据了
+  next_record_.set_data(nullptr);
   next_record_.rid().slot_num = -1;
   record_page_handler_->cleanup();
   return RC::RECORD_EOF;
@@ -830,6 +1782,8 @@ RC RecordFileScanner::close_scan()
     condition_filter_ = nullptr;
   }
 
+  // 释放记录持有的页帧
+  next_record_ = Record();
   record_page_iterator_.clean_record_page_handler_();
 
   // if (record_page_handler_ != nullptr) {
@@ -848,9 +1802,12 @@ RC RecordFileScanner::next(Record &record)
 {
   RC rc = fetch_next_record();
   if (OB_FAIL(rc)) {
+    // 扫描结束以后不再返回数据，释放上一条记录持有的页帧
+    record = Record();
     return rc;
   }
 
+  // 行存格式的记录指向页帧，同一个页面上的记录之间赋值只修改指针，不复制数据
   record = next_record_;
   return RC::SUCCESS;
 }
@@ -882,34 +1839,74 @@ RC ChunkFileScanner::close_scan()
 }
 
 RC ChunkFileScanner::open_scan_chunk(
-    Table *table, DiskBufferPool &buffer_pool, LogHandler &log_handler, ReadWriteMode mode)
+    Table *table, DiskBufferPool &buffer_pool, Trx *trx, LogHandler &log_handler, ReadWriteMode mode)
 {
   close_scan();
 
   table_            = table;
+  trx_              = trx;
+  morsels_          = nullptr;
   disk_buffer_pool_ = &buffer_pool;
   log_handler_      = &log_handler;
   rw_mode_          = mode;
+  page_chunk_.reset();
 
   RC rc = bp_iterator_.init(buffer_pool, 1);
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to init bp iterator. rc=%d:%s", rc, strrc(rc));
     return rc;
   }
-  if (table == nullptr || table->table_meta().storage_format() == StorageFormat::ROW_FORMAT) {
-    record_page_handler_ = new RowRecordPageHandler();
-  } else {
-    record_page_handler_ = new PaxRecordPageHandler();
-  }
+  record_page_handler_ =
+      RecordPageHandler::create(table == nullptr ? StorageFormat::ROW_FORMAT : table->table_meta().storage_format());
 
   return rc;
 }
 
+void ChunkFileScanner::set_morsel_queue(PageMorselQueue *morsels)
+{
+  morsels_ = morsels;
+  if (morsels_ != nullptr) {
+    morsels_->init(*disk_buffer_pool_);
+    bp_iterator_.init(*disk_buffer_pool_, 1, 1);  // 从第一个 morsel 开始
+  }
+}
+
+bool ChunkFileScanner::next_page()
+{
+  PageNum begin = BP_INVALID_PAGE_NUM;
+  PageNum end   = BP_INVALID_PAGE_NUM;
+  while (!bp_iterator_.has_next()) {
+    if (morsels_ == nullptr || !morsels_->next(begin, end)) {
+      return false;
+    }
+    bp_iterator_.init(*disk_buffer_pool_, begin, end);
+  }
+  return true;
+}
+
+bool ChunkFileScanner::need_filter() const
+{
+  if (table_ == nullptr || table_->table_meta().field_num() == 0) {
+    return false;
+  }
+  return !filters_.empty() || (trx_ != nullptr && !table_->table_meta().trx_fields().empty());
+}
+
 RC ChunkFileScanner::next_chunk(Chunk &chunk)
 {
   RC rc = RC::SUCCESS;
 
-  while (bp_iterator_.has_next()) {
+  // 需要判断可见性或者过滤时，先读出页面中的所有字段，再把选中的记录复制到 chunk 中
+  const bool filter = need_filter();
+  if (filter && page_chunk_.column_num() == 0) {
+    const TableMeta &table_meta = table_->table_meta();
+    for (int i = 0; i < table_meta.field_num(); i++) {
+      page_chunk_.add_column(make_unique<Column>(*table_meta.field(i)), i);
+    }
+  }
+  Chunk &page_chunk = filter ? page_chunk_ : chunk;
+
+  while (next_page()) {
     PageNum page_num = bp_iterator_.next();
     record_page_handler_->cleanup();
     rc = record_page_handler_->init(*disk_buffer_pool_, *log_handler_, page_num, rw_mode_);
@@ -917,17 +1914,96 @@ RC ChunkFileScanner::next_chunk(Chunk &chunk)
       LOG_WARN("failed to init record page handler. page_num=%d, rc=%s", page_num, strrc(rc));
       return rc;
     }
-    rc = record_page_handler_->get_chunk(chunk);
-    if (rc == RC::SUCCESS) {
-      return rc;
-    } else if (rc == RC::RECORD_EOF) {
+    if (!record_page_handler_->may_match(predicates_)) {
+      LOG_TRACE("skip page by zone map. page_num=%d", page_num);
+      continue;
+    }
+
+    page_chunk.reset_data();
+    rc = record_page_handler_->get_chunk(page_chunk, predicates_);
+    if (rc == RC::RECORD_EOF) {
       break;
-    } else {
+    } else if (OB_FAIL(rc)) {
       LOG_WARN("failed to get chunk from page. page_num=%d, rc=%s", page_num, strrc(rc));
       return rc;
     }
+
+    if (filter && page_chunk.rows() > 0) {
+      rc = filter_page_chunk();
+      if (OB_FAIL(rc)) {
+        LOG_TRACE("failed to filter records. page_num=%d, rc=%s", page_num, strrc(rc));
+        return rc;
+      }
+      chunk.reset_data();
+      rc = output_selected(chunk);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+    }
+
+    if (chunk.column_num() > 0 && chunk.rows() == 0) {
+      continue;  // 页面中的记录都被过滤掉了
+    }
+    return RC::SUCCESS;
   }
 
   record_page_handler_->cleanup();
   return RC::RECORD_EOF;
 }
+
+RC ChunkFileScanner::filter_page_chunk()
+{
+  const int rows = page_chunk_.rows();
+  select_.assign(rows, 1);
+
+  if (trx_ != nullptr && !table_->table_meta().trx_fields().empty()) {
+    RC rc = trx_->visit_chunk(table_, page_chunk_, select_, rw_mode_);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
+  // eval 只会把不满足条件的记录清零，多个条件依次计算就是 AND 的结果
+  for (Expression *filter : filters_) {
+    RC rc = filter->eval(page_chunk_, select_);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to eval filter. rc=%s", strrc(rc));
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC ChunkFileScanner::output_selected(Chunk &chunk)
+{
+  const int rows = page_chunk_.rows();
+  for (int i = 0; i < chunk.column_num(); i++) {
+    Column   &column = chunk.column(i);
+    const int col_id = chunk.column_ids(i);
+    if (col_id < 0 || col_id >= page_chunk_.column_num() || column.attr_len() != page_chunk_.column(col_id).attr_len()) {
+      LOG_WARN("column does not match the table. col_id=%d, attr_len=%d", col_id, column.attr_len());
+      return RC::INVALID_ARGUMENT;
+    }
+
+    const Column &source = page_chunk_.column(col_id);
+    const int     len    = source.attr_len();
+    for (int begin = 0; begin < rows;) {
+      if (!select_[begin]) {
+        begin++;
+        continue;
+      }
+      int end = begin + 1;
+      while (end < rows && select_[end]) {
+        end++;
+      }
+
+      RC rc = column.append(source.data() + begin * len, end - begin);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to append data to column. col_id=%d, rc=%s", col_id, strrc(rc));
+        return rc;
+      }
+      begin = end;
+    }
+  }
+  return RC::SUCCESS;
+}
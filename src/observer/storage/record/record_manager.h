@@ -18,12 +18,16 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/sstream.h"
 #include "storage/buffer/disk_buffer_pool.h"
 #include "storage/common/chunk.h"
+#include "storage/record/column_encoding.h"
+#include "storage/record/free_space_map.h"
 #include "storage/record/record.h"
 #include "storage/record/record_log.h"
+#include "storage/record/zone_map.h"
 #include "common/types.h"
 
 class LogHandler;
 class ConditionFilter;
+class Expression;
 class RecordPageHandler;
 class LogHandler;
 class Trx;
@@ -54,6 +58,9 @@ class Table;
  * - RecordFileScanner：可以用来遍历整个文件上的所有记录
  * - RecordPageIterator：可以用来遍历指定页面上的所有记录
  * - PageHeader：每个页面上都会记录的页面头信息
+ *
+ * 对于问题1和问题2，SLOTTED_FORMAT 格式的表使用槽页面(slotted page)存放变长记录，
+ * 可以参考 SlottedRecordPageHandler。
  */
 
 /**
@@ -156,7 +163,7 @@ public:
    * @param record_size 每个记录的大小
    * @param table_meta  表的元数据
    */
-  RC init_empty_page(
+  virtual RC init_empty_page(
       DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, int record_size, TableMeta *table_meta);
 
   /**
@@ -167,7 +174,7 @@ public:
    * @param col_num  表中包含的列数
    * @param col_idx_data 列索引数据
    */
-  RC init_empty_page(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, int record_size,
+  virtual RC init_empty_page(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, int record_size,
       int col_num, const char *col_idx_data);
 
   /**
@@ -191,6 +198,15 @@ public:
    */
   virtual RC recover_insert_record(const char *data, const RID &rid) { return RC::UNIMPLEMENTED; }
 
+  /**
+   * @brief 批量插入记录，直到记录插完或者页面放满
+   * @details 整个页面只记录一条日志，而不是每条记录一条
+   * @param records  要插入的记录
+   * @param rids     返回每条记录插入的位置，至少有 records.size() 个
+   * @param inserted 返回插入了多少条记录
+   */
+  RC insert_records(span<const char *const> records, RID *rids, int &inserted);
+
   /**
    * @brief 删除指定的记录
    *
@@ -206,7 +222,8 @@ public:
 
   /**
    * @brief 获取指定位置的记录数据
-   *
+   * @details 记录在页面上连续存放时(行存格式)，record 直接指向页帧内存，不复制数据，
+   * 需要修改或者在页面锁释放以后继续使用时，调用 Record::materialize 复制一份。
    * @param rid 指定的位置
    * @param record 获取到的记录结果
    */
@@ -220,6 +237,19 @@ public:
    */
   virtual RC get_chunk(Chunk &chunk) { return RC::UNIMPLEMENTED; }
 
+  /**
+   * @brief 获取整个页面中指定列的记录，同时用简单的条件过滤
+   * @details 只是一个优化，不保证过滤掉所有不满足条件的记录，调用方仍然需要自己过滤。
+   * 默认不做过滤。
+   */
+  virtual RC get_chunk(Chunk &chunk, span<const ZoneMapPredicate> predicates) { return get_chunk(chunk); }
+
+  /**
+   * @brief 页面中是否可能有满足所有条件的记录
+   * @details 只有 PAX 页面维护了 zone map，其它格式的页面总是返回 true
+   */
+  virtual bool may_match(span<const ZoneMapPredicate> predicates) const { return true; }
+
   /**
    * @brief 返回该记录页的页号
    */
@@ -228,7 +258,12 @@ public:
   /**
    * @brief 当前页面是否已经没有空闲位置插入新的记录
    */
-  bool is_full() const;
+  virtual bool is_full() const;
+
+  /**
+   * @brief 页面中还可以用来存放记录的空间
+   */
+  virtual int free_space() const;
 
 protected:
   /**
@@ -291,15 +326,39 @@ public:
   RC get_record(const RID &rid, Record &record) override;
 };
 
+/**
+ * @brief PAX 页面中每一列的描述
+ * @ingroup RecordManager
+ */
+struct PaxColumnMeta
+{
+  int32_t record_offset;  ///< 这一列在记录中的偏移
+  int32_t attr_type;      ///< 字段类型，维护 zone map 时使用
+  int32_t null_bit;       ///< 这一列在 NULL 位图中的位置，不可能为 NULL 时是 -1
+  int32_t encoding;       ///< 这一列当前的编码方式(ColumnEncoding)
+};
+
 /**
  * @brief 负责处理 PAX 存储格式的页面中各种操作
  * @ingroup RecordManager
  * @details PAX 格式实现，当前定长记录模式下每个页面的组织大概是这样的：
  * @code
- * | PageHeader | record allocate bitmap | column index  |
- * |------------|------------------------| ------------- |
- * | column1 | column2 | ..................... | columnN |
+ * | PageHeader | record allocate bitmap | column index | column meta | zone maps |
+ * |------------|------------------------|--------------|-------------|-----------|
+ * | column1 | column2 | ..................... | columnN | null bitmap |
  * @endcode
+ * 每个字段是一列，记录中不属于任何字段的部分(也就是 NULL 位图)作为最后一列存放，
+ * 所以页面的列数是字段个数加一。column meta 记录每一列在记录中的位置，
+ * 创建页面时与 column index 一起写入日志，重放时不需要表的元数据。
+ *
+ * 每一列有一个 ZoneMap，记录这一列的最小值、最大值和 NULL 的个数，随着页面的修改一起维护。
+ * ChunkFileScanner 根据 zone map 跳过不可能有满足条件的记录的页面，不需要解码页面中的数据。
+ *
+ * 页面写满的时候，为每一列选择一种编码方式(参考 ColumnEncoder)，在原来的位置上改写成编码以后的数据，
+ * 剩下的空间清零。修改一条记录时，只有值真正发生变化的列才会解码回原始格式，比如 MVCC 提交时
+ * 只修改事务字段，其它列仍然保持编码。编码只改变页面内的物理格式，不改变记录的内容，所以不需要写日志，
+ * 重放日志时在编码或者没有编码的页面上执行的结果是一样的。
+ * 读取 Chunk 时可以直接在编码以后的数据上计算比较条件(参考 EncodedColumn::filter)，只解码满足条件的记录。
  * 更多细节可参考：docs/design/miniob-pax-storage.md
  */
 class PaxRecordPageHandler : public RecordPageHandler
@@ -307,6 +366,11 @@ class PaxRecordPageHandler : public RecordPageHandler
 public:
   PaxRecordPageHandler() : RecordPageHandler(StorageFormat::PAX_FORMAT) {}
 
+  RC init_empty_page(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, int record_size,
+      TableMeta *table_meta) override;
+  RC init_empty_page(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, int record_size,
+      int col_num, const char *col_idx_data) override;
+
   /**
    * @brief 插入一条记录
    *
@@ -316,8 +380,12 @@ public:
    */
   virtual RC insert_record(const char *data, RID *rid) override;
 
+  RC recover_insert_record(const char *data, const RID &rid) override;
+
   virtual RC delete_record(const RID *rid) override;
 
+  RC update_record(const RID &rid, const char *data) override;
+
   /**
    * @brief 获取指定位置的记录数据
    *
@@ -334,12 +402,194 @@ public:
    */
   virtual RC get_chunk(Chunk &chunk) override;
 
+  /**
+   * @brief 以 Chunk 格式获取页面中满足条件的记录
+   * @details 只在编码以后的列上计算条件，没有编码的列不过滤
+   */
+  RC get_chunk(Chunk &chunk, span<const ZoneMapPredicate> predicates) override;
+
+  bool may_match(span<const ZoneMapPredicate> predicates) const override;
+
+  /**
+   * @brief 指定列的 zone map，仅用于观察和测试
+   */
+  const ZoneMap &zone_map(int col_id) const { return zone_maps()[col_id]; }
+
+  /**
+   * @brief 指定列当前的编码方式，仅用于观察和测试
+   */
+  ColumnEncoding column_encoding(int col_id) const { return static_cast<ColumnEncoding>(column_metas()[col_id].encoding); }
+
 private:
-  // get the field data by `slot_num` and `column id`
-  char *get_field_data(SlotNum slot_num, int col_id);
+  /**
+   * @brief 初始化页头、列索引、列描述和 zone map
+   * @param field_lens 每一列的长度
+   */
+  void init_pax_page(int record_size, int column_num, const int *field_lens, const PaxColumnMeta *metas);
+
+  PaxColumnMeta *column_metas() const
+  {
+    return reinterpret_cast<PaxColumnMeta *>(
+        frame_->data() + page_header_->col_idx_offset + page_header_->column_num * sizeof(int));
+  }
+  ZoneMap *zone_maps() const
+  {
+    return reinterpret_cast<ZoneMap *>(frame_->data() + page_header_->col_idx_offset +
+                                       page_header_->column_num * (sizeof(int) + sizeof(PaxColumnMeta)));
+  }
+
+  /// 存放 NULL 位图的列
+  int null_column() const { return page_header_->column_num - 1; }
+
+  /// null_bits 是 NULL 位图列的数据
+  bool is_null(const char *null_bits, int col_id) const;
+
+  /**
+   * @brief 把记录按列放到指定的槽中，同时更新 zone map
+   * @details 不修改 bitmap 和 record_num，也不写日志
+   */
+  void put_record(SlotNum slot_num, const char *data);
+
+  /**
+   * @brief 从 zone map 中去掉指定槽中的记录
+   */
+  void remove_from_zone_maps(SlotNum slot_num);
+
+  bool          is_encoded(int col_id) const { return column_encoding(col_id) != ColumnEncoding::PLAIN; }
+  EncodedColumn encoded_column(int col_id) const;
+
+  /**
+   * @brief 读取指定槽中一列的值，列可能已经编码
+   */
+  void read_field(SlotNum slot_num, int col_id, char *out) const;
+
+  /**
+   * @brief 为所有没有编码的列选择编码方式并编码。页面写满的时候调用
+   */
+  void encode_columns();
+
+  /**
+   * @brief 把一列解码回原始格式，修改这一列之前调用
+   */
+  void decode_column(int col_id);
+
+  // get the field data by `slot_num` and `column id`, the column must not be encoded
+  char *get_field_data(SlotNum slot_num, int col_id) const;
 
   // get the field length by `column id`, all columns are fixed length.
-  int get_field_len(int col_id);
+  int get_field_len(int col_id) const;
+};
+
+/**
+ * @brief 槽页面的页头，放在 PageHeader 的列索引位置
+ * @ingroup RecordManager
+ */
+struct SlottedPageHeader
+{
+  int32_t slot_count;       ///< 槽目录中槽的个数，不超过 record_capacity
+  int32_t heap_offset;      ///< 记录堆的起始位置，记录从页面末尾向前分配
+  int32_t fragmented_size;  ///< 记录堆中已经释放但是还没有整理的空间大小
+};
+
+/**
+ * @brief 负责处理槽页面(slotted page)中各种操作
+ * @ingroup RecordManager
+ * @details 定长行存中 CHARS(N) 字段不管实际值有多长都要占用N个字节，对于很宽但是值很短的字符串表，
+ * 页面中大部分空间存放的都是补齐用的0。槽页面按照变长的方式存放记录，页面的组织是这样的：
+ * @code
+ * | PageHeader | record allocate bitmap | SlottedPageHeader | var field index |
+ * |------------|------------------------|-------------------|-----------------|
+ * | slot0 | slot1 | ... slotN | -> free space <- | recordN | ... | record0 |
+ * @endcode
+ * 槽目录(slot)从前向后增长，每个槽记录一条记录在页面中的偏移和长度；记录堆从页面末尾向前增长。
+ * RID 中的 slot num 就是槽的编号，记录在页面中移动时 RID 不变。bitmap 与行存的含义相同，所以
+ * RecordPageIterator/RecordFileScanner 不需要修改。
+ *
+ * 记录存放的时候会去掉 CHARS 字段末尾补齐的0，并在字段前面加上两个字节的长度，其它字段原样存放；
+ * 读取的时候再还原成定长记录，所以对上层来说与行存格式完全相同。事务字段都是定长的，
+ * MVCC 修改版本号不会改变记录的长度。变长字段的位置记录在 var field index 中，
+ * 每个字段用一个 int 表示(偏移 << 16 | 长度)，创建页面时写入日志，重放时不需要表的元数据。
+ *
+ * 删除或者变短的记录留下的空洞记在 fragmented_size 中，连续的空闲空间不够时整理页面(compact)，
+ * 把所有记录重新紧凑地放到页面末尾。
+ * 为了保证选中的页面一定能插入成功，剩余空间放不下一条最长的记录时就认为页面已经满了。
+ * 更新时记录变长并且整理以后页面仍然放不下，返回 RC::RECORD_NOMEM。
+ */
+class SlottedRecordPageHandler : public RecordPageHandler
+{
+public:
+  SlottedRecordPageHandler() : RecordPageHandler(StorageFormat::SLOTTED_FORMAT) {}
+
+  RC init_empty_page(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, int record_size,
+      TableMeta *table_meta) override;
+  RC init_empty_page(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, int record_size,
+      int col_num, const char *col_idx_data) override;
+
+  RC insert_record(const char *data, RID *rid) override;
+  RC recover_insert_record(const char *data, const RID &rid) override;
+  RC delete_record(const RID *rid) override;
+  RC update_record(const RID &rid, const char *data) override;
+  RC get_record(const RID &rid, Record &record) override;
+
+  bool is_full() const override;
+
+  /**
+   * @brief 页面中剩余的空闲空间，包括还没有整理的空洞
+   */
+  int free_space() const override;
+
+private:
+  struct Slot
+  {
+    uint16_t offset;  ///< 记录在页面中的偏移
+    uint16_t length;  ///< 编码以后的记录长度，0 表示槽是空的
+  };
+
+  /**
+   * @brief 初始化页头、变长字段索引和槽目录
+   */
+  void init_slotted_page(int record_size, int var_field_num, const int *var_fields);
+
+  SlottedPageHeader *slotted_header() const
+  {
+    return reinterpret_cast<SlottedPageHeader *>(frame_->data() + page_header_->col_idx_offset);
+  }
+  const int *var_fields() const
+  {
+    return reinterpret_cast<const int *>(frame_->data() + page_header_->col_idx_offset + sizeof(SlottedPageHeader));
+  }
+  Slot *slots() const { return reinterpret_cast<Slot *>(frame_->data() + page_header_->data_offset); }
+
+  /**
+   * @brief 槽目录后面连续的空闲空间
+   */
+  int contiguous_free_space() const;
+
+  /**
+   * @brief 编码以后记录的最大长度
+   */
+  int max_encoded_size() const { return page_header_->record_real_size + page_header_->column_num * 2; }
+
+  /// 把定长记录编码成变长格式，返回编码以后的长度
+  int  encode(const char *data, char *buf) const;
+  void decode(const char *buf, char *data) const;
+
+  /**
+   * @brief 把记录放到指定的槽中，槽中已经有记录时替换掉
+   * @details 不修改 bitmap 和 record_num，也不写日志
+   */
+  RC put_record(SlotNum slot_num, const char *data);
+
+  /**
+   * @brief 为指定的槽分配空间，必要时扩展槽目录或者整理页面
+   * @return 分配到的偏移，空间不够时返回-1
+   */
+  int allocate(SlotNum slot_num, int size);
+
+  /**
+   * @brief 整理页面，把所有记录紧凑地放到页面末尾
+   */
+  void compact();
 };
 /**
  * @brief 管理整个文件中记录的增删改查
@@ -356,8 +606,11 @@ public:
    * @brief 初始化
    *
    * @param buffer_pool 当前操作的是哪个文件
+   * @param free_space_map_file 保存空闲空间表的文件。文件存在时直接加载，不再扫描整个数据文件；
+   *                            关闭时再保存回去。为空时不保存
    */
-  RC init(DiskBufferPool &buffer_pool, LogHandler &log_handler, TableMeta *table_meta);
+  RC init(DiskBufferPool &buffer_pool, LogHandler &log_handler, TableMeta *table_meta,
+      const char *free_space_map_file = nullptr);
 
   /**
    * @brief 关闭，做一些资源清理的工作
@@ -380,6 +633,16 @@ public:
    */
   RC insert_record(const char *data, int record_size, RID *rid);
 
+  /**
+   * @brief 批量插入记录
+   * @details 每次占用一个页面，尽量把它放满，每个页面只加一次锁、只记录一条日志。
+   * 失败时已经插入的记录不会删除，通过 rids 返回，由调用方处理
+   * @param records     要插入的记录
+   * @param record_size 记录大小
+   * @param rids        返回插入成功的记录的标识符，与 records 的前几条一一对应
+   */
+  RC insert_records(span<const char *const> records, int record_size, vector<RID> &rids);
+
   /**
    * @brief 数据库恢复时，在指定文件指定位置插入数据
    *
@@ -393,19 +656,37 @@ public:
 
   RC visit_record(const RID &rid, function<RC(Record &)> updater);
 
+  /**
+   * @brief 以只读方式遍历一段页面上的所有记录
+   * @details 从 start_page 开始最多访问 max_pages 个页面，每个页面只在访问期间持有读锁，
+   * 供后台任务分批扫描使用。visitor 拿到的记录指向页帧内存，需要保留时应自行 materialize。
+   * @param next_page 下一批的起始页面，文件已经扫描完时为 BP_INVALID_PAGE_NUM
+   */
+  RC visit_pages(PageNum start_page, int max_pages, function<void(Record &)> visitor, PageNum &next_page);
+
+  /**
+   * @brief 空闲空间表，仅用于观察和测试
+   */
+  const FreeSpaceMap &free_space_map() const { return free_space_map_; }
+
 private:
   /**
-   * @brief 初始化当前没有填满记录的页面，初始化free_pages_成员
+   * @brief 扫描文件中的所有页面，初始化空闲空间表
    */
   RC init_free_pages();
 
+  /**
+   * @brief 页面在空闲空间表中的等级
+   */
+  static int free_space_level(const RecordPageHandler &page_handler);
+
 private:
-  DiskBufferPool        *disk_buffer_pool_ = nullptr;
-  LogHandler            *log_handler_      = nullptr;  ///< 记录日志的处理器
-  unordered_set<PageNum> free_pages_;                  ///< 没有填充满的页面集合
-  common::Mutex          lock_;  ///< 当编译时增加-DCONCURRENCY=ON 选项时，才会真正的支持并发
-  StorageFormat          storage_format_;
-  TableMeta             *table_meta_;
+  DiskBufferPool *disk_buffer_pool_ = nullptr;
+  LogHandler     *log_handler_      = nullptr;  ///< 记录日志的处理器
+  FreeSpaceMap    free_space_map_;              ///< 每个页面的剩余空间，并发插入时用来给每个线程分配不同的页面
+  string          free_space_map_file_;         ///< 关闭时把空闲空间表保存到这个文件
+  StorageFormat   storage_format_;
+  TableMeta      *table_meta_;
 };
 
 /**
@@ -438,7 +719,8 @@ public:
 
   /**
    * @brief 获取下一条记录
-   *
+   * @details 行存格式的记录直接指向页帧内存并持有页帧的pin，扫描到当前页面期间数据都是有效的。
+   * 返回失败(包括RECORD_EOF)时会清空record，释放它持有的页帧。
    * @param record 返回的下一条记录
    */
   RC next(Record &record);
@@ -483,8 +765,32 @@ public:
   ChunkFileScanner() = default;
   ~ChunkFileScanner();
 
-  // TODO: not support filter and transaction
-  RC open_scan_chunk(Table *table, DiskBufferPool &buffer_pool, LogHandler &log_handler, ReadWriteMode mode);
+  /**
+   * @brief 打开一个文件扫描
+   * @param trx 当前的事务。不为空并且表中有事务字段时，只返回对这个事务可见的记录
+   */
+  RC open_scan_chunk(Table *table, DiskBufferPool &buffer_pool, Trx *trx, LogHandler &log_handler, ReadWriteMode mode);
+
+  /**
+   * @brief 设置用来跳过页面的条件
+   * @details 根据页面中的 zone map 判断页面中不可能有满足条件的记录时，直接跳过这个页面。
+   * 这里只是粗略的过滤，不能代替 set_predicates 设置的完整条件。
+   */
+  void set_zone_map_predicates(vector<ZoneMapPredicate> predicates) { predicates_ = std::move(predicates); }
+
+  /**
+   * @brief 设置过滤条件
+   * @details 每个页面的记录读出来以后，使用 Expression::eval 计算，只返回满足所有条件的记录。
+   * 条件中的字段按照 field_id 访问列。表达式属于调用方，扫描期间需要一直有效。
+   */
+  void set_predicates(vector<Expression *> predicates) { filters_ = std::move(predicates); }
+
+  /**
+   * @brief 只扫描从 morsels 中取到的页面
+   * @details 多个线程各自使用一个 ChunkFileScanner，共用一个 PageMorselQueue，就可以并行扫描一个文件。
+   * 需要在 open_scan_chunk 之后、next_chunk 之前调用。
+   */
+  void set_morsel_queue(PageMorselQueue *morsels);
 
   /**
    * @brief 关闭一个文件扫描，释放相应的资源
@@ -492,17 +798,43 @@ public:
   RC close_scan();
 
   /**
-   * @brief 每次调用获取一个页面中的所有记录。
+   * @brief 每次调用获取一个页面中所有可见并且满足条件的记录。
+   * @details 没有满足条件的记录的页面会直接跳过，所以返回的 Chunk 中至少有一条记录。
    */
   RC next_chunk(Chunk &chunk);
 
+private:
+  /// 找到下一个要扫描的页面，当前 morsel 扫描完以后取下一个
+  bool next_page();
+
+  /// 是否需要先把页面中的所有字段读出来，判断可见性和计算过滤条件
+  bool need_filter() const;
+
+  /**
+   * @brief 判断 page_chunk_ 中记录的可见性并计算过滤条件，结果放在 select_ 中
+   */
+  RC filter_page_chunk();
+
+  /**
+   * @brief 把 page_chunk_ 中选中的记录复制到 chunk 中
+   */
+  RC output_selected(Chunk &chunk);
+
 private:
   Table *table_ = nullptr;  ///< 当前遍历的是哪张表。
+  Trx   *trx_   = nullptr;  ///< 当前是哪个事务在遍历
 
   DiskBufferPool *disk_buffer_pool_ = nullptr;  ///< 当前访问的文件
   LogHandler     *log_handler_      = nullptr;
   ReadWriteMode   rw_mode_ = ReadWriteMode::READ_WRITE;  ///< 遍历出来的数据，是否可能对它做修改
 
   BufferPoolIterator bp_iterator_;                    ///< 遍历buffer pool的所有页面
+  PageMorselQueue   *morsels_             = nullptr;  ///< 并行扫描时从这里取要扫描的页面
   RecordPageHandler *record_page_handler_ = nullptr;  ///< 处理文件某页面的记录
+
+  vector<ZoneMapPredicate> predicates_;  ///< 用来跳过页面的条件
+  vector<Expression *>     filters_;     ///< 完整的过滤条件
+
+  Chunk           page_chunk_;  ///< 一个页面中的所有字段，第 i 列是表中的第 i 个字段
+  vector<uint8_t> select_;      ///< page_chunk_ 中的记录是否可见并且满足条件
 };
@@ -0,0 +1,110 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+
+#include "storage/record/zone_map.h"
+
+/**
+ * @brief 常量与列中的值比较
+ * @details 浮点数直接比较，不考虑精度误差，与向量化执行的 ComparisonExpr 一致，
+ * 否则相差很小的值会被认为相等，可能会跳过有满足条件的记录的页面
+ */
+static int compare_value(const Value &value, AttrType attr_type, int attr_len, const char *data)
+{
+  if (attr_type == AttrType::FLOATS) {
+    float column_value = 0;
+    memcpy(&column_value, data, sizeof(column_value));
+    const float constant = value.get_float();
+    return constant < column_value ? -1 : (constant > column_value ? 1 : 0);
+  }
+  return value.compare(Value(attr_type, const_cast<char *>(data), attr_len));
+}
+
+bool ZoneMap::has_min_max(AttrType attr_type, int attr_len)
+{
+  switch (attr_type) {
+    case AttrType::CHARS:
+    case AttrType::INTS:
+    case AttrType::FLOATS:
+    case AttrType::BOOLEANS:
+    case AttrType::DATES: return attr_len > 0 && attr_len <= VALUE_SIZE;
+    default: return false;
+  }
+}
+
+void ZoneMap::init() { memset(this, 0, sizeof(*this)); }
+
+void ZoneMap::add(AttrType attr_type, int attr_len, const char *data, bool is_null)
+{
+  if (is_null) {
+    null_count++;
+    return;
+  }
+
+  if (has_min_max(attr_type, attr_len)) {
+    if (value_count <= 0) {
+      memcpy(min, data, attr_len);
+      memcpy(max, data, attr_len);
+    } else {
+      Value value(attr_type, const_cast<char *>(data), attr_len);
+      if (compare_value(value, attr_type, attr_len, min) < 0) {
+        memcpy(min, data, attr_len);
+      } else if (compare_value(value, attr_type, attr_len, max) > 0) {
+        memcpy(max, data, attr_len);
+      }
+    }
+  }
+  value_count++;
+}
+
+void ZoneMap::remove(bool is_null)
+{
+  if (is_null) {
+    null_count--;
+  } else {
+    value_count--;
+  }
+}
+
+bool ZoneMap::may_match(AttrType attr_type, int attr_len, const ZoneMapPredicate &predicate) const
+{
+  switch (predicate.op) {
+    case CompOp::IS: return null_count > 0;
+    case CompOp::NOT_IS: return value_count > 0;
+    case CompOp::EQUAL_TO:
+    case CompOp::NOT_EQUAL:
+    case CompOp::LESS_THAN:
+    case CompOp::LESS_EQUAL:
+    case CompOp::GREAT_THAN:
+    case CompOp::GREAT_EQUAL: break;
+    default: return true;
+  }
+
+  // 与 NULL 比较的结果不会是 true
+  if (value_count <= 0 || predicate.value.is_null()) {
+    return false;
+  }
+  if (!has_min_max(attr_type, attr_len) || predicate.value.attr_type() != attr_type) {
+    return true;
+  }
+
+  const int cmp_min = compare_value(predicate.value, attr_type, attr_len, min);
+  const int cmp_max = compare_value(predicate.value, attr_type, attr_len, max);
+  switch (predicate.op) {
+    case CompOp::EQUAL_TO: return cmp_min >= 0 && cmp_max <= 0;
+    case CompOp::NOT_EQUAL: return !(cmp_min == 0 && cmp_max == 0);
+    case CompOp::LESS_THAN: return cmp_min > 0;    // column < value
+    case CompOp::LESS_EQUAL: return cmp_min >= 0;  // column <= value
+    case CompOp::GREAT_THAN: return cmp_max < 0;   // column > value
+    case CompOp::GREAT_EQUAL: return cmp_max <= 0; // column >= value
+    default: return true;
+  }
+}
@@ -0,0 +1,74 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "common/lang/span.h"
+#include "common/value.h"
+#include "sql/parser/parse_defs.h"
+
+/**
+ * @brief 可以用来跳过页面的简单谓词：column op value
+ * @ingroup RecordManager
+ * @details 只支持比较运算以及 IS NULL / IS NOT NULL。多个谓词之间是 AND 的关系。
+ */
+struct ZoneMapPredicate
+{
+  int    col_id;  ///< 字段的 field_id，与 Chunk 中的 col_id 一致
+  CompOp op;
+  Value  value;  ///< IS NULL / IS NOT NULL 时不使用
+};
+
+/**
+ * @brief PAX 页面中一列数据的统计信息(zone map)
+ * @ingroup RecordManager
+ * @details 记录页面中这一列的最小值、最大值和 NULL 的个数，扫描时不需要解码页面就能判断
+ * 页面中是否可能有满足条件的记录。
+ *
+ * 只有不超过 VALUE_SIZE 的定长类型才维护最小值和最大值，其它类型只维护计数。
+ * 删除记录时最小值和最大值不会收缩，只是变得不够精确，仍然是正确的边界；
+ * 非 NULL 的记录全部删除以后会重新开始统计。
+ * 统计信息随着页面的修改一起更新，通过重放记录日志恢复，不需要单独写日志。
+ */
+struct ZoneMap
+{
+  static constexpr int VALUE_SIZE = 8;
+
+  int32_t null_count;   ///< 为 NULL 的记录数
+  int32_t value_count;  ///< 不为 NULL 的记录数，大于0时最小值和最大值才有效
+  char    min[VALUE_SIZE];
+  char    max[VALUE_SIZE];
+
+  /**
+   * @brief 指定类型的列是否维护最小值和最大值
+   */
+  static bool has_min_max(AttrType attr_type, int attr_len);
+
+  void init();
+
+  /**
+   * @brief 加入一个值
+   * @param data 字段数据。is_null 为 true 时不使用
+   */
+  void add(AttrType attr_type, int attr_len, const char *data, bool is_null);
+
+  /**
+   * @brief 删除一个值
+   */
+  void remove(bool is_null);
+
+  /**
+   * @brief 这一列中是否可能有满足条件的值
+   * @details 不能判断的情况都返回 true
+   */
+  bool may_match(AttrType attr_type, int attr_len, const ZoneMapPredicate &predicate) const;
+};
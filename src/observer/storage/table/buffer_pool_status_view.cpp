@@ -0,0 +1,114 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/table/buffer_pool_status_view.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/limits.h"
+#include "sql/operator/value_list_physical_operator.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/record/phy_op_record_scanner.h"
+
+namespace {
+
+AttrInfoSqlNode make_attr_info(const char *name, AttrType type, size_t length = 1)
+{
+  AttrInfoSqlNode attr_info;
+  attr_info.type     = type;
+  attr_info.name     = name;
+  attr_info.arr_len  = length;
+  attr_info.dim      = 0;
+  attr_info.nullable = false;
+  return attr_info;
+}
+
+Value int_value(int64_t value) { return Value(static_cast<int>(min<int64_t>(value, numeric_limits<int32_t>::max()))); }
+
+}  // namespace
+
+BufferPoolStatusView::BufferPoolStatusView(BufferPoolManager &bp_manager, int32_t view_id)
+    : View(NAME, {} /*attrs_name*/, "" /*view_definition*/, false /*is_updatable*/, view_id), bp_manager_(bp_manager)
+{
+  table_meta_.init(view_id, NAME, nullptr /*trx_fields*/, attr_infos(), StorageFormat::ROW_FORMAT);
+}
+
+const vector<AttrInfoSqlNode> &BufferPoolStatusView::attr_infos()
+{
+  static const vector<AttrInfoSqlNode> attr_infos = {
+      make_attr_info("file_name", AttrType::CHARS, 256),
+      make_attr_info("hit", AttrType::INTS),
+      make_attr_info("miss", AttrType::INTS),
+      make_attr_info("hit_ratio", AttrType::FLOATS),
+      make_attr_info("evict", AttrType::INTS),
+      make_attr_info("flush", AttrType::INTS),
+      make_attr_info("read_pages", AttrType::INTS),
+      make_attr_info("read_kb", AttrType::INTS),
+      make_attr_info("read_avg_us", AttrType::FLOATS),
+      make_attr_info("read_p99_us", AttrType::INTS),
+      make_attr_info("write_pages", AttrType::INTS),
+      make_attr_info("write_kb", AttrType::INTS),
+      make_attr_info("write_avg_us", AttrType::FLOATS),
+      make_attr_info("write_p99_us", AttrType::INTS),
+      make_attr_info("warm_up_loading", AttrType::INTS),
+      make_attr_info("warm_up_total", AttrType::INTS),
+      make_attr_info("warm_up_done", AttrType::INTS),
+      make_attr_info("warm_up_loaded", AttrType::INTS),
+  };
+  return attr_infos;
+}
+
+void BufferPoolStatusView::make_rows(BufferPoolManager &bp_manager, vector<vector<Value>> &rows)
+{
+  vector<BufferPoolStatus> status_list;
+  bp_manager.all_status(status_list);
+  const BufferPoolWarmer::Progress warm_up = bp_manager.warmer().progress();
+
+  rows.clear();
+  for (const BufferPoolStatus &status : status_list) {
+    rows.push_back({
+        Value(status.file_name.c_str()),
+        int_value(status.hit_count),
+        int_value(status.miss_count),
+        Value(static_cast<float>(status.hit_ratio())),
+        int_value(status.evict_count),
+        int_value(status.flush_count),
+        int_value(status.read_pages),
+        int_value(status.read_bytes / 1024),
+        Value(static_cast<float>(status.read_avg_us)),
+        int_value(status.read_p99_us),
+        int_value(status.write_pages),
+        int_value(status.write_bytes / 1024),
+        Value(static_cast<float>(status.write_avg_us)),
+        int_value(status.write_p99_us),
+        int_value(warm_up.loading ? 1 : 0),
+        int_value(warm_up.total_pages),
+        int_value(warm_up.done_pages),
+        int_value(warm_up.loaded_pages),
+    });
+  }
+}
+
+RC BufferPoolStatusView::get_record_scanner(RecordPhysicalOperatorScanner &scanner, Trx *trx, ReadWriteMode mode)
+{
+  if (mode != ReadWriteMode::READ_ONLY) {
+    LOG_WARN("virtual table %s is read only", NAME);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  vector<vector<Value>> rows;
+  make_rows(bp_manager_, rows);
+
+  auto oper = make_unique<ValueListPhysicalOperator>();
+  for (vector<Value> &row : rows) {
+    oper->append(std::move(row));
+  }
+
+  scanner.set_oper(std::move(oper));
+  return scanner.open_oper(trx);
+}
@@ -0,0 +1,50 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/vector.h"
+#include "common/value.h"
+#include "storage/table/view.h"
+
+class BufferPoolManager;
+
+/**
+ * @brief 缓冲池统计信息的虚拟表
+ * @details 每个打开的缓冲池文件(数据文件和索引文件)一行，不存储任何数据，每次扫描时从 BufferPoolManager
+ * 读取最新的统计信息，参考 BufferPoolMetrics。只能查询，不能修改。
+ * SHOW BUFFER POOL STATUS 输出相同的内容。
+ * 只有 INTS 一种整数类型，计数超过 INT32_MAX 时显示 INT32_MAX，读写的数据量使用KB作为单位。
+ * 最后几列 warm_up_* 是缓冲池预热的进度(参考 BufferPoolWarmer::Progress)，所有文件一起统计，每一行都相同。
+ */
+class BufferPoolStatusView : public View
+{
+public:
+  static constexpr const char *NAME = "__buffer_pool_status__";
+
+public:
+  BufferPoolStatusView(BufferPoolManager &bp_manager, int32_t view_id);
+  virtual ~BufferPoolStatusView() = default;
+
+  RC get_record_scanner(RecordPhysicalOperatorScanner &scanner, Trx *trx, ReadWriteMode mode) override;
+
+  /**
+   * @brief 虚拟表的字段
+   */
+  static const vector<AttrInfoSqlNode> &attr_infos();
+
+  /**
+   * @brief 每个文件一行统计信息，与 attr_infos 的顺序一致
+   */
+  static void make_rows(BufferPoolManager &bp_manager, vector<vector<Value>> &rows);
+
+private:
+  BufferPoolManager &bp_manager_;
+};
@@ -31,10 +31,12 @@ See the Mulan PSL v2 for more details. */
 #include "storage/index/index.h"
 #include "storage/record/record_manager.h"
 #include "storage/table/table.h"
+#include "storage/table/text_data_manager.h"
 #include "storage/table/vector_data_manager.h"
 #include "storage/index/vector_index_meta.h"
 #include "storage/index/vector_index.h"
 #include "storage/trx/trx.h"
+#include "storage/trx/mvcc_trx.h"
 #include "sql/expr/tuple.h"
 
 Table::~Table()
@@ -59,7 +61,7 @@ Table::~Table()
 }
 
 RC Table::create(Db *db, int32_t table_id, const char *path, const char *name, const char *base_dir,
-    span<const AttrInfoSqlNode> attributes, StorageFormat storage_format)
+    span<const AttrInfoSqlNode> attributes, StorageFormat storage_format, bool page_compression)
 {
   if (table_id < 0) {
     LOG_WARN("invalid table id. table_id=%d, table_name=%s", table_id, name);
@@ -95,7 +97,7 @@ RC Table::create(Db *db, int32_t table_id, const char *path, const char *name, c
 
   // 创建文件
   const vector<FieldMeta> *trx_fields = db->trx_kit().trx_fields();
-  if ((rc = table_meta_.init(table_id, name, trx_fields, attributes, storage_format)) != RC::SUCCESS) {
+  if ((rc = table_meta_.init(table_id, name, trx_fields, attributes, storage_format, page_compression)) != RC::SUCCESS) {
     LOG_ERROR("Failed to init table meta. name:%s, ret:%d", name, rc);
     return rc;  // delete table file
   }
@@ -128,6 +130,10 @@ RC Table::create(Db *db, int32_t table_id, const char *path, const char *name, c
       return RC::IOERR_OPEN;
     }
     close(fd);
+    text_data_manager_ = TextDataManager::create(text_file);
+    if (text_data_manager_ == nullptr) {
+      return RC::IOERR_OPEN;
+    }
   }
   bool has_vector = std::any_of(
       attributes.begin(), attributes.end(), [](AttrInfoSqlNode attr) { return attr.type == AttrType::VECTORS; });
@@ -143,7 +149,10 @@ RC Table::create(Db *db, int32_t table_id, const char *path, const char *name, c
       return RC::IOERR_OPEN;
     }
     close(fd);
-    vector_data_manager_ = VectorDataManager::create(this);
+    vector_data_manager_ = VectorDataManager::create(vector_file, db->vector_cache_size());
+    if (vector_data_manager_ == nullptr) {
+      return RC::IOERR_OPEN;
+    }
   }
 
   string             data_file = table_data_file(base_dir, name);
@@ -171,7 +180,11 @@ RC Table::drop(Db *db, const char *table_name, const char *base_dir)
   std::string meta_file_path = table_meta_file(base_dir, table_name);
   std::string text_file_path   = table_text_data_file(base_dir_.c_str(), table_meta_.name());
   std::string vector_file_path = table_vector_data_file(base_dir_.c_str(), table_meta_.name());
+  std::string fsm_file_path    = table_free_space_map_file(base_dir, table_name);
   // TODO: delete index
+  // 先关闭记录管理器，它关闭时会保存空闲空间表，下面一起删掉
+  delete record_handler_;
+  record_handler_ = nullptr;
   data_buffer_pool_->close_file();
   data_buffer_pool_ = nullptr;  // 防止析构函数中再次尝试关闭文件
   if (unlink(meta_file_path.c_str()) == -1) {
@@ -182,6 +195,12 @@ RC Table::drop(Db *db, const char *table_name, const char *base_dir)
     LOG_ERROR("Failed to remove table data file for %s due to %s", meta_file_path.c_str(), strerror(errno));
     return RC::INTERNAL;
   }
+  if (unlink(fsm_file_path.c_str()) == -1) {
+    if (errno != ENOENT) {
+      LOG_ERROR("Failed to remove free space map file for %s due to %s", meta_file_path.c_str(), strerror(errno));
+      return RC::INTERNAL;
+    }
+  }
   if (unlink(text_file_path.c_str()) == -1) {
     if (errno != ENOENT) {
       LOG_ERROR("Failed to remove text data file for %s due to %s", meta_file_path.c_str(), strerror(errno));
@@ -245,11 +264,23 @@ RC Table::open(Db *db, const char *meta_file, const char *base_dir)
   }
 
   auto field_metas = table_meta_.field_metas();
-  bool has_vector  = std::any_of(
+  bool has_text    = std::any_of(
+      field_metas->begin(), field_metas->end(), [](FieldMeta attr) { return attr.type() == AttrType::TEXTS; });
+  if (has_text) {
+    text_data_manager_ = TextDataManager::create(text_data_file());
+    if (text_data_manager_ == nullptr) {
+      LOG_ERROR("Failed to open text data file. table=%s", name());
+      return RC::IOERR_OPEN;
+    }
+  }
+  bool has_vector = std::any_of(
       field_metas->begin(), field_metas->end(), [](FieldMeta attr) { return attr.type() == AttrType::VECTORS; });
   if (has_vector) {
-
-    vector_data_manager_ = VectorDataManager::create(this);
+    vector_data_manager_ = VectorDataManager::create(vector_data_file(), db->vector_cache_size());
+    if (vector_data_manager_ == nullptr) {
+      LOG_ERROR("Failed to open vector data file. table=%s", name());
+      return RC::IOERR_OPEN;
+    }
   }
   return rc;
 }
@@ -274,6 +305,59 @@ RC Table::insert_record(Record &record)
   return rc;
 }
 
+RC Table::insert_records(vector<Record> &records)
+{
+  if (records.empty()) {
+    return RC::SUCCESS;
+  }
+
+  vector<const char *> datas;
+  datas.reserve(records.size());
+  for (Record &record : records) {
+    datas.push_back(record.data());
+  }
+
+  vector<RID> rids;
+  RC          rc = record_handler_->insert_records(datas, table_meta_.record_size(), rids);
+  if (OB_SUCC(rc)) {
+    for (size_t i = 0; i < records.size(); i++) {
+      records[i].set_rid(rids[i]);
+    }
+  } else {
+    LOG_ERROR("Insert records failed. table name=%s, inserted=%d, rc=%s", 
+              table_meta_.name(), static_cast<int>(rids.size()), strrc(rc));
+  }
+
+  // 每个索引自己保证要么全部插入要么都不插入，失败时只需要回滚前面的索引
+  size_t indexed_num = 0;
+  for (; OB_SUCC(rc) && indexed_num < indexes_.size(); indexed_num++) {
+    rc = indexes_[indexed_num]->insert_entries(datas, rids);
+    if (OB_FAIL(rc)) {  // 可能出现了键值重复
+      break;
+    }
+  }
+
+  if (OB_FAIL(rc)) {
+    for (size_t i = 0; i < indexed_num; i++) {
+      for (size_t j = 0; j < rids.size(); j++) {
+        RC rc2 = indexes_[i]->delete_entry(datas[j], &rids[j]);
+        if (OB_FAIL(rc2)) {
+          LOG_PANIC("Failed to rollback index entry when insert records failed. table name=%s, rc=%d:%s",
+                    name(), rc2, strrc(rc2));
+        }
+      }
+    }
+    for (const RID &rid : rids) {
+      RC rc2 = record_handler_->delete_record(&rid);
+      if (OB_FAIL(rc2)) {
+        LOG_PANIC("Failed to rollback record data when insert records failed. table name=%s, rc=%d:%s",
+                  name(), rc2, strrc(rc2));
+      }
+    }
+  }
+  return rc;
+}
+
 RC Table::visit_record(const RID &rid, function<RC(Record &)> visitor)
 {
   return record_handler_->visit_record(rid, visitor);
@@ -397,10 +481,12 @@ RC Table::init_record_handler(const char *base_dir)
     LOG_ERROR("Failed to open disk buffer pool for file:%s. rc=%d:%s", data_file.c_str(), rc, strrc(rc));
     return rc;
   }
+  data_buffer_pool_->set_page_compression(table_meta_.page_compression());
 
   record_handler_ = new RecordFileHandler(table_meta_.storage_format());
 
-  rc = record_handler_->init(*data_buffer_pool_, db_->log_handler(), &table_meta_);
+  string free_space_map_file = table_free_space_map_file(base_dir, table_meta_.name());
+  rc = record_handler_->init(*data_buffer_pool_, db_->log_handler(), &table_meta_, free_space_map_file.c_str());
   if (rc != RC::SUCCESS) {
     LOG_ERROR("Failed to init record handler. rc=%s", strrc(rc));
     data_buffer_pool_->close_file();
@@ -424,7 +510,7 @@ RC Table::get_record_scanner(RecordFileScanner &scanner, Trx *trx, ReadWriteMode
 
 RC Table::get_chunk_scanner(ChunkFileScanner &scanner, Trx *trx, ReadWriteMode mode)
 {
-  RC rc = scanner.open_scan_chunk(this, *data_buffer_pool_, db_->log_handler(), mode);
+  RC rc = scanner.open_scan_chunk(this, *data_buffer_pool_, trx, db_->log_handler(), mode);
   if (rc != RC::SUCCESS) {
     LOG_ERROR("failed to open scanner. rc=%s", strrc(rc));
   }
@@ -566,9 +652,37 @@ RC Table::delete_record(const Record &record)
            name(), index->index_meta().name().c_str(), record.rid().to_string().c_str(), strrc(rc));
   }
   rc = record_handler_->delete_record(&record.rid());
+  if (OB_SUCC(rc)) {
+    free_texts_and_vectors_of_record(record.data());
+  }
   return rc;
 }
 
+void Table::free_texts_and_vectors_of_record(const char *record_data) const
+{
+  if (text_data_manager_ == nullptr && vector_data_manager_ == nullptr) {
+    return;
+  }
+
+  const int sys_field_num = table_meta_.sys_field_num();
+  auto      bitmap        = common::Bitmap(record_data + table_meta_.null_bitmap_start(), table_meta_.field_num());
+  for (int i = sys_field_num; i < table_meta_.field_num(); i++) {
+    const FieldMeta *field = table_meta_.field(i);
+    if (bitmap.get_bit(field->field_id() - sys_field_num)) {
+      continue;
+    }
+    if (field->type() == AttrType::TEXTS) {
+      TextData text_data{};
+      memcpy(&text_data, record_data + field->offset(), field->len());
+      text_data_manager_->free_text(text_data);
+    } else if (field->type() == AttrType::VECTORS) {
+      VectorData vector_data{};
+      memcpy(&vector_data, record_data + field->offset(), field->len());
+      vector_data_manager_->free_vector(vector_data);
+    }
+  }
+}
+
 RC Table::insert_entry_of_indexes(const char *record, const RID &rid)
 {
   RC rc = RC::SUCCESS;
@@ -632,6 +746,19 @@ RC Table::sync()
     }
   }
 
+  rc = flush_texts_and_vectors();
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to flush text and vector data. table=%s, rc=%s", name(), strrc(rc));
+    return rc;
+  }
+  if (vector_data_manager_ != nullptr) {
+    rc = vector_data_manager_->sync();
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("Failed to sync vector data. table=%s, rc=%s", name(), strrc(rc));
+      return rc;
+    }
+  }
+
   rc = data_buffer_pool_->flush_all_pages();
   LOG_INFO("Sync table over. table=%s", name());
   return rc;
@@ -666,54 +793,50 @@ RC Table::update_index(const Record &old_record, const Record &new_record, const
 
 RC Table::load_text(TextData *data) const
 {
-  std::string text_file = text_data_file();
-  int         fd        = ::open(text_file.c_str(), O_RDONLY);
-  if (fd < 0) {
-    LOG_WARN("failed to open table text data file %s: %s", text_file.c_str(), strerror(errno));
-    return RC::IOERR_OPEN;
-  }
-  lseek(fd, data->offset, SEEK_SET);
-  size_t offset = 0;
-  auto   buffer = new char[data->len + 1];
-  while (offset < data->len) {
-    size_t readed = read(fd, buffer + offset, data->len - offset);
-    if (readed < 0) {
-      LOG_WARN("failed to read text data: %s", strerror(errno));
-    }
-    offset += readed;
-  }
-  close(fd);
-  buffer[data->len] = '\0';
-  data->str         = buffer;
-  return RC::SUCCESS;
+  ASSERT(text_data_manager_ != nullptr, "table %s has no text attribute", this->name());
+  return text_data_manager_->load_text(data);
 }
 RC Table::dump_text(TextData *data) const
 {
-  // 在文件末尾追加写入 text
-  std::string text_file = text_data_file();
-  int         fd        = ::open(text_file.c_str(), O_RDWR);
-  if (fd < 0) {
-    LOG_WARN("failed to open table text data file %s: %s", text_file.c_str(), strerror(errno));
-    return RC::IOERR_OPEN;
+  ASSERT(text_data_manager_ != nullptr, "table %s has no text attribute", this->name());
+  // 释放文本时还活跃的事务都结束了，这些空间可以复用了
+  MvccTrxKit *trx_kit = db_ == nullptr ? nullptr : dynamic_cast<MvccTrxKit *>(&db_->trx_kit());
+  if (trx_kit != nullptr) {
+    text_data_manager_->reclaim(trx_kit->oldest_active_trx_id());
   }
-  size_t end    = lseek(fd, 0, SEEK_END);
-  size_t offset = 0;
-  while (offset < data->len) {
-    size_t writed = write(fd, data->str + offset, data->len - offset);
-    if (writed < 0) {
-      LOG_WARN("failed to write text data %s", strerror(errno));
-      return RC::IOERR_WRITE;
+  return text_data_manager_->dump_text(data);
+}
+void Table::free_text(const TextData &data) const
+{
+  ASSERT(text_data_manager_ != nullptr, "table %s has no text attribute", this->name());
+  MvccTrxKit *trx_kit = db_ == nullptr ? nullptr : dynamic_cast<MvccTrxKit *>(&db_->trx_kit());
+  if (trx_kit == nullptr) {
+    text_data_manager_->free_text(data);
+    return;
+  }
+  text_data_manager_->retire_text(data, trx_kit->last_trx_id());
+}
+RC Table::flush_texts_and_vectors() const
+{
+  if (text_data_manager_ != nullptr) {
+    RC rc = text_data_manager_->flush();
+    if (OB_FAIL(rc)) {
+      return rc;
     }
-    offset += writed;
   }
-  close(fd);
-  data->offset = end;
+  if (vector_data_manager_ != nullptr) {
+    return vector_data_manager_->flush();
+  }
   return RC::SUCCESS;
 }
 
-RC Table::load_vector(VectorData *data) const
+RC Table::load_vector(VectorData *data, bool &mapped) const
 {
   ASSERT(vector_data_manager_ != nullptr, "table %s has no vector attribute", this->name());
+  mapped = vector_data_manager_->map_vector(data);
+  if (mapped) {
+    return RC::SUCCESS;
+  }
   return vector_data_manager_->load_vector(data);
 }
 RC Table::dump_vector(VectorData *data) const
@@ -726,6 +849,11 @@ RC Table::update_vector(const VectorData *old_vector_data, const VectorData *new
   ASSERT(vector_data_manager_ != nullptr, "table %s has no vector attribute", this->name());
   return vector_data_manager_->update_vector(old_vector_data, new_vector_data);
 }
+void Table::free_vector(const VectorData &data) const
+{
+  ASSERT(vector_data_manager_ != nullptr, "table %s has no vector attribute", this->name());
+  vector_data_manager_->free_vector(data);
+}
 
 RC Table::create_vector_index(Trx *trx, const FieldMeta *field_meta, const std::string &vector_index_name,
     DistanceType distance_type, size_t lists, size_t probes)
@@ -14,6 +14,7 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "storage/table/text_data_manager.h"
 #include "storage/table/vector_data_manager.h"
 #include "storage/table/table_meta.h"
 #include "common/types.h"
@@ -53,9 +54,11 @@ public:
    * @param base_dir 表数据存放的路径
    * @param attribute_count 字段个数
    * @param attributes 字段
+   * @param storage_format 存储格式
+   * @param page_compression 数据和索引文件是否开启页面压缩
    */
   RC create(Db *db, int32_t table_id, const char *path, const char *name, const char *base_dir,
-      span<const AttrInfoSqlNode> attributes, StorageFormat storage_format);
+      span<const AttrInfoSqlNode> attributes, StorageFormat storage_format, bool page_compression = false);
 
   RC drop(Db *db, const char *table_name, const char *base_dir);
 
@@ -81,6 +84,14 @@ public:
    * @param record[in/out] 传入的数据包含具体的数据，插入成功会通过此字段返回RID
    */
   RC insert_record(Record &record);
+
+  /**
+   * @brief 在当前的表中批量插入记录
+   * @details 记录文件每个页面只记录一条日志，索引按照键值排序以后批量插入。
+   * 要么全部插入成功，要么都不插入。与 insert_record 一样不关心事务相关操作。
+   * @param records[in/out] 插入成功会设置每条记录的RID
+   */
+  RC insert_records(vector<Record> &records);
   RC delete_record(const Record &record);
 
   RC delete_record(const RID &rid);
@@ -121,6 +132,9 @@ public:
 
   RC sync();
 
+  /// 记录被物理删除，或者 make_record 生成的记录没有插入成功时，释放它引用的文本和向量
+  void free_texts_and_vectors_of_record(const char *record_data) const;
+
 private:
   RC insert_entry_of_indexes(const char *record, const RID &rid);
   RC delete_entry_of_indexes(const char *record, const RID &rid, bool error_on_not_exists);
@@ -146,10 +160,19 @@ public:
 public:
   RC load_text(TextData *data) const;
   RC dump_text(TextData *data) const;
-
-  RC load_vector(VectorData *data) const;
+  /// 释放原地更新替换掉的文本。其它事务可能已经复制了旧的记录还没有读取文本，
+  /// 使用MVCC事务时，要等当前活跃的事务都结束以后，空间才能被之后写入的文本复用
+  void free_text(const TextData &data) const;
+  /// 把缓冲的文本和向量写入文件，写入文本或向量的语句结束时调用
+  RC flush_texts_and_vectors() const;
+
+  /// 读取向量。mapped 为 true 时 data->vector 直接指向映射到内存的向量数据文件，在表关闭前有效，不需要释放；
+  /// 否则向量复制到新申请的内存中
+  RC load_vector(VectorData *data, bool &mapped) const;
   RC dump_vector(VectorData *data) const;
   RC update_vector(const VectorData *old_vector_data, const VectorData *new_vector_data) const;
+  /// 释放不再使用的向量，空间可以被之后写入的同样长度的向量复用
+  void free_vector(const VectorData &data) const;
 
 private:
 protected:
@@ -165,6 +188,7 @@ protected:
   vector<Index *>    indexes_;
   std::vector<VectorIndex *> vector_indexes_;
 
+  std::unique_ptr<TextDataManager>   text_data_manager_;
   std::unique_ptr<VectorDataManager> vector_data_manager_;
 
   bool is_outer_table_ = false; // 子查询用。判断是否是外层查询的表
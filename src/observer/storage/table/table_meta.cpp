@@ -24,6 +24,7 @@ See the Mulan PSL v2 for more details. */
 static const Json::StaticString FIELD_TABLE_ID("table_id");
 static const Json::StaticString FIELD_TABLE_NAME("table_name");
 static const Json::StaticString FIELD_STORAGE_FORMAT("storage_format");
+static const Json::StaticString FIELD_PAGE_COMPRESSION("page_compression");
 static const Json::StaticString FIELD_FIELDS("fields");
 static const Json::StaticString FIELD_INDEXES("indexes");
 static const Json::StaticString FIELD_VECTOR_INDEXES("vector_indexes");
@@ -35,6 +36,7 @@ TableMeta::TableMeta(const TableMeta &other)
       indexes_(other.indexes_),
       vector_indexes_(other.vector_indexes_),
       storage_format_(other.storage_format_),
+      page_compression_(other.page_compression_),
       record_size_(other.record_size_)
 {}
 
@@ -48,7 +50,7 @@ void TableMeta::swap(TableMeta &other) noexcept
 }
 
 RC TableMeta::init(int32_t table_id, const char *name, const std::vector<FieldMeta> *trx_fields,
-                   span<const AttrInfoSqlNode> attributes, StorageFormat storage_format)
+                   span<const AttrInfoSqlNode> attributes, StorageFormat storage_format, bool page_compression)
 {
   if (common::is_blank(name)) {
     LOG_ERROR("Name cannot be empty");
@@ -108,6 +110,7 @@ RC TableMeta::init(int32_t table_id, const char *name, const std::vector<FieldMe
   table_id_ = table_id;
   name_     = name;
   storage_format_ = storage_format;
+  page_compression_ = page_compression;
   LOG_INFO("Sussessfully initialized table meta. table id=%d, name=%s", table_id, name);
   return RC::SUCCESS;
 }
@@ -201,6 +204,7 @@ int TableMeta::serialize(std::ostream &ss) const
   table_value[FIELD_TABLE_ID]   = table_id_;
   table_value[FIELD_TABLE_NAME] = name_;
   table_value[FIELD_STORAGE_FORMAT] = static_cast<int>(storage_format_);
+  table_value[FIELD_PAGE_COMPRESSION] = page_compression_;
 
   Json::Value fields_value;
   for (const FieldMeta &field : fields_) {
@@ -280,6 +284,14 @@ int TableMeta::deserialize(std::istream &is)
 
   int32_t storage_format = storage_format_value.asInt();
 
+  // 老版本的元数据中没有这个字段
+  const Json::Value &page_compression_value = table_value[FIELD_PAGE_COMPRESSION];
+  if (!page_compression_value.isNull() && !page_compression_value.isBool()) {
+    LOG_ERROR("Invalid page compression. json value=%s", page_compression_value.toStyledString().c_str());
+    return -1;
+  }
+  bool page_compression = page_compression_value.asBool();
+
   RC  rc        = RC::SUCCESS;
   int field_num = fields_value.size();
 
@@ -300,6 +312,7 @@ int TableMeta::deserialize(std::istream &is)
 
   table_id_ = table_id;
   storage_format_ = static_cast<StorageFormat>(storage_format);
+  page_compression_ = page_compression;
   name_.swap(table_name);
   fields_.swap(fields);
   record_size_ = fields_.back().offset() + fields_.back().len() - fields_.begin()->offset();
@@ -41,7 +41,7 @@ public:
   void swap(TableMeta &other) noexcept;
 
   RC init(int32_t table_id, const char *name, const std::vector<FieldMeta> *trx_fields,
-      std::span<const AttrInfoSqlNode> attributes, StorageFormat storage_format);
+      std::span<const AttrInfoSqlNode> attributes, StorageFormat storage_format, bool page_compression = false);
 
   RC add_index(const IndexMeta &index);
   RC add_vector_index(const VectorIndexMeta &vector_index_meta);
@@ -56,6 +56,7 @@ public:
   auto                field_metas() const -> const std::vector<FieldMeta>                *{ return &fields_; }
   auto                trx_fields() const -> std::span<const FieldMeta>;
   const StorageFormat storage_format() const { return storage_format_; }
+  bool                page_compression() const { return page_compression_; }
 
   int field_num() const;  // sys field included
   int sys_field_num() const;
@@ -88,6 +89,7 @@ protected:
   std::vector<IndexMeta> indexes_;
   std::vector<VectorIndexMeta> vector_indexes_;
   StorageFormat          storage_format_;
+  bool                   page_compression_ = false;  ///< 数据和索引文件是否开启页面压缩
   int                    null_bitmap_start_;
   int                    record_size_ = 0;
 };
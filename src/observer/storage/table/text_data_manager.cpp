@@ -0,0 +1,404 @@
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+
+#include "storage/table/text_data_manager.h"
+#include "common/log/log.h"
+
+std::unique_ptr<TextDataManager> TextDataManager::create(const std::string &text_data_file)
+{
+  int fd = open(text_data_file.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+  if (fd < 0) {
+    LOG_WARN("failed to open file %s : %s", text_data_file.c_str(), strerror(errno));
+    return nullptr;
+  }
+  struct stat st;
+  if (fstat(fd, &st) < 0) {
+    LOG_WARN("failed to stat file %s : %s", text_data_file.c_str(), strerror(errno));
+    close(fd);
+    return nullptr;
+  }
+  return std::unique_ptr<TextDataManager>(new TextDataManager(fd, static_cast<size_t>(st.st_size)));
+}
+
+TextDataManager::~TextDataManager()
+{
+  RC rc = flush_append_buffer();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to flush text data: %s", strrc(rc));
+  }
+  close(fd_);
+}
+
+RC TextDataManager::load_text(TextData *data)
+{
+  auto buffer       = new char[data->len + 1];
+  buffer[data->len] = '\0';
+
+  RC     rc          = RC::SUCCESS;
+  size_t direct_len  = 0;  // 需要在锁外面直接从文件读取的长度
+  size_t reuse_count = 0;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (data->offset + data->len > file_end_ + append_buffer_.size()) {
+      LOG_WARN("invalid text data. offset=%zu, len=%zu, data end=%zu",
+               data->offset, data->len, file_end_ + append_buffer_.size());
+      delete[] buffer;
+      return RC::INVALID_ARGUMENT;
+    }
+
+    // 还没有写入文件的部分从追加缓冲区中复制
+    size_t file_len = data->len;
+    if (data->offset + data->len > file_end_) {
+      const size_t buffer_start = std::max(data->offset, file_end_);
+      file_len                  = buffer_start - data->offset;
+      memcpy(buffer + file_len, append_buffer_.data() + (buffer_start - file_end_), data->len - file_len);
+    }
+
+    if (file_len >= DIRECT_READ_SIZE) {
+      direct_len  = file_len;
+      reuse_count = extent_reuse_count_;
+    } else if (file_len > 0) {
+      rc = read_cached(data->offset, buffer, file_len);
+    }
+  }
+
+  // 大的文本不经过页面缓存，避免把缓存中的其它页面都挤出去，读取时不加锁。
+  // 文件中的数据只有在空闲区间被复用时才会被覆盖，读取期间有区间被复用时，读到的数据可能被写了一半，加锁重新读取。
+  // 文本被释放以后读到的就是别的数据了，所以可能还有读者的文本要通过 retire_text 延迟释放
+  if (OB_SUCC(rc) && direct_len > 0) {
+    rc = pread_fully(data->offset, buffer, direct_len);
+    if (OB_SUCC(rc)) {
+      std::lock_guard<std::mutex> guard(lock_);
+      if (extent_reuse_count_ != reuse_count) {
+        rc = pread_fully(data->offset, buffer, direct_len);
+      }
+    }
+  }
+
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to load text. offset=%zu, len=%zu, rc=%s", data->offset, data->len, strrc(rc));
+    delete[] buffer;
+    return rc;
+  }
+  data->str = buffer;
+  return RC::SUCCESS;
+}
+
+RC TextDataManager::dump_text(TextData *data)
+{
+  std::lock_guard<std::mutex> guard(lock_);
+
+  size_t offset = 0;
+  if (data->len > 0 && alloc_free_extent(data->len, offset)) {
+    RC rc = write_at(offset, data->str, data->len);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to write text into free extent. offset=%zu, len=%zu, rc=%s", offset, data->len, strrc(rc));
+      return rc;
+    }
+    data->offset = offset;
+    return RC::SUCCESS;
+  }
+
+  // 没有合适的空闲区间，追加到末尾
+  if (append_buffer_.size() + data->len > APPEND_BUFFER_SIZE) {
+    RC rc = flush_append_buffer();
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
+  offset = file_end_ + append_buffer_.size();
+  if (data->len >= APPEND_BUFFER_SIZE) {
+    RC rc = pwrite_fully(file_end_, data->str, data->len);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    update_cached_pages(file_end_, data->str, data->len);
+    file_end_ += data->len;
+  } else {
+    append_buffer_.append(data->str, data->len);
+  }
+  data->offset = offset;
+  return RC::SUCCESS;
+}
+
+void TextDataManager::free_text(const TextData &data)
+{
+  if (data.len == 0) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(lock_);
+  if (data.offset + data.len > file_end_ + append_buffer_.size()) {
+    LOG_WARN("try to free invalid text data. offset=%zu, len=%zu", data.offset, data.len);
+    return;
+  }
+
+  free_extent(data.offset, data.len);
+}
+
+void TextDataManager::retire_text(const TextData &data, int32_t retire_id)
+{
+  if (data.len == 0) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(lock_);
+  if (data.offset + data.len > file_end_ + append_buffer_.size()) {
+    LOG_WARN("try to retire invalid text data. offset=%zu, len=%zu", data.offset, data.len);
+    return;
+  }
+  retired_extents_.push_back(RetiredExtent{retire_id, data.offset, data.len});
+}
+
+void TextDataManager::reclaim(int32_t horizon)
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  size_t kept = 0;
+  for (size_t i = 0; i < retired_extents_.size(); i++) {
+    const RetiredExtent &extent = retired_extents_[i];
+    if (extent.retire_id < horizon) {
+      free_extent(extent.offset, extent.len);
+    } else {
+      retired_extents_[kept++] = extent;
+    }
+  }
+  retired_extents_.resize(kept);
+}
+
+void TextDataManager::free_extent(size_t offset, size_t len)
+{
+  const size_t data_offset = offset;
+  const size_t data_len    = len;
+
+  // 和前后相邻的空闲区间合并。和已有的空闲区间重叠说明重复释放了，忽略
+  auto next = free_extents_.lower_bound(offset);
+  if (next != free_extents_.end() && next->first < data_offset + data_len) {
+    LOG_WARN("text data has been freed. offset=%zu, len=%zu", data_offset, data_len);
+    return;
+  }
+  if (next != free_extents_.begin()) {
+    auto prev = std::prev(next);
+    if (prev->first + prev->second > data_offset) {
+      LOG_WARN("text data has been freed. offset=%zu, len=%zu", data_offset, data_len);
+      return;
+    }
+    if (prev->first + prev->second == data_offset) {
+      offset = prev->first;
+      len += prev->second;
+      remove_free_extent(prev);
+    }
+  }
+  if (next != free_extents_.end() && next->first == data_offset + data_len) {
+    len += next->second;
+    remove_free_extent(next);
+  }
+
+  free_extents_.emplace(offset, len);
+  free_extents_by_size_.emplace(len, offset);
+}
+
+RC TextDataManager::flush()
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  return flush_append_buffer();
+}
+
+size_t TextDataManager::data_end()
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  return file_end_ + append_buffer_.size();
+}
+
+size_t TextDataManager::free_size()
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  size_t size = 0;
+  for (const auto &[offset, len] : free_extents_) {
+    size += len;
+  }
+  return size;
+}
+
+RC TextDataManager::flush_append_buffer()
+{
+  if (append_buffer_.empty()) {
+    return RC::SUCCESS;
+  }
+
+  RC rc = pwrite_fully(file_end_, append_buffer_.data(), append_buffer_.size());
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  update_cached_pages(file_end_, append_buffer_.data(), append_buffer_.size());
+  file_end_ += append_buffer_.size();
+  append_buffer_.clear();
+  return RC::SUCCESS;
+}
+
+RC TextDataManager::write_at(size_t offset, const char *data, size_t len)
+{
+  const size_t file_len = offset < file_end_ ? std::min(len, file_end_ - offset) : 0;
+  if (file_len > 0) {
+    RC rc = pwrite_fully(offset, data, file_len);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    update_cached_pages(offset, data, file_len);
+  }
+  if (file_len < len) {
+    memcpy(append_buffer_.data() + (offset + file_len - file_end_), data + file_len, len - file_len);
+  }
+  return RC::SUCCESS;
+}
+
+RC TextDataManager::pwrite_fully(size_t offset, const char *data, size_t len)
+{
+  size_t written = 0;
+  while (written < len) {
+    ssize_t ret = pwrite(fd_, data + written, len - written, offset + written);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      LOG_WARN("failed to write text data: %s", strerror(errno));
+      return RC::IOERR_WRITE;
+    }
+    written += ret;
+  }
+  return RC::SUCCESS;
+}
+
+RC TextDataManager::pread_fully(size_t offset, char *data, size_t len)
+{
+  size_t readed = 0;
+  while (readed < len) {
+    ssize_t ret = pread(fd_, data + readed, len - readed, offset + readed);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      LOG_WARN("failed to read text data: %s", strerror(errno));
+      return RC::IOERR_READ;
+    }
+    if (ret == 0) {
+      LOG_WARN("failed to read text data: unexpected end of file. offset=%zu, len=%zu", offset, len);
+      return RC::IOERR_READ;
+    }
+    readed += ret;
+  }
+  return RC::SUCCESS;
+}
+
+RC TextDataManager::read_cached(size_t offset, char *data, size_t len)
+{
+  size_t copied = 0;
+  while (copied < len) {
+    const size_t current = offset + copied;
+    CachedPage  *page    = nullptr;
+    RC           rc      = get_page(current / PAGE_SIZE, page);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    // 数据可能横跨多页，也有可能不足一页
+    const size_t page_offset = current % PAGE_SIZE;
+    const size_t copy_len    = std::min(len - copied, PAGE_SIZE - page_offset);
+    memcpy(data + copied, page->data + page_offset, copy_len);
+    copied += copy_len;
+  }
+  return RC::SUCCESS;
+}
+
+RC TextDataManager::get_page(PageId page_id, CachedPage *&page)
+{
+  auto iter = page_cache_.find(page_id);
+  if (iter != page_cache_.end()) {
+    lru_list_.splice(lru_list_.begin(), lru_list_, iter->second);
+    page = &lru_list_.front();
+    return RC::SUCCESS;
+  }
+
+  // 缓存满了就复用最近最少使用的页面
+  if (lru_list_.size() >= CACHE_PAGE_NUM) {
+    page_cache_.erase(lru_list_.back().page_id);
+    lru_list_.splice(lru_list_.begin(), lru_list_, std::prev(lru_list_.end()));
+  } else {
+    lru_list_.emplace_front();
+  }
+
+  CachedPage  &cached_page = lru_list_.front();
+  const size_t page_start  = page_id * PAGE_SIZE;
+  // 只读取文件中已有的数据，页面剩下的部分以后追加写入时会通过 update_cached_pages 填上
+  const size_t read_len = page_start < file_end_ ? std::min(PAGE_SIZE, file_end_ - page_start) : 0;
+  RC           rc       = pread_fully(page_start, cached_page.data, read_len);
+  if (OB_FAIL(rc)) {
+    lru_list_.pop_front();
+    return rc;
+  }
+  memset(cached_page.data + read_len, 0, PAGE_SIZE - read_len);
+
+  cached_page.page_id = page_id;
+  page_cache_.emplace(page_id, lru_list_.begin());
+  page = &cached_page;
+  return RC::SUCCESS;
+}
+
+void TextDataManager::update_cached_pages(size_t offset, const char *data, size_t len)
+{
+  if (len == 0) {
+    return;
+  }
+  const PageId first_page = offset / PAGE_SIZE;
+  const PageId last_page  = (offset + len - 1) / PAGE_SIZE;
+  if (last_page - first_page + 1 > page_cache_.size()) {
+    // 写入的数据比缓存大很多时，遍历缓存而不是遍历页面
+    for (CachedPage &page : lru_list_) {
+      if (page.page_id >= first_page && page.page_id <= last_page) {
+        const size_t page_start = page.page_id * PAGE_SIZE;
+        const size_t start      = std::max(offset, page_start);
+        const size_t end        = std::min(offset + len, page_start + PAGE_SIZE);
+        memcpy(page.data + (start - page_start), data + (start - offset), end - start);
+      }
+    }
+    return;
+  }
+
+  for (PageId page_id = first_page; page_id <= last_page; page_id++) {
+    auto iter = page_cache_.find(page_id);
+    if (iter == page_cache_.end()) {
+      continue;
+    }
+    const size_t page_start = page_id * PAGE_SIZE;
+    const size_t start      = std::max(offset, page_start);
+    const size_t end        = std::min(offset + len, page_start + PAGE_SIZE);
+    memcpy(iter->second->data + (start - page_start), data + (start - offset), end - start);
+  }
+}
+
+bool TextDataManager::alloc_free_extent(size_t len, size_t &offset)
+{
+  // 找能放下数据的最小的空闲区间，剩下的部分仍然是空闲的
+  auto iter = free_extents_by_size_.lower_bound(std::make_pair(len, static_cast<size_t>(0)));
+  if (iter == free_extents_by_size_.end()) {
+    return false;
+  }
+
+  const auto [extent_len, extent_offset] = *iter;
+  remove_free_extent(free_extents_.find(extent_offset));
+  extent_reuse_count_++;
+  if (extent_len > len) {
+    free_extents_.emplace(extent_offset + len, extent_len - len);
+    free_extents_by_size_.emplace(extent_len - len, extent_offset + len);
+  }
+  offset = extent_offset;
+  return true;
+}
+
+void TextDataManager::remove_free_extent(std::map<size_t, size_t>::iterator iter)
+{
+  free_extents_by_size_.erase(std::make_pair(iter->second, iter->first));
+  free_extents_.erase(iter);
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/rc.h"
+#include "common/type/attr_type.h"
+
+/// 读写一张表的 TEXT 数据文件，代替每次读写都 open/lseek/read/close 的做法
+/// 主要逻辑： 1. 文件一直打开，使用 pread/pwrite 读写  2. 小的文本通过 LRU 页面缓存读取，大的文本直接读取
+///          3. 追加写入的数据先放在缓冲区中，攒够一批或者调用 flush 时才写入文件
+///          4. 删除和更新释放的空间记录在空闲区间中，写入新的文本时优先复用
+/// 空闲区间只保存在内存中，重启后不再复用之前释放的空间。
+/// 原地更新替换掉的文本，其它读者可能已经复制了旧的记录，稍后才会读取，先通过 retire_text 记下来，
+/// 等这些读者都结束以后再由 reclaim 放到空闲区间中。
+/// 一张表的数据会被多个会话同时访问，所有的接口都是线程安全的。
+class TextDataManager
+{
+private:
+  using PageId                               = size_t;
+  static constexpr size_t PAGE_SIZE          = 4096;
+  static constexpr size_t CACHE_PAGE_NUM     = 256;             ///< 页面缓存最多缓存多少个页面
+  static constexpr size_t DIRECT_READ_SIZE   = 4 * PAGE_SIZE;   ///< 不小于这个长度的文本不经过页面缓存，直接从文件读取
+  static constexpr size_t APPEND_BUFFER_SIZE = 16 * PAGE_SIZE;  ///< 追加缓冲区的大小，写满了就刷到文件中
+
+  struct CachedPage
+  {
+    PageId page_id;
+    char   data[PAGE_SIZE];
+  };
+
+  TextDataManager(int fd, size_t file_end) : fd_(fd), file_end_(file_end) {}
+
+public:
+  static std::unique_ptr<TextDataManager> create(const std::string &text_data_file);
+
+  ~TextDataManager();
+
+  /// 读取文本，data->str 指向新申请的内存，以 '\0' 结尾，由调用者释放
+  RC load_text(TextData *data);
+  /// 写入文本，并设置 data->offset
+  RC dump_text(TextData *data);
+  /// 释放文本占用的空间，之后写入的文本可以复用
+  void free_text(const TextData &data);
+  /// 释放文本占用的空间，但是要等 reclaim 的 horizon 超过 retire_id 以后才能复用
+  void retire_text(const TextData &data, int32_t retire_id);
+  /// 把 retire_id 小于 horizon 的文本空间放到空闲区间中
+  void reclaim(int32_t horizon);
+  /// 把追加缓冲区中的数据写入文件
+  RC flush();
+
+  /// 数据的结尾，包括还在追加缓冲区中的数据
+  size_t data_end();
+  /// 空闲区间的总长度，不包括还不能复用的空间
+  size_t free_size();
+
+private:
+  RC flush_append_buffer();
+  /// 把数据写到 offset 的位置，可能一部分在文件中，一部分在追加缓冲区中
+  RC write_at(size_t offset, const char *data, size_t len);
+  RC pwrite_fully(size_t offset, const char *data, size_t len);
+  RC pread_fully(size_t offset, char *data, size_t len);
+  /// 通过页面缓存读取文件中的数据
+  RC read_cached(size_t offset, char *data, size_t len);
+  RC get_page(PageId page_id, CachedPage *&page);
+  /// 写入文件以后，同步修改页面缓存中的内容
+  void update_cached_pages(size_t offset, const char *data, size_t len);
+
+  void free_extent(size_t offset, size_t len);
+  bool alloc_free_extent(size_t len, size_t &offset);
+  void remove_free_extent(std::map<size_t, size_t>::iterator iter);
+
+private:
+  std::mutex lock_;
+
+  int    fd_;
+  size_t file_end_;  ///< 文件中数据的结尾，后面紧跟着追加缓冲区中的数据
+
+  std::string append_buffer_;
+
+  std::map<size_t, size_t>            free_extents_;          ///< 空闲区间，offset -> len
+  std::set<std::pair<size_t, size_t>> free_extents_by_size_;  ///< 同样的空闲区间，按照 (len, offset) 排序，用来找最合适的区间
+  size_t                              extent_reuse_count_ = 0;  ///< 复用空闲区间的次数，不加锁读取文件的前后没有变化，说明读取期间数据没有被覆盖
+
+  struct RetiredExtent
+  {
+    int32_t retire_id;
+    size_t  offset;
+    size_t  len;
+  };
+  std::vector<RetiredExtent> retired_extents_;  ///< 已经释放但是还不能复用的空间
+
+  std::list<CachedPage>                                       lru_list_;  ///< 链表头表示最近经常使用，末尾表示最近最少使用
+  std::unordered_map<PageId, std::list<CachedPage>::iterator> page_cache_;
+};
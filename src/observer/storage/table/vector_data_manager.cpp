@@ -1,212 +1,340 @@
 #include <fcntl.h>
-#include <cmath>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
 
 #include "storage/table/vector_data_manager.h"
-#include "storage/table/table.h"
 #include "common/log/log.h"
 
-RC VectorDataManager::get_buffer(PageId page_id, std::byte *&buffer)
+VectorDataManager::VectorDataManager(int fd, size_t data_end, size_t cache_size) : fd_(fd), data_end_(data_end)
 {
-  LOG_TRACE("get buffer %d", page_id);
-  RC   rc = RC::SUCCESS;
-  auto it = buffer_pool_.find(page_id);
-  if (it != buffer_pool_.end()) {
-    lru_list_.erase(std::find(lru_list_.begin(), lru_list_.end(), page_id));
-    lru_list_.push_front(page_id);
-    buffer = it->second;
-    return rc;
+  const size_t page_num = std::max(cache_size / PAGE_SIZE, PARTITION_NUM);
+  for (size_t i = 0; i < PARTITION_NUM; i++) {
+    auto partition      = std::make_unique<Partition>();
+    partition->capacity = page_num / PARTITION_NUM + (i < page_num % PARTITION_NUM ? 1 : 0);
+    partitions_.push_back(std::move(partition));
   }
-  rc = alloc_buffer(page_id, buffer);
-  if (OB_FAIL(rc)) {
-    LOG_WARN("failed to allocate a new buffer: %s", strrc(rc));
-    return rc;
+}
+
+std::unique_ptr<VectorDataManager> VectorDataManager::create(const std::string &vector_data_file, size_t cache_size)
+{
+  int fd = open(vector_data_file.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+  if (fd < 0) {
+    LOG_WARN("failed to open file %s : %s", vector_data_file.c_str(), strerror(errno));
+    return nullptr;
+  }
+  // 写回页面时只写到数据的结尾，所以文件的大小就是数据的结尾
+  off_t file_size = lseek(fd, 0, SEEK_END);
+  if (file_size < 0) {
+    LOG_WARN("failed to get the size of file %s : %s", vector_data_file.c_str(), strerror(errno));
+    close(fd);
+    return nullptr;
   }
+  return std::unique_ptr<VectorDataManager>(new VectorDataManager(fd, file_size, cache_size));
+}
 
-  buffer_pool_[page_id] = buffer;
-  lru_list_.push_front(page_id);
-  if (lru_list_.size() > BUFFER_POOL_SIZE) {  // 淘汰最近最少使用的 page
-    ASSERT(lru_list_.size() - 1 == BUFFER_POOL_SIZE, "not implemented");
-    release_buffer(lru_list_.back());
+VectorDataManager::~VectorDataManager()
+{
+  RC rc = flush();
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("failed to flush vector data: %s", strrc(rc));
   }
-  return RC::SUCCESS;
+  for (auto &[data, size] : mappings_) {
+    munmap(data, size);
+  }
+  close(fd_);
 }
 
-RC VectorDataManager::alloc_buffer(PageId page_id, std::byte *&buffer)
+RC VectorDataManager::get_page(Partition &partition, PageId page_id, CachedPage *&page)
 {
-  // 开辟一个全新的page
-  if (page_id > max_page_id_) {
-    LOG_TRACE("alloc a new buffer %d", page_id);
-    ASSERT(page_id == max_page_id_ + 1, "not implemented");
-    max_page_id_++;
-    if (ftruncate(fd_, (max_page_id_ + 1) * PAGE_SIZE) < 0) {
-      LOG_WARN("failed to ftruncate: %s", strerror(errno));
-      return RC::IOERR_ACCESS;
-    }
-    buffer = new std::byte[PAGE_SIZE];
+  auto iter = partition.pages.find(page_id);
+  if (iter != partition.pages.end()) {
+    partition.lru_list.splice(partition.lru_list.begin(), partition.lru_list, iter->second);
+    page = &*iter->second;
     return RC::SUCCESS;
   }
-  LOG_TRACE("alloc an old buffer %d", page_id);
-  // 将已有的 page 加载进内存形成 buffer
-  if (lseek(fd_, page_id * PAGE_SIZE, SEEK_SET) == static_cast<off_t>(-1)) {
-    LOG_WARN("failed to lseek: %s", strerror(errno));
-    return RC::IOERR_ACCESS;
-  }
-  size_t offset = 0;
-  buffer        = new std::byte[PAGE_SIZE];
-
-  while (offset < PAGE_SIZE) {
-    ssize_t readed = read(fd_, buffer + offset, PAGE_SIZE - offset);
-    if (readed < 0) {
-      LOG_WARN("failed to read vector data: %s", strerror(errno));
-      delete[] buffer;
-      buffer = nullptr;
+
+  if (partition.lru_list.size() >= partition.capacity) {
+    // 淘汰最近最少使用的页面，复用它的内存
+    auto victim = std::prev(partition.lru_list.end());
+    if (partition.dirty_pages.contains(victim->page_id)) {
+      RC rc = write_page(partition, *victim);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to write back vector page %zu: %s", victim->page_id, strrc(rc));
+        return rc;
+      }
+    }
+    partition.pages.erase(victim->page_id);
+    partition.lru_list.splice(partition.lru_list.begin(), partition.lru_list, victim);
+  } else {
+    partition.lru_list.emplace_front();
+  }
+
+  // 文件中还没有的部分是新分配的空间，填充 0
+  CachedPage &new_page = partition.lru_list.front();
+  size_t      read_len = 0;
+  while (read_len < PAGE_SIZE) {
+    ssize_t ret = pread(fd_, new_page.data + read_len, PAGE_SIZE - read_len, page_id * PAGE_SIZE + read_len);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      LOG_WARN("failed to read vector page %zu: %s", page_id, strerror(errno));
+      partition.lru_list.pop_front();
       return RC::IOERR_READ;
     }
-    offset += readed;
+    if (ret == 0) {
+      break;
+    }
+    read_len += ret;
   }
+  memset(new_page.data + read_len, 0, PAGE_SIZE - read_len);
+  new_page.page_id = page_id;
+  partition.pages.emplace(page_id, partition.lru_list.begin());
+  page = &new_page;
   return RC::SUCCESS;
 }
 
-RC VectorDataManager::release_buffer(PageId page_id)
+RC VectorDataManager::write_page(Partition &partition, const CachedPage &page)
 {
-  LOG_TRACE("release buffer %d", page_id);
-  ASSERT(buffer_pool_.contains(page_id), "internal error");
-  if (const auto it = dirty_buffers_.find(page_id); it != dirty_buffers_.end()) {
-    if (lseek(fd_, page_id * PAGE_SIZE, SEEK_SET) == static_cast<off_t>(-1)) {
-      LOG_WARN("failed to lseek: %s", strerror(errno));
-      return RC::IOERR_ACCESS;
-    }
-    size_t offset = 0;
-    while (offset < PAGE_SIZE) {
-      ssize_t writed = write(fd_, buffer_pool_[page_id] + offset, PAGE_SIZE - offset);
-      if (writed < 0) {
-        LOG_WARN("failed to write back buffer: %s", strerror(errno));
-        return RC::IOERR_WRITE;
+  // 最后一页只写到数据的结尾
+  const size_t page_offset = page.page_id * PAGE_SIZE;
+  const size_t data_end    = data_end_.load();
+  const size_t len         = data_end > page_offset ? std::min(PAGE_SIZE, data_end - page_offset) : 0;
+  size_t       written     = 0;
+  while (written < len) {
+    ssize_t ret = pwrite(fd_, page.data + written, len - written, page_offset + written);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
       }
-      offset += writed;
+      LOG_WARN("failed to write vector page %zu: %s", page.page_id, strerror(errno));
+      return RC::IOERR_WRITE;
     }
-    dirty_buffers_.erase(it);
+    written += ret;
+  }
+  if (partition.dirty_pages.erase(page.page_id) > 0) {
+    dirty_page_num_--;
   }
-  delete[] buffer_pool_[page_id];
-  buffer_pool_.erase(page_id);
-  lru_list_.pop_back();
   return RC::SUCCESS;
 }
 
-std::unique_ptr<VectorDataManager> VectorDataManager::create(const Table *table)
+RC VectorDataManager::read_data(size_t offset, std::byte *data, size_t len)
 {
-  std::string vector_data_file = table->vector_data_file();
-  int         fd               = open(vector_data_file.c_str(), O_RDWR | O_CREAT, 0600);
-  if (fd < 0) {
-    LOG_WARN("failed to open file %s : %s", vector_data_file.c_str(), strerror(errno));
-    return nullptr;
+  while (len > 0) {
+    const PageId page_id     = offset / PAGE_SIZE;
+    const size_t page_offset = offset % PAGE_SIZE;
+    const size_t copy_len    = std::min(len, PAGE_SIZE - page_offset);
+
+    Partition                  &partition = partition_of(page_id);
+    std::lock_guard<std::mutex> guard(partition.lock);
+    CachedPage                 *page = nullptr;
+    RC                          rc   = get_page(partition, page_id, page);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    memcpy(data, page->data + page_offset, copy_len);
+
+    offset += copy_len;
+    data += copy_len;
+    len -= copy_len;
   }
-  size_t file_size   = lseek(fd, 0, SEEK_END);
-  PageId max_page_id = std::ceil(file_size / static_cast<float>(PAGE_SIZE)) - 1;
-  return std::unique_ptr<VectorDataManager>(new VectorDataManager(fd, max_page_id));
+  return RC::SUCCESS;
 }
 
-RC VectorDataManager::load_vector(VectorData *vector_data)
+RC VectorDataManager::write_data(size_t offset, const std::byte *data, size_t len)
 {
-  LOG_TRACE("load vector[offset = %d, dim = %d]", vector_data->offset, vector_data->dim);
-  PageId page_id_start = std::floor(vector_data->offset / static_cast<float>(PAGE_SIZE));
-  PageId page_id_end =
-      std::floor((vector_data->offset + vector_data->dim * sizeof(float)) / static_cast<float>(PAGE_SIZE));
-  const auto vector           = new float[vector_data->dim];
-  size_t     copy_dest_offset = 0;
-  for (PageId current_page_id = page_id_start; current_page_id <= page_id_end; current_page_id += 1) {
-    std::byte *buffer;
-    if (RC rc = get_buffer(current_page_id, buffer); OB_FAIL(rc)) {
-      delete[] vector;
-      LOG_WARN("failed to load vector: %s", strrc(rc));
+  while (len > 0) {
+    const PageId page_id     = offset / PAGE_SIZE;
+    const size_t page_offset = offset % PAGE_SIZE;
+    const size_t copy_len    = std::min(len, PAGE_SIZE - page_offset);
+
+    Partition                  &partition = partition_of(page_id);
+    std::lock_guard<std::mutex> guard(partition.lock);
+    CachedPage                 *page = nullptr;
+    RC                          rc   = get_page(partition, page_id, page);
+    if (OB_FAIL(rc)) {
       return rc;
     }
-
-    void  *copy_start;
-    size_t max_copy_len;
-    if (vector_data->offset > current_page_id * PAGE_SIZE) {
-      copy_start = buffer + vector_data->offset % PAGE_SIZE;  // 复制第一页时，从offset 开始而不是从页首地址开始
-      max_copy_len = PAGE_SIZE - vector_data->offset % PAGE_SIZE;
-    } else {
-      copy_start   = buffer;
-      max_copy_len = PAGE_SIZE;
+    memcpy(page->data + page_offset, data, copy_len);
+    if (partition.dirty_pages.insert(page_id).second) {
+      dirty_page_num_++;
     }
-    // 复制数据可能横跨多页，也有可能不足一页
-    const size_t copy_len = std::min(vector_data->dim * sizeof(float) - copy_dest_offset, max_copy_len);
-    memcpy(reinterpret_cast<std::byte *>(vector) + copy_dest_offset, copy_start, copy_len);
-    copy_dest_offset += copy_len;
+
+    offset += copy_len;
+    data += copy_len;
+    len -= copy_len;
+  }
+  return RC::SUCCESS;
+}
+
+RC VectorDataManager::load_vector(VectorData *vector_data)
+{
+  LOG_TRACE("load vector[offset = %zu, dim = %zu]", vector_data->offset, vector_data->dim);
+  const auto vector = new float[vector_data->dim];
+  RC rc = read_data(vector_data->offset, reinterpret_cast<std::byte *>(vector), vector_data->dim * sizeof(float));
+  if (OB_FAIL(rc)) {
+    delete[] vector;
+    LOG_WARN("failed to load vector: %s", strrc(rc));
+    return rc;
   }
   vector_data->vector = vector;
   return RC::SUCCESS;
 }
 
-RC VectorDataManager::dump_vector(VectorData *vector_data)
+bool VectorDataManager::map_vector(VectorData *vector_data)
 {
-  LOG_TRACE("dump vector [%f, %f, %f...]", vector_data->vector[0], vector_data->vector[1], vector_data->vector[2]);
-  PageId page_id_start   = std::floor(data_end_ / static_cast<float>(PAGE_SIZE));
-  PageId page_id_end     = std::floor((data_end_ + vector_data->dim * sizeof(float)) / static_cast<float>(PAGE_SIZE));
-  PageId copy_src_offset = 0;
-  for (PageId current_page_id = page_id_start; current_page_id <= page_id_end; current_page_id += 1) {
-    std::byte *buffer;
-    if (RC rc = get_buffer(current_page_id, buffer); OB_FAIL(rc)) {
-      LOG_WARN("failed to load vector: %s", strrc(rc));
-      return rc;
+  const size_t len = vector_data->dim * sizeof(float);
+  if (len == 0) {
+    return false;
+  }
+  const size_t end = vector_data->offset + len;
+  if (end > mapped_end_.load() && !extend_mapping(end)) {
+    return false;
+  }
+  if (dirty_page_num_.load() > 0 && has_dirty_page(vector_data->offset, len)) {
+    return false;
+  }
+  vector_data->vector = reinterpret_cast<const float *>(mapped_data_.load() + vector_data->offset);
+  return true;
+}
+
+bool VectorDataManager::extend_mapping(size_t end)
+{
+  std::lock_guard<std::mutex> guard(map_lock_);
+  if (end <= mapped_end_.load()) {
+    return true;
+  }
+
+  struct stat st;
+  if (fstat(fd_, &st) < 0) {
+    LOG_WARN("failed to stat vector data file: %s", strerror(errno));
+    return false;
+  }
+  const size_t file_size = st.st_size;
+  if (end > file_size) {
+    return false;  // 数据还在页面缓存中，没有写入文件
+  }
+
+  if (file_size > mapped_size_) {
+    // 多映射一些空间，文件变大以后不用每次都重新映射。映射中超过文件大小的部分不会被访问
+    size_t map_size = std::max(file_size, mapped_size_ * 2);
+    map_size        = (map_size + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+    void *data      = mmap(nullptr, map_size, PROT_READ, MAP_SHARED, fd_, 0);
+    if (data == MAP_FAILED) {
+      LOG_WARN("failed to mmap vector data file. size=%zu, error=%s", map_size, strerror(errno));
+      return false;
     }
-    void  *copy_start;
-    size_t max_copy_len;
-    if (data_end_ > max_page_id_ * PAGE_SIZE) {
-      copy_start          = buffer + data_end_ % PAGE_SIZE;
-      vector_data->offset = data_end_;
-      max_copy_len        = PAGE_SIZE - data_end_ % PAGE_SIZE;
+    mappings_.emplace_back(data, map_size);
+    mapped_size_ = map_size;
+    mapped_data_.store(static_cast<const std::byte *>(data));
+  }
+  // 先发布新的地址，再发布可以读取的范围
+  mapped_end_.store(file_size);
+  return true;
+}
+
+bool VectorDataManager::has_dirty_page(size_t offset, size_t len)
+{
+  for (PageId page_id = offset / PAGE_SIZE; page_id <= (offset + len - 1) / PAGE_SIZE; page_id++) {
+    Partition                  &partition = partition_of(page_id);
+    std::lock_guard<std::mutex> guard(partition.lock);
+    if (partition.dirty_pages.contains(page_id)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+RC VectorDataManager::dump_vector(VectorData *vector_data)
+{
+  const size_t len = vector_data->dim * sizeof(float);
+  {
+    std::lock_guard<std::mutex> guard(space_lock_);
+    auto                        iter = free_vectors_.find(len);
+    if (iter != free_vectors_.end()) {
+      vector_data->offset = *iter->second.begin();
+      iter->second.erase(iter->second.begin());
+      if (iter->second.empty()) {
+        free_vectors_.erase(iter);
+      }
     } else {
-      copy_start   = buffer;
-      max_copy_len = PAGE_SIZE;
+      vector_data->offset = data_end_.fetch_add(len);
     }
-    const size_t copy_len = std::min(vector_data->dim * sizeof(float) - copy_src_offset, max_copy_len);
-    memcpy(copy_start, reinterpret_cast<const std::byte *>(vector_data->vector) + copy_src_offset, copy_len);
-    copy_src_offset += copy_len;
-    dirty_buffers_.insert(current_page_id);
   }
-  data_end_ += vector_data->dim * sizeof(float);
-  return RC::SUCCESS;
+
+  RC rc = write_data(vector_data->offset, reinterpret_cast<const std::byte *>(vector_data->vector), len);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to dump vector: %s", strrc(rc));
+  }
+  return rc;
 }
 
 RC VectorDataManager::update_vector(const VectorData *old_vector_data, const VectorData *new_vector_data)
 {
   ASSERT(old_vector_data->dim == new_vector_data->dim, "only vectors with the same dimension can be updated");
-  PageId page_id_start = std::floor(old_vector_data->offset / static_cast<float>(PAGE_SIZE));
-  PageId page_id_end =
-      std::floor((old_vector_data->offset + old_vector_data->dim * sizeof(float)) / static_cast<float>(PAGE_SIZE));
-  size_t copy_src_offset = 0;
-  for (PageId current_page_id = page_id_start; current_page_id <= page_id_end; current_page_id += 1) {
-    std::byte *buffer;
-    if (RC rc = get_buffer(current_page_id, buffer); OB_FAIL(rc)) {
-      LOG_WARN("failed to load vector: %s", strrc(rc));
-      return rc;
-    }
+  RC rc = write_data(old_vector_data->offset,
+      reinterpret_cast<const std::byte *>(new_vector_data->vector),
+      old_vector_data->dim * sizeof(float));
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to update vector: %s", strrc(rc));
+  }
+  return rc;
+}
 
-    void  *copy_start;
-    size_t max_copy_len;
-    if (old_vector_data->offset > current_page_id * PAGE_SIZE) {
-      copy_start = buffer + old_vector_data->offset % PAGE_SIZE;  // 复制第一页时，从offset 开始而不是从页首地址开始
-      max_copy_len = PAGE_SIZE - old_vector_data->offset % PAGE_SIZE;
-    } else {
-      copy_start   = buffer;
-      max_copy_len = PAGE_SIZE;
+void VectorDataManager::free_vector(const VectorData &vector_data)
+{
+  const size_t len = vector_data.dim * sizeof(float);
+  if (len == 0) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(space_lock_);
+  if (vector_data.offset + len > data_end_.load()) {
+    LOG_WARN("invalid vector to free. offset=%zu, dim=%zu, data end=%zu",
+             vector_data.offset, vector_data.dim, data_end_.load());
+    return;
+  }
+  // 同一个向量重复释放时只记录一次
+  free_vectors_[len].insert(vector_data.offset);
+}
+
+RC VectorDataManager::flush()
+{
+  for (auto &partition : partitions_) {
+    std::lock_guard<std::mutex> guard(partition->lock);
+    while (!partition->dirty_pages.empty()) {
+      const PageId page_id = *partition->dirty_pages.begin();
+      RC           rc      = write_page(*partition, *partition->pages[page_id]);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
     }
-    // 复制数据可能横跨多页，也有可能不足一页
-    const size_t copy_len = std::min(old_vector_data->dim * sizeof(float) - copy_src_offset, max_copy_len);
-    memcpy(copy_start, reinterpret_cast<const std::byte *>(new_vector_data->vector) + copy_src_offset, copy_len);
-    copy_src_offset += copy_len;
-    dirty_buffers_.insert(current_page_id);
   }
   return RC::SUCCESS;
 }
 
-VectorDataManager::~VectorDataManager()
+RC VectorDataManager::sync()
 {
-  close(fd_);
-  for (auto &[page_id, buffer] : buffer_pool_) {
-    delete[] buffer;
+  RC rc = flush();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  if (fsync(fd_) < 0) {
+    LOG_WARN("failed to fsync vector data: %s", strerror(errno));
+    return RC::IOERR_SYNC;
+  }
+  return RC::SUCCESS;
+}
+
+size_t VectorDataManager::free_size()
+{
+  std::lock_guard<std::mutex> guard(space_lock_);
+  size_t                      size = 0;
+  for (const auto &[len, offsets] : free_vectors_) {
+    size += len * offsets.size();
   }
+  return size;
 }
@@ -1,51 +1,109 @@
 #pragma once
-#include <unordered_map>
+#include <atomic>
 #include <list>
-#include <unordered_set>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "common/rc.h"
 #include "common/type/attr_type.h"
 
-class Table;
-
 /// 为了减少系统调用次数、减少文件 IO 次数，使用 VectorDataManager 读写向量数据
-/// 主要逻辑： 1. IO 规模规整化为磁盘物理页大小  2. 使用缓冲池减少IO次数   3. LRU管理缓冲
+/// 主要逻辑： 1. IO 规模规整化为磁盘物理页大小  2. 使用页面缓存减少IO次数   3. LRU管理缓存
+///          4. 页面缓存按照页号分成多个分区，每个分区单独加锁，多个会话可以同时读写不同分区的页面
+///          5. 删除和更新释放的向量空间记录下来，写入同样长度的向量时优先复用
+/// 脏页在调用 flush 时写回文件，每条语句结束时调用，保证提交的记录引用的向量数据已经在文件中。
+/// 写回时只写到 data_end_ 为止，文件的大小就是数据的结尾，重启以后从这里继续追加，不会留下空洞。
+/// 空闲空间只保存在内存中，重启后不再复用之前释放的空间。
+/// 读取时优先使用 map_vector，直接返回映射到内存的文件中的地址，不需要申请内存和复制。
+/// 文件变大后重新映射，旧的映射保留到析构时才解除，之前返回的地址一直有效。
 class VectorDataManager
 {
-  // 向量数据文件按页管理, 每 4K 即 Page, Page加载到内存后形成 Buffer, Buffer 经历若干次读写后写回 Page
+  // 向量数据文件按页管理, 每 4K 即 Page, Page 加载到内存后放在页面缓存中, 经历若干次读写后写回 Page
 private:
-  using PageId                      = ssize_t;
-  static constexpr size_t PAGE_SIZE = 4096;
+  using PageId                          = size_t;
+  static constexpr size_t PAGE_SIZE     = 4096;
+  static constexpr size_t PARTITION_NUM = 16;
 
-  explicit VectorDataManager(int fd, PageId max_page_id)
-      : fd_(fd), max_page_id_(max_page_id), data_end_((max_page_id + 1) * PAGE_SIZE)
-  {}
+  struct CachedPage
+  {
+    PageId    page_id;
+    std::byte data[PAGE_SIZE];
+  };
 
-  RC get_buffer(PageId page_id, std::byte *&buffer);
+  struct Partition
+  {
+    std::mutex                                                  lock;
+    size_t                                                      capacity = 0;  ///< 最多缓存多少个页面
+    std::list<CachedPage>                                       lru_list;  ///< 链表头表示最近经常使用，末尾表示最近最少使用
+    std::unordered_map<PageId, std::list<CachedPage>::iterator> pages;
+    std::unordered_set<PageId>                                  dirty_pages;
+  };
 
-  RC alloc_buffer(PageId page_id, std::byte *&buffer);
-
-  RC release_buffer(PageId page_id);
+  VectorDataManager(int fd, size_t data_end, size_t cache_size);
 
 public:
-  static std::unique_ptr<VectorDataManager> create(const Table *table);
+  static constexpr size_t DEFAULT_CACHE_SIZE = 16 * 1024 * 1024;  ///< 默认每张表缓存 16M 的向量数据
+
+  /// cache_size 是页面缓存的大小，单位是字节，每个分区至少缓存一个页面
+  static std::unique_ptr<VectorDataManager> create(
+      const std::string &vector_data_file, size_t cache_size = DEFAULT_CACHE_SIZE);
+
+  ~VectorDataManager();
 
+  /// 读取向量，vector_data->vector 指向新申请的内存，由调用者释放
   RC load_vector(VectorData *vector_data);
+  /// 不复制数据，让 vector_data->vector 直接指向映射到内存的文件，在 VectorDataManager 析构前有效，不需要释放。
+  /// 向量还没有写入文件（所在的页面是脏页）时返回 false，需要使用 load_vector 读取
+  bool map_vector(VectorData *vector_data);
+  /// 写入向量，并设置 vector_data->offset
   RC dump_vector(VectorData *vector_data);
   RC update_vector(const VectorData *old_vector_data, const VectorData *new_vector_data);
+  /// 释放向量占用的空间，之后写入的同样长度的向量可以复用
+  void free_vector(const VectorData &vector_data);
 
-  ~VectorDataManager();
+  /// 把脏页写回文件
+  RC flush();
+  /// 把脏页写回文件，并且等待数据落盘
+  RC sync();
+
+  size_t data_end() const { return data_end_.load(); }
+  /// 空闲空间的总长度
+  size_t free_size();
+
+private:
+  Partition &partition_of(PageId page_id) { return *partitions_[page_id % PARTITION_NUM]; }
+
+  /// 在页面缓存中查找页面，不在缓存中时从文件加载。调用前需要持有分区的锁
+  RC get_page(Partition &partition, PageId page_id, CachedPage *&page);
+  RC write_page(Partition &partition, const CachedPage &page);
+
+  /// 通过页面缓存读写 offset 开始的 len 个字节，数据可能横跨多页
+  RC read_data(size_t offset, std::byte *data, size_t len);
+  RC write_data(size_t offset, const std::byte *data, size_t len);
+
+  /// 映射文件中 end 之前的数据，文件比映射的区域大时重新映射
+  bool extend_mapping(size_t end);
+  /// [offset, offset + len) 所在的页面是否有脏页，有脏页时文件中的数据不是最新的
+  bool has_dirty_page(size_t offset, size_t len);
 
 private:
-  int                                     fd_;
-  PageId                                  max_page_id_;
-  std::unordered_map<PageId, std::byte *> buffer_pool_;
-  std::unordered_set<PageId>              dirty_buffers_;
+  int fd_;
+
+  std::mutex          space_lock_;  ///< 保护空间的分配和空闲空间
+  std::atomic<size_t> data_end_;    ///< 文件的 data_end_ 之前是向量数据，之后 (包括自己）是空数据
+  std::unordered_map<size_t, std::set<size_t>> free_vectors_;  ///< 空闲的向量空间，长度 -> offset
 
-  /// NOTE: 目前的实现 每次重启数据库后（如果向量已经持久化）data_end_从页头开始，会造成数据空洞
+  std::vector<std::unique_ptr<Partition>> partitions_;
+  std::atomic<size_t>                     dirty_page_num_{0};  ///< 所有分区中脏页的数量，没有脏页时读取不需要加锁检查
 
-  size_t                  data_end_;  // 文件的data_end_之前是向量数据，之后 (包括自己）是空数据
-  std::list<PageId>       lru_list_;  // 链表头表示最近经常使用，末尾表示最近最少使用
-  static constexpr size_t BUFFER_POOL_SIZE = 16;
-};
\ No newline at end of file
+  std::mutex                             map_lock_;  ///< 保护重新映射
+  std::atomic<const std::byte *>         mapped_data_{nullptr};
+  std::atomic<size_t>                    mapped_end_{0};  ///< 可以直接从映射中读取的范围，不超过映射时文件的大小
+  size_t                                 mapped_size_ = 0;  ///< 映射的长度，会预留一部分空间给之后追加的数据
+  std::vector<std::pair<void *, size_t>> mappings_;  ///< 所有映射过的区域，析构时才解除映射
+};
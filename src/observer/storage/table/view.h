@@ -38,7 +38,7 @@ class View : public Table {
 
   void set_operator(std::unique_ptr<PhysicalOperator> oper) { operator_ = std::move(oper); }
 
-  RC get_record_scanner(RecordPhysicalOperatorScanner &scanner, Trx *trx, ReadWriteMode mode);
+  virtual RC get_record_scanner(RecordPhysicalOperatorScanner &scanner, Trx *trx, ReadWriteMode mode);
 
   void set_base_tables(const std::vector<Table *> &tables) { base_tables_ = tables; }
   
@@ -44,6 +44,31 @@ const vector<FieldMeta> *MvccTrxKit::trx_fields() const { return &fields_; }
 
 int32_t MvccTrxKit::next_trx_id() { return ++current_trx_id_; }
 
+int32_t MvccTrxKit::begin_trx_id()
+{
+  // 分配事务号和记录活跃事务需要是原子的，否则计算最老的活跃事务时可能漏掉刚开始的事务
+  lock_.lock();
+  int32_t trx_id = next_trx_id();
+  active_trx_ids_.insert(trx_id);
+  lock_.unlock();
+  return trx_id;
+}
+
+void MvccTrxKit::end_trx_id(int32_t trx_id)
+{
+  lock_.lock();
+  active_trx_ids_.erase(trx_id);
+  lock_.unlock();
+}
+
+int32_t MvccTrxKit::oldest_active_trx_id()
+{
+  lock_.lock();
+  int32_t trx_id = active_trx_ids_.empty() ? current_trx_id_.load() + 1 : *active_trx_ids_.begin();
+  lock_.unlock();
+  return trx_id;
+}
+
 int32_t MvccTrxKit::max_trx_id() const { return numeric_limits<int32_t>::max(); }
 
 Trx *MvccTrxKit::create_trx(LogHandler &log_handler)
@@ -123,7 +148,12 @@ MvccTrx::MvccTrx(MvccTrxKit &kit, LogHandler &log_handler, int32_t trx_id)
   recovering_ = true;
 }
 
-MvccTrx::~MvccTrx() {}
+MvccTrx::~MvccTrx()
+{
+  if (started_ && !recovering_) {
+    trx_kit_.end_trx_id(trx_id_);
+  }
+}
 
 RC MvccTrx::insert_record(Table *table, Record &record)
 {
@@ -241,6 +271,48 @@ RC MvccTrx::visit_record(Table *table, Record &record, ReadWriteMode mode)
   return rc;
 }
 
+RC MvccTrx::visit_chunk(Table *table, Chunk &chunk, vector<uint8_t> &select, ReadWriteMode mode)
+{
+  span<const FieldMeta> trx_fields = table->table_meta().trx_fields();
+  ASSERT(trx_fields.size() >= 2, "invalid trx fields number. %d", trx_fields.size());
+
+  // 事务字段放在表中所有字段的最前面
+  const Column &begin_column = chunk.column(0);
+  const Column &end_column   = chunk.column(1);
+  ASSERT(begin_column.attr_len() == sizeof(int32_t) && end_column.attr_len() == sizeof(int32_t),
+         "invalid trx field length");
+
+  const int32_t *begin_xids = reinterpret_cast<const int32_t *>(begin_column.data());
+  const int32_t *end_xids   = reinterpret_cast<const int32_t *>(end_column.data());
+  const int      rows       = min(static_cast<int>(select.size()), begin_column.count());
+  for (int i = 0; i < rows; i++) {
+    if (select[i] == 0) {
+      continue;
+    }
+
+    const int32_t begin_xid = begin_xids[i];
+    const int32_t end_xid   = end_xids[i];
+    if (begin_xid > 0 && end_xid > 0) {
+      select[i] = trx_id_ >= begin_xid && trx_id_ <= end_xid;
+    } else if (begin_xid < 0) {
+      // 刚插入而且没有提交的数据只有插入的事务自己可见
+      select[i] = -begin_xid == trx_id_;
+    } else if (end_xid < 0) {
+      // 正在删除但是还没有提交的数据
+      if (mode == ReadWriteMode::READ_ONLY) {
+        select[i] = -end_xid != trx_id_;
+      } else if (-end_xid != trx_id_) {
+        LOG_TRACE("concurrency conflit. someone is deleting this record right now. trx id=%d, begin xid=%d, end xid=%d",
+                  trx_id_, begin_xid, end_xid);
+        return RC::LOCKED_CONCURRENCY_CONFLICT;
+      } else {
+        select[i] = 0;
+      }
+    }
+  }
+  return RC::SUCCESS;
+}
+
 /**
  * @brief 获取指定表上的事务使用的字段
  *
@@ -264,7 +336,7 @@ RC MvccTrx::start_if_need()
 {
   if (!started_) {
     ASSERT(operations_.empty(), "try to start a new trx while operations is not empty");
-    trx_id_ = trx_kit_.next_trx_id();
+    trx_id_ = trx_kit_.begin_trx_id();
     LOG_DEBUG("current thread change to new trx with %d", trx_id_);
     started_ = true;
   }
@@ -340,6 +412,7 @@ RC MvccTrx::commit_with_trx_id(int32_t commit_xid)
   }
 
   operations_.clear();
+  trx_kit_.end_trx_id(trx_id_);
 
   LOG_TRACE("append trx commit log. trx id=%d, commit_xid=%d, rc=%s", trx_id_, commit_xid, strrc(rc));
   return rc;
@@ -415,6 +488,7 @@ RC MvccTrx::rollback()
   }
 
   operations_.clear();
+  trx_kit_.end_trx_id(trx_id_);
 
   if (!recovering_) {
     rc = log_handler_.rollback(trx_id_);
@@ -14,6 +14,7 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/lang/set.h"
 #include "common/lang/vector.h"
 #include "storage/trx/trx.h"
 #include "storage/trx/mvcc_trx_log.h"
@@ -47,6 +48,29 @@ public:
 public:
   int32_t next_trx_id();
 
+  /**
+   * @brief 事务开始时分配事务号，并记录为活跃事务
+   */
+  int32_t begin_trx_id();
+
+  /**
+   * @brief 事务提交或回滚以后，不再是活跃事务
+   */
+  void end_trx_id(int32_t trx_id);
+
+  /**
+   * @brief 活跃事务中最小的事务号
+   * @details 没有活跃事务时返回下一个要分配的事务号。
+   * 删除已经提交并且 end_xid 小于这个值的记录，对当前和以后的所有事务都不可见，可以被 MvccVacuum 回收。
+   */
+  int32_t oldest_active_trx_id();
+
+  /**
+   * @brief 已经分配的最大事务号
+   * @details 此时活跃的事务，事务号都不会超过这个值
+   */
+  int32_t last_trx_id() const { return current_trx_id_.load(); }
+
 public:
   int32_t max_trx_id() const;
 
@@ -57,12 +81,13 @@ private:
 
   common::Mutex lock_;
   vector<Trx *> trxes_;
+  set<int32_t>  active_trx_ids_;  ///< 已经开始但是还没有结束的事务，受 lock_ 保护
 };
 
 /**
  * @brief 多版本并发事务
  * @ingroup Transaction
- * TODO 没有垃圾回收
+ * @details 删除的记录只是设置了 end_xid，由 MvccVacuum 在后台回收。
  */
 class MvccTrx : public Trx
 {
@@ -91,6 +116,12 @@ public:
    */
   RC visit_record(Table *table, Record &record, ReadWriteMode mode) override;
 
+  /**
+   * @brief 与 visit_record 的规则相同，一次判断一组记录
+   * @details 直接读取 begin_xid 和 end_xid 两列，不需要组装成 Record
+   */
+  RC visit_chunk(Table *table, Chunk &chunk, vector<uint8_t> &select, ReadWriteMode mode) override;
+
   RC start_if_need() override;
   RC commit() override;
   RC rollback() override;
@@ -0,0 +1,179 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/trx/mvcc_vacuum.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/chrono.h"
+#include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "common/log/log.h"
+#include "common/thread/thread_util.h"
+#include "storage/db/db.h"
+#include "storage/field/field.h"
+#include "storage/record/record_manager.h"
+#include "storage/table/table.h"
+#include "storage/trx/mvcc_trx.h"
+
+using namespace common;
+
+MvccVacuum::MvccVacuum(Db &db, MvccTrxKit &trx_kit) : db_(db), trx_kit_(trx_kit) {}
+
+MvccVacuum::~MvccVacuum() { stop(); }
+
+RC MvccVacuum::start(const Options &options)
+{
+  if (!options.enabled) {
+    LOG_INFO("mvcc vacuum is disabled");
+    return RC::SUCCESS;
+  }
+
+#ifndef CONCURRENCY
+  LOG_WARN("mvcc vacuum is only supported when CONCURRENCY is enabled");
+  return RC::UNSUPPORTED;
+#endif
+
+  if (thread_) {
+    LOG_ERROR("mvcc vacuum has been started");
+    return RC::INTERNAL;
+  }
+
+  options_                 = options;
+  options_.interval_ms     = max(1, options_.interval_ms);
+  options_.pages_per_batch = max(1, options_.pages_per_batch);
+  options_.batch_sleep_ms  = max(0, options_.batch_sleep_ms);
+
+  running_.store(true);
+  thread_ = make_unique<thread>(&MvccVacuum::thread_func, this);
+  LOG_INFO("mvcc vacuum started. interval=%dms, pages per batch=%d, batch sleep=%dms",
+           options_.interval_ms, options_.pages_per_batch, options_.batch_sleep_ms);
+  return RC::SUCCESS;
+}
+
+RC MvccVacuum::stop()
+{
+  if (!thread_) {
+    return RC::SUCCESS;
+  }
+
+  {
+    lock_guard<mutex> guard(wakeup_lock_);
+    running_.store(false);
+  }
+  wakeup_cv_.notify_one();
+
+  thread_->join();
+  thread_.reset();
+  LOG_INFO("mvcc vacuum stopped");
+  return RC::SUCCESS;
+}
+
+unique_lock<mutex> MvccVacuum::pause() { return unique_lock<mutex>(round_lock_); }
+
+void MvccVacuum::sleep_for(int ms)
+{
+  unique_lock<mutex> guard(wakeup_lock_);
+  wakeup_cv_.wait_for(guard, chrono::milliseconds(ms), [this]() { return !running_.load(); });
+}
+
+void MvccVacuum::thread_func()
+{
+  thread_set_name("MvccVacuum");
+  LOG_INFO("mvcc vacuum thread started");
+
+  while (running_.load()) {
+    sleep_for(options_.interval_ms);
+    if (!running_.load()) {
+      break;
+    }
+
+    vacuum();
+  }
+
+  LOG_INFO("mvcc vacuum thread exit");
+}
+
+int MvccVacuum::vacuum()
+{
+  vector<string> table_names;
+  {
+    lock_guard<mutex> round_guard(round_lock_);
+    db_.all_tables(table_names);
+  }
+
+  int vacuumed_count = 0;
+  for (const string &table_name : table_names) {
+    PageNum start_page = 0;
+    while (start_page != BP_INVALID_PAGE_NUM) {
+      {
+        // 每一批都重新查找表，批次之间表可能已经被删除了
+        lock_guard<mutex> round_guard(round_lock_);
+        Table *table = db_.find_table(table_name.c_str());
+        if (table == nullptr || table->record_handler() == nullptr || table->table_meta().trx_fields().size() < 2) {
+          break;
+        }
+        vacuumed_count += vacuum_table(table, start_page);
+      }
+
+      if (start_page != BP_INVALID_PAGE_NUM && options_.batch_sleep_ms > 0 && running_.load()) {
+        sleep_for(options_.batch_sleep_ms);
+      }
+    }
+  }
+
+  if (vacuumed_count > 0) {
+    LOG_INFO("mvcc vacuum removed %d dead records", vacuumed_count);
+  }
+  return vacuumed_count;
+}
+
+int MvccVacuum::vacuum_table(Table *table, PageNum &start_page)
+{
+  span<const FieldMeta> trx_fields = table->table_meta().trx_fields();
+  Field begin_xid_field(table, &trx_fields[0]);
+  Field end_xid_field(table, &trx_fields[1]);
+
+  // 删除提交时的事务号如果比所有活跃事务都小，这条记录对谁都不可见了
+  const int32_t oldest_trx_id = trx_kit_.oldest_active_trx_id();
+  const int32_t max_trx_id    = trx_kit_.max_trx_id();
+
+  // 扫描时持有页面读锁，不能在这里删除。先把要删除的记录复制出来，索引项的键值需要用到记录的数据
+  vector<Record> dead_records;
+  auto collector = [&](Record &record) {
+    const int32_t begin_xid = begin_xid_field.get_int(record);
+    const int32_t end_xid   = end_xid_field.get_int(record);
+    if (begin_xid > 0 && end_xid > 0 && end_xid != max_trx_id && end_xid < oldest_trx_id) {
+      Record dead_record(record);
+      if (OB_SUCC(dead_record.materialize())) {
+        dead_records.push_back(std::move(dead_record));
+      }
+    }
+  };
+
+  const PageNum batch_start = start_page;
+  RC rc = table->record_handler()->visit_pages(batch_start, options_.pages_per_batch, collector, start_page);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to scan table for vacuum. table=%s, start page=%d, rc=%s", table->name(), batch_start, strrc(rc));
+    start_page = BP_INVALID_PAGE_NUM;
+    return 0;
+  }
+
+  int vacuumed_count = 0;
+  for (Record &record : dead_records) {
+    // 不可见的记录不会再被修改，扫描和删除之间不需要一直持有页面锁
+    rc = table->delete_record(record);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to vacuum record. table=%s, rid=%s, rc=%s",
+               table->name(), record.rid().to_string().c_str(), strrc(rc));
+      continue;
+    }
+    vacuumed_count++;
+  }
+  return vacuumed_count;
+}
@@ -0,0 +1,99 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/atomic.h"
+#include "common/lang/memory.h"
+#include "common/lang/mutex.h"
+#include "common/lang/thread.h"
+#include "common/rc.h"
+#include "common/types.h"
+
+class Db;
+class Table;
+class MvccTrxKit;
+
+/**
+ * @brief 后台回收MVCC删除的记录
+ * @ingroup Transaction
+ * @details MvccTrx 删除记录时只是把 end_xid 设置成提交时的事务号，记录本身和索引项都留在原处，
+ * 表和索引会随着删除和更新不断膨胀，扫描也要跳过越来越多不可见的记录。
+ * MvccVacuum 在后台线程中周期性地扫描所有的表，如果一条记录的删除已经提交，并且 end_xid 小于最老的活跃事务号，
+ * 说明它对当前和以后的所有事务都不可见了，就删除它的索引项，再从页面上删除记录，并更新空闲空间表，
+ * 这样插入时就可以复用这些空间。
+ *
+ * 为了不影响前台请求，每次只扫描 pages_per_batch 个页面，批次之间休眠 batch_sleep_ms 毫秒，并且扫描时只持有页面读锁。
+ * 删除记录和普通的删除一样会记录redo日志。
+ * 记录引用的 TEXT 和向量数据在删除记录时一起释放，向量索引中的数据不会回收。
+ *
+ * 后台线程会和前台线程并发访问页面，所以只在CONCURRENCY编译模式下才会启动。
+ */
+class MvccVacuum
+{
+public:
+  struct Options
+  {
+    bool enabled         = false;
+    int  interval_ms     = 1000;  ///< 两轮回收之间间隔多久
+    int  pages_per_batch = 16;    ///< 每批最多扫描多少个页面
+    int  batch_sleep_ms  = 1;     ///< 每批之后休眠多久，避免长时间占用IO和CPU
+  };
+
+public:
+  MvccVacuum(Db &db, MvccTrxKit &trx_kit);
+  ~MvccVacuum();
+
+  RC start(const Options &options);
+  RC stop();
+
+  bool running() const { return running_.load(); }
+
+  /**
+   * @brief 暂停回收，直到返回的锁被释放
+   * @details 回收时会访问表和索引，创建、删除表或者创建索引时需要确保后台线程没有在处理这张表。
+   */
+  unique_lock<mutex> pause();
+
+  /**
+   * @brief 对所有的表做一轮回收
+   * @details 后台线程调用，测试时也可以直接调用
+   * @return 本轮回收的记录个数
+   */
+  int vacuum();
+
+private:
+  void thread_func();
+
+  /**
+   * @brief 回收一张表中的一批页面
+   * @param start_page 从哪个页面开始，返回时设置为下一批的起始页面，扫描完时为 BP_INVALID_PAGE_NUM
+   * @return 回收的记录个数
+   */
+  int vacuum_table(Table *table, PageNum &start_page);
+
+  /**
+   * @brief 批次之间休眠，stop 时会提前返回
+   */
+  void sleep_for(int ms);
+
+private:
+  Db         &db_;
+  MvccTrxKit &trx_kit_;
+  Options     options_;
+
+  atomic<bool>       running_{false};
+  unique_ptr<thread> thread_;
+
+  mutex              wakeup_lock_;
+  condition_variable wakeup_cv_;
+
+  mutex round_lock_;  ///< 处理每一批页面时都持有这个锁
+};
@@ -147,6 +147,14 @@ public:
   virtual RC delete_record(Table *table, Record &record)                    = 0;
   virtual RC visit_record(Table *table, Record &record, ReadWriteMode mode) = 0;
 
+  /**
+   * @brief 批量判断一组记录是否可见，向量化扫描时使用
+   * @param chunk  一组记录，第 i 列是表中的第 i 个字段(TableMeta::field(i))
+   * @param select 每条记录一个元素，不可见的记录对应的位置清零，已经是0的不再判断
+   * @return 与 visit_record 相同，有冲突时返回 LOCKED_CONCURRENCY_CONFLICT
+   */
+  virtual RC visit_chunk(Table *table, Chunk &chunk, vector<uint8_t> &select, ReadWriteMode mode) = 0;
+
   virtual RC start_if_need() = 0;
   virtual RC commit()        = 0;
   virtual RC rollback()      = 0;
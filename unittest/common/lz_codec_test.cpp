@@ -0,0 +1,133 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+#include <random>
+#include <vector>
+
+#include "common/compress/lz_codec.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace common;
+
+namespace {
+
+/// 压缩再解压，检查结果与原始数据一致，返回压缩后的大小
+int round_trip(const vector<char> &data)
+{
+  vector<char> compressed(LzCodec::compress_bound(static_cast<int>(data.size())));
+  int compressed_size = LzCodec::compress(data.data(), static_cast<int>(data.size()), compressed.data(),
+      static_cast<int>(compressed.size()));
+  EXPECT_GT(compressed_size, 0);
+
+  vector<char> decompressed(data.size() + 1);
+  int decompressed_size = LzCodec::decompress(compressed.data(), compressed_size, decompressed.data(),
+      static_cast<int>(decompressed.size()));
+  EXPECT_EQ(static_cast<int>(data.size()), decompressed_size);
+  EXPECT_EQ(0, memcmp(data.data(), decompressed.data(), data.size()));
+  return compressed_size;
+}
+
+}  // namespace
+
+TEST(LzCodec, round_trip)
+{
+  // 很短的数据只有字面量
+  ASSERT_EQ(4, round_trip(vector<char>{'a', 'b', 'c'}));
+
+  // 全是0
+  vector<char> zeros(8192, 0);
+  ASSERT_LT(round_trip(zeros), 64);
+
+  // 像页面中的定长记录一样：小整数加上补了很多空格的字符串
+  vector<char> records;
+  for (int i = 0; records.size() < 8000; i++) {
+    int32_t id = i;
+    records.insert(records.end(), reinterpret_cast<char *>(&id), reinterpret_cast<char *>(&id) + sizeof(id));
+    string name = "name" + to_string(i);
+    name.resize(32, ' ');
+    records.insert(records.end(), name.begin(), name.end());
+  }
+  ASSERT_LT(round_trip(records), static_cast<int>(records.size()) / 3);
+
+  // 重叠的匹配，以及长度超过255的字面量和匹配
+  vector<char> runs;
+  mt19937      random_generator(0);
+  for (int i = 0; i < 300; i++) {
+    runs.push_back(static_cast<char>(random_generator()));
+  }
+  runs.insert(runs.end(), 1000, 'x');
+  runs.insert(runs.end(), runs.begin(), runs.begin() + 500);
+  round_trip(runs);
+
+  // 随机数据压缩不了，但是也不会超过 compress_bound
+  vector<char> random_data(8192);
+  for (char &c : random_data) {
+    c = static_cast<char>(random_generator());
+  }
+  ASSERT_LE(round_trip(random_data), LzCodec::compress_bound(8192));
+}
+
+TEST(LzCodec, capacity)
+{
+  vector<char> random_data(4096);
+  mt19937      random_generator(1);
+  for (char &c : random_data) {
+    c = static_cast<char>(random_generator());
+  }
+
+  // 压缩结果放不下时放弃压缩
+  vector<char> compressed(4096);
+  ASSERT_EQ(-1, LzCodec::compress(random_data.data(), 4096, compressed.data(), 2048));
+
+  vector<char> zeros(4096, 0);
+  int compressed_size = LzCodec::compress(zeros.data(), 4096, compressed.data(), 4096);
+  ASSERT_GT(compressed_size, 0);
+
+  // 解压结果放不下
+  vector<char> decompressed(4096);
+  ASSERT_EQ(-1, LzCodec::decompress(compressed.data(), compressed_size, decompressed.data(), 4095));
+  ASSERT_EQ(4096, LzCodec::decompress(compressed.data(), compressed_size, decompressed.data(), 4096));
+}
+
+TEST(LzCodec, corrupted)
+{
+  vector<char> data(8192);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<char>(i % 97);
+  }
+  vector<char> compressed(LzCodec::compress_bound(8192));
+  int compressed_size = LzCodec::compress(data.data(), 8192, compressed.data(), static_cast<int>(compressed.size()));
+  ASSERT_GT(compressed_size, 0);
+
+  // 截断的数据
+  vector<char> decompressed(8192);
+  for (int size = 1; size < compressed_size; size++) {
+    ASSERT_NE(8192, LzCodec::decompress(compressed.data(), size, decompressed.data(), 8192));
+  }
+
+  // 随机修改一些字节，不能越界读写(配合 sanitizer 检查)
+  mt19937 random_generator(2);
+  for (int i = 0; i < 1000; i++) {
+    vector<char> broken(compressed.begin(), compressed.begin() + compressed_size);
+    for (int j = 0; j < 3; j++) {
+      broken[random_generator() % compressed_size] = static_cast<char>(random_generator());
+    }
+    int ret = LzCodec::decompress(broken.data(), compressed_size, decompressed.data(), 8192);
+    ASSERT_LE(ret, 8192);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,85 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <thread>
+#include <vector>
+
+#include "common/metrics/metrics.h"
+#include "common/metrics/metrics_registry.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace common;
+
+TEST(Metrics, counter)
+{
+  Counter counter;
+  ASSERT_EQ(nullptr, counter.get_snapshot());
+
+  vector<thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&counter]() {
+      for (int j = 0; j < 10000; j++) {
+        counter.inc();
+      }
+    });
+  }
+  for (thread &t : threads) {
+    t.join();
+  }
+  ASSERT_EQ(40000, counter.value());
+
+  // 快照不会清零
+  counter.snapshot();
+  ASSERT_EQ("40000", counter.get_snapshot()->to_string());
+  ASSERT_EQ(40000, counter.value());
+}
+
+TEST(Metrics, latency_histogram)
+{
+  LatencyHistogram histogram;
+  ASSERT_EQ(0, histogram.percentile(0.5));
+  ASSERT_EQ(0.0, histogram.mean());
+
+  // 1..100 各一次，中位数50落在 [32, 64) 桶中，p99 是99，落在 [64, 128) 桶中，但是不会超过最大值
+  for (long i = 1; i <= 100; i++) {
+    histogram.update(i);
+  }
+  ASSERT_EQ(100, histogram.count());
+  ASSERT_EQ(5050, histogram.sum());
+  ASSERT_EQ(100, histogram.max());
+  ASSERT_DOUBLE_EQ(50.5, histogram.mean());
+  ASSERT_EQ(63, histogram.percentile(0.5));
+  ASSERT_EQ(100, histogram.percentile(0.99));
+  ASSERT_EQ(1, histogram.percentile(0));
+
+  histogram.update(0);
+  histogram.update(-1);
+  ASSERT_EQ(0, histogram.percentile(0));
+
+  histogram.snapshot();
+  ASSERT_NE(nullptr, histogram.get_snapshot());
+}
+
+TEST(Metrics, registry)
+{
+  MetricsRegistry registry;
+  Counter         counter;
+  registry.register_metric("counter", &counter);
+  registry.snapshot();
+  ASSERT_NE(nullptr, counter.get_snapshot());
+  registry.unregister("counter");
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
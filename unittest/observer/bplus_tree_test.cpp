@@ -0,0 +1,241 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <atomic>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/double_write_buffer.h"
+#include "storage/clog/vacuous_log_handler.h"
+#include "storage/index/bplus_tree.h"
+
+using namespace std;
+using namespace common;
+
+namespace {
+
+vector<IndexUserKey> make_user_keys(int value)
+{
+  char key[KEY_NULL_BYTE + sizeof(value)];
+  memset(key, 0, KEY_NULL_BYTE);
+  memcpy(key + KEY_NULL_BYTE, &value, sizeof(value));
+  return vector<IndexUserKey>{IndexUserKey(key, sizeof(key))};
+}
+
+RID make_rid(int value) { return RID(value / 100 + 1, value % 100); }
+
+bool find_key(BplusTreeHandler &handler, int value)
+{
+  list<RID> rids;
+  RC        rc = RC::SUCCESS;
+  // 扫描器移动到下一个叶子节点时只会尝试加锁，加锁失败需要调用者重试
+  do {
+    rids.clear();
+    rc = handler.get_entry(make_user_keys(value), rids);
+  } while (rc == RC::LOCKED_NEED_WAIT);
+
+  if (OB_FAIL(rc) || rids.size() != 1) {
+    return false;
+  }
+  return rids.front() == make_rid(value);
+}
+
+}  // namespace
+
+TEST(Frame, version)
+{
+  Frame frame;
+  frame.pin();
+
+  const uint64_t version = frame.version();
+  ASSERT_EQ(0, version % 2);
+
+  frame.write_latch();
+  ASSERT_EQ(1, frame.version() % 2);
+  ASSERT_FALSE(frame.validate_version(version));
+
+  // 重入写锁不会再修改版本号
+  frame.write_latch();
+  const uint64_t latched_version = frame.version();
+  frame.write_unlatch();
+  ASSERT_EQ(latched_version, frame.version());
+
+  frame.write_unlatch();
+  ASSERT_EQ(version + 2, frame.version());
+
+  // 读锁不修改页面
+  frame.read_latch();
+  frame.read_unlatch();
+  ASSERT_TRUE(frame.validate_version(version + 2));
+  frame.unpin();
+}
+
+TEST(BplusTreeHandler, optimistic_find_leaf)
+{
+  const char *index_file = "bplus_tree_optimistic.index";
+  ::remove(index_file);
+
+  VacuousLogHandler log_handler;
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+
+  BplusTreeHandler handler;
+  ASSERT_EQ(RC::SUCCESS,
+      handler.create(log_handler, bpm, index_file, vector<AttrType>{AttrType::INTS}, vector<int>{4},
+          false /*is_unique*/, 4 /*internal_max_size*/, 4 /*leaf_max_size*/));
+
+  // 空树
+  ASSERT_FALSE(find_key(handler, 0));
+
+  const int key_num = 1000;
+  for (int i = 0; i < key_num; i++) {
+    RID rid = make_rid(i);
+    ASSERT_EQ(RC::SUCCESS, handler.insert_entry(make_user_keys(i), &rid));
+  }
+
+  for (int i = 0; i < key_num; i++) {
+    ASSERT_TRUE(find_key(handler, i)) << "key=" << i;
+  }
+  ASSERT_FALSE(find_key(handler, key_num));
+
+  for (int i = 0; i < key_num; i += 2) {
+    RID rid = make_rid(i);
+    ASSERT_EQ(RC::SUCCESS, handler.delete_entry(make_user_keys(i), &rid));
+  }
+  for (int i = 0; i < key_num; i++) {
+    ASSERT_EQ(i % 2 != 0, find_key(handler, i)) << "key=" << i;
+  }
+  ASSERT_TRUE(handler.validate_tree());
+
+  ASSERT_EQ(RC::SUCCESS, handler.close());
+  ::remove(index_file);
+}
+
+TEST(BplusTreeHandler, insert_entries)
+{
+  const char *index_file = "bplus_tree_insert_entries.index";
+  ::remove(index_file);
+
+  VacuousLogHandler log_handler;
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+
+  BplusTreeHandler handler;
+  ASSERT_EQ(RC::SUCCESS,
+      handler.create(log_handler, bpm, index_file, vector<AttrType>{AttrType::INTS}, vector<int>{4},
+          true /*is_unique*/, 4 /*internal_max_size*/, 4 /*leaf_max_size*/));
+
+  // 乱序的一批键值
+  const int                    key_num = 1000;
+  vector<vector<IndexUserKey>> user_keys_list;
+  vector<RID>                  rids;
+  for (int i = 0; i < key_num; i++) {
+    const int value = (i * 7919) % key_num;
+    user_keys_list.push_back(make_user_keys(value));
+    rids.push_back(make_rid(value));
+  }
+  ASSERT_EQ(RC::SUCCESS, handler.insert_entries(user_keys_list, rids));
+  for (int i = 0; i < key_num; i++) {
+    ASSERT_TRUE(find_key(handler, i)) << "key=" << i;
+  }
+
+  // 有重复键值时整批都不插入
+  user_keys_list.clear();
+  rids.clear();
+  for (int value : {key_num + 2, key_num + 1, 10, key_num}) {
+    user_keys_list.push_back(make_user_keys(value));
+    rids.push_back(make_rid(value));
+  }
+  ASSERT_EQ(RC::RECORD_DUPLICATE_KEY, handler.insert_entries(user_keys_list, rids));
+  ASSERT_FALSE(find_key(handler, key_num));
+  ASSERT_FALSE(find_key(handler, key_num + 1));
+  ASSERT_FALSE(find_key(handler, key_num + 2));
+  ASSERT_TRUE(find_key(handler, 10));
+  ASSERT_TRUE(handler.validate_tree());
+
+  ASSERT_EQ(RC::SUCCESS, handler.close());
+  ::remove(index_file);
+}
+
+#ifdef CONCURRENCY
+TEST(BplusTreeHandler, concurrent_read_write)
+{
+  const char *index_file = "bplus_tree_concurrent.index";
+  ::remove(index_file);
+
+  VacuousLogHandler log_handler;
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+
+  BplusTreeHandler handler;
+  ASSERT_EQ(RC::SUCCESS,
+      handler.create(log_handler, bpm, index_file, vector<AttrType>{AttrType::INTS}, vector<int>{4},
+          false /*is_unique*/, 4 /*internal_max_size*/, 4 /*leaf_max_size*/));
+
+  // 偶数一直在树中，奇数被写线程不停地插入和删除，让节点不停地分裂和合并
+  const int key_num = 2000;
+  for (int i = 0; i < key_num; i += 2) {
+    RID rid = make_rid(i);
+    ASSERT_EQ(RC::SUCCESS, handler.insert_entry(make_user_keys(i), &rid));
+  }
+
+  atomic<bool> stop{false};
+  atomic<int>  missing{0};
+
+  vector<thread> readers;
+  for (int t = 0; t < 4; t++) {
+    readers.emplace_back([&, t]() {
+      while (!stop.load()) {
+        for (int i = t * 2; i < key_num; i += 8) {
+          if (!find_key(handler, i)) {
+            missing.fetch_add(1);
+          }
+        }
+      }
+    });
+  }
+
+  // 读线程还没有结束时不能用 ASSERT 提前返回，否则 thread 析构时会直接终止进程
+  int write_failed = 0;
+  for (int round = 0; round < 5 && write_failed == 0; round++) {
+    for (int i = 1; i < key_num; i += 2) {
+      RID rid = make_rid(i);
+      RC  rc  = handler.insert_entry(make_user_keys(i), &rid);
+      EXPECT_EQ(RC::SUCCESS, rc);
+      write_failed += OB_FAIL(rc) ? 1 : 0;
+    }
+    for (int i = 1; i < key_num; i += 2) {
+      RID rid = make_rid(i);
+      RC  rc  = handler.delete_entry(make_user_keys(i), &rid);
+      EXPECT_EQ(RC::SUCCESS, rc);
+      write_failed += OB_FAIL(rc) ? 1 : 0;
+    }
+  }
+
+  stop.store(true);
+  for (thread &reader : readers) {
+    reader.join();
+  }
+
+  ASSERT_EQ(0, write_failed);
+  ASSERT_EQ(0, missing.load());
+  ASSERT_TRUE(handler.validate_tree());
+
+  ASSERT_EQ(RC::SUCCESS, handler.close());
+  ::remove(index_file);
+}
+#endif  // CONCURRENCY
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,89 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <filesystem>
+
+#include "gtest/gtest.h"
+#include "storage/buffer/buffer_pool_warmer.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/double_write_buffer.h"
+#include "storage/clog/vacuous_log_handler.h"
+
+using namespace std;
+using namespace common;
+
+TEST(BufferPoolWarmer, dump_and_load)
+{
+  filesystem::path directory("buffer_pool_warmer");
+  filesystem::remove_all(directory);
+  filesystem::create_directories(directory);
+
+  filesystem::path buffer_pool_filename = directory / "buffer_pool.bp";
+  filesystem::path dump_filename        = directory / "buffer_pool.dump";
+
+  VacuousLogHandler log_handler;
+  const int         page_num = 50;
+  {
+    BufferPoolManager buffer_pool_manager;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.init(make_unique<VacuousDoubleWriteBuffer>()));
+    ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.create_file(buffer_pool_filename.c_str()));
+    DiskBufferPool *buffer_pool = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+
+    for (int i = 0; i < page_num; i++) {
+      Frame *frame = nullptr;
+      ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+      frame->mark_dirty();
+      ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+    }
+
+    // 只有偶数页面还在内存中
+    for (PageNum i = 1; i <= page_num; i += 2) {
+      ASSERT_EQ(RC::SUCCESS, buffer_pool->purge_page(i));
+    }
+
+    ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.warmer().dump(dump_filename.c_str()));
+    ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.close_file(buffer_pool_filename.c_str()));
+  }
+
+  BufferPoolManager buffer_pool_manager;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.init(make_unique<VacuousDoubleWriteBuffer>()));
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+
+  BPFrameManager &frame_manager = buffer_pool_manager.get_frame_manager();
+  ASSERT_FALSE(frame_manager.contains(buffer_pool->id(), 2));
+
+  BufferPoolWarmer &warmer = buffer_pool_manager.warmer();
+  ASSERT_EQ(RC::SUCCESS, warmer.load(dump_filename.c_str()));
+
+  BufferPoolWarmer::Progress progress = warmer.progress();
+  ASSERT_FALSE(progress.loading);
+  ASSERT_EQ(page_num / 2, progress.total_pages);
+  ASSERT_EQ(page_num / 2, progress.done_pages);
+  ASSERT_EQ(page_num / 2, progress.loaded_pages);
+
+  for (PageNum i = 1; i <= page_num; i++) {
+    ASSERT_EQ(i % 2 == 0, frame_manager.contains(buffer_pool->id(), i));
+  }
+
+  // 文件没有打开时跳过
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.close_file(buffer_pool_filename.c_str()));
+  ASSERT_EQ(RC::SUCCESS, warmer.load(dump_filename.c_str()));
+  progress = warmer.progress();
+  ASSERT_EQ(page_num / 2, progress.done_pages);
+  ASSERT_EQ(0, progress.loaded_pages);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
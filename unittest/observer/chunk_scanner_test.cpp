@@ -0,0 +1,127 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "pax_table_test_util.h"
+#include "sql/expr/expression.h"
+#include "storage/db/db.h"
+#include "storage/record/record_manager.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief 使用 chunk scanner 扫描表，返回记录数
+ */
+int scan(Table *table, Trx *trx, vector<Expression *> predicates = {})
+{
+  ChunkFileScanner scanner;
+  EXPECT_EQ(RC::SUCCESS, table->get_chunk_scanner(scanner, trx, ReadWriteMode::READ_ONLY));
+  scanner.set_predicates(std::move(predicates));
+
+  const TableMeta &table_meta = table->table_meta();
+  const FieldMeta *a_meta     = table_meta.field("a");
+  Chunk            chunk;
+  chunk.add_column(make_unique<Column>(*a_meta), a_meta->field_id());
+
+  int rows = 0;
+  RC  rc   = RC::SUCCESS;
+  while (OB_SUCC(rc = scanner.next_chunk(chunk))) {
+    EXPECT_GT(chunk.rows(), 0);
+    rows += chunk.rows();
+    chunk.reset_data();
+  }
+  EXPECT_EQ(RC::RECORD_EOF, rc);
+  scanner.close_scan();
+  return rows;
+}
+
+}  // namespace
+
+TEST(ChunkFileScanner, mvcc_and_predicates)
+{
+  filesystem::path test_directory("chunk_scanner_test");
+  unique_ptr<Db>   db;
+  Table           *table = nullptr;
+  create_pax_test_table(test_directory, db, table);
+  ASSERT_FALSE(HasFatalFailure());
+
+  TrxKit &trx_kit = db->trx_kit();
+
+  Trx *insert_trx = trx_kit.create_trx(db->log_handler());
+  ASSERT_EQ(RC::SUCCESS, insert_trx->start_if_need());
+  insert_pax_test_records(table, insert_trx, 0, 1000);
+  ASSERT_EQ(RC::SUCCESS, insert_trx->commit());
+  trx_kit.destroy_trx(insert_trx);
+
+  // 没有提交的记录只对自己可见
+  Trx *uncommitted_trx = trx_kit.create_trx(db->log_handler());
+  ASSERT_EQ(RC::SUCCESS, uncommitted_trx->start_if_need());
+  insert_pax_test_records(table, uncommitted_trx, 1000, 1100);
+
+  Trx *read_trx = trx_kit.create_trx(db->log_handler());
+  ASSERT_EQ(RC::SUCCESS, read_trx->start_if_need());
+  ASSERT_EQ(1000, scan(table, read_trx));
+  ASSERT_EQ(1100, scan(table, uncommitted_trx));
+
+  // 过滤条件与可见性一起判断
+  const FieldMeta *a_meta = table->table_meta().field("a");
+  const FieldMeta *b_meta = table->table_meta().field("b");
+  ComparisonExpr   b_equal(
+      CompOp::EQUAL_TO, make_unique<FieldExpr>(table, b_meta), make_unique<ValueExpr>(Value(3)));
+  ASSERT_EQ(100, scan(table, read_trx, {&b_equal}));
+  ASSERT_EQ(110, scan(table, uncommitted_trx, {&b_equal}));
+
+  ComparisonExpr a_less(
+      CompOp::LESS_THAN, make_unique<FieldExpr>(table, a_meta), make_unique<ValueExpr>(Value(500)));
+  ASSERT_EQ(50, scan(table, read_trx, {&b_equal, &a_less}));
+
+  // b = 3 OR a >= 990
+  vector<unique_ptr<Expression>> children;
+  children.push_back(make_unique<ComparisonExpr>(
+      CompOp::EQUAL_TO, make_unique<FieldExpr>(table, b_meta), make_unique<ValueExpr>(Value(3))));
+  children.push_back(make_unique<ComparisonExpr>(
+      CompOp::GREAT_EQUAL, make_unique<FieldExpr>(table, a_meta), make_unique<ValueExpr>(Value(990))));
+  ConjunctionExpr or_expr(ConjunctionExpr::Type::OR, children);
+  ASSERT_EQ(109, scan(table, read_trx, {&or_expr}));
+
+  // 条件不满足的时候不返回空的 chunk
+  ComparisonExpr a_none(
+      CompOp::GREAT_THAN, make_unique<FieldExpr>(table, a_meta), make_unique<ValueExpr>(Value(5000)));
+  ASSERT_EQ(0, scan(table, read_trx, {&a_none}));
+
+  ASSERT_EQ(RC::SUCCESS, uncommitted_trx->commit());
+  trx_kit.destroy_trx(uncommitted_trx);
+  ASSERT_EQ(RC::SUCCESS, read_trx->commit());
+  trx_kit.destroy_trx(read_trx);
+
+  Trx *new_trx = trx_kit.create_trx(db->log_handler());
+  ASSERT_EQ(RC::SUCCESS, new_trx->start_if_need());
+  ASSERT_EQ(1100, scan(table, new_trx));
+  ASSERT_EQ(110, scan(table, new_trx, {&b_equal}));
+  ASSERT_EQ(RC::SUCCESS, new_trx->commit());
+  trx_kit.destroy_trx(new_trx);
+
+  db.reset();
+  filesystem::remove_all(test_directory);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
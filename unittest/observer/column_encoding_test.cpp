@@ -0,0 +1,187 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+#include <vector>
+
+#include "storage/record/column_encoding.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief 编码以后检查每个值都能正确地还原
+ */
+void check_round_trip(
+    AttrType attr_type, int attr_len, const vector<char> &values, ColumnEncoding expected_encoding)
+{
+  const int count        = static_cast<int>(values.size()) / attr_len;
+  int       encoded_size = 0;
+  ASSERT_EQ(expected_encoding, ColumnEncoder::choose(attr_type, attr_len, values.data(), count, encoded_size));
+  if (expected_encoding == ColumnEncoding::PLAIN) {
+    ASSERT_EQ(static_cast<int>(values.size()), encoded_size);
+    return;
+  }
+  ASSERT_LT(encoded_size, static_cast<int>(values.size()));
+
+  vector<char> encoded(encoded_size);
+  ColumnEncoder::encode(expected_encoding, attr_type, attr_len, values.data(), count, encoded.data());
+
+  EncodedColumn column(expected_encoding, attr_len, encoded.data());
+  ASSERT_EQ(count, column.count());
+
+  vector<char> decoded(values.size());
+  column.decode(0, count, decoded.data());
+  ASSERT_EQ(values, decoded);
+
+  // 从中间开始解码
+  column.decode(count / 3, count - count / 3, decoded.data());
+  ASSERT_EQ(0, memcmp(values.data() + count / 3 * attr_len, decoded.data(), (count - count / 3) * attr_len));
+
+  vector<char> value(attr_len);
+  for (int i = 0; i < count; i++) {
+    column.get(i, value.data());
+    ASSERT_EQ(0, memcmp(values.data() + i * attr_len, value.data(), attr_len));
+    ASSERT_TRUE(column.equal_to(i, values.data() + i * attr_len));
+  }
+}
+
+vector<char> make_ints(const vector<int> &ints)
+{
+  vector<char> values(ints.size() * sizeof(int));
+  memcpy(values.data(), ints.data(), values.size());
+  return values;
+}
+
+}  // namespace
+
+TEST(ColumnEncoding, choose_and_round_trip)
+{
+  const int count = 1000;
+
+  // 连续相同的值
+  vector<int> ints(count);
+  for (int i = 0; i < count; i++) {
+    ints[i] = i / 100;
+  }
+  check_round_trip(AttrType::INTS, sizeof(int), make_ints(ints), ColumnEncoding::RLE);
+
+  // 取值范围很小的非负整数
+  for (int i = 0; i < count; i++) {
+    ints[i] = (i * 7) % 13;
+  }
+  check_round_trip(AttrType::INTS, sizeof(int), make_ints(ints), ColumnEncoding::BIT_PACKING);
+
+  // 有负数或者离0很远的整数
+  for (int i = 0; i < count; i++) {
+    ints[i] = -1000000 + (i * 31) % 1000;
+  }
+  check_round_trip(AttrType::INTS, sizeof(int), make_ints(ints), ColumnEncoding::FRAME_OF_REFERENCE);
+  for (int i = 0; i < count; i++) {
+    ints[i] = 1 << 30 | (i * 31) % 1000;
+  }
+  check_round_trip(AttrType::INTS, sizeof(int), make_ints(ints), ColumnEncoding::FRAME_OF_REFERENCE);
+
+  // 取值很少的字符串
+  const int    str_len = 16;
+  vector<char> strs(count * str_len, 0);
+  const char  *words[] = {"apple", "banana", "cherry"};
+  for (int i = 0; i < count; i++) {
+    strcpy(strs.data() + i * str_len, words[(i * 7) % 3]);
+  }
+  check_round_trip(AttrType::CHARS, str_len, strs, ColumnEncoding::DICTIONARY);
+
+  // 所有的值都不一样，没有办法压缩
+  vector<float> floats(count);
+  for (int i = 0; i < count; i++) {
+    floats[i] = i * 1.5f - 100;
+  }
+  vector<char> float_values(count * sizeof(float));
+  memcpy(float_values.data(), floats.data(), float_values.size());
+  check_round_trip(AttrType::FLOATS, sizeof(float), float_values, ColumnEncoding::PLAIN);
+
+  // 相同的值只需要0位
+  ints.assign(count, 42);
+  check_round_trip(AttrType::INTS, sizeof(int), make_ints(ints), ColumnEncoding::RLE);
+  check_round_trip(AttrType::INTS, sizeof(int), make_ints({INT32_MIN, INT32_MAX, INT32_MIN, INT32_MAX}),
+      ColumnEncoding::PLAIN);
+}
+
+TEST(ColumnEncoding, extreme_values)
+{
+  // 差值需要32位
+  vector<int> ints;
+  for (int i = 0; i < 100; i++) {
+    ints.push_back(i % 2 == 0 ? INT32_MIN : INT32_MAX);
+  }
+  const vector<char> values = make_ints(ints);
+  for (ColumnEncoding encoding : {ColumnEncoding::FRAME_OF_REFERENCE, ColumnEncoding::DICTIONARY}) {
+    vector<char> encoded(values.size() * 2);
+    ColumnEncoder::encode(encoding, AttrType::INTS, sizeof(int), values.data(), 100, encoded.data());
+    EncodedColumn column(encoding, sizeof(int), encoded.data());
+    vector<char>  decoded(values.size());
+    column.decode(0, 100, decoded.data());
+    ASSERT_EQ(values, decoded);
+  }
+}
+
+TEST(ColumnEncoding, filter)
+{
+  const int   count = 1000;
+  vector<int> ints(count);
+  for (int i = 0; i < count; i++) {
+    ints[i] = i % 10 < 5 ? i / 50 : i / 3 % 20 - 5;
+  }
+  const vector<char> values = make_ints(ints);
+
+  const CompOp ops[] = {
+      CompOp::EQUAL_TO, CompOp::NOT_EQUAL, CompOp::LESS_THAN, CompOp::LESS_EQUAL, CompOp::GREAT_THAN, CompOp::GREAT_EQUAL};
+  for (ColumnEncoding encoding : {ColumnEncoding::DICTIONARY, ColumnEncoding::RLE, ColumnEncoding::FRAME_OF_REFERENCE}) {
+    vector<char> encoded(values.size() * 2);
+    ColumnEncoder::encode(encoding, AttrType::INTS, sizeof(int), values.data(), count, encoded.data());
+    EncodedColumn column(encoding, sizeof(int), encoded.data());
+
+    for (CompOp op : ops) {
+      for (int constant : {-6, -5, 0, 7, 14, 19, 100}) {
+        vector<uint8_t> select(count, 1);
+        select[3] = 0;  // 已经被过滤掉的不会再选中
+        ASSERT_TRUE(column.filter(AttrType::INTS, op, Value(constant), select.data()));
+        for (int i = 0; i < count; i++) {
+          bool expected = false;
+          switch (op) {
+            case CompOp::EQUAL_TO: expected = ints[i] == constant; break;
+            case CompOp::NOT_EQUAL: expected = ints[i] != constant; break;
+            case CompOp::LESS_THAN: expected = ints[i] < constant; break;
+            case CompOp::LESS_EQUAL: expected = ints[i] <= constant; break;
+            case CompOp::GREAT_THAN: expected = ints[i] > constant; break;
+            case CompOp::GREAT_EQUAL: expected = ints[i] >= constant; break;
+            default: break;
+          }
+          ASSERT_EQ(i != 3 && expected, select[i] != 0)
+              << "encoding=" << column_encoding_name(encoding) << ", i=" << i << ", constant=" << constant;
+        }
+      }
+    }
+
+    // 不同的类型不能直接比较
+    vector<uint8_t> select(count, 1);
+    ASSERT_FALSE(column.filter(AttrType::INTS, CompOp::EQUAL_TO, Value(1.0f), select.data()));
+    ASSERT_FALSE(column.filter(AttrType::INTS, CompOp::IS, Value(1), select.data()));
+    ASSERT_EQ(vector<uint8_t>(count, 1), select);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -12,13 +12,17 @@ See the Mulan PSL v2 for more details. */
 // Created by wangyunlai on 2024/02/01
 //
 
+#include <sys/stat.h>
 #include <filesystem>
+#include <fstream>
+#include <random>
 
 #include "gtest/gtest.h"
 #include "common/log/log.h"
 #include "storage/buffer/disk_buffer_pool.h"
 #include "storage/clog/vacuous_log_handler.h"
 #include "storage/buffer/double_write_buffer.h"
+#include "storage/buffer/page_compressor.h"
 
 using namespace std;
 using namespace common;
@@ -105,6 +109,67 @@ TEST(DiskBufferPool, allocate_dispose)
   ASSERT_EQ(buffer_pool_manager.close_file(buffer_pool_filename.c_str()), RC::SUCCESS);
 }
 
+TEST(DiskBufferPool, space_map)
+{
+  // 超过一个位图能管理的页面，需要扩展出第二个位图页面
+  filesystem::path directory("buffer_pool");
+  filesystem::remove_all(directory);
+  filesystem::create_directories(directory);
+
+  filesystem::path buffer_pool_filename = directory / "space_map.bp";
+
+  BufferPoolManager buffer_pool_manager;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.init(make_unique<VacuousDoubleWriteBuffer>()));
+
+  VacuousLogHandler log_handler;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.create_file(buffer_pool_filename.c_str()));
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+
+  const PageNum map_page_num = BPFileHeader::PAGES_PER_SPACE_MAP;
+  const int     page_num     = map_page_num + 10;
+  for (int i = 0; i < page_num; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+    ASSERT_NE(map_page_num, frame->page_num());
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  }
+
+  // 位图页面不会被遍历出来，也不能释放
+  ASSERT_EQ(page_num, buffer_pool_page_count(buffer_pool));
+  ASSERT_EQ(map_page_num + 1, buffer_pool->next_allocated_page(map_page_num));
+  ASSERT_NE(RC::SUCCESS, buffer_pool->dispose_page(map_page_num));
+
+  // 优先复用前面的组中的空闲页面
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->dispose_page(map_page_num + 5));
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->dispose_page(7));
+  ASSERT_EQ(page_num - 2, buffer_pool_page_count(buffer_pool));
+
+  Frame *frame = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+  ASSERT_EQ(7, frame->page_num());
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+  ASSERT_EQ(map_page_num + 5, frame->page_num());
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+
+  // 重新打开文件，位图页面从磁盘加载
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->dispose_page(map_page_num + 3));
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.close_file(buffer_pool_filename.c_str()));
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+  ASSERT_EQ(page_num - 1, buffer_pool_page_count(buffer_pool));
+
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+  ASSERT_EQ(map_page_num + 3, frame->page_num());
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+  ASSERT_EQ(page_num + 2, frame->page_num());  // 文件头和位图页面之后
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.close_file(buffer_pool_filename.c_str()));
+  filesystem::remove_all(directory);
+}
+
 TEST(BufferPool, create)
 {
   filesystem::path test_directory("buffer_pool");
@@ -132,6 +197,272 @@ TEST(BufferPool, create)
   ASSERT_EQ(buffer_pool->id(), buffer_pool2->id());
 }
 
+TEST(DiskBufferPool, read_ahead)
+{
+  filesystem::path directory("buffer_pool");
+  filesystem::remove_all(directory);
+  filesystem::create_directories(directory);
+
+  filesystem::path buffer_pool_filename = directory / "read_ahead.bp";
+
+  BufferPoolManager buffer_pool_manager;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.init(make_unique<VacuousDoubleWriteBuffer>()));
+
+  VacuousLogHandler log_handler;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.create_file(buffer_pool_filename.c_str()));
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+
+  const int page_num = 30;
+  for (int i = 0; i < page_num; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+    memcpy(frame->data(), &i, sizeof(i));
+    frame->mark_dirty();
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  }
+
+  // 重新打开文件，所有的数据页面都不在内存中
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.close_file(buffer_pool_filename.c_str()));
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+
+  const int window = 8;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.init_read_ahead(window));
+
+  BPFrameManager    &frame_manager = buffer_pool_manager.get_frame_manager();
+  BufferPoolIterator iterator;
+  ASSERT_EQ(RC::SUCCESS, iterator.init(*buffer_pool, 1));
+
+  // 只访问一个页面不会预读
+  ASSERT_EQ(1, iterator.next());
+  buffer_pool->wait_read_ahead();
+  ASSERT_FALSE(frame_manager.contains(buffer_pool->id(), 2));
+
+  // 连续访问后预读后面一个窗口的页面
+  ASSERT_EQ(2, iterator.next());
+  buffer_pool->wait_read_ahead();
+  for (PageNum i = 3; i < 3 + window; i++) {
+    ASSERT_TRUE(frame_manager.contains(buffer_pool->id(), i));
+  }
+  ASSERT_FALSE(frame_manager.contains(buffer_pool->id(), 3 + window));
+
+  // 访问到预读的第一个页面时，预读下一个窗口
+  ASSERT_EQ(3, iterator.next());
+  buffer_pool->wait_read_ahead();
+  ASSERT_TRUE(frame_manager.contains(buffer_pool->id(), 3 + window));
+
+  for (PageNum i = 3; i < 3 + window * 2; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(i, &frame));
+    int value = -1;
+    memcpy(&value, frame->data(), sizeof(value));
+    ASSERT_EQ(i - 1, value);  // 第0页是文件头，数据页面从1开始
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  }
+
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.close_file(buffer_pool_filename.c_str()));
+}
+
+TEST(DiskBufferPool, direct_io)
+{
+  filesystem::path directory("buffer_pool");
+  filesystem::remove_all(directory);
+  filesystem::create_directories(directory);
+
+  filesystem::path buffer_pool_filename = directory / "direct_io.bp";
+  filesystem::path dblwr_filename       = directory / "direct_io.dblwr";
+
+  BufferPoolManager buffer_pool_manager;
+  buffer_pool_manager.set_direct_io(true);
+
+  // double write buffer 中的页面内存没有对齐，写回数据文件时需要复制到对齐的内存中
+  auto dblwr_buffer = make_unique<DiskDoubleWriteBuffer>(buffer_pool_manager);
+  ASSERT_EQ(RC::SUCCESS, dblwr_buffer->open_file(dblwr_filename.c_str()));
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.init(std::move(dblwr_buffer)));
+
+  VacuousLogHandler log_handler;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.create_file(buffer_pool_filename.c_str()));
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+  if (!buffer_pool->direct_io()) {
+    ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.close_file(buffer_pool_filename.c_str()));
+    GTEST_SKIP() << "file system does not support O_DIRECT";
+  }
+
+  const int page_num = 10;
+  for (int i = 0; i < page_num; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+    ASSERT_EQ(0, reinterpret_cast<uintptr_t>(&frame->page()) % BP_IO_ALIGN);
+    memcpy(frame->data(), &i, sizeof(i));
+    frame->mark_dirty();
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  }
+
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.close_file(buffer_pool_filename.c_str()));
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+  ASSERT_TRUE(buffer_pool->direct_io());
+
+  for (PageNum i = 1; i <= page_num; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(i, &frame));
+    int value = -1;
+    memcpy(&value, frame->data(), sizeof(value));
+    ASSERT_EQ(i - 1, value);
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  }
+
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.close_file(buffer_pool_filename.c_str()));
+}
+
+TEST(DiskBufferPool, page_compression)
+{
+  filesystem::path directory("buffer_pool");
+  filesystem::remove_all(directory);
+  filesystem::create_directories(directory);
+
+  filesystem::path buffer_pool_filename = directory / "compression.bp";
+
+  BufferPoolManager buffer_pool_manager;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.init(make_unique<VacuousDoubleWriteBuffer>()));
+
+  VacuousLogHandler log_handler;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.create_file(buffer_pool_filename.c_str()));
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+  buffer_pool->set_page_compression(true);
+
+  // 最后一个页面是随机数据，压缩不了
+  const int page_num = 30;
+  mt19937   random_generator(0);
+  for (int i = 0; i < page_num; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+    if (i == page_num - 1) {
+      for (int j = 0; j < BP_PAGE_DATA_SIZE; j++) {
+        frame->data()[j] = static_cast<char>(random_generator());
+      }
+    } else {
+      memset(frame->data(), ' ', BP_PAGE_DATA_SIZE);
+      for (int j = 0; j + sizeof(int) <= BP_PAGE_DATA_SIZE; j += 64) {
+        memcpy(frame->data() + j, &i, sizeof(i));
+      }
+    }
+    frame->mark_dirty();
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  }
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.close_file(buffer_pool_filename.c_str()));
+
+  auto read_disk_page = [&buffer_pool_filename](PageNum page_num, Page &page) {
+    ifstream in(buffer_pool_filename, ios::binary);
+    in.seekg(static_cast<int64_t>(page_num) * BP_PAGE_SIZE);
+    in.read(reinterpret_cast<char *>(&page), BP_PAGE_SIZE);
+    return static_cast<bool>(in);
+  };
+
+  // 文件头不压缩，数据页面除了最后一个都是压缩过的，文件的长度不变
+  Page page;
+  ASSERT_TRUE(read_disk_page(BP_HEADER_PAGE, page));
+  ASSERT_FALSE(PageCompressor::is_compressed(page));
+  for (PageNum i = 1; i < page_num; i++) {
+    ASSERT_TRUE(read_disk_page(i, page));
+    ASSERT_TRUE(PageCompressor::is_compressed(page)) << "page num=" << i;
+  }
+  ASSERT_TRUE(read_disk_page(page_num, page));
+  ASSERT_FALSE(PageCompressor::is_compressed(page));
+  ASSERT_EQ(static_cast<uintmax_t>(page_num + 1) * BP_PAGE_SIZE, filesystem::file_size(buffer_pool_filename));
+
+  struct stat st;
+  ASSERT_EQ(0, stat(buffer_pool_filename.c_str(), &st));
+  LOG_INFO("compressed file size=%ld, disk usage=%ld", st.st_size, st.st_blocks * 512);
+
+  // 关闭压缩以后仍然可以读取压缩过的页面，修改以后按照原样写入
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.init_read_ahead(8));
+  BufferPoolIterator iterator;
+  ASSERT_EQ(RC::SUCCESS, iterator.init(*buffer_pool, 1));
+  while (iterator.has_next()) {
+    PageNum page_num_read = iterator.next();
+    Frame  *frame         = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(page_num_read, &frame));
+    if (page_num_read < page_num) {
+      int value = -1;
+      memcpy(&value, frame->data() + 64, sizeof(value));
+      ASSERT_EQ(page_num_read - 1, value);
+      ASSERT_EQ(' ', frame->data()[BP_PAGE_DATA_SIZE - 1]);
+    }
+    if (page_num_read == 1) {
+      frame->data()[0] = 'x';
+      frame->mark_dirty();
+    }
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  }
+  buffer_pool->wait_read_ahead();
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.close_file(buffer_pool_filename.c_str()));
+
+  ASSERT_TRUE(read_disk_page(1, page));
+  ASSERT_FALSE(PageCompressor::is_compressed(page));
+  ASSERT_EQ('x', page.data[0]);
+  ASSERT_TRUE(read_disk_page(2, page));
+  ASSERT_TRUE(PageCompressor::is_compressed(page));
+}
+
+TEST(DiskBufferPool, metrics)
+{
+  filesystem::path directory("buffer_pool");
+  filesystem::remove_all(directory);
+  filesystem::create_directories(directory);
+
+  filesystem::path buffer_pool_filename = directory / "metrics.bp";
+
+  // 只有128个页帧，分配更多的页面时一定会淘汰
+  BufferPoolManager buffer_pool_manager(static_cast<int64_t>(BP_PAGE_SIZE) * DEFAULT_ITEM_NUM_PER_POOL);
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.init(make_unique<VacuousDoubleWriteBuffer>()));
+
+  VacuousLogHandler log_handler;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.create_file(buffer_pool_filename.c_str()));
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+
+  const int page_num = DEFAULT_ITEM_NUM_PER_POOL * 2;
+  for (int i = 0; i < page_num; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+    frame->mark_dirty();
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  }
+
+  // 淘汰的都是脏页，先刷盘再淘汰。分配页面时也会写盘来扩展文件
+  BufferPoolStatus status = buffer_pool->status();
+  EXPECT_EQ(buffer_pool_filename.string(), status.file_name);
+  EXPECT_GE(status.evict_count, page_num - DEFAULT_ITEM_NUM_PER_POOL);
+  EXPECT_GE(status.flush_count, status.evict_count);
+  EXPECT_GE(status.write_pages, status.flush_count + page_num);
+  EXPECT_EQ(status.write_pages * BP_PAGE_SIZE, status.write_bytes);
+
+  // 第一个数据页面已经被淘汰了，第一次访问要读盘，第二次就在内存中了
+  Frame *frame = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(1, &frame));
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(1, &frame));
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+
+  BufferPoolStatus new_status = buffer_pool->status();
+  EXPECT_EQ(status.miss_count + 1, new_status.miss_count);
+  EXPECT_EQ(status.hit_count + 1, new_status.hit_count);
+  EXPECT_EQ(status.read_pages + 1, new_status.read_pages);
+  EXPECT_EQ(status.read_bytes + BP_PAGE_SIZE, new_status.read_bytes);
+
+  vector<BufferPoolStatus> status_list;
+  buffer_pool_manager.all_status(status_list);
+  ASSERT_EQ(1, static_cast<int>(status_list.size()));
+  EXPECT_EQ(new_status.hit_count, status_list[0].hit_count);
+
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.close_file(buffer_pool_filename.c_str()));
+  buffer_pool_manager.all_status(status_list);
+  EXPECT_TRUE(status_list.empty());
+}
+
 int main(int argc, char **argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include <filesystem>
+#include <thread>
 
 #include "gtest/gtest.h"
 
@@ -201,6 +202,80 @@ TEST(DoubleWriteBuffer, single_file_exception)
   bpm  = nullptr;
 }
 
+TEST(DoubleWriteBuffer, group_flush)
+{
+  /*
+  多个线程同时向double write buffer中添加页面，页面按批写入磁盘
+  每个批次完成后，double write buffer文件头中的页面个数是0，数据文件中是最新的页面
+  */
+  filesystem::path directory("double_write_buffer_test_group_flush_dir");
+  filesystem::remove_all(directory);
+  filesystem::create_directories(directory);
+
+  filesystem::path buffer_pool_filename         = directory / "buffer_pool.bp";
+  filesystem::path double_write_buffer_filename = directory / "double_write_buffer.dwb";
+
+  auto              bpm = make_unique<BufferPoolManager>();
+  VacuousLogHandler log_handler;
+  auto              double_write_buffer = make_unique<DiskDoubleWriteBuffer>(*bpm, 8 /*max_pages*/);
+  ASSERT_EQ(RC::SUCCESS, double_write_buffer->open_file(double_write_buffer_filename.c_str()));
+  ASSERT_EQ(bpm->init(std::move(double_write_buffer)), RC::SUCCESS);
+  DiskDoubleWriteBuffer *disk_double_write_buffer = static_cast<DiskDoubleWriteBuffer *>(bpm->get_dblwr_buffer());
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(buffer_pool_filename.c_str()));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+
+  const int thread_num      = 4;
+  const int page_per_thread = 20;
+  for (int i = 0; i < thread_num * page_per_thread; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+    frame->unpin();
+  }
+  ASSERT_EQ(RC::SUCCESS, disk_double_write_buffer->flush_page());
+
+  vector<thread> threads;
+  for (int t = 0; t < thread_num; t++) {
+    threads.emplace_back([buffer_pool, disk_double_write_buffer, t, page_per_thread]() {
+      for (int i = 0; i < page_per_thread; i++) {
+        PageNum page_num = 1 + t * page_per_thread + i;
+        Page    page;
+        memset(&page, 0, sizeof(page));
+        memcpy(page.data, &page_num, sizeof(page_num));
+        ASSERT_EQ(RC::SUCCESS, disk_double_write_buffer->add_page(buffer_pool, page_num, page));
+
+        // 页面还在内存的批次中，或者已经写到了数据文件中
+        Page read_page;
+        RC   rc = disk_double_write_buffer->read_page(buffer_pool, page_num, read_page);
+        ASSERT_TRUE(rc == RC::SUCCESS || rc == RC::BUFFERPOOL_INVALID_PAGE_NUM);
+      }
+    });
+  }
+  for (thread &t : threads) {
+    t.join();
+  }
+  ASSERT_EQ(RC::SUCCESS, disk_double_write_buffer->flush_page());
+
+  int fd = open(double_write_buffer_filename.c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+  DoubleWriteBufferHeader header;
+  ASSERT_EQ(static_cast<ssize_t>(sizeof(header)), pread(fd, &header, sizeof(header), 0));
+  ASSERT_EQ(0, header.page_cnt);
+  close(fd);
+
+  for (PageNum page_num = 1; page_num <= thread_num * page_per_thread; page_num++) {
+    Page page;
+    ASSERT_EQ(RC::BUFFERPOOL_INVALID_PAGE_NUM, disk_double_write_buffer->read_page(buffer_pool, page_num, page));
+    ASSERT_EQ(static_cast<ssize_t>(sizeof(page)), pread(buffer_pool->file_desc(), &page, sizeof(page), page_num * sizeof(Page)));
+    PageNum value = -1;
+    memcpy(&value, page.data, sizeof(value));
+    ASSERT_EQ(page_num, value);
+  }
+
+  bpm = nullptr;
+}
+
 int main(int argc, char **argv)
 {
   testing::InitGoogleTest(&argc, argv);
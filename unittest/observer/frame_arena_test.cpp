@@ -0,0 +1,46 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "storage/buffer/frame_arena.h"
+
+using namespace std;
+
+TEST(FrameArena, init)
+{
+  const size_t size = 3 * BP_PAGE_SIZE + 100;
+
+  FrameArenaOptions options_list[3];
+  options_list[1].huge_page       = true;
+  options_list[2].huge_page       = true;
+  options_list[2].numa_interleave = true;
+  for (const FrameArenaOptions &options : options_list) {
+    FrameArena arena;
+    // 不支持大页、NUMA时会退化成普通内存，总是能申请成功
+    ASSERT_EQ(RC::SUCCESS, arena.init(size, options));
+    ASSERT_GE(arena.size(), size);
+    ASSERT_EQ(0, arena.size() % BP_IO_ALIGN);
+    ASSERT_EQ(0, reinterpret_cast<uintptr_t>(arena.data()) % BP_IO_ALIGN);
+    memset(arena.data(), 0x5A, arena.size());
+    ASSERT_EQ(0x5A, arena.data()[arena.size() - 1]);
+
+    // 重新申请会释放原来的内存
+    ASSERT_EQ(RC::SUCCESS, arena.init(BP_PAGE_SIZE, FrameArenaOptions()));
+    ASSERT_EQ(static_cast<size_t>(BP_PAGE_SIZE), arena.size());
+  }
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,151 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/buffer/frame_replacer.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "gtest/gtest.h"
+
+static Frame *first_victim(FrameReplacer &replacer)
+{
+  Frame *victim = nullptr;
+  replacer.foreach_victim([&victim](Frame *frame) {
+    victim = frame;
+    return false;
+  });
+  return victim;
+}
+
+TEST(FrameReplacer, create)
+{
+  FrameReplacer *replacer = nullptr;
+  ASSERT_EQ(RC::SUCCESS, FrameReplacer::create(nullptr, 10, replacer));
+  ASSERT_STREQ("lru", replacer->name());
+  delete replacer;
+
+  ASSERT_EQ(RC::SUCCESS, FrameReplacer::create("2Q", 10, replacer));
+  ASSERT_STREQ("2q", replacer->name());
+  delete replacer;
+
+  ASSERT_EQ(RC::INVALID_ARGUMENT, FrameReplacer::create("unknown", 10, replacer));
+}
+
+TEST(FrameReplacer, lru)
+{
+  Frame frames[4];
+  for (int i = 0; i < 4; i++) {
+    frames[i].set_buffer_pool_id(1);
+    frames[i].set_page_num(i);
+  }
+
+  LruFrameReplacer replacer;
+  for (Frame &frame : frames) {
+    replacer.insert(&frame);
+  }
+  ASSERT_EQ(&frames[0], first_victim(replacer));
+
+  replacer.touch(&frames[0]);
+  ASSERT_EQ(&frames[1], first_victim(replacer));
+
+  replacer.remove(&frames[1], false /*evicted*/);
+  ASSERT_EQ(&frames[2], first_victim(replacer));
+
+  int count = 0;
+  replacer.foreach_victim([&count](Frame *) {
+    count++;
+    return true;
+  });
+  ASSERT_EQ(3, count);
+}
+
+TEST(FrameReplacer, two_queue_scan_resistant)
+{
+  const int capacity = 8;
+
+  TwoQueueFrameReplacer replacer(capacity);
+
+  // 热点页面先被加载并淘汰一次，再次加载时会进入Am队列
+  Frame hot;
+  hot.set_buffer_pool_id(1);
+  hot.set_page_num(100);
+  replacer.insert(&hot);
+  replacer.remove(&hot, true /*evicted*/);
+  replacer.insert(&hot);
+
+  // 模拟全表扫描，每个页面只访问一次
+  Frame scan_frames[capacity];
+  for (int i = 0; i < capacity; i++) {
+    scan_frames[i].set_buffer_pool_id(2);
+    scan_frames[i].set_page_num(i);
+    replacer.insert(&scan_frames[i]);
+    replacer.touch(&scan_frames[i]);
+  }
+
+  // A1in 超过容量的 1/4 时，扫描的页面先被淘汰。如果是LRU，热点页面会第一个被淘汰
+  const int a1in_size = capacity / 4;
+  for (int i = 0; i < capacity - a1in_size; i++) {
+    Frame *victim = first_victim(replacer);
+    ASSERT_EQ(&scan_frames[i], victim);
+    replacer.remove(victim, true /*evicted*/);
+  }
+
+  ASSERT_EQ(&hot, first_victim(replacer));
+}
+
+TEST(FrameReplacer, two_queue_ignore_disposed)
+{
+  const int capacity = 8;
+
+  TwoQueueFrameReplacer replacer(capacity);
+
+  // 页面被删除时不是淘汰，再次加载时仍然是新的页面，放在A1in中
+  Frame disposed;
+  disposed.set_buffer_pool_id(1);
+  disposed.set_page_num(100);
+  replacer.insert(&disposed);
+  replacer.remove(&disposed, false /*evicted*/);
+  replacer.insert(&disposed);
+
+  Frame scan_frames[capacity];
+  for (int i = 0; i < capacity; i++) {
+    scan_frames[i].set_buffer_pool_id(2);
+    scan_frames[i].set_page_num(i);
+    replacer.insert(&scan_frames[i]);
+  }
+  ASSERT_EQ(&disposed, first_victim(replacer));
+}
+
+TEST(FrameReplacer, frame_manager_stat)
+{
+  BPFrameManager frame_manager("Test");
+  ASSERT_EQ(RC::SUCCESS, frame_manager.init(1, 4, "2q"));
+
+  Frame *frame = frame_manager.alloc(1, 1);
+  ASSERT_NE(frame, nullptr);
+  frame->unpin();
+
+  ASSERT_EQ(frame, frame_manager.get(1, 1));
+  frame->unpin();
+  ASSERT_EQ(nullptr, frame_manager.get(1, 2));
+
+  ASSERT_EQ(1, frame_manager.purge_frames(1, [](Frame *) { return RC::SUCCESS; }));
+
+  BPFrameManager::Stat stat = frame_manager.stat();
+  ASSERT_EQ(1UL, stat.hit_count);
+  ASSERT_EQ(1UL, stat.miss_count);
+  ASSERT_EQ(1UL, stat.evict_count);
+  ASSERT_DOUBLE_EQ(0.5, stat.hit_ratio());
+  ASSERT_EQ(RC::SUCCESS, frame_manager.cleanup());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
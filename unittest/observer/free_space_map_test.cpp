@@ -0,0 +1,211 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/double_write_buffer.h"
+#include "storage/clog/vacuous_log_handler.h"
+#include "storage/record/free_space_map.h"
+#include "storage/record/record_manager.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace common;
+
+TEST(FreeSpaceMap, level)
+{
+  ASSERT_EQ(1, FreeSpaceMap::level(0));
+  ASSERT_EQ(1, FreeSpaceMap::level(1));
+  ASSERT_EQ(FreeSpaceMap::MAX_LEVEL, FreeSpaceMap::level(BP_PAGE_DATA_SIZE));
+  for (int free_bytes = 1; free_bytes < BP_PAGE_DATA_SIZE; free_bytes += 97) {
+    ASSERT_LE(FreeSpaceMap::level(free_bytes), FreeSpaceMap::level(free_bytes + 97));
+  }
+}
+
+TEST(FreeSpaceMap, claim_release)
+{
+  FreeSpaceMap free_space_map;
+  ASSERT_EQ(BP_INVALID_PAGE_NUM, free_space_map.claim());
+
+  free_space_map.update(1, 10);
+  free_space_map.update(2, 0);
+  free_space_map.update(3, 20);
+  const PageNum far_page = FreeSpaceMap::CHUNK_PAGES * 3 + 5;
+  free_space_map.update(far_page, 30);
+
+  // 满的页面不会被选中，被占用的页面也不会再被选中
+  ASSERT_EQ(1, free_space_map.claim());
+  ASSERT_EQ(3, free_space_map.claim());
+  ASSERT_EQ(far_page, free_space_map.claim());
+  ASSERT_EQ(BP_INVALID_PAGE_NUM, free_space_map.claim());
+
+  // update 不改变占用状态
+  free_space_map.update(3, 25);
+  ASSERT_EQ(25, free_space_map.get_level(3));
+  ASSERT_EQ(BP_INVALID_PAGE_NUM, free_space_map.claim());
+
+  free_space_map.release(3, 5);
+  free_space_map.release(1, 0);
+  ASSERT_EQ(5, free_space_map.get_level(3));
+  ASSERT_EQ(0, free_space_map.get_level(1));
+  ASSERT_EQ(3, free_space_map.claim());
+  ASSERT_EQ(BP_INVALID_PAGE_NUM, free_space_map.claim());
+
+  // 超出范围的页面不记录
+  free_space_map.update(FreeSpaceMap::MAX_CHUNKS * FreeSpaceMap::CHUNK_PAGES, 10);
+  ASSERT_EQ(0, free_space_map.get_level(FreeSpaceMap::MAX_CHUNKS * FreeSpaceMap::CHUNK_PAGES));
+}
+
+TEST(FreeSpaceMap, concurrent_claim)
+{
+  FreeSpaceMap free_space_map;
+  const int    page_num = 64;
+  for (PageNum page = 1; page <= page_num; page++) {
+    free_space_map.update(page, 1);
+  }
+
+  // 同一时刻每个页面最多只能被一个线程占用
+  vector<atomic<int>> owners(page_num + 1);
+  atomic<int>         conflicts{0};
+  vector<thread>      threads;
+  for (int t = 0; t < 16; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < 10000; i++) {
+        PageNum page = free_space_map.claim();
+        if (page == BP_INVALID_PAGE_NUM) {
+          continue;
+        }
+        int expected = 0;
+        if (!owners[page].compare_exchange_strong(expected, t + 1)) {
+          conflicts++;
+        }
+        this_thread::yield();
+        owners[page].store(0);
+        free_space_map.release(page, 1 + i % 3);
+      }
+    });
+  }
+  for (thread &t : threads) {
+    t.join();
+  }
+  ASSERT_EQ(0, conflicts.load());
+
+  int claimed = 0;
+  while (free_space_map.claim() != BP_INVALID_PAGE_NUM) {
+    claimed++;
+  }
+  ASSERT_EQ(page_num, claimed);
+}
+
+TEST(FreeSpaceMap, save_load)
+{
+  const char *file_name = "free_space_map_test.fsm";
+  filesystem::remove(file_name);
+
+  FreeSpaceMap free_space_map;
+  for (PageNum page = 1; page < 10000; page += 7) {
+    free_space_map.update(page, page % FreeSpaceMap::MAX_LEVEL);
+  }
+  ASSERT_NE(BP_INVALID_PAGE_NUM, free_space_map.claim());
+  ASSERT_EQ(RC::SUCCESS, free_space_map.save(file_name));
+
+  // 占用状态不会保存
+  FreeSpaceMap loaded;
+  ASSERT_EQ(RC::SUCCESS, loaded.load(file_name));
+  for (PageNum page = 0; page < 10000; page++) {
+    ASSERT_EQ(free_space_map.get_level(page), loaded.get_level(page));
+  }
+  ASSERT_EQ(1, loaded.claim());
+
+  // 损坏的文件不能加载
+  {
+    fstream fs(file_name, ios_base::in | ios_base::out | ios_base::binary);
+    fs.seekp(100);
+    fs.put(0x55);
+  }
+  FreeSpaceMap corrupted;
+  ASSERT_NE(RC::SUCCESS, corrupted.load(file_name));
+  ASSERT_NE(RC::SUCCESS, corrupted.load("not_exist.fsm"));
+  filesystem::remove(file_name);
+}
+
+TEST(FreeSpaceMap, record_file_handler)
+{
+  VacuousLogHandler log_handler;
+
+  const char *record_file = "free_space_map_record.bp";
+  const char *fsm_file    = "free_space_map_record.fsm";
+  filesystem::remove(record_file);
+  filesystem::remove(fsm_file);
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(record_file));
+  DiskBufferPool *bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, record_file, bp));
+
+  char        record_data[100] = "hello";
+  vector<RID> rids;
+  {
+    RecordFileHandler file_handler(StorageFormat::ROW_FORMAT);
+    ASSERT_EQ(RC::SUCCESS, file_handler.init(*bp, log_handler, nullptr, fsm_file));
+
+    // 并发插入的线程各自使用不同的页面，插入完成以后所有的记录都在
+    const int      thread_num = 16;
+    vector<thread> threads;
+    mutex          rids_lock;
+    for (int t = 0; t < thread_num; t++) {
+      threads.emplace_back([&]() {
+        for (int i = 0; i < 500; i++) {
+          RID rid;
+          ASSERT_EQ(RC::SUCCESS, file_handler.insert_record(record_data, sizeof(record_data), &rid));
+          lock_guard<mutex> guard(rids_lock);
+          rids.push_back(rid);
+        }
+      });
+    }
+    for (thread &t : threads) {
+      t.join();
+    }
+    sort(rids.begin(), rids.end(), [](const RID &a, const RID &b) { return RID::compare(&a, &b) < 0; });
+    ASSERT_EQ(rids.end(), adjacent_find(rids.begin(), rids.end()));
+
+    // 删除以后页面重新有了空闲空间
+    ASSERT_EQ(RC::SUCCESS, file_handler.delete_record(&rids[0]));
+    ASSERT_GT(file_handler.free_space_map().get_level(rids[0].page_num), 0);
+    file_handler.close();
+  }
+  ASSERT_TRUE(filesystem::exists(fsm_file));
+
+  // 重新打开时加载空闲空间表，然后删掉文件
+  RecordFileHandler file_handler(StorageFormat::ROW_FORMAT);
+  ASSERT_EQ(RC::SUCCESS, file_handler.init(*bp, log_handler, nullptr, fsm_file));
+  ASSERT_FALSE(filesystem::exists(fsm_file));
+  ASSERT_GT(file_handler.free_space_map().get_level(rids[0].page_num), 0);
+
+  RID rid;
+  ASSERT_EQ(RC::SUCCESS, file_handler.insert_record(record_data, sizeof(record_data), &rid));
+  ASSERT_EQ(rids[0], rid);
+  file_handler.close();
+
+  bpm.close_file(record_file);
+  filesystem::remove(record_file);
+  filesystem::remove(fsm_file);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
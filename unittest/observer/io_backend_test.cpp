@@ -0,0 +1,103 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <filesystem>
+
+#include "gtest/gtest.h"
+#include "storage/buffer/io_backend.h"
+
+using namespace std;
+
+static void test_batch(IoBackend &backend)
+{
+  filesystem::path filename = filesystem::path("io_backend") / (string(backend.name()) + ".data");
+  filesystem::create_directories(filename.parent_path());
+  filesystem::remove(filename);
+
+  int fd = open(filename.c_str(), O_CREAT | O_RDWR, 0644);
+  ASSERT_GE(fd, 0);
+
+  const int block_size  = 4096;
+  const int block_count = 16;
+
+  // 写入的位置有连续的也有不连续的
+  vector<vector<char>> blocks(block_count, vector<char>(block_size));
+  vector<IoRequest>    requests(block_count);
+  for (int i = 0; i < block_count; i++) {
+    fill(blocks[i].begin(), blocks[i].end(), static_cast<char>('a' + i));
+    requests[i].fd     = fd;
+    requests[i].offset = (i < block_count / 2 ? i : i * 2) * block_size;
+    requests[i].buffer = blocks[i].data();
+    requests[i].size   = block_size;
+  }
+  ASSERT_EQ(RC::SUCCESS, backend.write_batch(requests));
+
+  vector<vector<char>> read_blocks(block_count, vector<char>(block_size));
+  for (int i = 0; i < block_count; i++) {
+    requests[i].buffer = read_blocks[i].data();
+  }
+  ASSERT_EQ(RC::SUCCESS, backend.read_batch(requests));
+  for (int i = 0; i < block_count; i++) {
+    ASSERT_EQ(blocks[i], read_blocks[i]);
+    ASSERT_EQ(RC::SUCCESS, requests[i].rc);
+  }
+
+  // 超过文件末尾的读取会失败，不影响其它的请求
+  vector<char>      single(block_size);
+  vector<IoRequest> tail_requests(2);
+  tail_requests[0] = IoRequest{fd, 0, single.data(), block_size};
+  tail_requests[1] = IoRequest{fd, block_count * 4 * block_size, read_blocks[0].data(), block_size};
+  ASSERT_EQ(RC::IOERR_READ, backend.read_batch(tail_requests));
+  ASSERT_EQ(RC::SUCCESS, tail_requests[0].rc);
+  ASSERT_EQ(RC::IOERR_READ, tail_requests[1].rc);
+  ASSERT_EQ(blocks[0], single);
+
+  ASSERT_EQ(RC::SUCCESS, backend.write(fd, 0, blocks[1].data(), block_size));
+  ASSERT_EQ(RC::SUCCESS, backend.read(fd, 0, single.data(), block_size));
+  ASSERT_EQ(blocks[1], single);
+
+  close(fd);
+}
+
+TEST(IoBackend, create)
+{
+  unique_ptr<IoBackend> backend;
+  ASSERT_EQ(RC::SUCCESS, IoBackend::create(nullptr, backend));
+  ASSERT_STREQ("psync", backend->name());
+
+  // 系统不支持时会退化成 psync
+  ASSERT_EQ(RC::SUCCESS, IoBackend::create("io_uring", backend));
+  ASSERT_NE(nullptr, backend.get());
+
+  ASSERT_EQ(RC::INVALID_ARGUMENT, IoBackend::create("unknown", backend));
+}
+
+TEST(IoBackend, psync)
+{
+  PsyncIoBackend backend;
+  test_batch(backend);
+}
+
+TEST(IoBackend, io_uring)
+{
+  IoUringBackend backend;
+  if (OB_FAIL(backend.init())) {
+    GTEST_SKIP() << "io_uring is not supported";
+  }
+  test_batch(backend);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,175 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <vector>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "storage/db/db.h"
+#include "storage/index/index.h"
+#include "storage/table/table.h"
+#include "storage/record/record.h"
+#include "storage/record/record_manager.h"
+#include "storage/trx/mvcc_trx.h"
+#include "storage/trx/mvcc_vacuum.h"
+
+using namespace common;
+using std::to_string;
+
+static int count_records(Table *table)
+{
+  RecordFileScanner scanner;
+  EXPECT_EQ(RC::SUCCESS, table->get_record_scanner(scanner, nullptr, ReadWriteMode::READ_ONLY));
+  int    count = 0;
+  Record record;
+  while (OB_SUCC(scanner.next(record))) {
+    count++;
+  }
+  return count;
+}
+
+static int count_index_entries(Index *index)
+{
+  IndexScanner *scanner = index->create_scanner({}, true, {}, true);
+  EXPECT_NE(scanner, nullptr);
+  int count = 0;
+  RID rid;
+  while (OB_SUCC(scanner->next_entry(&rid))) {
+    count++;
+  }
+  scanner->destroy();
+  return count;
+}
+
+TEST(MvccVacuum, vacuum)
+{
+  /*
+  插入一批记录并删除一半，提交以后只要还有更老的事务活跃，记录就不能回收。
+  老的事务结束后回收，检查记录和索引项都被删除了，新插入的记录可以复用这些空间。
+  */
+  filesystem::path test_directory("mvcc_vacuum_test");
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  const char      *dbname  = "test_db";
+  filesystem::path db_path = test_directory / dbname;
+  filesystem::create_directories(db_path);
+
+  auto db = make_unique<Db>();
+  ASSERT_EQ(RC::SUCCESS, db->init(dbname, db_path.c_str(), "mvcc", "disk"));
+  ASSERT_NE(db->vacuum(), nullptr);
+
+  const int               field_num = 4;
+  vector<AttrInfoSqlNode> attr_infos;
+  for (int i = 0; i < field_num; i++) {
+    AttrInfoSqlNode attr_info;
+    attr_info.name    = string("field_") + to_string(i);
+    attr_info.type    = AttrType::INTS;
+    attr_info.arr_len = 1;
+    attr_infos.push_back(attr_info);
+  }
+  ASSERT_EQ(RC::SUCCESS, db->create_table("vacuum_table", attr_infos));
+  Table *table = db->find_table("vacuum_table");
+  ASSERT_NE(table, nullptr);
+
+  TrxKit &trx_kit = db->trx_kit();
+
+  Trx *index_trx = trx_kit.create_trx(db->log_handler());
+  vector<const FieldMeta *> index_fields{table->table_meta().field("field_0")};
+  ASSERT_EQ(RC::SUCCESS, table->create_index(index_trx, index_fields, "vacuum_index", false));
+  trx_kit.destroy_trx(index_trx);
+  Index *index = table->find_index("vacuum_index");
+  ASSERT_NE(index, nullptr);
+
+  const int insert_num = 1000;
+  Trx      *insert_trx = trx_kit.create_trx(db->log_handler());
+  insert_trx->start_if_need();
+  for (int i = 0; i < insert_num; i++) {
+    vector<Value> values(field_num);
+    for (Value &value : values) {
+      value.set_int(i);
+    }
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, table->make_record(values.size(), values.data(), record));
+    ASSERT_EQ(RC::SUCCESS, insert_trx->insert_record(table, record));
+  }
+  ASSERT_EQ(RC::SUCCESS, insert_trx->commit());
+  trx_kit.destroy_trx(insert_trx);
+
+  // 这个事务比删除提交得早，它还可能读到被删除的记录
+  Trx *old_trx = trx_kit.create_trx(db->log_handler());
+  old_trx->start_if_need();
+
+  Trx *delete_trx = trx_kit.create_trx(db->log_handler());
+  delete_trx->start_if_need();
+  vector<Record> records;
+  {
+    RecordFileScanner scanner;
+    ASSERT_EQ(RC::SUCCESS, table->get_record_scanner(scanner, delete_trx, ReadWriteMode::READ_ONLY));
+    Record record;
+    for (int i = 0; OB_SUCC(scanner.next(record)); i++) {
+      if (i % 2 == 0) {
+        records.push_back(record);
+        ASSERT_EQ(RC::SUCCESS, records.back().materialize());
+      }
+    }
+  }
+  for (Record &record : records) {
+    ASSERT_EQ(RC::SUCCESS, delete_trx->delete_record(table, record));
+  }
+  ASSERT_EQ(RC::SUCCESS, delete_trx->commit());
+  trx_kit.destroy_trx(delete_trx);
+
+  const int delete_num = static_cast<int>(records.size());
+  ASSERT_EQ(insert_num / 2, delete_num);
+
+  MvccVacuum *vacuum = db->vacuum();
+  ASSERT_EQ(0, vacuum->vacuum());
+  ASSERT_EQ(insert_num, count_records(table));
+  ASSERT_EQ(insert_num, count_index_entries(index));
+
+  ASSERT_EQ(RC::SUCCESS, old_trx->commit());
+  trx_kit.destroy_trx(old_trx);
+
+  ASSERT_EQ(delete_num, vacuum->vacuum());
+  ASSERT_EQ(insert_num - delete_num, count_records(table));
+  ASSERT_EQ(insert_num - delete_num, count_index_entries(index));
+  ASSERT_EQ(0, vacuum->vacuum());
+
+  // 回收的空间可以被新插入的记录复用，不需要分配新的页面
+  PageNum max_page_num = 0;
+  for (const Record &record : records) {
+    max_page_num = std::max(max_page_num, record.rid().page_num);
+  }
+
+  Trx *reinsert_trx = trx_kit.create_trx(db->log_handler());
+  reinsert_trx->start_if_need();
+  for (int i = 0; i < delete_num; i++) {
+    vector<Value> values(field_num);
+    for (Value &value : values) {
+      value.set_int(insert_num + i);
+    }
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, table->make_record(values.size(), values.data(), record));
+    ASSERT_EQ(RC::SUCCESS, reinsert_trx->insert_record(table, record));
+    ASSERT_LE(record.rid().page_num, max_page_num);
+  }
+  ASSERT_EQ(RC::SUCCESS, reinsert_trx->commit());
+  trx_kit.destroy_trx(reinsert_trx);
+
+  ASSERT_EQ(insert_num, count_records(table));
+  ASSERT_EQ(insert_num, count_index_entries(index));
+
+  db.reset();
+  filesystem::remove_all(test_directory);
+}
@@ -0,0 +1,79 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <filesystem>
+
+#include "gtest/gtest.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/double_write_buffer.h"
+#include "storage/buffer/page_cleaner.h"
+#include "storage/clog/vacuous_log_handler.h"
+
+using namespace std;
+using namespace common;
+
+TEST(PageCleaner, clean_victim_frames)
+{
+  filesystem::path directory("page_cleaner");
+  filesystem::remove_all(directory);
+  filesystem::create_directories(directory);
+
+  filesystem::path buffer_pool_filename = directory / "buffer_pool.bp";
+
+  BufferPoolManager buffer_pool_manager;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.init(make_unique<VacuousDoubleWriteBuffer>()));
+
+  VacuousLogHandler log_handler;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.create_file(buffer_pool_filename.c_str()));
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+
+  const int page_num = 100;
+  for (int i = 0; i < page_num; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+    frame->mark_dirty();
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  }
+
+  BPFrameManager &frame_manager = buffer_pool_manager.get_frame_manager();
+  PageCleaner    &page_cleaner  = buffer_pool_manager.page_cleaner();
+  ASSERT_FALSE(page_cleaner.running());
+
+  // 脏页比例没有超过目标值，只刷淘汰顺序靠前的页面
+  ASSERT_GT(page_cleaner.clean(), 0);
+
+  vector<Frame *> victim_frames;
+  vector<Frame *> other_frames;
+  frame_manager.find_dirty_frames(1, page_num /*max_other_count*/, victim_frames, other_frames);
+  ASSERT_TRUE(victim_frames.empty());
+  ASSERT_FALSE(other_frames.empty());
+  ASSERT_EQ(other_frames.size(), frame_manager.dirty_frame_num());
+  for (Frame *frame : other_frames) {
+    frame->unpin();
+  }
+
+  // 每个分区最多返回 max_other_count 个其它的脏页帧
+  other_frames.clear();
+  frame_manager.find_dirty_frames(1, 1 /*max_other_count*/, victim_frames, other_frames);
+  ASSERT_FALSE(other_frames.empty());
+  ASSERT_LE(other_frames.size(), static_cast<size_t>(frame_manager.partition_num()));
+  for (Frame *frame : other_frames) {
+    frame->unpin();
+  }
+
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.close_file(buffer_pool_filename.c_str()));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,152 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "pax_table_test_util.h"
+#include "sql/expr/expression.h"
+#include "sql/operator/exchange_vec_physical_operator.h"
+#include "sql/operator/table_scan_vec_physical_operator.h"
+#include "storage/db/db.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief 执行算子，返回记录数以及字段 a 的和
+ */
+void run(PhysicalOperator &oper, Trx *trx, int a_index, int &rows, int64_t &sum)
+{
+  rows = 0;
+  sum  = 0;
+  ASSERT_EQ(RC::SUCCESS, oper.open(trx));
+
+  Chunk chunk;
+  RC    rc = RC::SUCCESS;
+  while (OB_SUCC(rc = oper.next(chunk))) {
+    rows += chunk.rows();
+    for (int i = 0; i < chunk.rows(); i++) {
+      sum += chunk.get_value(a_index, i).get_int();
+    }
+  }
+  ASSERT_EQ(RC::RECORD_EOF, rc);
+  ASSERT_EQ(RC::SUCCESS, oper.close());
+}
+
+/**
+ * @brief 创建并行扫描 table 的算子
+ * @param predicate 不为空时只返回 a < predicate 的记录
+ */
+unique_ptr<PhysicalOperator> make_parallel_scan(Table *table, int parallel_degree, const int *predicate)
+{
+  auto morsels  = make_shared<PageMorselQueue>(2);
+  auto exchange = make_unique<ExchangeVecPhysicalOperator>();
+  exchange->set_morsel_queue(morsels);
+
+  auto owner = make_unique<TableScanVecPhysicalOperator>(table, ReadWriteMode::READ_ONLY);
+  if (predicate != nullptr) {
+    vector<unique_ptr<Expression>> predicates;
+    predicates.push_back(make_unique<ComparisonExpr>(CompOp::LESS_THAN,
+        make_unique<FieldExpr>(table, table->table_meta().field("a")),
+        make_unique<ValueExpr>(Value(*predicate))));
+    owner->set_predicates(std::move(predicates));
+  }
+  owner->set_morsel_queue(morsels);
+  TableScanVecPhysicalOperator &owner_ref = *owner;
+  exchange->add_child(std::move(owner));
+
+  for (int i = 1; i < parallel_degree; i++) {
+    auto worker = make_unique<TableScanVecPhysicalOperator>(table, ReadWriteMode::READ_ONLY);
+    worker->share_predicates(owner_ref);
+    worker->set_morsel_queue(morsels);
+    exchange->add_child(std::move(worker));
+  }
+  return exchange;
+}
+
+}  // namespace
+
+TEST(ParallelScan, exchange)
+{
+#ifndef CONCURRENCY
+  GTEST_SKIP() << "parallel scan needs CONCURRENCY";
+#endif
+  filesystem::path test_directory("parallel_scan_test");
+  unique_ptr<Db>   db;
+  Table           *table = nullptr;
+  create_pax_test_table(test_directory, db, table);
+  ASSERT_FALSE(HasFatalFailure());
+  const int a_index = table->table_meta().field("a")->field_id();
+
+  const int record_num = 20000;
+  TrxKit   &trx_kit    = db->trx_kit();
+  Trx      *trx        = trx_kit.create_trx(db->log_handler());
+  ASSERT_EQ(RC::SUCCESS, trx->start_if_need());
+  insert_pax_test_records(table, trx, 0, record_num);
+  ASSERT_FALSE(HasFatalFailure());
+  ASSERT_EQ(RC::SUCCESS, trx->commit());
+  trx_kit.destroy_trx(trx);
+
+  trx = trx_kit.create_trx(db->log_handler());
+  ASSERT_EQ(RC::SUCCESS, trx->start_if_need());
+
+  // 单线程扫描的结果
+  int     rows = 0;
+  int64_t sum  = 0;
+  TableScanVecPhysicalOperator serial_scan(table, ReadWriteMode::READ_ONLY);
+  run(serial_scan, trx, a_index, rows, sum);
+  ASSERT_EQ(record_num, rows);
+  const int64_t expected_sum = static_cast<int64_t>(record_num) * (record_num - 1) / 2;
+  ASSERT_EQ(expected_sum, sum);
+
+  for (int parallel_degree : {1, 2, 4, 8}) {
+    unique_ptr<PhysicalOperator> parallel_scan = make_parallel_scan(table, parallel_degree, nullptr);
+    run(*parallel_scan, trx, a_index, rows, sum);
+    ASSERT_EQ(record_num, rows) << "parallel degree=" << parallel_degree;
+    ASSERT_EQ(expected_sum, sum) << "parallel degree=" << parallel_degree;
+
+    // 重新打开以后再扫描一遍所有的页面
+    run(*parallel_scan, trx, a_index, rows, sum);
+    ASSERT_EQ(record_num, rows) << "parallel degree=" << parallel_degree;
+    ASSERT_EQ(expected_sum, sum) << "parallel degree=" << parallel_degree;
+
+    const int bound = 1000;
+    parallel_scan   = make_parallel_scan(table, parallel_degree, &bound);
+    run(*parallel_scan, trx, a_index, rows, sum);
+    ASSERT_EQ(bound, rows);
+    ASSERT_EQ(static_cast<int64_t>(bound) * (bound - 1) / 2, sum);
+  }
+
+  // 调用方提前结束时可以正常关闭
+  unique_ptr<PhysicalOperator> parallel_scan = make_parallel_scan(table, 4, nullptr);
+  ASSERT_EQ(RC::SUCCESS, parallel_scan->open(trx));
+  Chunk chunk;
+  ASSERT_EQ(RC::SUCCESS, parallel_scan->next(chunk));
+  ASSERT_GT(chunk.rows(), 0);
+  ASSERT_EQ(RC::SUCCESS, parallel_scan->close());
+
+  ASSERT_EQ(RC::SUCCESS, trx->commit());
+  trx_kit.destroy_trx(trx);
+
+  db.reset();
+  filesystem::remove_all(test_directory);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -35,7 +35,7 @@ using namespace common;
 class PaxRecordFileScannerWithParam : public testing::TestWithParam<int>
 {};
 
-TEST_P(PaxRecordFileScannerWithParam, DISABLED_test_file_iterator)
+TEST_P(PaxRecordFileScannerWithParam, test_file_iterator)
 {
   int               record_insert_num = GetParam();
   VacuousLogHandler log_handler;
@@ -87,7 +87,7 @@ TEST_P(PaxRecordFileScannerWithParam, DISABLED_test_file_iterator)
   ASSERT_EQ(count, 0);
 
   // chunk iterator
-  rc = chunk_scanner.open_scan_chunk(&table, *bp, log_handler, ReadWriteMode::READ_ONLY);
+  rc = chunk_scanner.open_scan_chunk(&table, *bp, nullptr /*trx*/, log_handler, ReadWriteMode::READ_ONLY);
   ASSERT_EQ(rc, RC::SUCCESS);
   Chunk     chunk;
   FieldMeta fm;
@@ -126,7 +126,7 @@ TEST_P(PaxRecordFileScannerWithParam, DISABLED_test_file_iterator)
   ASSERT_EQ(count, rids.size());
 
   // chunk iterator
-  rc = chunk_scanner.open_scan_chunk(&table, *bp, log_handler, ReadWriteMode::READ_ONLY);
+  rc = chunk_scanner.open_scan_chunk(&table, *bp, nullptr /*trx*/, log_handler, ReadWriteMode::READ_ONLY);
   ASSERT_EQ(rc, RC::SUCCESS);
   chunk.reset_data();
   count = 0;
@@ -157,7 +157,7 @@ TEST_P(PaxRecordFileScannerWithParam, DISABLED_test_file_iterator)
   ASSERT_EQ(count, rids.size() / 2);
 
   // chunk iterator
-  rc = chunk_scanner.open_scan_chunk(&table, *bp, log_handler, ReadWriteMode::READ_ONLY);
+  rc = chunk_scanner.open_scan_chunk(&table, *bp, nullptr /*trx*/, log_handler, ReadWriteMode::READ_ONLY);
   ASSERT_EQ(rc, RC::SUCCESS);
   chunk.reset_data();
   count = 0;
@@ -175,7 +175,7 @@ TEST_P(PaxRecordFileScannerWithParam, DISABLED_test_file_iterator)
 class PaxPageHandlerTestWithParam : public testing::TestWithParam<int>
 {};
 
-TEST_P(PaxPageHandlerTestWithParam, DISABLED_PaxPageHandler)
+TEST_P(PaxPageHandlerTestWithParam, PaxPageHandler)
 {
   int               record_num = GetParam();
   VacuousLogHandler log_handler;
@@ -339,6 +339,331 @@ TEST_P(PaxPageHandlerTestWithParam, DISABLED_PaxPageHandler)
   delete bpm;
 }
 
+namespace {
+
+/**
+ * 两个可以为 NULL 的 INTS 字段，记录的开头是 NULL 位图，与实际的表一样
+ */
+void init_nullable_table_meta(TableMeta &table_meta)
+{
+  table_meta.fields_.resize(2);
+  table_meta.fields_[0].init("a", AttrType::INTS, 1, 4, true, 0, true);
+  table_meta.fields_[1].init("b", AttrType::INTS, 5, 4, true, 1, true);
+  table_meta.null_bitmap_start_ = 0;
+  table_meta.record_size_       = 9;
+}
+
+void make_nullable_record(char *record, int a, int b, bool a_is_null)
+{
+  memset(record, 0, 9);
+  if (a_is_null) {
+    Bitmap(record, 2).set_bit(0);
+  }
+  memcpy(record + 1, &a, sizeof(a));
+  memcpy(record + 5, &b, sizeof(b));
+}
+
+ZoneMapPredicate make_predicate(int col_id, CompOp op, int value)
+{
+  return ZoneMapPredicate{col_id, op, Value(value)};
+}
+
+}  // namespace
+
+TEST(PaxZoneMap, page)
+{
+  VacuousLogHandler log_handler;
+
+  const char *record_manager_file = "pax_zone_map_page.bp";
+  ::remove(record_manager_file);
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(record_manager_file));
+  DiskBufferPool *bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, record_manager_file, bp));
+
+  Frame *frame = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+
+  TableMeta table_meta;
+  init_nullable_table_meta(table_meta);
+
+  PaxRecordPageHandler page_handler;
+  ASSERT_EQ(RC::SUCCESS, page_handler.init_empty_page(*bp, log_handler, frame->page_num(), 9, &table_meta));
+
+  // 空页面不可能有满足条件的记录
+  ASSERT_FALSE(page_handler.may_match({}));
+
+  // a = i + 10，每10条记录有一个 NULL；b = i
+  const int record_num = 100;
+  char      record_data[9];
+  vector<RID> rids;
+  for (int i = 0; i < record_num; i++) {
+    make_nullable_record(record_data, i + 10, i, i % 10 == 0);
+    RID rid;
+    ASSERT_EQ(RC::SUCCESS, page_handler.insert_record(record_data, &rid));
+    rids.push_back(rid);
+  }
+
+  const ZoneMap &zone_map_a = page_handler.zone_map(0);
+  ASSERT_EQ(10, zone_map_a.null_count);
+  ASSERT_EQ(90, zone_map_a.value_count);
+  int min_value = 0, max_value = 0;
+  memcpy(&min_value, zone_map_a.min, sizeof(int));
+  memcpy(&max_value, zone_map_a.max, sizeof(int));
+  ASSERT_EQ(11, min_value);
+  ASSERT_EQ(109, max_value);
+  ASSERT_EQ(0, page_handler.zone_map(1).null_count);
+
+  // 按列存放以后仍然能还原出原来的记录
+  Record record;
+  ASSERT_EQ(RC::SUCCESS, page_handler.get_record(rids[20], record));
+  make_nullable_record(record_data, 30, 20, true);
+  ASSERT_EQ(0, memcmp(record.data(), record_data, sizeof(record_data)));
+
+  auto may_match = [&page_handler](vector<ZoneMapPredicate> predicates) { return page_handler.may_match(predicates); };
+  ASSERT_FALSE(may_match({make_predicate(0, CompOp::EQUAL_TO, 5)}));
+  ASSERT_FALSE(may_match({make_predicate(0, CompOp::GREAT_THAN, 109)}));
+  ASSERT_FALSE(may_match({make_predicate(0, CompOp::LESS_THAN, 11)}));
+  ASSERT_TRUE(may_match({make_predicate(0, CompOp::LESS_EQUAL, 11)}));
+  ASSERT_TRUE(may_match({make_predicate(0, CompOp::EQUAL_TO, 50)}));
+  ASSERT_TRUE(may_match({make_predicate(0, CompOp::IS, 0)}));
+  ASSERT_FALSE(may_match({make_predicate(1, CompOp::IS, 0)}));
+  // 多个条件之间是 AND
+  ASSERT_FALSE(may_match({make_predicate(0, CompOp::GREAT_EQUAL, 50), make_predicate(1, CompOp::LESS_THAN, 0)}));
+  // 类型不同时不能判断
+  ASSERT_TRUE(may_match({ZoneMapPredicate{0, CompOp::EQUAL_TO, Value(5.0f)}}));
+
+  // 删除所有不为 NULL 的 a 以后，只有 IS NULL 可能满足
+  for (int i = 0; i < record_num; i++) {
+    if (i % 10 != 0) {
+      ASSERT_EQ(RC::SUCCESS, page_handler.delete_record(&rids[i]));
+    }
+  }
+  ASSERT_EQ(0, page_handler.zone_map(0).value_count);
+  ASSERT_FALSE(may_match({make_predicate(0, CompOp::GREAT_THAN, 0)}));
+  ASSERT_FALSE(may_match({make_predicate(0, CompOp::NOT_IS, 0)}));
+  ASSERT_TRUE(may_match({make_predicate(0, CompOp::IS, 0)}));
+
+  // 更新以后重新开始统计
+  make_nullable_record(record_data, 1000, 0, false);
+  ASSERT_EQ(RC::SUCCESS, page_handler.update_record(rids[0], record_data));
+  ASSERT_EQ(9, page_handler.zone_map(0).null_count);
+  ASSERT_TRUE(may_match({make_predicate(0, CompOp::EQUAL_TO, 1000)}));
+  ASSERT_FALSE(may_match({make_predicate(0, CompOp::LESS_THAN, 1000)}));
+
+  ASSERT_EQ(RC::SUCCESS, page_handler.cleanup());
+  bpm.close_file(record_manager_file);
+  ::remove(record_manager_file);
+}
+
+TEST(PaxZoneMap, skip_pages)
+{
+  filesystem::path directory("pax_zone_map_skip_pages");
+  filesystem::remove_all(directory);
+  ASSERT_TRUE(filesystem::create_directories(directory));
+  filesystem::path record_manager_file = directory / "pax.bp";
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+
+  DiskLogHandler        log_handler;
+  IntegratedLogReplayer log_replayer(bpm);
+  ASSERT_EQ(RC::SUCCESS, log_handler.init(directory.c_str()));
+  ASSERT_EQ(RC::SUCCESS, log_handler.replay(log_replayer, 0));
+  ASSERT_EQ(RC::SUCCESS, log_handler.start());
+
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(record_manager_file.c_str()));
+  DiskBufferPool *bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, record_manager_file.c_str(), bp));
+
+  Table table;
+  table.table_meta_.storage_format_ = StorageFormat::PAX_FORMAT;
+  init_nullable_table_meta(table.table_meta_);
+
+  // a 按照插入顺序递增，每个页面中的 a 都是一段连续的值
+  const int record_num = 5000;
+  {
+    RecordFileHandler file_handler(StorageFormat::PAX_FORMAT);
+    ASSERT_EQ(RC::SUCCESS, file_handler.init(*bp, log_handler, &table.table_meta_));
+    char record_data[9];
+    for (int i = 0; i < record_num; i++) {
+      make_nullable_record(record_data, i, i, false);
+      RID rid;
+      ASSERT_EQ(RC::SUCCESS, file_handler.insert_record(record_data, sizeof(record_data), &rid));
+    }
+    file_handler.close();
+  }
+
+  auto scan = [&](DiskBufferPool &buffer_pool, LogHandler &log, vector<ZoneMapPredicate> predicates, int &rows, int &matched) {
+    ChunkFileScanner scanner;
+    ASSERT_EQ(RC::SUCCESS, scanner.open_scan_chunk(&table, buffer_pool, nullptr /*trx*/, log, ReadWriteMode::READ_ONLY));
+    scanner.set_zone_map_predicates(std::move(predicates));
+
+    Chunk     chunk;
+    FieldMeta field_meta;
+    field_meta.init("a", AttrType::INTS, 1, 4, true, 0);
+    chunk.add_column(make_unique<Column>(field_meta, 2048), 0);
+
+    rows    = 0;
+    matched = 0;
+    RC rc   = RC::SUCCESS;
+    while (OB_SUCC(rc = scanner.next_chunk(chunk))) {
+      rows += chunk.rows();
+      for (int i = 0; i < chunk.rows(); i++) {
+        if (chunk.get_value(0, i).get_int() >= record_num - 100) {
+          matched++;
+        }
+      }
+      chunk.reset_data();
+    }
+    ASSERT_EQ(RC::RECORD_EOF, rc);
+  };
+
+  // 不跳过页面时扫描所有的记录
+  int rows = 0, matched = 0;
+  scan(*bp, log_handler, {}, rows, matched);
+  ASSERT_EQ(record_num, rows);
+  ASSERT_EQ(100, matched);
+
+  // 只有最后一两个页面可能满足条件
+  scan(*bp, log_handler, {make_predicate(0, CompOp::GREAT_EQUAL, record_num - 100)}, rows, matched);
+  ASSERT_EQ(100, matched);
+  ASSERT_LT(rows, record_num / 2);
+
+  scan(*bp, log_handler, {make_predicate(0, CompOp::EQUAL_TO, record_num)}, rows, matched);
+  ASSERT_EQ(0, rows);
+
+  // 重放日志以后 zone map 仍然有效
+  filesystem::path record_manager_file_copy = directory / "pax_copy.bp";
+  filesystem::copy_file(record_manager_file, record_manager_file_copy);
+  bpm.close_file(record_manager_file.c_str());
+  filesystem::remove(record_manager_file);
+  ASSERT_EQ(RC::SUCCESS, log_handler.stop());
+  ASSERT_EQ(RC::SUCCESS, log_handler.await_termination());
+
+  DiskLogHandler    log_handler2;
+  BufferPoolManager bpm2;
+  ASSERT_EQ(RC::SUCCESS, bpm2.init(make_unique<VacuousDoubleWriteBuffer>()));
+  filesystem::copy(record_manager_file_copy, record_manager_file);
+  DiskBufferPool *bp2 = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm2.open_file(log_handler2, record_manager_file.c_str(), bp2));
+  IntegratedLogReplayer log_replayer2(bpm2);
+  ASSERT_EQ(RC::SUCCESS, log_handler2.init(directory.c_str()));
+  ASSERT_EQ(RC::SUCCESS, log_handler2.replay(log_replayer2, 0));
+  ASSERT_EQ(RC::SUCCESS, log_handler2.start());
+
+  scan(*bp2, log_handler2, {make_predicate(0, CompOp::GREAT_EQUAL, record_num - 100)}, rows, matched);
+  ASSERT_EQ(100, matched);
+  ASSERT_LT(rows, record_num / 2);
+
+  ASSERT_EQ(RC::SUCCESS, log_handler2.stop());
+  ASSERT_EQ(RC::SUCCESS, log_handler2.await_termination());
+  bpm2.close_file(record_manager_file.c_str());
+  filesystem::remove_all(directory);
+}
+
+TEST(PaxEncoding, page)
+{
+  VacuousLogHandler log_handler;
+
+  const char *record_manager_file = "pax_encoding_page.bp";
+  ::remove(record_manager_file);
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(record_manager_file));
+  DiskBufferPool *bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, record_manager_file, bp));
+
+  Frame *frame = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+
+  TableMeta table_meta;
+  init_nullable_table_meta(table_meta);
+
+  PaxRecordPageHandler page_handler;
+  ASSERT_EQ(RC::SUCCESS, page_handler.init_empty_page(*bp, log_handler, frame->page_num(), 9, &table_meta));
+
+  // a 只有几个不同的值，b 递增。页面写满以前不编码
+  char        record_data[9];
+  vector<RID> rids;
+  vector<int> a_values;
+  for (int i = 0; !page_handler.is_full(); i++) {
+    ASSERT_EQ(ColumnEncoding::PLAIN, page_handler.column_encoding(0));
+    make_nullable_record(record_data, i % 5, i, i % 10 == 0);
+    RID rid;
+    ASSERT_EQ(RC::SUCCESS, page_handler.insert_record(record_data, &rid));
+    rids.push_back(rid);
+    a_values.push_back(i % 5);
+  }
+  ASSERT_NE(ColumnEncoding::PLAIN, page_handler.column_encoding(0));
+  ASSERT_NE(ColumnEncoding::PLAIN, page_handler.column_encoding(1));
+  ASSERT_NE(ColumnEncoding::PLAIN, page_handler.column_encoding(2));
+
+  auto check_records = [&]() {
+    Record record;
+    for (size_t i = 0; i < rids.size(); i++) {
+      ASSERT_EQ(RC::SUCCESS, page_handler.get_record(rids[i], record));
+      make_nullable_record(record_data, a_values[i], static_cast<int>(i), i % 10 == 0);
+      ASSERT_EQ(0, memcmp(record.data(), record_data, sizeof(record_data))) << "i=" << i;
+    }
+  };
+  check_records();
+
+  // 在编码以后的列上直接过滤
+  {
+    Chunk     chunk;
+    FieldMeta field_meta;
+    field_meta.init("b", AttrType::INTS, 5, 4, true, 1);
+    chunk.add_column(make_unique<Column>(field_meta, 2048), 1);
+    vector<ZoneMapPredicate> predicates = {make_predicate(0, CompOp::EQUAL_TO, 3)};
+    ASSERT_EQ(RC::SUCCESS, page_handler.get_chunk(chunk, predicates));
+    int expected_rows = 0;
+    for (size_t i = 0; i < rids.size(); i++) {
+      if (a_values[i] == 3) {
+        ASSERT_EQ(static_cast<int>(i), chunk.get_value(0, expected_rows).get_int());
+        expected_rows++;
+      }
+    }
+    ASSERT_EQ(expected_rows, chunk.rows());
+
+    // 没有条件时输出所有记录
+    chunk.reset_data();
+    ASSERT_EQ(RC::SUCCESS, page_handler.get_chunk(chunk));
+    ASSERT_EQ(static_cast<int>(rids.size()), chunk.rows());
+  }
+
+  // 更新的值与原来相同时不需要解码；只解码值发生变化的列
+  make_nullable_record(record_data, a_values[7], 7, false);
+  ASSERT_EQ(RC::SUCCESS, page_handler.update_record(rids[7], record_data));
+  ASSERT_NE(ColumnEncoding::PLAIN, page_handler.column_encoding(0));
+  ASSERT_NE(ColumnEncoding::PLAIN, page_handler.column_encoding(1));
+
+  a_values[7] = 100;
+  make_nullable_record(record_data, a_values[7], 7, false);
+  ASSERT_EQ(RC::SUCCESS, page_handler.update_record(rids[7], record_data));
+  ASSERT_EQ(ColumnEncoding::PLAIN, page_handler.column_encoding(0));
+  ASSERT_NE(ColumnEncoding::PLAIN, page_handler.column_encoding(1));
+  check_records();
+
+  // 删除以后再插入，页面重新写满时再次编码
+  ASSERT_EQ(RC::SUCCESS, page_handler.delete_record(&rids[20]));
+  ASSERT_FALSE(page_handler.is_full());
+  a_values[20] = 2;
+  make_nullable_record(record_data, a_values[20], 20, true);
+  RID rid;
+  ASSERT_EQ(RC::SUCCESS, page_handler.insert_record(record_data, &rid));
+  ASSERT_EQ(rids[20], rid);
+  ASSERT_NE(ColumnEncoding::PLAIN, page_handler.column_encoding(0));
+  check_records();
+
+  ASSERT_EQ(RC::SUCCESS, page_handler.cleanup());
+  bpm.close_file(record_manager_file);
+  ::remove(record_manager_file);
+}
+
 INSTANTIATE_TEST_SUITE_P(PaxFileScannerTests, PaxRecordFileScannerWithParam, testing::Values(1, 10, 100, 1000, 2000, 10000));
 
 INSTANTIATE_TEST_SUITE_P(PaxPageTests, PaxPageHandlerTestWithParam, testing::Values(1, 10, 100, 337));
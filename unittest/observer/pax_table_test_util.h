@@ -0,0 +1,59 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "storage/db/db.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+
+/**
+ * @brief 在 test_directory 中创建使用 MVCC 事务的数据库，以及一张 PAX 格式的表 t(a int, b int)
+ * @details 会先清空 test_directory。只有 PAX 格式的表支持按 chunk 扫描
+ */
+inline void create_pax_test_table(const std::filesystem::path &test_directory, std::unique_ptr<Db> &db, Table *&table)
+{
+  std::filesystem::remove_all(test_directory);
+  std::filesystem::create_directories(test_directory);
+
+  db = std::make_unique<Db>();
+  ASSERT_EQ(RC::SUCCESS, db->init("test_db", test_directory.c_str(), "mvcc", "disk"));
+
+  std::vector<AttrInfoSqlNode> attr_infos(2);
+  attr_infos[0].name = "a";
+  attr_infos[1].name = "b";
+  for (AttrInfoSqlNode &attr_info : attr_infos) {
+    attr_info.type     = AttrType::INTS;
+    attr_info.arr_len  = 1;
+    attr_info.dim      = 0;
+    attr_info.nullable = false;
+  }
+  ASSERT_EQ(RC::SUCCESS, db->create_table("t", attr_infos, StorageFormat::PAX_FORMAT));
+  table = db->find_table("t");
+  ASSERT_NE(table, nullptr);
+}
+
+/**
+ * @brief 插入 [begin, end) 的记录，a = i, b = i % 10
+ */
+inline void insert_pax_test_records(Table *table, Trx *trx, int begin, int end)
+{
+  for (int i = begin; i < end; i++) {
+    Value  values[2] = {Value(i), Value(i % 10)};
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, table->make_record(2, values, record));
+    ASSERT_EQ(RC::SUCCESS, trx->insert_record(table, record));
+  }
+}
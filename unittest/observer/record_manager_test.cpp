@@ -16,9 +16,11 @@ See the Mulan PSL v2 for more details. */
 #include <sstream>
 #include <filesystem>
 #include <utility>
+#include <map>
 
 #include "storage/buffer/disk_buffer_pool.h"
 #include "storage/record/record_manager.h"
+#include "storage/table/table_meta.h"
 #include "storage/trx/vacuous_trx.h"
 #include "storage/clog/vacuous_log_handler.h"
 #include "storage/clog/disk_log_handler.h"
@@ -116,12 +118,176 @@ TEST(RecordPageHandler, test_record_page_handler)
   }
   ASSERT_EQ(count, 6);
 
+  // 记录直接指向页帧，关闭文件前需要释放
+  record = Record();
   record_page_handle->cleanup();
   bpm->close_file(record_manager_file);
   delete bpm;
   delete record_page_handle;
 }
 
+TEST(RecordPageHandler, test_zero_copy_record)
+{
+  VacuousLogHandler log_handler;
+
+  const char *record_manager_file = "record_manager.bp";
+  ::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  ASSERT_EQ(RC::SUCCESS, bpm->init(make_unique<VacuousDoubleWriteBuffer>()));
+  DiskBufferPool *bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(record_manager_file));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(log_handler, record_manager_file, bp));
+
+  Frame *frame = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+
+  const int          record_size        = 8;
+  RecordPageHandler *record_page_handle = new RowRecordPageHandler();
+  ASSERT_EQ(RC::SUCCESS, record_page_handle->init_empty_page(*bp, log_handler, frame->page_num(), record_size, nullptr));
+
+  char buf[record_size] = "abcdefg";
+  RID  rid;
+  ASSERT_EQ(RC::SUCCESS, record_page_handle->insert_record(buf, &rid));
+
+  const int base_pin_count = frame->pin_count();
+
+  // 读取的记录直接指向页帧，并且pin住页帧
+  Record record;
+  ASSERT_EQ(RC::SUCCESS, record_page_handle->get_record(rid, record));
+  ASSERT_TRUE(record.pinned());
+  ASSERT_GE(record.data(), frame->data());
+  ASSERT_LT(record.data(), frame->data() + BP_PAGE_DATA_SIZE);
+  ASSERT_EQ(0, memcmp(buf, record.data(), record_size));
+  ASSERT_EQ(base_pin_count + 1, frame->pin_count());
+
+  // 复制只增加pin计数，不复制数据
+  {
+    Record copy(record);
+    ASSERT_EQ(record.data(), copy.data());
+    ASSERT_EQ(base_pin_count + 2, frame->pin_count());
+
+    // 同一个页帧上的记录之间赋值，pin计数不变
+    copy = record;
+    ASSERT_EQ(base_pin_count + 2, frame->pin_count());
+  }
+  ASSERT_EQ(base_pin_count + 1, frame->pin_count());
+
+  Record moved(std::move(record));
+  ASSERT_TRUE(moved.pinned());
+  ASSERT_FALSE(record.pinned());
+  ASSERT_EQ(base_pin_count + 1, frame->pin_count());
+
+  // materialize 复制数据并释放页帧
+  ASSERT_EQ(RC::SUCCESS, moved.materialize());
+  ASSERT_FALSE(moved.pinned());
+  ASSERT_EQ(base_pin_count, frame->pin_count());
+  ASSERT_TRUE(moved.data() < frame->data() || moved.data() >= frame->data() + BP_PAGE_DATA_SIZE);
+  ASSERT_EQ(0, memcmp(buf, moved.data(), record_size));
+
+  record_page_handle->cleanup();
+  bp->unpin_page(frame);
+  bpm->close_file(record_manager_file);
+  delete bpm;
+  delete record_page_handle;
+}
+
+TEST(RecordPageHandler, test_slotted_record_page_handler)
+{
+  VacuousLogHandler log_handler;
+
+  const char *record_manager_file = "slotted_record_manager.bp";
+  filesystem::remove(record_manager_file);
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+  DiskBufferPool *bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(record_manager_file));
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, record_manager_file, bp));
+
+  // id int, name char(200), remark char(200)
+  vector<AttrInfoSqlNode> attr_infos(3);
+  attr_infos[0] = {AttrType::INTS, "id", 1, 1, false};
+  attr_infos[1] = {AttrType::CHARS, "name", 200, 1, false};
+  attr_infos[2] = {AttrType::CHARS, "remark", 200, 1, false};
+  TableMeta table_meta;
+  ASSERT_EQ(RC::SUCCESS, table_meta.init(1, "slotted", nullptr, attr_infos, StorageFormat::SLOTTED_FORMAT));
+  const int        record_size = table_meta.record_size();
+  const FieldMeta *name_field  = table_meta.field("name");
+
+  auto make_record = [&](int id, const string &name) {
+    vector<char> data(record_size, 0);
+    memcpy(data.data() + table_meta.field("id")->offset(), &id, sizeof(id));
+    memcpy(data.data() + name_field->offset(), name.data(), name.size());
+    return data;
+  };
+
+  Frame *frame = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+  auto page_handler = make_unique<SlottedRecordPageHandler>();
+  ASSERT_EQ(RC::SUCCESS, page_handler->init_empty_page(*bp, log_handler, frame->page_num(), record_size, &table_meta));
+  frame->unpin();
+
+  // 短字符串不再按照定长占用空间，一个页面能放下的记录比定长行存多很多
+  map<int, vector<char>> records;
+  RID                    rid;
+  while (!page_handler->is_full()) {
+    const int id = static_cast<int>(records.size());
+    records[id]  = make_record(id, "name" + to_string(id));
+    ASSERT_EQ(RC::SUCCESS, page_handler->insert_record(records[id].data(), &rid));
+    ASSERT_EQ(id, rid.slot_num);
+  }
+  const int row_capacity = (BP_PAGE_DATA_SIZE - sizeof(PageHeader)) / record_size;
+  ASSERT_GT(static_cast<int>(records.size()), row_capacity * 10);
+
+  auto check_records = [&]() {
+    RecordPageIterator iterator;
+    iterator.init(page_handler.get());
+    Record record;
+    size_t count = 0;
+    while (iterator.has_next()) {
+      ASSERT_EQ(RC::SUCCESS, iterator.next(record));
+      ASSERT_EQ(record_size, record.len());
+      auto iter = records.find(record.rid().slot_num);
+      ASSERT_NE(iter, records.end());
+      ASSERT_EQ(0, memcmp(iter->second.data(), record.data(), record_size));
+      count++;
+    }
+    ASSERT_EQ(records.size(), count);
+  };
+  check_records();
+
+  // 删除一半的记录，再把剩下的记录改长，需要整理页面才能放下
+  for (int id = 0; id < static_cast<int>(records.size()); id += 2) {
+    RID delete_rid(frame->page_num(), id);
+    ASSERT_EQ(RC::SUCCESS, page_handler->delete_record(&delete_rid));
+  }
+  for (auto iter = records.begin(); iter != records.end();) {
+    iter = iter->first % 2 == 0 ? records.erase(iter) : next(iter);
+  }
+  check_records();
+
+  for (auto &[id, data] : records) {
+    data = make_record(id, "longer name " + to_string(id));
+    ASSERT_EQ(RC::SUCCESS, page_handler->update_record(RID(frame->page_num(), id), data.data()));
+  }
+  check_records();
+
+  // 放不下的时候更新失败，原来的记录保持不变
+  const int         full_id = records.begin()->first;
+  const vector<char> full   = make_record(full_id, string(name_field->len(), 'x'));
+  while (page_handler->free_space() >= 100) {
+    const int id = records.rbegin()->first + 1;
+    records[id]  = make_record(id, "");
+    ASSERT_EQ(RC::SUCCESS, page_handler->recover_insert_record(records[id].data(), RID(frame->page_num(), id)));
+  }
+  ASSERT_EQ(RC::RECORD_NOMEM, page_handler->update_record(RID(frame->page_num(), full_id), full.data()));
+  check_records();
+
+  page_handler->cleanup();
+  bpm.close_file(record_manager_file);
+}
+
 TEST(RecordFileScanner, test_record_file_iterator)
 {
   VacuousLogHandler log_handler;
@@ -355,6 +521,95 @@ TEST(RecordManager, durability)
   bpm2.close_file(record_manager_file.c_str());
 }
 
+TEST(RecordManager, insert_records_durability)
+{
+  // 批量插入时每个页面只有一条日志，重启以后根据日志恢复所有的记录
+  filesystem::path directory("record_manager_insert_records");
+  filesystem::remove_all(directory);
+  ASSERT_TRUE(filesystem::create_directories(directory));
+
+  filesystem::path record_manager_file = directory / "record_manager.bp";
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(bpm.init(make_unique<VacuousDoubleWriteBuffer>()), RC::SUCCESS);
+
+  DiskLogHandler        log_handler;
+  IntegratedLogReplayer log_replayer(bpm);
+  ASSERT_EQ(log_handler.init(directory.c_str()), RC::SUCCESS);
+  ASSERT_EQ(log_handler.replay(log_replayer, 0), RC::SUCCESS);
+  ASSERT_EQ(log_handler.start(), RC::SUCCESS);
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(bpm.create_file(record_manager_file.c_str()), RC::SUCCESS);
+  ASSERT_EQ(bpm.open_file(log_handler, record_manager_file.c_str(), buffer_pool), RC::SUCCESS);
+
+  RecordFileHandler record_file_handler(StorageFormat::ROW_FORMAT);
+  ASSERT_EQ(record_file_handler.init(*buffer_pool, log_handler, nullptr), RC::SUCCESS);
+
+  const int record_size = 100;
+  const int record_num  = 2000;
+
+  // 先插入几条再删掉一条，让批量插入从一个不满的页面开始
+  char record_data[record_size] = "single";
+  RID  rids_before[3];
+  for (RID &rid : rids_before) {
+    ASSERT_EQ(record_file_handler.insert_record(record_data, record_size, &rid), RC::SUCCESS);
+  }
+  ASSERT_EQ(record_file_handler.delete_record(&rids_before[1]), RC::SUCCESS);
+
+  vector<string>       records(record_num, string(record_size, 0));
+  vector<const char *> datas;
+  for (int i = 0; i < record_num; i++) {
+    snprintf(records[i].data(), record_size, "record %d", i);
+    datas.push_back(records[i].data());
+  }
+  vector<RID> rids;
+  ASSERT_EQ(record_file_handler.insert_records(datas, record_size, rids), RC::SUCCESS);
+  ASSERT_EQ(record_num, static_cast<int>(rids.size()));
+  ASSERT_EQ(rids_before[1], rids[0]);
+
+  vector<RID> sorted_rids = rids;
+  sort(sorted_rids.begin(), sorted_rids.end(), [](const RID &a, const RID &b) { return RID::compare(&a, &b) < 0; });
+  ASSERT_EQ(sorted_rids.end(), adjacent_find(sorted_rids.begin(), sorted_rids.end()));
+
+  // 不刷页面，直接丢掉数据文件中的修改
+  filesystem::path record_manager_file_copy = directory / "record_manager_copy.bp";
+  filesystem::copy_file(record_manager_file, record_manager_file_copy);
+  record_file_handler.close();
+  bpm.close_file(record_manager_file.c_str());
+  filesystem::remove(record_manager_file);
+  ASSERT_EQ(log_handler.stop(), RC::SUCCESS);
+  ASSERT_EQ(log_handler.await_termination(), RC::SUCCESS);
+
+  DiskLogHandler    log_handler2;
+  BufferPoolManager bpm2;
+  ASSERT_EQ(RC::SUCCESS, bpm2.init(make_unique<VacuousDoubleWriteBuffer>()));
+  DiskBufferPool *buffer_pool2 = nullptr;
+  filesystem::copy(record_manager_file_copy, record_manager_file);
+  ASSERT_EQ(bpm2.open_file(log_handler2, record_manager_file.c_str(), buffer_pool2), RC::SUCCESS);
+
+  IntegratedLogReplayer log_replayer2(bpm2);
+  ASSERT_EQ(log_handler2.init(directory.c_str()), RC::SUCCESS);
+  ASSERT_EQ(log_handler2.replay(log_replayer2, 0), RC::SUCCESS);
+  ASSERT_EQ(log_handler2.start(), RC::SUCCESS);
+
+  RecordFileHandler record_file_handler2(StorageFormat::ROW_FORMAT);
+  ASSERT_EQ(record_file_handler2.init(*buffer_pool2, log_handler2, nullptr), RC::SUCCESS);
+  for (int i = 0; i < record_num; i++) {
+    Record record;
+    ASSERT_EQ(record_file_handler2.get_record(rids[i], record), RC::SUCCESS);
+    ASSERT_EQ(0, memcmp(record.data(), records[i].data(), record_size)) << "record " << i;
+  }
+  Record record;
+  ASSERT_EQ(record_file_handler2.get_record(rids_before[0], record), RC::SUCCESS);
+  ASSERT_EQ(record_file_handler2.get_record(rids_before[2], record), RC::SUCCESS);
+
+  record_file_handler2.close();
+  ASSERT_EQ(log_handler2.stop(), RC::SUCCESS);
+  ASSERT_EQ(log_handler2.await_termination(), RC::SUCCESS);
+  bpm2.close_file(record_manager_file.c_str());
+}
+
 int main(int argc, char **argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,179 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "storage/table/text_data_manager.h"
+
+using namespace std;
+
+static string make_text(int i, size_t len)
+{
+  string text = to_string(i) + ":";
+  text.resize(len, 'a' + i % 26);
+  return text;
+}
+
+static TextData dump(TextDataManager &manager, const string &text)
+{
+  TextData data{};
+  data.len = text.size();
+  data.str = text.c_str();
+  EXPECT_EQ(RC::SUCCESS, manager.dump_text(&data));
+  return data;
+}
+
+static string load(TextDataManager &manager, TextData data)
+{
+  EXPECT_EQ(RC::SUCCESS, manager.load_text(&data));
+  string text(data.str, data.len);
+  delete[] data.str;
+  return text;
+}
+
+TEST(TextDataManager, read_write)
+{
+  const char *file_name = "text_data_manager_test.data";
+  filesystem::remove(file_name);
+
+  // 长度覆盖空文本、跨页的文本、直接读取的大文本和超过追加缓冲区的文本
+  const vector<size_t> lengths{0, 1, 100, 4095, 4097, 20000, 70000};
+  vector<string>       texts;
+  vector<TextData>     datas;
+  {
+    unique_ptr<TextDataManager> manager = TextDataManager::create(file_name);
+    ASSERT_NE(manager, nullptr);
+    for (int i = 0; i < 100; i++) {
+      texts.push_back(make_text(i, lengths[i % lengths.size()]));
+      datas.push_back(dump(*manager, texts.back()));
+    }
+
+    // 还在追加缓冲区中的文本也可以读到
+    for (size_t i = 0; i < texts.size(); i++) {
+      ASSERT_EQ(texts[i], load(*manager, datas[i]));
+    }
+
+    ASSERT_EQ(RC::SUCCESS, manager->flush());
+    for (size_t i = 0; i < texts.size(); i++) {
+      ASSERT_EQ(texts[i], load(*manager, datas[i]));
+    }
+
+    // 没有刷盘的文本在关闭时写入文件
+    texts.push_back(make_text(100, 10));
+    datas.push_back(dump(*manager, texts.back()));
+  }
+
+  unique_ptr<TextDataManager> manager = TextDataManager::create(file_name);
+  ASSERT_NE(manager, nullptr);
+  for (size_t i = 0; i < texts.size(); i++) {
+    ASSERT_EQ(texts[i], load(*manager, datas[i]));
+  }
+
+  manager.reset();
+  filesystem::remove(file_name);
+}
+
+TEST(TextDataManager, reuse_free_extents)
+{
+  const char *file_name = "text_data_manager_reuse_test.data";
+  filesystem::remove(file_name);
+
+  unique_ptr<TextDataManager> manager = TextDataManager::create(file_name);
+  ASSERT_NE(manager, nullptr);
+
+  vector<string>   texts;
+  vector<TextData> datas;
+  for (int i = 0; i < 10; i++) {
+    texts.push_back(make_text(i, 1000));
+    datas.push_back(dump(*manager, texts.back()));
+  }
+  // 先读一遍，让页面进入缓存，后面复用空间时要同步修改缓存
+  for (size_t i = 0; i < texts.size(); i++) {
+    ASSERT_EQ(texts[i], load(*manager, datas[i]));
+  }
+  ASSERT_EQ(RC::SUCCESS, manager->flush());
+  const size_t data_end = manager->data_end();
+
+  // 相邻的空闲区间合并成一个，重复释放会被忽略
+  manager->free_text(datas[3]);
+  manager->free_text(datas[5]);
+  manager->free_text(datas[4]);
+  manager->free_text(datas[4]);
+  ASSERT_EQ(3000, manager->free_size());
+
+  // 新的文本写入空闲区间，不会增加文件的大小
+  string   text = make_text(100, 2500);
+  TextData data = dump(*manager, text);
+  ASSERT_EQ(datas[3].offset, data.offset);
+  ASSERT_EQ(500, manager->free_size());
+  ASSERT_EQ(data_end, manager->data_end());
+  ASSERT_EQ(text, load(*manager, data));
+
+  // 放不下的文本追加到末尾
+  string   big_text = make_text(101, 600);
+  TextData big_data = dump(*manager, big_text);
+  ASSERT_EQ(data_end, big_data.offset);
+  ASSERT_EQ(big_text, load(*manager, big_data));
+
+  for (size_t i = 0; i < texts.size(); i++) {
+    if (i < 3 || i > 5) {
+      ASSERT_EQ(texts[i], load(*manager, datas[i]));
+    }
+  }
+
+  manager.reset();
+  manager = TextDataManager::create(file_name);
+  ASSERT_EQ(text, load(*manager, data));
+  ASSERT_EQ(big_text, load(*manager, big_data));
+
+  manager.reset();
+  filesystem::remove(file_name);
+}
+
+TEST(TextDataManager, reclaim_retired_extents)
+{
+  const char *file_name = "text_data_manager_retire_test.data";
+  filesystem::remove(file_name);
+
+  unique_ptr<TextDataManager> manager = TextDataManager::create(file_name);
+  ASSERT_NE(manager, nullptr);
+
+  string   old_text = make_text(1, 1000);
+  TextData old_data = dump(*manager, old_text);
+  ASSERT_EQ(RC::SUCCESS, manager->flush());
+  const size_t data_end = manager->data_end();
+
+  // 释放以后还没有到回收的水位，旧的读者依然可以读到原来的文本
+  manager->retire_text(old_data, 10);
+  ASSERT_EQ(0, manager->free_size());
+  manager->reclaim(10);
+  ASSERT_EQ(0, manager->free_size());
+
+  string   text = make_text(2, 1000);
+  TextData data = dump(*manager, text);
+  ASSERT_EQ(data_end, data.offset);
+  ASSERT_EQ(old_text, load(*manager, old_data));
+
+  // 超过水位以后空间才会被复用
+  manager->reclaim(11);
+  ASSERT_EQ(1000, manager->free_size());
+  string   new_text = make_text(3, 1000);
+  TextData new_data = dump(*manager, new_text);
+  ASSERT_EQ(old_data.offset, new_data.offset);
+  ASSERT_EQ(new_text, load(*manager, new_data));
+  ASSERT_EQ(text, load(*manager, data));
+
+  manager.reset();
+  filesystem::remove(file_name);
+}
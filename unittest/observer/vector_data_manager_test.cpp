@@ -0,0 +1,246 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "storage/table/vector_data_manager.h"
+
+using namespace std;
+
+static vector<float> make_vector(int i, size_t dim)
+{
+  vector<float> values(dim);
+  for (size_t j = 0; j < dim; j++) {
+    values[j] = static_cast<float>(i * 1000 + j);
+  }
+  return values;
+}
+
+static VectorData dump(VectorDataManager &manager, const vector<float> &values)
+{
+  VectorData data{};
+  data.dim    = values.size();
+  data.vector = values.data();
+  EXPECT_EQ(RC::SUCCESS, manager.dump_vector(&data));
+  return data;
+}
+
+static vector<float> load(VectorDataManager &manager, VectorData data)
+{
+  EXPECT_EQ(RC::SUCCESS, manager.load_vector(&data));
+  vector<float> values(data.vector, data.vector + data.dim);
+  delete[] data.vector;
+  return values;
+}
+
+TEST(VectorDataManager, read_write)
+{
+  const char *file_name = "vector_data_manager_test.data";
+  filesystem::remove(file_name);
+
+  // 缓存只有很少的页面，读写时会不断淘汰脏页
+  const size_t          cache_size = 16 * 4096;
+  vector<vector<float>> vectors;
+  vector<VectorData>    datas;
+  size_t                data_end = 0;
+  {
+    unique_ptr<VectorDataManager> manager = VectorDataManager::create(file_name, cache_size);
+    ASSERT_NE(manager, nullptr);
+    for (int i = 0; i < 1000; i++) {
+      vectors.push_back(make_vector(i, 3 + i % 300));
+      datas.push_back(dump(*manager, vectors.back()));
+    }
+    for (size_t i = 0; i < vectors.size(); i++) {
+      ASSERT_EQ(vectors[i], load(*manager, datas[i]));
+    }
+
+    // 更新以后读到新的数据
+    vectors[10] = make_vector(2000, vectors[10].size());
+    VectorData new_data{};
+    new_data.dim    = vectors[10].size();
+    new_data.vector = vectors[10].data();
+    ASSERT_EQ(RC::SUCCESS, manager->update_vector(&datas[10], &new_data));
+    ASSERT_EQ(vectors[10], load(*manager, datas[10]));
+
+    ASSERT_EQ(RC::SUCCESS, manager->sync());
+    data_end = manager->data_end();
+    ASSERT_EQ(data_end, filesystem::file_size(file_name));
+
+    // 没有刷盘的向量在关闭时写入文件
+    vectors.push_back(make_vector(1000, 5));
+    datas.push_back(dump(*manager, vectors.back()));
+    data_end = manager->data_end();
+  }
+
+  // 重启以后从数据的结尾继续写入，不会留下空洞
+  ASSERT_EQ(data_end, filesystem::file_size(file_name));
+  unique_ptr<VectorDataManager> manager = VectorDataManager::create(file_name, cache_size);
+  ASSERT_NE(manager, nullptr);
+  ASSERT_EQ(data_end, manager->data_end());
+  for (size_t i = 0; i < vectors.size(); i++) {
+    ASSERT_EQ(vectors[i], load(*manager, datas[i]));
+  }
+
+  vector<float> values = make_vector(1001, 7);
+  VectorData    data   = dump(*manager, values);
+  ASSERT_EQ(data_end, data.offset);
+  ASSERT_EQ(values, load(*manager, data));
+
+  manager.reset();
+  filesystem::remove(file_name);
+}
+
+TEST(VectorDataManager, reuse_free_space)
+{
+  const char *file_name = "vector_data_manager_reuse_test.data";
+  filesystem::remove(file_name);
+
+  unique_ptr<VectorDataManager> manager = VectorDataManager::create(file_name);
+  ASSERT_NE(manager, nullptr);
+
+  vector<vector<float>> vectors;
+  vector<VectorData>    datas;
+  for (int i = 0; i < 10; i++) {
+    vectors.push_back(make_vector(i, 100));
+    datas.push_back(dump(*manager, vectors.back()));
+  }
+  const size_t data_end = manager->data_end();
+
+  // 重复释放只记录一次
+  manager->free_vector(datas[3]);
+  manager->free_vector(datas[5]);
+  manager->free_vector(datas[5]);
+  ASSERT_EQ(2 * 100 * sizeof(float), manager->free_size());
+
+  // 同样长度的向量复用释放的空间，不会增加文件的大小
+  vector<float> values = make_vector(100, 100);
+  VectorData    data   = dump(*manager, values);
+  ASSERT_EQ(datas[3].offset, data.offset);
+  ASSERT_EQ(data_end, manager->data_end());
+  ASSERT_EQ(values, load(*manager, data));
+
+  // 长度不同的向量追加到末尾
+  vector<float> other_values = make_vector(101, 50);
+  VectorData    other_data   = dump(*manager, other_values);
+  ASSERT_EQ(data_end, other_data.offset);
+  ASSERT_EQ(100 * sizeof(float), manager->free_size());
+
+  for (size_t i = 0; i < vectors.size(); i++) {
+    if (i != 3 && i != 5) {
+      ASSERT_EQ(vectors[i], load(*manager, datas[i]));
+    }
+  }
+
+  manager.reset();
+  filesystem::remove(file_name);
+}
+
+static vector<float> mapped(const VectorData &data) { return vector<float>(data.vector, data.vector + data.dim); }
+
+TEST(VectorDataManager, map_vector)
+{
+  const char *file_name = "vector_data_manager_map_test.data";
+  filesystem::remove(file_name);
+
+  unique_ptr<VectorDataManager> manager = VectorDataManager::create(file_name);
+  ASSERT_NE(manager, nullptr);
+
+  vector<float> values = make_vector(0, 768);
+  VectorData    data   = dump(*manager, values);
+
+  // 还没有写入文件的向量不能映射
+  ASSERT_FALSE(manager->map_vector(&data));
+  ASSERT_EQ(RC::SUCCESS, manager->flush());
+  ASSERT_TRUE(manager->map_vector(&data));
+  ASSERT_EQ(values, mapped(data));
+  const float *first_address = data.vector;
+
+  // 文件变大以后重新映射，之前返回的地址仍然有效
+  vector<vector<float>> vectors;
+  vector<VectorData>    datas;
+  for (int i = 1; i < 2000; i++) {
+    vectors.push_back(make_vector(i, 768));
+    datas.push_back(dump(*manager, vectors.back()));
+  }
+  ASSERT_EQ(RC::SUCCESS, manager->flush());
+  for (size_t i = 0; i < datas.size(); i++) {
+    ASSERT_TRUE(manager->map_vector(&datas[i]));
+    ASSERT_EQ(vectors[i], mapped(datas[i]));
+  }
+  ASSERT_EQ(values, vector<float>(first_address, first_address + values.size()));
+
+  // 更新以后页面是脏页，刷盘以后才能映射，映射中看到的是新的数据
+  vector<float> new_values = make_vector(5000, 768);
+  VectorData    new_data{};
+  new_data.dim    = new_values.size();
+  new_data.vector = new_values.data();
+  ASSERT_EQ(RC::SUCCESS, manager->update_vector(&data, &new_data));
+  ASSERT_FALSE(manager->map_vector(&data));
+  ASSERT_EQ(new_values, load(*manager, data));
+  ASSERT_EQ(RC::SUCCESS, manager->flush());
+  ASSERT_TRUE(manager->map_vector(&data));
+  ASSERT_EQ(new_values, mapped(data));
+
+  manager.reset();
+  filesystem::remove(file_name);
+}
+
+TEST(VectorDataManager, concurrent_read_write)
+{
+  const char *file_name = "vector_data_manager_concurrent_test.data";
+  filesystem::remove(file_name);
+
+  unique_ptr<VectorDataManager> manager = VectorDataManager::create(file_name, 32 * 4096);
+  ASSERT_NE(manager, nullptr);
+
+  // 多个线程同时写入向量
+  const int          thread_num        = 8;
+  const int          vector_per_thread = 500;
+  const size_t       dim               = 128;
+  vector<VectorData> datas(thread_num * vector_per_thread);
+  vector<thread>     threads;
+  for (int t = 0; t < thread_num; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = t * vector_per_thread; i < (t + 1) * vector_per_thread; i++) {
+        datas[i] = dump(*manager, make_vector(i, dim));
+      }
+    });
+  }
+  for (thread &t : threads) {
+    t.join();
+  }
+  threads.clear();
+
+  // 多个线程从不同的位置开始读取所有的向量
+  for (int t = 0; t < thread_num; t++) {
+    threads.emplace_back([&, t]() {
+      for (size_t i = 0; i < datas.size(); i++) {
+        const size_t index = (i + t * vector_per_thread) % datas.size();
+        EXPECT_EQ(make_vector(index, dim), load(*manager, datas[index]));
+      }
+    });
+  }
+  for (thread &t : threads) {
+    t.join();
+  }
+
+  ASSERT_EQ(datas.size() * dim * sizeof(float), manager->data_end());
+  for (size_t i = 0; i < datas.size(); i++) {
+    ASSERT_EQ(make_vector(i, dim), load(*manager, datas[i]));
+  }
+
+  manager.reset();
+  filesystem::remove(file_name);
+}